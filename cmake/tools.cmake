@@ -64,4 +64,35 @@ function(ts_add_instruction_support target_name flag)
             target_compile_options(${target_name} PRIVATE -msse2)
         endif()
     endif()
-endfunction()
\ No newline at end of file
+endfunction()
+# ts_add_source_instruction_support(flag source1 [source2 ...])
+# compile only given sources with extra instruction set, used by runtime dispatched kernels
+# flag:
+# avx2:add avx2,fma support
+# avx512:add avx512 f,dq,bw,vl and fma support
+# aesni:add aes support
+function(ts_add_source_instruction_support flag)
+    set(src_files)
+    set(INDEX 1)
+    while(INDEX LESS ${ARGC})
+        list(APPEND src_files ${ARGV${INDEX}})
+        math(EXPR INDEX "${INDEX} + 1")
+    endwhile()
+
+    if (MSVC)
+        if(${flag} STREQUAL "avx2")
+            set_source_files_properties(${src_files} PROPERTIES COMPILE_FLAGS "/arch:AVX2")
+        elseif(${flag} STREQUAL "avx512")
+            set_source_files_properties(${src_files} PROPERTIES COMPILE_FLAGS "/arch:AVX512")
+        endif()
+    else()
+        if(${flag} STREQUAL "avx2")
+            set_source_files_properties(${src_files} PROPERTIES COMPILE_FLAGS "-mavx -mavx2 -mfma")
+        elseif(${flag} STREQUAL "avx512")
+            set_source_files_properties(${src_files} PROPERTIES
+                    COMPILE_FLAGS "-mavx -mavx2 -mfma -mavx512f -mavx512dq -mavx512bw -mavx512vl")
+        elseif(${flag} STREQUAL "aesni")
+            set_source_files_properties(${src_files} PROPERTIES COMPILE_FLAGS "-msse2 -maes")
+        endif()
+    endif()
+endfunction()
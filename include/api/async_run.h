@@ -0,0 +1,94 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENNIS_API_ASYNC_RUN_H
+#define TENNIS_API_ASYNC_RUN_H
+
+#include "common.h"
+#include "tensor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Handle of one asynchronous run, @sa ts_Workbench_run_async
+ */
+struct ts_AsyncRun;
+typedef struct ts_AsyncRun ts_AsyncRun;
+
+enum ts_AsyncRun_Status {
+    TS_ASYNC_QUEUED     = 0,    ///< waiting in executor
+    TS_ASYNC_RUNNING    = 1,    ///< filtering or running, can not be cancelled
+    TS_ASYNC_DONE       = 2,    ///< outputs ready
+    TS_ASYNC_FAILED     = 3,    ///< failed in filtering or running
+    TS_ASYNC_CANCELLED  = 4,    ///< cancelled before running
+};
+typedef enum ts_AsyncRun_Status ts_AsyncRun_Status;
+
+/**
+ * Called once in executor thread when run ready or cancelled.
+ * @param run borrowed handle, only valid in callback, do not free it
+ * @param userdata the pointer given to ts_Workbench_run_async
+ * @note do not block in callback, the next run waits for it
+ */
+typedef void (*ts_AsyncRun_callback)(ts_AsyncRun *run, void *userdata);
+
+/**
+ * Free async run handle, the run is not cancelled.
+ * @param run instance of async run
+ * Happen nothing if failed.
+ */
+TENNIS_C_API void ts_free_AsyncRun(const ts_AsyncRun *run);
+
+/**
+ * Get status of run.
+ * @param run instance of async run
+ * @return status, TS_ASYNC_FAILED if failed.
+ */
+TENNIS_C_API ts_AsyncRun_Status ts_AsyncRun_status(ts_AsyncRun *run);
+
+/**
+ * Wait run ready.
+ * @param run instance of async run
+ * @return ts_true if outputs ready, ts_false if run failed or cancelled, with error message set.
+ */
+TENNIS_C_API ts_bool ts_AsyncRun_wait(ts_AsyncRun *run);
+
+/**
+ * Wait run ready or out of time.
+ * @param run instance of async run
+ * @param milliseconds max waiting time
+ * @return ts_true if run ready (done, failed or cancelled), ts_false if out of time.
+ */
+TENNIS_C_API ts_bool ts_AsyncRun_wait_for(ts_AsyncRun *run, int64_t milliseconds);
+
+/**
+ * Cancel run still queued.
+ * @param run instance of async run
+ * @return ts_true if cancelled, ts_false if already running or ready.
+ */
+TENNIS_C_API ts_bool ts_AsyncRun_cancel(ts_AsyncRun *run);
+
+/**
+ * Wait run ready, then get number of outputs.
+ * @param run instance of async run
+ * @return number of outputs, 0 if failed.
+ */
+TENNIS_C_API int32_t ts_AsyncRun_output_count(ts_AsyncRun *run);
+
+/**
+ * Wait run ready, then get output i-th tensor.
+ * @param run instance of async run
+ * @param i slot index
+ * @param tensor output tensor
+ * @return false if failed.
+ */
+TENNIS_C_API ts_bool ts_AsyncRun_output(ts_AsyncRun *run, int32_t i, ts_Tensor *tensor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TENNIS_API_ASYNC_RUN_H
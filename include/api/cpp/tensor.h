@@ -274,6 +274,22 @@ namespace ts {
                 return std::move(dolly);
             }
 
+            /**
+             * @return tensor borrowing data, no copy, data must be alive until the tensor and its shares freed
+             * @see ts_new_Tensor_borrowed
+             */
+            inline Tensor borrow(DTYPE dtype, const Shape &shape, void *data) {
+                auto borrowed = Tensor::NewRef(ts_new_Tensor_borrowed(
+                        shape.data(), int32_t(shape.size()), ts_DTYPE(dtype), data));
+                TS_API_AUTO_CHECK(borrowed != nullptr);
+                return borrowed;
+            }
+
+            template<typename T>
+            inline Tensor borrow(const Shape &shape, T *data) {
+                return borrow(dtypeid<T>::id, shape, data);
+            }
+
             inline Tensor from(const std::string &value) {
                 return Tensor(TS_CHAR8, {int32_t(value.length())}, value.c_str());
             }
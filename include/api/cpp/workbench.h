@@ -84,6 +84,12 @@ namespace ts {
                 return std::move(dolly);
             }
 
+            Workbench share() const {
+                Workbench dolly(ts_Workbench_share(m_impl.get()));
+                TS_API_AUTO_CHECK(dolly.m_impl != nullptr);
+                return std::move(dolly);
+            }
+
             void input(int slot, const ts_Tensor *tensor) {
                 TS_API_AUTO_CHECK(ts_Workbench_input(m_impl.get(), slot, tensor));
             }
@@ -104,6 +110,22 @@ namespace ts {
                 TS_API_AUTO_CHECK(ts_Workbench_run(m_impl.get()));
             }
 
+            void bind_output(int slot, const ts_Tensor *buffer) {
+                TS_API_AUTO_CHECK(ts_Workbench_bind_output(m_impl.get(), slot, buffer));
+            }
+
+            void bind_output(int slot, const Tensor &buffer) {
+                bind_output(slot, buffer.get_raw());
+            }
+
+            void bind_output(const std::string &name, const ts_Tensor *buffer) {
+                TS_API_AUTO_CHECK(ts_Workbench_bind_output_by_name(m_impl.get(), name.c_str(), buffer));
+            }
+
+            void bind_output(const std::string &name, const Tensor &buffer) {
+                bind_output(name, buffer.get_raw());
+            }
+
             void output(int slot, ts_Tensor *tensor) {
                 TS_API_AUTO_CHECK(ts_Workbench_output(m_impl.get(), slot, tensor));
             }
@@ -17,6 +17,15 @@ extern "C" {
  */
 TENNIS_C_API ts_bool ts_setup();
 
+/**
+ * Set if workbenches created or set computing thread number later run in one process-wide thread pool.
+ * @param use ts_true for sharing one thread pool, ts_false for one thread pool each workbench (default)
+ * @return ts_true if succeed.
+ * @note the computing thread number of each workbench still limits the threads it uses,
+ *       so N workbenches do not create N times threads
+ */
+TENNIS_C_API ts_bool ts_use_shared_thread_pool(ts_bool use);
+
 #ifdef __cplusplus
 }
 #endif
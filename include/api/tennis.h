@@ -15,6 +15,7 @@
 #include "module.h"
 #include "image_filter.h"
 #include "workbench.h"
+#include "async_run.h"
 #include "intime.h"
 
 #endif //TENNIS_API_TENNIS_H
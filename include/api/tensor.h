@@ -140,6 +140,21 @@ TENNIS_C_API ts_Tensor *ts_Tensor_reshape(ts_Tensor *tensor, const int32_t *shap
  */
 TENNIS_C_API ts_Tensor *ts_new_Tensor_in_flow(ts_InFlow in_flow, const int32_t *shape, int32_t shape_len, ts_DTYPE dtype, const void *data);
 
+/**
+ * New tensor borrowing caller's buffer, no memory allocated or copied.
+ * @param shape shape of new tensor
+ * @param shape_len length of given shape
+ * @param dtype data type of tensor
+ * @param data caller owned data on cpu, must have same data type as dtype, can not be NULL.
+ * @return new reference, NULL if failed.
+ * @note @sa ts_free_Tensor to free ts_Tensor, data is not freed.
+ * @note data must be alive and unchanged until the tensor and every tensor sharing it are freed,
+ *       including the input set to workbench by ts_Workbench_input, which is hold until next input or workbench freed.
+ * @note data must be aligned to size of dtype. 32 bytes aligned is suggested, kernels need no more than that.
+ * @note data may be written directly if the tensor is bound as output buffer, @sa ts_Workbench_bind_output
+ */
+TENNIS_C_API ts_Tensor *ts_new_Tensor_borrowed(const int32_t *shape, int32_t shape_len, ts_DTYPE dtype, void *data);
+
 /**
  * Get tensor view on device in flow.
  * @param tensor the instance of tensor
@@ -10,6 +10,7 @@
 #include "module.h"
 #include "image_filter.h"
 #include "program.h"
+#include "async_run.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +56,15 @@ TENNIS_C_API void ts_free_Workbench(const ts_Workbench *workbench);
  */
 TENNIS_C_API ts_Workbench *ts_Workbench_clone(ts_Workbench *workbench);
 
+/**
+ * Create lightweight ts_Workbench running the same program, program, weights and thread pool are shared.
+ * @param workbench instance of workbench with setup program
+ * @return new reference, NULL if failed.
+ * @note workbenches sharing one program can run concurrently in different threads,
+ *       do not bind filter or set operator param after sharing.
+ */
+TENNIS_C_API ts_Workbench *ts_Workbench_share(ts_Workbench *workbench);
+
 /**
  * Input i-th tensor.
  * @param workbench instance of workbench
@@ -80,6 +90,31 @@ TENNIS_C_API ts_bool ts_Workbench_input_by_name(ts_Workbench *workbench, const c
  */
 TENNIS_C_API ts_bool ts_Workbench_run(ts_Workbench *workbench);
 
+/**
+ * Run asynchronously on executor owned by workbench, input filtering and running are pipelined.
+ * @param workbench instance of workbench
+ * @param inputs each input tensor, in slot order
+ * @param len number of inputs, must be input count of workbench
+ * @param callback called in executor thread when run ready or cancelled, can be NULL
+ * @param userdata passed to callback
+ * @return new reference, NULL if failed.
+ * @note @sa ts_free_AsyncRun to free ts_AsyncRun, freeing handle does not cancel the run
+ * @note blocks while async capacity runs in flight, @sa ts_Workbench_set_async_capacity
+ * @note inputs are hold until run ready, borrowed input data must be alive until then
+ * @note outputs are got by ts_AsyncRun_output, the outputs and bound output buffers of workbench are not touched
+ */
+TENNIS_C_API ts_AsyncRun *ts_Workbench_run_async(ts_Workbench *workbench, const ts_Tensor *const *inputs, int32_t len,
+                                                ts_AsyncRun_callback callback, void *userdata);
+
+/**
+ * Set max number of async runs in flight, default is 2.
+ * @param workbench instance of workbench
+ * @param capacity max number of async runs in flight
+ * @return false if failed.
+ * @note waits all async runs finished
+ */
+TENNIS_C_API ts_bool ts_Workbench_set_async_capacity(ts_Workbench *workbench, int32_t capacity);
+
 /**
  * Get output i-th tensor.
  * @param workbench instance of workbench
@@ -89,6 +124,29 @@ TENNIS_C_API ts_bool ts_Workbench_run(ts_Workbench *workbench);
  */
 TENNIS_C_API ts_bool ts_Workbench_output(ts_Workbench *workbench, int32_t i, ts_Tensor *tensor);
 
+/**
+ * Bind caller provided buffer to output i-th, the output is written into buffer in next runs.
+ * @param workbench instance of workbench
+ * @param i slot index
+ * @param buffer output buffer, usually from ts_new_Tensor_borrowed, NULL for unbinding.
+ * @return false if failed.
+ * @note buffer must have the same dtype and element count of output, or ts_Workbench_run fails
+ * @note the operator producing the output writes into buffer directly if it can, or output is copied into buffer.
+ *       after run, ts_Workbench_output gets tensor sharing buffer memory, so no more copy needed.
+ * @note buffer memory must be alive until unbound or workbench freed, binding is cleared by ts_Workbench_setup.
+ */
+TENNIS_C_API ts_bool ts_Workbench_bind_output(ts_Workbench *workbench, int32_t i, const ts_Tensor *buffer);
+
+/**
+ * Bind caller provided buffer to named output.
+ * @param workbench instance of workbench
+ * @param name slot name
+ * @param buffer output buffer, NULL for unbinding.
+ * @return false if failed.
+ * @see ts_Workbench_bind_output
+ */
+TENNIS_C_API ts_bool ts_Workbench_bind_output_by_name(ts_Workbench *workbench, const char *name, const ts_Tensor *buffer);
+
 /**
  * Get output named tensor.
  * @param workbench instance of workbench
@@ -39,6 +39,7 @@ namespace ts {
             std::valarray<int> m_dilation4;
 
             bool m_kernel_packed = false;
+            Conv2DEpilogue m_epilogue;
         };
     }
 }
@@ -8,13 +8,47 @@
 #include "backend/common_structure.h"
 #include "core/tensor.h"
 #include "runtime/stack.h"
+#include "runtime/operator.h"
 
 namespace ts {
     namespace base {
+        /**
+         * fused in conv2d output: out = activation(out + bias), bias and slope are per output channel
+         */
+        class Conv2DEpilogue {
+        public:
+            Tensor bias;        ///< empty for no bias
+            FusedActivation activation = FusedActivation::NONE;
+            float max = 0;      ///< for RELU_MAX
+            Tensor slope;       ///< for LEAKY_RELU, with 1 or channels values
+
+            bool empty() const { return bias.empty() && activation == FusedActivation::NONE; }
+
+            /**
+             * declare optional fused params: fused_bias, fused_activation, fused_max and fused_slope
+             */
+            static void Field(Operator &op);
+
+            /**
+             * @return epilogue set in params of initialized op
+             */
+            static Conv2DEpilogue Get(const Operator &op);
+        };
+
         class Conv2DCore {
         public:
             virtual ~Conv2DCore() = default;
 
+            virtual void conv2d(const Tensor &x, const Padding2D &padding, float padding_value,
+                                const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
+                                Conv2DFormat format, Tensor &out, Stack &stack, bool kernel_packed,
+                                const Conv2DEpilogue &epilogue) {
+                if (!epilogue.empty()) {
+                    TS_LOG_ERROR << "What a Terrible Failure: dealing fused epilogue without fusion support." << eject;
+                }
+                conv2d(x, padding, padding_value, w, stride, dilation, format, out, stack, kernel_packed);
+            }
+
             virtual void conv2d(const Tensor &x, const Padding2D &padding, float padding_value,
                                 const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
                                 Conv2DFormat format, Tensor &out, Stack &stack, bool kernel_packed) {
@@ -82,6 +116,15 @@ namespace ts {
                 m_core->conv2d(x, padding, padding_value, w, stride, dilation, format, out, stack, kernel_packed);
             }
 
+            void conv2d(const Tensor &x, const Padding2D &padding, float padding_value,
+                        const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
+                        Conv2DFormat format, Tensor &out, Stack &stack, bool kernel_packed,
+                        const Conv2DEpilogue &epilogue) override {
+                // cores may hide this overload, so call it through the base interface
+                Conv2DCore &core = *m_core;
+                core.conv2d(x, padding, padding_value, w, stride, dilation, format, out, stack, kernel_packed, epilogue);
+            }
+
             void conv2d(const Tensor &x, const Padding2D &padding, float padding_value,
                                 const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
                                 Conv2DFormat format, Tensor &out, Stack &stack) override {
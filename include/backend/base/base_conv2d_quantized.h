@@ -36,6 +36,8 @@ namespace ts {
 
             //float m_quantize_scale;
             std::vector<float> m_dequantize_scales;
+            bool m_requantize = false;
+            float m_requantize_scale = 1.0f;
         };
     }
 }
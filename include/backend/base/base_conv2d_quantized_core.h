@@ -11,9 +11,13 @@ namespace ts {
         public:
             virtual ~Conv2DQuantizedCore() = default;
 
+            /**
+             * @param requantize_scale used if out is int8, quantize dequantized output again
+             */
             virtual void conv2d(const Tensor &x, const Padding2D &padding, float padding_value,
                 const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
-                Conv2DFormat format, std::vector<float>dequantize_scale, Tensor &out, Stack &stack) = 0;
+                Conv2DFormat format, std::vector<float>dequantize_scale, float requantize_scale,
+                Tensor &out, Stack &stack) = 0;
         };
 
         /**
@@ -31,9 +35,9 @@ namespace ts {
 
             void conv2d(const Tensor &x, const Padding2D &padding, float padding_value,
                 const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
-                Conv2DFormat format, std::vector<float>dequantize_scale,
+                Conv2DFormat format, std::vector<float>dequantize_scale, float requantize_scale,
                 Tensor &out, Stack &stack) override {
-                m_core->conv2d(x, padding, padding_value, w, stride, dilation, format, dequantize_scale, out, stack);
+                m_core->conv2d(x, padding, padding_value, w, stride, dilation, format, dequantize_scale, requantize_scale, out, stack);
             }
 
         private:
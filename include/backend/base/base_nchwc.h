@@ -0,0 +1,156 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_BACKEND_BASE_BASE_NCHWC_H
+#define TENSORSTACK_BACKEND_BASE_BASE_NCHWC_H
+
+#include "operator_on_device.h"
+
+#include "backend/common_structure.h"
+#include "base_conv2d_core.h"
+
+namespace ts {
+    namespace base {
+        /**
+         * Channel blocked layout NCHWc: [N, C / block, H, W, block], channel c is at [c / block, ..., c % block].
+         * Channels are padded to multiple of block, padded channels are kept zero by blocked kernels,
+         * so 2D params in these operators are given in [height, width] and [top, bottom, left, right] order.
+         */
+
+        /**
+         * NCHW to NCHWc, padded channels are zero
+         */
+        class ToNCHWc : public OperatorOnDevice {
+        public:
+            using self = ToNCHWc;
+            using supper = OperatorOnDevice;
+
+            ToNCHWc();
+
+            void init() override;
+
+            int run(Stack &stack) override;
+
+            int infer(Stack &stack, std::vector<Tensor::Prototype> &output) override;
+
+            virtual void to_nchwc(const Tensor &x, int block, Tensor &out) = 0;
+
+        private:
+            int m_block = 0;
+        };
+
+        /**
+         * NCHWc to NCHW, keep the first channels
+         */
+        class FromNCHWc : public OperatorOnDevice {
+        public:
+            using self = FromNCHWc;
+            using supper = OperatorOnDevice;
+
+            FromNCHWc();
+
+            void init() override;
+
+            int run(Stack &stack) override;
+
+            int infer(Stack &stack, std::vector<Tensor::Prototype> &output) override;
+
+            virtual void from_nchwc(const Tensor &x, int channels, Tensor &out) = 0;
+
+        private:
+            int m_channels = 0;
+        };
+
+        /**
+         * conv2d on NCHWc with fused epilogue of conv2d, bias and slope padded to blocked output channels.
+         * x: [N, IC / block, H, W, block]
+         * w: [OC / block, IC / block, KH, KW, block of input channels, block of output channels]
+         * out: [N, OC / block, OH, OW, block]
+         */
+        class Conv2DNCHWc : public OperatorOnDevice {
+        public:
+            using self = Conv2DNCHWc;
+            using supper = OperatorOnDevice;
+
+            Conv2DNCHWc();
+
+            void init() override;
+
+            int run(Stack &stack) override;
+
+            int infer(Stack &stack, std::vector<Tensor::Prototype> &output) override;
+
+            virtual void conv2d(const Tensor &x, const Padding2D &padding, const Tensor &w,
+                                const Stride2D &stride, const Dilation2D &dilation,
+                                const Conv2DEpilogue &epilogue, Tensor &out) = 0;
+
+        private:
+            Padding2D m_padding;
+            Stride2D m_stride;
+            Dilation2D m_dilation;
+            Conv2DEpilogue m_epilogue;
+        };
+
+        /**
+         * depthwise conv2d on NCHWc, with channel multiplier 1 and optional fused epilogue.
+         * x: [N, C / block, H, W, block]
+         * w: [C / block, KH, KW, block]
+         * out: [N, C / block, OH, OW, block]
+         */
+        class DepthwiseConv2DNCHWc : public OperatorOnDevice {
+        public:
+            using self = DepthwiseConv2DNCHWc;
+            using supper = OperatorOnDevice;
+
+            DepthwiseConv2DNCHWc();
+
+            void init() override;
+
+            int run(Stack &stack) override;
+
+            int infer(Stack &stack, std::vector<Tensor::Prototype> &output) override;
+
+            virtual void conv2d(const Tensor &x, const Padding2D &padding, const Tensor &w,
+                                const Stride2D &stride, const Dilation2D &dilation,
+                                const Conv2DEpilogue &epilogue, Tensor &out) = 0;
+
+        private:
+            Padding2D m_padding;
+            Stride2D m_stride;
+            Dilation2D m_dilation;
+            Conv2DEpilogue m_epilogue;
+        };
+
+        /**
+         * pooling2d on NCHWc, same output size and padding semantics as pooling2d
+         */
+        class Pooling2DNCHWc : public OperatorOnDevice {
+        public:
+            using self = Pooling2DNCHWc;
+            using supper = OperatorOnDevice;
+
+            Pooling2DNCHWc();
+
+            void init() override;
+
+            int run(Stack &stack) override;
+
+            int infer(Stack &stack, std::vector<Tensor::Prototype> &output) override;
+
+            virtual void pooling2d(const Tensor &x, Pooling2DType type, const Padding2D &padding,
+                                   Padding2DType padding_type, const KSize2D &ksize, const Stride2D &stride,
+                                   Tensor &out) = 0;
+
+        private:
+            Pooling2DType m_type;
+            Padding2D m_padding;
+            Padding2DType m_padding_type;
+            KSize2D m_ksize;
+            Stride2D m_stride;
+        };
+    }
+}
+
+
+#endif //TENSORSTACK_BACKEND_BASE_BASE_NCHWC_H
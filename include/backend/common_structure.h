@@ -86,6 +86,16 @@ namespace ts {
         AVG = 1,
     };
 
+    /**
+     * activation fused in operator output
+     */
+    enum class FusedActivation : int {
+        NONE = 0,
+        RELU = 1,
+        RELU_MAX = 2,
+        LEAKY_RELU = 3,     ///< leaky relu or prelu, with scalar or per channel slope
+    };
+
     enum class Padding2DType : int {
         BLACK = 0,
         COPY = 1,
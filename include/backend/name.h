@@ -143,6 +143,13 @@ namespace ts {
 
             TS_DEBUG_API const string &conv2d_winograd_v2() TS_NOEXCEPT;
 
+            // 2019-08-22, channel blocked layout
+            TS_DEBUG_API const string &to_nchwc() TS_NOEXCEPT;
+            TS_DEBUG_API const string &from_nchwc() TS_NOEXCEPT;
+            TS_DEBUG_API const string &conv2d_nchwc() TS_NOEXCEPT;
+            TS_DEBUG_API const string &depthwise_conv2d_nchwc() TS_NOEXCEPT;
+            TS_DEBUG_API const string &pooling2d_nchwc() TS_NOEXCEPT;
+
         }
 
         namespace typo {
@@ -224,12 +231,21 @@ namespace ts {
 
         TS_DEBUG_API extern string quantize_scale;
         TS_DEBUG_API extern string dequantize_scales;
+        TS_DEBUG_API extern string requantize_scale;
+
+        TS_DEBUG_API extern string fused_bias;
+        TS_DEBUG_API extern string fused_activation;
+        TS_DEBUG_API extern string fused_max;
+        TS_DEBUG_API extern string fused_slope;
 
         TS_DEBUG_API extern string dims;
         TS_DEBUG_API extern string repeats;
 
         TS_DEBUG_API extern string transpose;
         TS_DEBUG_API extern string kernel_winograd_transformed;
+
+        TS_DEBUG_API extern string block;
+        TS_DEBUG_API extern string channels;
     }
 }
 
@@ -9,6 +9,10 @@
 #include <string>
 #include <cstdint>
 #include <functional>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <ostream>
 
 #include "utils/except.h"
 #include "utils/ctxmgr_lite.h"
@@ -55,14 +59,80 @@ namespace ts {
         std::function<void(void)> m_later;
     };
 
+    /**
+     * one operator running recorded by profiler
+     */
+    class TS_DEBUG_API ProfileEvent {
+    public:
+        std::string op;             ///< operator type
+        std::string name;           ///< node name
+        int64_t start = 0;          ///< microseconds since profiler created
+        int64_t duration = 0;       ///< wall time in microseconds
+        int32_t thread = 0;         ///< serial of calling thread
+        double flops = 0;           ///< estimated floating point operations
+        int64_t bytes = 0;          ///< bytes of inputs and outputs
+        int64_t alloc_bytes = 0;    ///< bytes allocated by memory controllers while running
+        int32_t alloc_count = 0;    ///< allocation count while running
+        int32_t pool_size = 0;      ///< thread pool size, 0 for no thread pool
+        int64_t pool_work = 0;      ///< microseconds thread pool workers spent while running
+    };
+
     class TS_DEBUG_API Profiler : public SetupContext<Profiler> {
     public:
+        Profiler();
+
+        /**
+         * clean serial and recorded events, timer board are kept
+         */
         void clean() {
             this->m_serial.clear();
+            this->m_events.clear();
+            this->m_running.clear();
         }
 
         Later timer(const std::string &name);
 
+        /**
+         * start recording event, allocations will be counted in it until it finished
+         * @param op operator type
+         * @param name node name
+         * @return running event, fill the rest fields before next begin_event
+         */
+        ProfileEvent &begin_event(const std::string &op, const std::string &name);
+
+        /**
+         * finish last begun running event, set its duration
+         * @return finished event
+         * @note must be paired with begin_event
+         */
+        ProfileEvent &end_event();
+
+        /**
+         * count allocation in running event
+         * @param size allocated bytes
+         */
+        void alloc(size_t size);
+
+        const std::vector<ProfileEvent> &events() const { return m_events; }
+
+        /**
+         * write recorded events in Chrome trace event format, can be loaded by chrome://tracing or perfetto
+         * @param out output stream
+         */
+        void trace(std::ostream &out) const;
+
+        /**
+         * write per operator type aggregate table, sorted by total time
+         * @param out output stream
+         */
+        void summary(std::ostream &out) const;
+
+        /**
+         * write folded stacks "op;name microseconds" for flame graph tools
+         * @param out output stream
+         */
+        void folded(std::ostream &out) const;
+
         /**
          * query or add serial in system
          * @param name
@@ -76,8 +146,15 @@ namespace ts {
 
         void log(std::ostream &out) const;
     private:
+        int64_t now() const;
+
         Board<float> m_board;
         std::unordered_map<std::string, int32_t> m_serial;
+
+        std::chrono::steady_clock::time_point m_epoch;
+        std::vector<ProfileEvent> m_events;
+        std::vector<size_t> m_running;  ///< indices of running events, nested by sub programs
+        std::vector<std::thread::id> m_threads;
     };
 
     TS_DEBUG_API bool profiler_on();
@@ -95,6 +172,12 @@ namespace ts {
      * @return just write name
      */
     TS_DEBUG_API Later profiler_timer(const std::string &name);
+
+    /**
+     * count allocation in running event of bound profiler
+     * @param size allocated bytes
+     */
+    TS_DEBUG_API void profiler_alloc(size_t size);
 }
 
 
@@ -6,6 +6,7 @@
 #define TENSORSTACK_COMPILER_COMPILER_H
 
 #include "runtime/instruction.h"
+#include "runtime/dataflow.h"
 #include "module/graph.h"
 
 namespace ts {
@@ -30,6 +31,7 @@ namespace ts {
         int nresults = 0;
         std::vector<Instruction::shared> instructions;
         std::vector<DeviceTensor> data_segment;
+        Dataflow::shared dataflow;  ///< dependency of operator instructions, nullptr if not supported
     };
 
     /**
@@ -44,6 +46,24 @@ namespace ts {
         InstructionBlock compile(const std::vector<Node> &raw_inputs, const std::vector<Node> &outputs);
         InstructionBlock compile(const std::vector<Node> &raw_inputs, const std::vector<Node> &outputs,
                 const std::string &options);
+
+        /**
+         * zip graph and compute const nodes
+         * @param outputs graph outputs
+         * @param options compile options
+         * @return optimized outputs, new nodes are made in graph bound in context
+         * @context Graph, Workbench for computing const nodes
+         */
+        std::vector<Node> optimize(const std::vector<Node> &outputs, const std::string &options);
+
+        /**
+         * convert optimized graph to instructions
+         * @param raw_inputs graph inputs
+         * @param outputs optimized outputs
+         * @return instructions
+         */
+        InstructionBlock generate(const std::vector<Node> &raw_inputs, const std::vector<Node> &outputs);
+
         std::vector<Instruction::shared> convert_operator_instruction(const Node &node);
 
         static void run_const_nodes(const std::vector<Node> &nodes, std::vector<Node> &const_nodes);
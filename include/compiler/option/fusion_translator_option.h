@@ -0,0 +1,26 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_COMPILER_OPTION_FUSION_TRANSLATOR_OPTION_H
+#define TENSORSTACK_COMPILER_OPTION_FUSION_TRANSLATOR_OPTION_H
+
+#include "translator_option.h"
+
+namespace ts {
+    /**
+     * fuse conv2d -> [add_bias | batch_norm | fused_batch_norm | batch_scale]* -> [relu | relu_max | leaky_relu | prelu]
+     * into one conv2d on cpu:
+     * per channel affine ops are folded into const weights and fused_bias,
+     * the activation is applied in gemm epilogue, see fused_activation.
+     * Run as module translator, so folded weights can still be packed after.
+     * Used by compile option --fusion, on by default, --no-fusion to disable.
+     */
+    class Conv2DFusionTranslatorOption : public TranslatorV2Option {
+    public:
+        Module::shared translate(const ComputingDevice &device,
+                                 Module::shared module) const final;
+    };
+}
+
+#endif //TENSORSTACK_COMPILER_OPTION_FUSION_TRANSLATOR_OPTION_H
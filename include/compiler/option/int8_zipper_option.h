@@ -0,0 +1,25 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_COMPILER_OPTION_INT8_ZIPPER_OPTION_H
+#define TENSORSTACK_COMPILER_OPTION_INT8_ZIPPER_OPTION_H
+
+#include "zipper_option.h"
+
+
+namespace ts {
+    /**
+     * keep activations in int8 between quantized layers:
+     * conv2d_quantized -> [relu | max pooling]* -> quantize
+     * zipped to conv2d_quantized with requantize_scale -> [relu | max pooling]*, running on int8.
+     * relu and max pooling commute with quantize, so result is same.
+     */
+    class Int8ZipperOption : public ZipperOption {
+    public:
+        bool zip(const ComputingDevice &device, Node node, Node &zipped_node) const final;
+    };
+}
+
+
+#endif //TENSORSTACK_COMPILER_OPTION_INT8_ZIPPER_OPTION_H
@@ -0,0 +1,39 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_COMPILER_OPTION_NCHWC_TRANSLATOR_OPTION_H
+#define TENSORSTACK_COMPILER_OPTION_NCHWC_TRANSLATOR_OPTION_H
+
+#include "translator_option.h"
+
+namespace ts {
+    /**
+     * propagate channel blocked layout NCHWc on cpu:
+     * conv2d and depthwise_conv2d with const weights start blocked subgraphs,
+     * pooling2d, element-wise ops, add_bias and concat on channels keep blocked inputs blocked,
+     * reorders are only inserted at the boundaries of blocked subgraphs.
+     * Weights are packed into blocked layout at compile time, so run it before PackTranslatorOption.
+     * Set by compile option --nchwc.
+     */
+    class NCHWcTranslatorOption : public TranslatorV2Option {
+    public:
+        /**
+         * @param block channels in one block, 8 for AVX and 4 for SSE or NEON
+         */
+        explicit NCHWcTranslatorOption(int block);
+
+        Module::shared translate(const ComputingDevice &device,
+                                 Module::shared module) const final;
+
+        /**
+         * @return block for cpu running this process
+         */
+        static int Block();
+
+    private:
+        int m_block;
+    };
+}
+
+#endif //TENSORSTACK_COMPILER_OPTION_NCHWC_TRANSLATOR_OPTION_H
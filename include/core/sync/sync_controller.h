@@ -13,6 +13,8 @@
 #include "sync_block.h"
 #include "sync_memory.h"
 
+#include "board/profiler.h"
+
 #include <utils/api.h>
 
 namespace ts {
@@ -96,6 +98,9 @@ namespace ts {
         }
 
         SyncMemory alloc(const MemoryDevice &device, size_t size) override {
+#ifdef TS_USE_PROFILER
+            profiler_alloc(size);
+#endif
             auto controller = m_sync_controllers.sync(device);
             auto memory = controller->alloc(size);
             return SyncMemory(memory, m_memory_need_lock, this->sync_handler());
@@ -105,6 +110,15 @@ namespace ts {
             return shared(new self(m_device, m_memory_need_lock));
         }
 
+        /**
+         * get base memory controller working on device
+         * @param device memory device
+         * @return base memory controller
+         */
+        std::shared_ptr<BaseMemoryController> controller(const MemoryDevice &device) {
+            return m_sync_controllers.sync(device);
+        }
+
         SyncMemory::Block::sync_handler sync_handler() {
             auto shared_this = this->shared_from_this();
             return [=](const typename SyncMemory::Block::value_t &from_memory,
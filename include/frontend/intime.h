@@ -16,12 +16,128 @@
 #include <module/graph.h>
 #include <runtime/stack.h>
 #include <runtime/workbench.h>
+#include <utils/implement.h>
 
 
 namespace ts {
     namespace intime {
+        /**
+         * created operators of intime calls, keyed on operator, params and computing device.
+         * Bind it by `ctx::bind<intime::OperatorCache>`, then intime calls with the same params
+         * reuse the created and initialized operator, instead of creating and initializing it each call.
+         * Least recently used operators are dropped out of capacity.
+         * @note operators are shared by workbenches on the same device in this thread,
+         *       use one cache in each thread.
+         */
+        class TS_DEBUG_API OperatorCache {
+        public:
+            using self = OperatorCache;
+
+            /**
+             * @param capacity max number of cached operators, at least 1
+             */
+            explicit OperatorCache(size_t capacity = 64);
+
+            ~OperatorCache();
+
+            OperatorCache(const self &) = delete;
+
+            self &operator=(const self &) = delete;
+
+            /**
+             * get cached operator, or create it in bench if missing
+             * @param bench workbench creating operator
+             * @param bubble operator and params
+             * @return initialized operator
+             */
+            Operator::shared get(Workbench &bench, const Bubble &bubble);
+
+            void clear();
+
+            size_t size() const;
+
+            size_t capacity() const;
+
+            void set_capacity(size_t capacity);
+
+            /**
+             * @return number of calls reusing cached operator
+             */
+            size_t hits() const;
+
+            /**
+             * @return number of calls creating operator
+             */
+            size_t misses() const;
+
+        private:
+            class Implement;
+            Declare<Implement> m_impl;
+        };
+
+        /**
+         * record intime calls into Graph, which can be compiled to reusable Program.
+         * Bind it by `ctx::bind<intime::Capture>`, intime calls run eagerly as usual, and are recorded at the same time.
+         * Tensors are tracked by memory and shape: outputs of recorded calls link to their consumers,
+         * tensors marked by input() become parameters of program, and other tensors are frozen as constants.
+         * So mark every tensor changing between runs as input.
+         */
+        class TS_DEBUG_API Capture {
+        public:
+            using self = Capture;
+
+            Capture();
+
+            ~Capture();
+
+            Capture(const self &) = delete;
+
+            self &operator=(const self &) = delete;
+
+            /**
+             * mark tensor as next input of captured program
+             * @param x input tensor of this capturing
+             * @return x
+             */
+            const Tensor &input(const Tensor &x);
+
+            /**
+             * record an intime call, called by intime::run
+             * @param bubble operator and params
+             * @param inputs inputs of call
+             * @param output output of call, packed if operator has multi outputs
+             */
+            void record(const Bubble &bubble, const std::vector<Tensor> &inputs, const Tensor &output);
+
+            /**
+             * @return number of recorded calls
+             */
+            size_t size() const;
+
+            /**
+             * @param outputs outputs of recorded calls or inputs
+             * @return module of recorded calls reaching outputs, inputs are in order of marking
+             */
+            Module::shared module(const std::vector<Tensor> &outputs) const;
+
+            /**
+             * compile recorded calls reaching outputs, run it by `Workbench::launch_offline`
+             * @param outputs outputs of recorded calls or inputs
+             * @param device computing device
+             * @param options compile options
+             * @return program
+             */
+            Program::shared compile(const std::vector<Tensor> &outputs, const ComputingDevice &device,
+                                    const std::string &options = "") const;
+
+        private:
+            class Implement;
+            Declare<Implement> m_impl;
+        };
+
         /**
          * @note: the returned tensor is using borrowed memory from bench, use clone or free, before bench finalization
+         * @note: use operator in bound OperatorCache if there is one, and record call in bound Capture if there is one
          */
         TS_DEBUG_API Tensor run(Workbench &bench, const Bubble &bubble, const std::vector<Tensor> &inputs);
 
@@ -152,9 +152,40 @@ namespace ts {
         return _simd_f32x4_interval_load(p, inc);
     }
 
-//    inline simd<float, 4> exp(const simd<float, 4> &src){
-//        return _simd_f32x4_exp(src.value);
-//    }
+    /**
+     * Transcendental functions, not named exp, log, ... so they never hide the scalar ones in namespace ts.
+     * Accuracy on SSE, AVX and NEON (cephes polynomials), base backend uses libm:
+     *   exp: relative error < 4e-7 for normal results, exp(+inf) = inf, exp(-inf) = 0, exp(NaN) = NaN
+     *   log: relative error < 4e-7 (absolute < 2e-7 near 1), log(0) = -inf, log(x < 0) = NaN
+     *   sigmoid: absolute error < 2e-7
+     *   tanh: relative error < 4e-7
+     *   sqrt: correctly rounded, except armv7 as x * rsqrt(x)
+     *   rsqrt: relative error < 4e-7, estimate with newton steps
+     * See test/simd_math.cpp
+     */
+    inline simd<float, 4> exp_float32x4(const simd<float, 4> &x) {
+        return _simd_f32x4_exp(x.value);
+    }
+
+    inline simd<float, 4> log_float32x4(const simd<float, 4> &x) {
+        return _simd_f32x4_log(x.value);
+    }
+
+    inline simd<float, 4> sigmoid_float32x4(const simd<float, 4> &x) {
+        return _simd_f32x4_sigmoid(x.value);
+    }
+
+    inline simd<float, 4> tanh_float32x4(const simd<float, 4> &x) {
+        return _simd_f32x4_tanh(x.value);
+    }
+
+    inline simd<float, 4> sqrt_float32x4(const simd<float, 4> &x) {
+        return _simd_f32x4_sqrt(x.value);
+    }
+
+    inline simd<float, 4> rsqrt_float32x4(const simd<float, 4> &x) {
+        return _simd_f32x4_rsqrt(x.value);
+    }
 
     //TODO: add inc_load support
     template<>
@@ -279,4 +279,30 @@ inline _simd_f32x4x3 _simd_concat(const _simd_f32x4& q0, const _simd_f32x4& q1,
     return res;
 }
 
+//math
+inline _simd_f32x4 _simd_f32x4_exp(const _simd_f32x4& x) {
+    return{ expf(x[0]), expf(x[1]), expf(x[2]), expf(x[3]) };
+}
+
+inline _simd_f32x4 _simd_f32x4_log(const _simd_f32x4& x) {
+    return{ logf(x[0]), logf(x[1]), logf(x[2]), logf(x[3]) };
+}
+
+inline _simd_f32x4 _simd_f32x4_sqrt(const _simd_f32x4& x) {
+    return{ sqrtf(x[0]), sqrtf(x[1]), sqrtf(x[2]), sqrtf(x[3]) };
+}
+
+inline _simd_f32x4 _simd_f32x4_rsqrt(const _simd_f32x4& x) {
+    return{ 1.0f / sqrtf(x[0]), 1.0f / sqrtf(x[1]), 1.0f / sqrtf(x[2]), 1.0f / sqrtf(x[3]) };
+}
+
+inline _simd_f32x4 _simd_f32x4_sigmoid(const _simd_f32x4& x) {
+    return{ 1.0f / (1.0f + expf(-x[0])), 1.0f / (1.0f + expf(-x[1])),
+            1.0f / (1.0f + expf(-x[2])), 1.0f / (1.0f + expf(-x[3])) };
+}
+
+inline _simd_f32x4 _simd_f32x4_tanh(const _simd_f32x4& x) {
+    return{ tanhf(x[0]), tanhf(x[1]), tanhf(x[2]), tanhf(x[3]) };
+}
+
 #endif //TENSORSTACK_KERNELS_COMMON_SIMD_DEF_SIMD_BASE_DEF_H
\ No newline at end of file
@@ -364,6 +364,8 @@ inline _simd_f32x4x3 _simd_concat(const _simd_f32x4& q0, const _simd_f32x4& q1,
     return {{q0, q1, q2}};
 }
 
+#include "simd_neon_math_def.h"
+
 #endif
 
 #endif //TENSORSTACK_KERNELS_COMMON_SIMD_DEF_SIMD_NEON_DEF_H
\ No newline at end of file
@@ -0,0 +1,149 @@
+#ifndef TENSORSTACK_KERNELS_COMMON_SIMD_DEF_SIMD_NEON_MATH_DEF_H
+#define TENSORSTACK_KERNELS_COMMON_SIMD_DEF_SIMD_NEON_MATH_DEF_H
+
+/**
+ * Transcendental functions on float32x4_t, works on both armv7 and aarch64.
+ * Polynomials are taken from cephes single precision library, same as simd_sse_math_def.h.
+ */
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+/**
+ * 1 / x with two newton steps, rather than the 8 bits estimate
+ */
+inline _simd_f32x4 _simd_f32x4_recip(_simd_f32x4 x) {
+    float32x4_t r = vrecpeq_f32(x);
+    r = vmulq_f32(vrecpsq_f32(x, r), r);
+    r = vmulq_f32(vrecpsq_f32(x, r), r);
+    return r;
+}
+
+inline _simd_f32x4 _simd_f32x4_exp(_simd_f32x4 x) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    // same clamp as simd_sse_math_def.h, out of range x overflows to inf or underflows to 0, NaN is kept
+    x = vminq_f32(x, vdupq_n_f32(89.0f));
+    x = vmaxq_f32(x, vdupq_n_f32(-104.0f));
+
+    // x = n * ln(2) + r, |r| <= ln(2) / 2
+    float32x4_t fx = vmlaq_f32(vdupq_n_f32(0.5f), x, vdupq_n_f32(1.44269504088896341f));
+    float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(fx));
+    uint32x4_t greater = vcgtq_f32(t, fx);
+    fx = vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(greater, vreinterpretq_u32_f32(one))));
+    x = vmlsq_f32(x, fx, vdupq_n_f32(0.693359375f));
+    x = vmlsq_f32(x, fx, vdupq_n_f32(-2.12194440e-4f));
+
+    float32x4_t z = vmulq_f32(x, x);
+    float32x4_t y = vdupq_n_f32(1.9875691500e-4f);
+    y = vmlaq_f32(vdupq_n_f32(1.3981999507e-3f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(8.3334519073e-3f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(4.1665795894e-2f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(1.6666665459e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(5.0000001201e-1f), y, x);
+    y = vmlaq_f32(vaddq_f32(x, one), y, z);
+
+    // 2^n in two factors, so n in [-150, 128] never leaves the exponent range
+    int32x4_t n = vcvtq_s32_f32(fx);
+    int32x4_t n1 = vshrq_n_s32(n, 1);
+    int32x4_t n2 = vsubq_s32(n, n1);
+    float32x4_t pow2n1 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(n1, vdupq_n_s32(0x7f)), 23));
+    float32x4_t pow2n2 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(n2, vdupq_n_s32(0x7f)), 23));
+    return vmulq_f32(vmulq_f32(y, pow2n1), pow2n2);
+}
+
+inline _simd_f32x4 _simd_f32x4_log(_simd_f32x4 x) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t inf = vreinterpretq_f32_u32(vdupq_n_u32(0x7f800000));
+    uint32x4_t invalid = vmvnq_u32(vcgeq_f32(x, zero));
+    uint32x4_t is_zero = vceqq_f32(x, zero);
+    uint32x4_t is_inf = vceqq_f32(x, inf);
+
+    // scale denormals into normal range
+    uint32x4_t tiny = vcltq_f32(x, vreinterpretq_f32_u32(vdupq_n_u32(0x00800000)));
+    x = vbslq_f32(tiny, vmulq_f32(x, vdupq_n_f32(8388608.0f)), x);
+
+    // x = m * 2^e, m in [0.5, 1)
+    uint32x4_t ix = vreinterpretq_u32_f32(x);
+    float32x4_t e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(ix, 23)), vdupq_n_s32(126)));
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(tiny, vreinterpretq_u32_f32(vdupq_n_f32(23.0f)))));
+    x = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(ix, vdupq_n_u32(0x007fffff)),
+                                        vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+
+    // move m to [sqrt(0.5), sqrt(2)), then x = m - 1
+    uint32x4_t mask = vcltq_f32(x, vdupq_n_f32(0.707106781186547524f));
+    float32x4_t tmp = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(x), mask));
+    x = vsubq_f32(x, one);
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(one), mask)));
+    x = vaddq_f32(x, tmp);
+
+    float32x4_t z = vmulq_f32(x, x);
+    float32x4_t y = vdupq_n_f32(7.0376836292e-2f);
+    y = vmlaq_f32(vdupq_n_f32(-1.1514610310e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(1.1676998740e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(-1.2420140846e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(1.4249322787e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(-1.6668057665e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(2.0000714765e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(-2.4999993993e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(3.3333331174e-1f), y, x);
+    y = vmulq_f32(vmulq_f32(y, x), z);
+    y = vmlaq_f32(y, e, vdupq_n_f32(-2.12194440e-4f));
+    y = vmlsq_f32(y, z, vdupq_n_f32(0.5f));
+    x = vaddq_f32(x, y);
+    x = vmlaq_f32(x, e, vdupq_n_f32(0.693359375f));
+
+    x = vbslq_f32(is_inf, inf, x);
+    x = vbslq_f32(is_zero, vnegq_f32(inf), x);
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(x), invalid));
+}
+
+inline _simd_f32x4 _simd_f32x4_rsqrt(_simd_f32x4 x) {
+    // vrsqrts gives 1.5 on 0 * inf, so 0 and inf need no special case
+    float32x4_t y = vrsqrteq_f32(x);
+    y = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, y), y), y);
+    y = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, y), y), y);
+    return y;
+}
+
+inline _simd_f32x4 _simd_f32x4_sqrt(_simd_f32x4 x) {
+#if defined(__aarch64__)
+    return vsqrtq_f32(x);
+#else
+    const float32x4_t inf = vreinterpretq_f32_u32(vdupq_n_u32(0x7f800000));
+    uint32x4_t special = vorrq_u32(vceqq_f32(x, vdupq_n_f32(0.0f)), vceqq_f32(x, inf));
+    return vbslq_f32(special, x, vmulq_f32(x, _simd_f32x4_rsqrt(x)));
+#endif
+}
+
+inline _simd_f32x4 _simd_f32x4_sigmoid(_simd_f32x4 x) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    return _simd_f32x4_recip(vaddq_f32(one, _simd_f32x4_exp(vnegq_f32(x))));
+}
+
+inline _simd_f32x4 _simd_f32x4_tanh(_simd_f32x4 x) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000));
+    float32x4_t ax = vabsq_f32(x);
+
+    // |x| < 0.625: x + x^3 * P(x^2)
+    float32x4_t z = vmulq_f32(x, x);
+    float32x4_t p = vdupq_n_f32(-5.70498872745e-3f);
+    p = vmlaq_f32(vdupq_n_f32(2.06390887954e-2f), p, z);
+    p = vmlaq_f32(vdupq_n_f32(-5.37397155531e-2f), p, z);
+    p = vmlaq_f32(vdupq_n_f32(1.33314422036e-1f), p, z);
+    p = vmlaq_f32(vdupq_n_f32(-3.33332819422e-1f), p, z);
+    float32x4_t small = vmlaq_f32(x, vmulq_f32(p, z), x);
+
+    // otherwise: 1 - 2 / (exp(2|x|) + 1), with sign of x
+    float32x4_t e = _simd_f32x4_exp(vaddq_f32(ax, ax));
+    float32x4_t large = vmlsq_f32(one, vdupq_n_f32(2.0f), _simd_f32x4_recip(vaddq_f32(e, one)));
+    large = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(large), sign));
+
+    return vbslq_f32(vcltq_f32(ax, vdupq_n_f32(0.625f)), small, large);
+}
+
+#endif
+
+#endif //TENSORSTACK_KERNELS_COMMON_SIMD_DEF_SIMD_NEON_MATH_DEF_H
@@ -324,6 +324,8 @@ inline _simd_f32x4x3 _simd_concat(const _simd_f32x4& q0, const _simd_f32x4& q1,
     return res;
 }
 
+#include "simd_sse_math_def.h"
+
 #endif //TS_USE_SSE
 
 #endif //TENSORSTACK_KERNELS_COMMON_SIMD_DEF_SIMD_SSE_DEF_H
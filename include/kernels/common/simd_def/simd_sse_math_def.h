@@ -0,0 +1,143 @@
+#ifndef TENSORSTACK_KERNELS_COMMON_SIMD_DEF_SIMD_SSE_MATH_DEF_H
+#define TENSORSTACK_KERNELS_COMMON_SIMD_DEF_SIMD_SSE_MATH_DEF_H
+
+/**
+ * Transcendental functions on __m128, shared by SSE and AVX defines.
+ * Only SSE2 instructions are used.
+ * Polynomials are taken from cephes single precision library.
+ */
+
+#if defined(TS_USE_SSE) || defined(TS_USE_AVX)
+
+#include <immintrin.h>
+
+inline __m128 _simd_f32x4_select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline _simd_f32x4 _simd_f32x4_exp(_simd_f32x4 x) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    // keep NaN, min and max return the second operand if any is NaN.
+    // clamped so 2^n below stays in [-150, 128], then larger x overflows to inf,
+    // and smaller x underflows to denormal or 0, like exp(+inf) = inf and exp(-inf) = 0
+    x = _mm_min_ps(_mm_set1_ps(89.0f), x);
+    x = _mm_max_ps(_mm_set1_ps(-104.0f), x);
+
+    // x = n * ln(2) + r, |r| <= ln(2) / 2
+    __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f));
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+    fx = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, fx), one));
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+
+    __m128 z = _mm_mul_ps(x, x);
+    __m128 y = _mm_set1_ps(1.9875691500e-4f);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, z), _mm_add_ps(x, one));
+
+    // 2^n in two factors, so n in [-150, 128] never leaves the exponent range
+    __m128i n = _mm_cvttps_epi32(fx);
+    __m128i n1 = _mm_srai_epi32(n, 1);
+    __m128i n2 = _mm_sub_epi32(n, n1);
+    __m128 pow2n1 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n1, _mm_set1_epi32(0x7f)), 23));
+    __m128 pow2n2 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n2, _mm_set1_epi32(0x7f)), 23));
+    return _mm_mul_ps(_mm_mul_ps(y, pow2n1), pow2n2);
+}
+
+inline _simd_f32x4 _simd_f32x4_log(_simd_f32x4 x) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 inf = _mm_castsi128_ps(_mm_set1_epi32(0x7f800000));
+    __m128 invalid = _mm_cmpnge_ps(x, zero);
+    __m128 is_zero = _mm_cmpeq_ps(x, zero);
+    __m128 is_inf = _mm_cmpeq_ps(x, inf);
+
+    // scale denormals into normal range
+    __m128 tiny = _mm_cmplt_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x00800000)));
+    x = _simd_f32x4_select(tiny, _mm_mul_ps(x, _mm_set1_ps(8388608.0f)), x);
+
+    // x = m * 2^e, m in [0.5, 1)
+    __m128i ix = _mm_castps_si128(x);
+    __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(ix, 23), _mm_set1_epi32(126)));
+    e = _mm_sub_ps(e, _mm_and_ps(tiny, _mm_set1_ps(23.0f)));
+    x = _mm_or_ps(_mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x007fffff))), _mm_set1_ps(0.5f));
+
+    // move m to [sqrt(0.5), sqrt(2)), then x = m - 1
+    __m128 mask = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+    __m128 tmp = _mm_and_ps(x, mask);
+    x = _mm_sub_ps(x, one);
+    e = _mm_sub_ps(e, _mm_and_ps(one, mask));
+    x = _mm_add_ps(x, tmp);
+
+    __m128 z = _mm_mul_ps(x, x);
+    __m128 y = _mm_set1_ps(7.0376836292e-2f);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+    y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+    y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+    y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    x = _mm_add_ps(x, y);
+    x = _mm_add_ps(x, _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+
+    x = _simd_f32x4_select(is_inf, inf, x);
+    x = _simd_f32x4_select(is_zero, _mm_sub_ps(zero, inf), x);
+    return _mm_or_ps(x, invalid);
+}
+
+inline _simd_f32x4 _simd_f32x4_sqrt(_simd_f32x4 x) {
+    return _mm_sqrt_ps(x);
+}
+
+inline _simd_f32x4 _simd_f32x4_rsqrt(_simd_f32x4 x) {
+    const __m128 inf = _mm_castsi128_ps(_mm_set1_epi32(0x7f800000));
+    __m128 y = _mm_rsqrt_ps(x);
+    // one newton step: y = y * (1.5 - 0.5 * x * y * y)
+    __m128 hx = _mm_mul_ps(x, _mm_set1_ps(0.5f));
+    __m128 ny = _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(hx, _mm_mul_ps(y, y))));
+    // the estimate is already right for 0, inf, negative and NaN
+    __m128 special = _mm_or_ps(_mm_cmpnge_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x00800000))),
+                               _mm_cmpeq_ps(x, inf));
+    return _simd_f32x4_select(special, y, ny);
+}
+
+inline _simd_f32x4 _simd_f32x4_sigmoid(_simd_f32x4 x) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    return _mm_div_ps(one, _mm_add_ps(one, _simd_f32x4_exp(_mm_sub_ps(_mm_setzero_ps(), x))));
+}
+
+inline _simd_f32x4 _simd_f32x4_tanh(_simd_f32x4 x) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(int(0x80000000)));
+    __m128 sign = _mm_and_ps(x, sign_mask);
+    __m128 ax = _mm_andnot_ps(sign_mask, x);
+
+    // |x| < 0.625: x + x^3 * P(x^2)
+    __m128 z = _mm_mul_ps(x, x);
+    __m128 p = _mm_set1_ps(-5.70498872745e-3f);
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(2.06390887954e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-5.37397155531e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.33314422036e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(-3.33332819422e-1f));
+    __m128 small = _mm_add_ps(x, _mm_mul_ps(_mm_mul_ps(p, z), x));
+
+    // otherwise: 1 - 2 / (exp(2|x|) + 1), with sign of x
+    __m128 e = _simd_f32x4_exp(_mm_add_ps(ax, ax));
+    __m128 large = _mm_sub_ps(one, _mm_div_ps(_mm_set1_ps(2.0f), _mm_add_ps(e, one)));
+    large = _mm_or_ps(large, sign);
+
+    return _simd_f32x4_select(_mm_cmplt_ps(ax, _mm_set1_ps(0.625f)), small, large);
+}
+
+#endif
+
+#endif //TENSORSTACK_KERNELS_COMMON_SIMD_DEF_SIMD_SSE_MATH_DEF_H
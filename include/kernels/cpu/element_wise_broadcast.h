@@ -0,0 +1,175 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_KERNELS_CPU_ELEMENT_WISE_BROADCAST_H
+#define TENSORSTACK_KERNELS_CPU_ELEMENT_WISE_BROADCAST_H
+
+#include <vector>
+#include <algorithm>
+
+#include "core/tensor.h"
+#include "kernels/common/simd.h"
+#include "runtime/inside/parallel.h"
+
+namespace ts {
+    namespace cpu {
+        /**
+         * strided view of broadcasting binary element-wise operator.
+         * Axes of size 1 in output are dropped, adjacent axes which are contiguous in both inputs are collapsed,
+         * strides of broadcast axes are 0. So the innermost stride of each input is 0 or 1.
+         */
+        class TS_DEBUG_API BroadcastPlan {
+        public:
+            /**
+             * @param lhs lhs shape
+             * @param rhs rhs shape
+             * @param out out shape, each axis of lhs and rhs must be 1 or same as out,
+             *            lhs and rhs will be front appended ones if they have less dims.
+             */
+            BroadcastPlan(const Shape &lhs, const Shape &rhs, const Shape &out);
+
+            /**
+             * @return collapsed out shape, has at least one axis
+             */
+            const std::vector<int> &shape() const { return m_shape; }
+
+            const std::vector<int> &lhs_strides() const { return m_lhs_strides; }
+
+            const std::vector<int> &rhs_strides() const { return m_rhs_strides; }
+
+            int dims() const { return int(m_shape.size()); }
+
+            int count() const { return m_count; }
+
+            /**
+             * count of innermost axis
+             */
+            int inner() const { return m_shape.back(); }
+
+            /**
+             * get input offsets of given outer index, which is index of out shape without the innermost axis
+             */
+            void offset(int outer, int &lhs_offset, int &rhs_offset) const;
+
+        private:
+            std::vector<int> m_shape;
+            std::vector<int> m_lhs_strides;
+            std::vector<int> m_rhs_strides;
+            int m_count = 0;
+        };
+
+        template <typename T, typename OP, bool VECTORIZED = false>
+        struct BroadcastLoop {
+            /**
+             * out[i] = op(lhs[i * lhs_step], rhs[i * rhs_step]), steps are 0 or 1
+             */
+            static void run(const T *lhs, int lhs_step, const T *rhs, int rhs_step, T *out, int count, const OP &op) {
+                if (lhs_step && rhs_step) {
+                    for (int i = 0; i < count; ++i) out[i] = op(lhs[i], rhs[i]);
+                } else if (lhs_step) {
+                    auto scalar = *rhs;
+                    for (int i = 0; i < count; ++i) out[i] = op(lhs[i], scalar);
+                } else if (rhs_step) {
+                    auto scalar = *lhs;
+                    for (int i = 0; i < count; ++i) out[i] = op(scalar, rhs[i]);
+                } else {
+                    auto value = op(*lhs, *rhs);
+                    for (int i = 0; i < count; ++i) out[i] = value;
+                }
+            }
+        };
+
+        template <typename OP>
+        struct BroadcastLoop<float, OP, true> {
+            static void run(const float *lhs, int lhs_step, const float *rhs, int rhs_step, float *out, int count,
+                            const OP &op) {
+                int i = 0;
+                if (lhs_step && rhs_step) {
+                    for (; i + 3 < count; i += 4) op(float32x4(&lhs[i]), float32x4(&rhs[i])).store(&out[i]);
+                    for (; i < count; ++i) out[i] = op(lhs[i], rhs[i]);
+                } else if (lhs_step) {
+                    auto scalar = *rhs;
+                    float32x4 scalarx4(scalar);
+                    for (; i + 3 < count; i += 4) op(float32x4(&lhs[i]), scalarx4).store(&out[i]);
+                    for (; i < count; ++i) out[i] = op(lhs[i], scalar);
+                } else if (rhs_step) {
+                    auto scalar = *lhs;
+                    float32x4 scalarx4(scalar);
+                    for (; i + 3 < count; i += 4) op(scalarx4, float32x4(&rhs[i])).store(&out[i]);
+                    for (; i < count; ++i) out[i] = op(scalar, rhs[i]);
+                } else {
+                    auto value = op(*lhs, *rhs);
+                    for (; i < count; ++i) out[i] = value;
+                }
+            }
+        };
+
+        /**
+         * out = op(lhs, rhs) with broadcasting, split in blocks of innermost axis and run in parallel.
+         * @tparam T data type
+         * @tparam OP functor, T op(T, T); if OP::vectorized is true, float32x4 op(float32x4, float32x4) is used for float
+         * @param lhs lhs data
+         * @param rhs rhs data
+         * @param out out data, may be same as lhs or rhs when they have same shape as out
+         * @param plan broadcast plan
+         * @param op functor
+         */
+        template <typename T, typename OP>
+        inline void broadcast(const T *lhs, const T *rhs, T *out, const BroadcastPlan &plan, const OP &op) {
+            using Loop = BroadcastLoop<T, OP, std::is_same<T, float>::value && OP::vectorized>;
+
+            // empty output, any axis may be zero, including the innermost one
+            if (plan.count() == 0) return;
+
+            auto inner = plan.inner();
+            auto outer = plan.count() / inner;
+            auto lhs_step = plan.lhs_strides().back();
+            auto rhs_step = plan.rhs_strides().back();
+
+            // split long rows, so same shape or few rows can be parallel too
+            static const int min_block = 4096;
+            auto threads = int(parallel_size());
+            if (plan.count() < min_block * 2) threads = 1;
+            auto block = inner;
+            if (threads > 1 && outer < threads) {
+                auto row_blocks = (threads + outer - 1) / outer;
+                block = std::max(min_block, (inner + row_blocks - 1) / row_blocks);
+                block = std::min(block, inner);
+            }
+            auto blocks = (inner + block - 1) / block;
+            auto tasks = outer * blocks;
+
+            auto run = [&](int task) {
+                auto row = task / blocks;
+                auto first = (task % blocks) * block;
+                auto count = std::min(block, inner - first);
+                int lhs_offset, rhs_offset;
+                plan.offset(row, lhs_offset, rhs_offset);
+                Loop::run(lhs + lhs_offset + first * lhs_step, lhs_step,
+                          rhs + rhs_offset + first * rhs_step, rhs_step,
+                          out + size_t(row) * inner + first, count, op);
+            };
+
+            if (threads <= 1) {
+                for (int task = 0; task < tasks; ++task) run(task);
+                return;
+            }
+            TS_PARALLEL_FOR_BEGIN(task, 0, tasks)
+                run(task);
+            TS_PARALLEL_FOR_END()
+        }
+
+        /**
+         * out = op(lhs, rhs) with broadcasting
+         * @see broadcast
+         */
+        template <typename T, typename OP>
+        inline void broadcast(const Tensor &lhs, const Tensor &rhs, Tensor &out, const OP &op) {
+            BroadcastPlan plan(lhs.sizes(), rhs.sizes(), out.sizes());
+            broadcast<T, OP>(lhs.data<T>(), rhs.data<T>(), out.data<T>(), plan, op);
+        }
+    }
+}
+
+#endif //TENSORSTACK_KERNELS_CPU_ELEMENT_WISE_BROADCAST_H
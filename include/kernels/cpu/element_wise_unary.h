@@ -0,0 +1,47 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_KERNELS_CPU_ELEMENT_WISE_UNARY_H
+#define TENSORSTACK_KERNELS_CPU_ELEMENT_WISE_UNARY_H
+
+#include "kernels/common/simd.h"
+#include "runtime/inside/parallel.h"
+
+namespace ts {
+    namespace cpu {
+        /**
+         * out[i] = op(in[i]) by float32x4, the left elements are padded into one float32x4,
+         * so every element goes through the same vectorized function.
+         * @tparam OP float32x4 (const float32x4 &)
+         * @param in input data
+         * @param out output data, can be the same as in
+         * @param count number of elements
+         * @param op vectorized operator
+         */
+        template<typename OP>
+        inline void unary_float32x4(const float *in, float *out, int count, OP op) {
+            int body = count / 4 * 4;
+            if (body >= 4096) {
+                TS_PARALLEL_RANGE_BEGIN(range, 0, body / 4)
+                    for (int i = range.first * 4; i < range.second * 4; i += 4) {
+                        op(float32x4(&in[i])).store(&out[i]);
+                    }
+                TS_PARALLEL_RANGE_END()
+            } else {
+                for (int i = 0; i < body; i += 4) {
+                    op(float32x4(&in[i])).store(&out[i]);
+                }
+            }
+            int left = count - body;
+            if (left) {
+                float buffer[4] = {0, 0, 0, 0};
+                for (int i = 0; i < left; ++i) buffer[i] = in[body + i];
+                op(float32x4(buffer)).store(buffer);
+                for (int i = 0; i < left; ++i) out[body + i] = buffer[i];
+            }
+        }
+    }
+}
+
+#endif //TENSORSTACK_KERNELS_CPU_ELEMENT_WISE_UNARY_H
@@ -0,0 +1,53 @@
+#ifndef TENSORSTACK_KERNELS_CPU_GEMM_EPILOGUE_H
+#define TENSORSTACK_KERNELS_CPU_GEMM_EPILOGUE_H
+
+#include "backend/common_structure.h"
+
+#include <algorithm>
+
+namespace ts {
+    namespace cpu {
+        /**
+         * applied on output tile while it is still in cache: C[m, n] = activation(C[m, n] + bias[m])
+         */
+        template<typename T>
+        class GemmEpilogue {
+        public:
+            const T *bias = nullptr;    ///< per row bias, nullptr for no bias
+            FusedActivation activation = FusedActivation::NONE;
+            T max = 0;                  ///< for RELU_MAX
+            const T *slope = nullptr;   ///< for LEAKY_RELU
+            int slope_step = 0;         ///< 0 for one slope shared by all rows, 1 for per row slope
+
+            /**
+             * @param row row index of C
+             * @param data start of values in row
+             * @param count number of values
+             */
+            void operator()(int row, T *data, int count) const {
+                T b = bias ? bias[row] : T(0);
+                switch (activation) {
+                    default:
+                        for (int i = 0; i < count; ++i) data[i] += b;
+                        break;
+                    case FusedActivation::RELU:
+                        for (int i = 0; i < count; ++i) data[i] = std::max(data[i] + b, T(0));
+                        break;
+                    case FusedActivation::RELU_MAX:
+                        for (int i = 0; i < count; ++i) data[i] = std::min(std::max(data[i] + b, T(0)), max);
+                        break;
+                    case FusedActivation::LEAKY_RELU: {
+                        T s = slope[row * slope_step];
+                        for (int i = 0; i < count; ++i) {
+                            T v = data[i] + b;
+                            data[i] = v > 0 ? v : v * s;
+                        }
+                        break;
+                    }
+                }
+            }
+        };
+    }
+}
+
+#endif //TENSORSTACK_KERNELS_CPU_GEMM_EPILOGUE_H
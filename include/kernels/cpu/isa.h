@@ -0,0 +1,82 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_KERNELS_CPU_ISA_H
+#define TENSORSTACK_KERNELS_CPU_ISA_H
+
+#include "utils/api.h"
+
+namespace ts {
+    namespace cpu {
+        /**
+         * Instruction set tiers of runtime dispatched kernels.
+         * GENERIC kernels are built with the library flags, see TS_ON_HASWELL.
+         */
+        enum class ISA : int {
+            GENERIC = 0,
+            AVX2 = 1,       ///< AVX2 and FMA
+            AVX512 = 2,     ///< AVX512 F, DQ, BW and VL, with FMA
+        };
+
+        TS_DEBUG_API const char *isa_str(ISA isa);
+
+        /**
+         * Micro kernels of one tier, nullptr for kernel not specialized, then use the generic one.
+         * @note Keep this header free of inline code, it is included by sources built with extra instruction sets.
+         */
+        struct ISAKernels {
+            /**
+             * C[8, 8 * panels] = A * B
+             * A: 8 rows packed by math::pack8_A, [K, 8]
+             * B: panels packed by math::pack8_B, each panel is [K, 8] and follows the last one
+             */
+            void (*gemm_tile8)(int K, const float *A, const float *B, int panels, float *C, int ldc);
+            /**
+             * number of panels computed in registers at once, callers should pass a multiple of it if possible
+             */
+            int gemm_tile8_panels;
+            /**
+             * Winograd F(6x6, 3x3) input transform V = BT * d * B of tiles in one tile row,
+             * tile t is the 8x8 block at input + 6 * t,
+             * V[i][j] of tile t is written to output[(i * 8 + j) * stride + t].
+             */
+            void (*winograd_f63_input)(const float *input, int input_width, int tiles, float *output, int stride);
+            /**
+             * NCHW8c conv2d of pixels in one output row for blocks output blocks,
+             * out[j * out_stride + p * 8 + o] = sum_t sum_b inputs[t][offset + p * step + b] * weights[t][j * weight_stride + b * 8 + o],
+             * inputs[t] is the input pixel of tap t, weights[t] is the [8, 8] weight of tap t.
+             */
+            void (*conv2d_nchw8c_tile)(int taps, const float *const *inputs, int offset,
+                                       const float *const *weights, int weight_stride, int step, int pixels,
+                                       int blocks, float *out, int out_stride);
+            /**
+             * number of output blocks computed in registers at once, callers should pass blocks not greater than it
+             */
+            int conv2d_nchw8c_blocks;
+        };
+
+        /**
+         * @return best tier supported by both cpu and this library, detected once.
+         * Set environment TS_CPU_ISA to generic, avx2 or avx512 to limit it.
+         */
+        TS_DEBUG_API ISA cpu_isa();
+
+        /**
+         * @return kernels of cpu_isa()
+         */
+        TS_DEBUG_API const ISAKernels &isa_kernels();
+
+        /**
+         * @return kernels of given tier, all nullptr if not built in
+         */
+        TS_DEBUG_API const ISAKernels &isa_kernels(ISA isa);
+
+        namespace x86 {
+            const ISAKernels *kernels_avx2();
+            const ISAKernels *kernels_avx512();
+        }
+    }
+}
+
+#endif //TENSORSTACK_KERNELS_CPU_ISA_H
@@ -7,6 +7,7 @@
 
 #include "core/tensor.h"
 #include "../common/blas.h"
+#include "gemm_epilogue.h"
 
 namespace ts {
     namespace cpu {
@@ -58,18 +59,21 @@ namespace ts {
                     T_IN alpha, const T_IN *A,
                     const T_IN *B,
                     T_IN beta, T_OUT *C,
-                    bool A_need_pack, bool B_need_pack);
+                    bool A_need_pack, bool B_need_pack,
+                    const GemmEpilogue<T_OUT> *epilogue = nullptr);
 
             //NOTE:for pack gemm.
             //only support row major now and no trans
             //alpha==1,beta==0 should be promised now
             //input and output should be float now
+            //epilogue, if given, is applied on each output tile
             static void gemm(
                     int M, int N, int K,
                     T_IN alpha, const T_IN *A, T_IN *A_packed,
                     const T_IN *B, T_IN *B_packed,
                     T_IN beta, T_OUT *C,
-                    bool A_need_pack, bool B_need_pack);
+                    bool A_need_pack, bool B_need_pack,
+                    const GemmEpilogue<T_OUT> *epilogue = nullptr);
 
             static T_OUT asum(
                     int N,
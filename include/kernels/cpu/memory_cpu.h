@@ -8,10 +8,89 @@
 #include "global/hard_allocator.h"
 #include "global/hard_converter.h"
 
+#include <string>
+#include <cstdint>
+
 namespace ts {
+    /**
+     * system allocator, malloc and realloc
+     */
     void *cpu_allocator(int id, size_t new_size, void *mem, size_t mem_size);
 
+    /**
+     * aligned allocator, every block starts at CpuAllocator::Alignment() bytes,
+     * blocks not smaller than huge page threshold are mapped with transparent huge pages advised,
+     * and placed on set numa node. Registered as CPU allocator by default.
+     */
+    void *cpu_aligned_allocator(int id, size_t new_size, void *mem, size_t mem_size);
+
     void cpu_converter(int dst_id, void *dst, int src_id, const void *src, size_t size);
+
+    /**
+     * Settings and stats of CPU allocator.
+     * Environment TS_CPU_ALLOCATOR selects "aligned" or "system" allocator at start,
+     * TS_CPU_HUGE_PAGE sets huge page threshold in bytes, 0 for disabled,
+     * TS_CPU_NUMA sets numa node, "local" for the node of allocating thread.
+     */
+    class TS_DEBUG_API CpuAllocator {
+    public:
+        enum Numa : int {
+            NUMA_NONE = -1,     ///< no binding, first touch places memory
+            NUMA_LOCAL = -2,    ///< node of the thread allocating memory
+        };
+
+        class Stats {
+        public:
+            uint64_t blocks = 0;    ///< blocks in using
+            uint64_t memory = 0;    ///< bytes in using
+            uint64_t peak = 0;      ///< max bytes in using
+            uint64_t huge = 0;      ///< bytes in using, advised to use huge pages
+            uint64_t numa = 0;      ///< bytes in using, bound to numa node
+        };
+
+        /**
+         * @return alignment of aligned allocator in bytes
+         */
+        static size_t Alignment();
+
+        /**
+         * select registered CPU allocator
+         * @param name "aligned" or "system"
+         * @note memory controllers query allocator when created, so select it before creating workbenches,
+         *       blocks allocated before selecting are still freed by their own allocator.
+         */
+        static void Select(const std::string &name);
+
+        /**
+         * @return name of selected allocator
+         */
+        static std::string Selected();
+
+        /**
+         * @param threshold blocks not smaller than threshold use huge pages, 0 for disabled
+         */
+        static void SetHugePageThreshold(size_t threshold);
+
+        static size_t GetHugePageThreshold();
+
+        /**
+         * @param node numa node of huge page blocks, or NUMA_NONE, NUMA_LOCAL
+         * @note only blocks using huge pages are bound, smaller blocks share pages with others
+         */
+        static void SetNumaNode(int node);
+
+        static int GetNumaNode();
+
+        /**
+         * @return stats of aligned allocator, of all devices in this process
+         */
+        static Stats GetStats();
+
+        /**
+         * @return stats in json
+         */
+        static std::string Summary();
+    };
 }
 
 
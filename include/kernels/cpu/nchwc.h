@@ -0,0 +1,64 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_KERNELS_CPU_NCHWC_H
+#define TENSORSTACK_KERNELS_CPU_NCHWC_H
+
+#include "operator_on_cpu.h"
+#include "backend/base/base_nchwc.h"
+
+namespace ts {
+    namespace cpu {
+        /**
+         * cpu kernels of channel blocked layout, only FLOAT32 with block 4 or 8 are supported
+         */
+        class ToNCHWc : public OperatorOnCPU<base::ToNCHWc> {
+        public:
+            using self = ToNCHWc;
+            using supper = OperatorOnCPU<base::ToNCHWc>;
+
+            void to_nchwc(const Tensor &x, int block, Tensor &out) override;
+        };
+
+        class FromNCHWc : public OperatorOnCPU<base::FromNCHWc> {
+        public:
+            using self = FromNCHWc;
+            using supper = OperatorOnCPU<base::FromNCHWc>;
+
+            void from_nchwc(const Tensor &x, int channels, Tensor &out) override;
+        };
+
+        class Conv2DNCHWc : public OperatorOnCPU<base::Conv2DNCHWc> {
+        public:
+            using self = Conv2DNCHWc;
+            using supper = OperatorOnCPU<base::Conv2DNCHWc>;
+
+            void conv2d(const Tensor &x, const Padding2D &padding, const Tensor &w,
+                        const Stride2D &stride, const Dilation2D &dilation,
+                        const base::Conv2DEpilogue &epilogue, Tensor &out) override;
+        };
+
+        class DepthwiseConv2DNCHWc : public OperatorOnCPU<base::DepthwiseConv2DNCHWc> {
+        public:
+            using self = DepthwiseConv2DNCHWc;
+            using supper = OperatorOnCPU<base::DepthwiseConv2DNCHWc>;
+
+            void conv2d(const Tensor &x, const Padding2D &padding, const Tensor &w,
+                        const Stride2D &stride, const Dilation2D &dilation,
+                        const base::Conv2DEpilogue &epilogue, Tensor &out) override;
+        };
+
+        class Pooling2DNCHWc : public OperatorOnCPU<base::Pooling2DNCHWc> {
+        public:
+            using self = Pooling2DNCHWc;
+            using supper = OperatorOnCPU<base::Pooling2DNCHWc>;
+
+            void pooling2d(const Tensor &x, Pooling2DType type, const Padding2D &padding,
+                           Padding2DType padding_type, const KSize2D &ksize, const Stride2D &stride,
+                           Tensor &out) override;
+        };
+    }
+}
+
+#endif //TENSORSTACK_KERNELS_CPU_NCHWC_H
@@ -0,0 +1,77 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_KERNELS_CPU_NMS_H
+#define TENSORSTACK_KERNELS_CPU_NMS_H
+
+#include "utils/api.h"
+
+#include <vector>
+#include <algorithm>
+
+namespace ts {
+    namespace cpu {
+        /**
+         * Boxes kept by greedy non-maximum suppression, stored in structure of arrays,
+         * so the IoU of a candidate with all kept boxes is computed in float32x4 lanes.
+         * Box is given by corners (x1, y1) and (x2, y2) with x1 <= x2 and y1 <= y2,
+         * the area is given by caller, so each operator keeps its own definition of box size.
+         * IoU = inter / (area + kept_area - inter), box with zero union is never overlapped.
+         */
+        class TS_DEBUG_API NMSKept {
+        public:
+            void clear();
+
+            void reserve(size_t n);
+
+            size_t size() const { return m_x1.size(); }
+
+            /**
+             * @return true if IoU of given box with any kept box is greater than threshold
+             */
+            bool overlapped(float x1, float y1, float x2, float y2, float area, float threshold) const;
+
+            void keep(float x1, float y1, float x2, float y2, float area);
+
+        private:
+            std::vector<float> m_x1;
+            std::vector<float> m_y1;
+            std::vector<float> m_x2;
+            std::vector<float> m_y2;
+            std::vector<float> m_area;
+        };
+
+        /**
+         * Sort [first, last) with comp, but only make sure [first, middle) is sorted.
+         * Cheaper than std::partial_sort when middle - first is not small.
+         */
+        template<typename I, typename C>
+        inline void select_sort(I first, I middle, I last, C comp) {
+            if (middle != last) std::nth_element(first, middle, last, comp);
+            std::sort(first, middle, comp);
+        }
+
+        /**
+         * Pre-filter scores above threshold, return their indices in descending order of score,
+         * ties in ascending order of index, as stable sort does.
+         * @param top_k keep at most top_k indices if top_k >= 0, the rest are dropped without sorting
+         */
+        template<typename T>
+        inline void sorted_scores_index(const T *scores, int num, T threshold, int top_k,
+                                        std::vector<int> &index) {
+            index.clear();
+            for (int i = 0; i < num; ++i) {
+                if (scores[i] > threshold) index.push_back(i);
+            }
+            auto count = index.size();
+            if (top_k >= 0 && size_t(top_k) < count) count = size_t(top_k);
+            select_sort(index.begin(), index.begin() + count, index.end(), [scores](int a, int b) {
+                return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+            });
+            index.resize(count);
+        }
+    }
+}
+
+#endif //TENSORSTACK_KERNELS_CPU_NMS_H
@@ -15,7 +15,7 @@ namespace ts {
 
             void conv2d(const Tensor &x, const Padding2D &padding, float padding_value,
                         const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
-                        Conv2DFormat format, std::vector<float>dequantize_scales, 
+                        Conv2DFormat format, std::vector<float>dequantize_scales, float requantize_scale,
                         Tensor &out, Stack &stack) override;
         };
     }
@@ -0,0 +1,49 @@
+#ifndef TENSORSTACK_KERNELS_CPU_QUANTIZED_INT8_GEMM_H
+#define TENSORSTACK_KERNELS_CPU_QUANTIZED_INT8_GEMM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ts {
+    namespace cpu {
+        /**
+         * int8 x int8 -> int32 GEMM on packed panels, C = epilogue(A * B), A is M x K, B is K x N.
+         * Operands are packed as int16 pairs along K, so one multiply-add instruction
+         * (pmaddwd, or vmlal on NEON) accumulates two products without overflow.
+         * The int32 accumulator never leaves registers, scales are applied per row of A.
+         */
+        class Int8Gemm {
+        public:
+            static const int MR = 4;    ///< rows of A panel
+            static const int NR = 8;    ///< cols of B panel
+
+            /**
+             * @return count of int16 needed to pack A
+             */
+            static size_t pack_A_size(int M, int K);
+
+            /**
+             * @return count of int16 needed to pack B
+             */
+            static size_t pack_B_size(int K, int N);
+
+            static void pack_A(int M, int K, const int8_t *A, int lda, int16_t *packed);
+
+            static void pack_B(int K, int N, const int8_t *B, int ldb, int16_t *packed);
+
+            /**
+             * C[i, j] = (A * B)[i, j] * scales[i]
+             */
+            static void dequantize(int M, int N, int K, const int16_t *packed_A, const int16_t *packed_B,
+                                   const float *scales, float *C, int ldc);
+
+            /**
+             * C[i, j] = saturate(round((A * B)[i, j] * scales[i] * requantize_scale)), same as quantize after dequantize
+             */
+            static void requantize(int M, int N, int K, const int16_t *packed_A, const int16_t *packed_B,
+                                   const float *scales, float requantize_scale, int8_t *C, int ldc);
+        };
+    }
+}
+
+#endif //TENSORSTACK_KERNELS_CPU_QUANTIZED_INT8_GEMM_H
@@ -8,6 +8,8 @@
 #include <utils/implement.h>
 #include "core/controller.h"
 
+#include <string>
+
 
 namespace ts {
     class TS_DEBUG_API QueuedStackMemoryController : public MemoryController {
@@ -64,6 +66,81 @@ namespace ts {
     };
 
 
+    /**
+     * PlannedMemoryController, flow memory with static arena layout.
+     * The first run between begin() and end() is traced: each allocation's size and lifetime
+     * are recorded, then a liveness-based packing computes one fixed offset for every allocation.
+     * Later runs with the same allocation sequence are served from one slab at the planned offsets,
+     * so no allocation happens on the hot path.
+     * Any allocation out of plan (changed shape, out of run, overlapped block still alive)
+     * falls back to VatMemoryController, the run is then re-traced and re-planned.
+     * Plans are keyed by the signature given to begin(signature), like the input shapes of run,
+     * the recently used capacity() plans are kept, so switching between a few input shapes replays their own plan.
+     */
+    class TS_DEBUG_API PlannedMemoryController : public MemoryController {
+    public:
+        using self = PlannedMemoryController;
+        using shared = std::shared_ptr<self>;  ///< smart pointer
+        using supper = MemoryController;
+        /**
+         * @param device the memory device
+         */
+        explicit PlannedMemoryController(const MemoryDevice &device);
+
+        ~PlannedMemoryController() override;
+
+        Memory alloc(size_t size) override;
+
+        uint64_t summary() const override;
+
+        /**
+         * mark the beginning of a run, allocations after this will be traced or planned
+         */
+        void begin();
+
+        /**
+         * mark the beginning of a run, use the plan of given signature
+         * @param signature key of plan, runs with same signature are expected to have same allocation sequence
+         */
+        void begin(const std::string &signature);
+
+        /**
+         * mark the ending of a run, plan will be built if last run is out of plan
+         */
+        void end();
+
+        /**
+         * drop plan and all cached slab
+         */
+        void reset();
+
+        /**
+         * @return if there is a ready plan
+         */
+        bool planned() const;
+
+        /**
+         * @return bytes of one slab of last used plan, 0 if no plan ready
+         */
+        uint64_t arena() const;
+
+        /**
+         * @return number of ready plans
+         */
+        size_t plans() const;
+
+        /**
+         * @param capacity max number of plans kept, least recently used plan will be dropped, at least 1
+         */
+        void set_capacity(size_t capacity);
+
+        size_t capacity() const;
+
+    private:
+        class Implement;
+        Declare<Implement> m_impl;
+    };
+
     using FlowMemoryController = VatMemoryController;
 }
 
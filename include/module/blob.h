@@ -0,0 +1,85 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_MODULE_BLOB_H
+#define TENSORSTACK_MODULE_BLOB_H
+
+#include "core/memory.h"
+#include "module/io/stream.h"
+#include "utils/ctxmgr_lite.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ts {
+    /**
+     * Save big tensor memory out of serialized stream, as aligned blobs.
+     * @note ctx::bind<BlobWriter> before serialize, tensor memory accepted is replaced by blob offset in stream
+     */
+    class TS_DEBUG_API BlobWriter : public SetupContext<BlobWriter> {
+    public:
+        using self = BlobWriter;
+
+        /**
+         * @param alignment alignment of each blob
+         * @param threshold memory smaller than threshold bytes is still written in stream
+         */
+        explicit BlobWriter(size_t alignment = 64, size_t threshold = 1024);
+
+        /**
+         * @param memory CPU memory, kept until blobs written
+         * @return offset in blobs, negative if memory should be written in stream
+         */
+        int64_t write(const Memory &memory);
+
+        /**
+         * @return total size of blobs, including padding
+         */
+        uint64_t size() const { return m_size; }
+
+        size_t alignment() const { return m_alignment; }
+
+        /**
+         * write all blobs to stream, with padding between them
+         * @return writen bytes
+         */
+        size_t serialize(StreamWriter &stream) const;
+
+    private:
+        size_t m_alignment;
+        size_t m_threshold;
+        uint64_t m_size = 0;
+        std::vector<Memory> m_blobs;
+    };
+
+    /**
+     * Read tensor memory saved by BlobWriter.
+     * @note ctx::bind<BlobReader> before externalize
+     */
+    class TS_DEBUG_API BlobReader : public SetupContext<BlobReader> {
+    public:
+        using self = BlobReader;
+
+        /**
+         * @param hard CPU memory containing all blobs, tensors read share this memory
+         * @param shift start of blobs in hard memory
+         * @param size total size of blobs
+         */
+        BlobReader(HardMemory::shared hard, size_t shift, uint64_t size);
+
+        /**
+         * @param offset offset in blobs
+         * @param size memory size
+         * @return memory sharing blobs
+         */
+        Memory read(uint64_t offset, size_t size) const;
+
+    private:
+        HardMemory::shared m_hard;
+        size_t m_shift;
+        uint64_t m_size;
+    };
+}
+
+#endif //TENSORSTACK_MODULE_BLOB_H
@@ -12,6 +12,7 @@
 #include <cstdint>
 
 #define TS_MODULE_CODE_V1 0x19910929
+#define TS_MODULE_CODE_V2 0x19910930    ///< weights saved in aligned blobs, see BlobWriter
 
 namespace ts {
     class TS_DEBUG_API Header : public Serializable {
@@ -0,0 +1,57 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_MODULE_IO_MSTREAM_H
+#define TENSORSTACK_MODULE_IO_MSTREAM_H
+
+#include "stream.h"
+#include "core/hard_memory.h"
+
+namespace ts {
+    /**
+     * Read from memory buffer, the buffer is borrowed
+     */
+    class TS_DEBUG_API MemoryStreamReader : public StreamReader {
+    public:
+        using self = MemoryStreamReader;
+        using supper = StreamReader;
+
+        MemoryStreamReader(const self &) = delete;
+
+        self &operator=(const self &) = delete;
+
+        MemoryStreamReader(const void *data, size_t size);
+
+        size_t read(void *buffer, size_t size) final;
+
+        /**
+         * @param size skip bytes
+         * @return skipped bytes
+         */
+        size_t skip(size_t size);
+
+        /**
+         * @return read bytes from beginning
+         */
+        size_t position() const { return m_position; }
+
+        size_t size() const { return m_size; }
+
+    private:
+        const char *m_data;
+        size_t m_size;
+        size_t m_position = 0;
+    };
+
+    /**
+     * Map whole file into CPU memory, pages are shared with other processes mapping the same file.
+     * The mapping is read only, writing to it faults, so tensors on it must never be written in place.
+     * @param path file path
+     * @return mapped memory, unmapped once released; nullptr if failed
+     * @note read whole file in memory on platform not supporting mmap
+     */
+    TS_DEBUG_API HardMemory::shared map_file(const std::string &path);
+}
+
+#endif //TENSORSTACK_MODULE_IO_MSTREAM_H
@@ -50,6 +50,7 @@ namespace ts {
         enum SerializationFormat {
             BINARY,
             DESCRIPTION,
+            BINARY_V2,  ///< binary with weights in aligned blobs, which can be loaded by mapping file, no copy
         };
 
         static Module::shared Load(StreamReader &stream, SerializationFormat format = BINARY);
@@ -0,0 +1,116 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_RUNTIME_ASYNC_RUN_H
+#define TENSORSTACK_RUNTIME_ASYNC_RUN_H
+
+#include "core/tensor.h"
+#include "utils/implement.h"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace ts {
+    class Executor;
+
+    /**
+     * Handle of one asynchronous run, returned by Workbench::run_async and Executor::submit
+     */
+    class TS_DEBUG_API AsyncRun {
+    public:
+        using self = AsyncRun;
+        using shared = std::shared_ptr<self>;
+
+        using Outputs = std::vector<Tensor>;
+        /**
+         * called once in executor thread after run finished, failed or cancelled,
+         * the future is already ready in callback, so get() is allowed there
+         */
+        using Callback = std::function<void(AsyncRun &)>;
+
+        enum Status {
+            QUEUED = 0,     ///< waiting in executor
+            RUNNING = 1,    ///< filtering or running, can not be cancelled
+            DONE = 2,       ///< outputs ready
+            FAILED = 3,     ///< exception thrown in filtering or running
+            CANCELLED = 4,  ///< cancelled before running
+        };
+
+        explicit AsyncRun(const Callback &callback = nullptr);
+
+        ~AsyncRun();
+
+        AsyncRun(const self &) = delete;
+
+        AsyncRun &operator=(const self &) = delete;
+
+        Status status() const;
+
+        /**
+         * @return if status is DONE, FAILED or CANCELLED
+         */
+        bool ready() const;
+
+        /**
+         * wait until ready
+         */
+        void wait() const;
+
+        /**
+         * wait until ready or out of time
+         * @param milliseconds max waiting time
+         * @return if ready
+         */
+        bool wait_for(int64_t milliseconds) const;
+
+        /**
+         * wait until ready, and get outputs
+         * @return outputs in slot order
+         * @throw the exception of failed run, or Exception if cancelled
+         */
+        const Outputs &get() const;
+
+        /**
+         * @return future of outputs, can be waited in other threads
+         */
+        std::shared_future<Outputs> future() const;
+
+        /**
+         * cancel run which is still queued
+         * @return true if cancelled, false if already running or ready
+         */
+        bool cancel();
+
+    private:
+        friend class Executor;
+
+        /**
+         * QUEUED to RUNNING
+         * @return false if cancelled
+         */
+        bool start();
+
+        /**
+         * RUNNING to DONE
+         */
+        void finish(Outputs outputs);
+
+        /**
+         * RUNNING to FAILED
+         */
+        void fail(std::exception_ptr exception);
+
+        /**
+         * @param release called once when this run leaves executor, by ready or cancelled
+         */
+        void bind_release(std::function<void()> release);
+
+        class Implement;
+        Declare<Implement> m_impl;
+    };
+}
+
+#endif //TENSORSTACK_RUNTIME_ASYNC_RUN_H
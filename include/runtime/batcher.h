@@ -0,0 +1,73 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_RUNTIME_BATCHER_H
+#define TENSORSTACK_RUNTIME_BATCHER_H
+
+#include "workbench.h"
+#include "utils/implement.h"
+
+#include <future>
+
+namespace ts {
+    /**
+     * Dynamic batching in front of workbench.
+     * Requests are queued until max batch size reached or the oldest one waits for the latency,
+     * then concatenated along N, run once, and outputs sliced back to each request.
+     */
+    class TS_DEBUG_API Batcher {
+    public:
+        using self = Batcher;
+        using shared = std::shared_ptr<self>;
+
+        using Outputs = std::vector<Tensor>;
+
+        /**
+         * @param bench workbench with program setup, batcher runs on a shared one, see Workbench::share
+         * @param max_batch_size max number of samples in one run
+         * @param latency max microseconds a request waits for others
+         * @note every output should have samples in first dim
+         */
+        Batcher(const Workbench::shared &bench, int max_batch_size, int latency);
+
+        /**
+         * @param bench workbench with program setup, batcher runs on a shared one, see Workbench::share
+         * @param max_batch_size max number of samples in one run
+         * @param latency max microseconds a request waits for others
+         * @param batch_outputs if each output has samples in first dim, in output slot order.
+         *                      the output without batch axis is computed on whole batch, and given to every request.
+         */
+        Batcher(const Workbench::shared &bench, int max_batch_size, int latency,
+                const std::vector<bool> &batch_outputs);
+
+        /**
+         * finish all queued requests before destroyed
+         */
+        ~Batcher();
+
+        Batcher(const self &) = delete;
+
+        Batcher &operator=(const self &) = delete;
+
+        /**
+         * queue request
+         * @param inputs each input of program, in slot order, with same samples in first dim.
+         *               input with filter is filtered before concatenated, so images can be in different size.
+         * @return outputs of this request, the outputs with batch axis are sliced.
+         *         if any output flagged with batch axis has not batch samples in first dim, the request fails.
+         * @note thread safe
+         */
+        std::future<Outputs> submit(const std::vector<Tensor> &inputs);
+
+        int max_batch_size() const;
+
+        int latency() const;
+
+    private:
+        class Implement;
+        Declare<Implement> m_impl;
+    };
+}
+
+#endif //TENSORSTACK_RUNTIME_BATCHER_H
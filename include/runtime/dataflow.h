@@ -0,0 +1,91 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_RUNTIME_DATAFLOW_H
+#define TENSORSTACK_RUNTIME_DATAFLOW_H
+
+#include <memory>
+#include <vector>
+
+#include "utils/api.h"
+
+namespace ts {
+    class Workbench;
+    class Program;
+
+    /**
+     * Dependency graph of operator instructions in one Program.
+     * Every node is one OperatorInstruction, whose inputs are program arguments, data segments or other nodes.
+     * Nodes are listed in topological order, so that independent branches can be found and run concurrently.
+     */
+    class TS_DEBUG_API Dataflow {
+    public:
+        using self = Dataflow;
+        using shared = std::shared_ptr<self>;
+
+        class Value {
+        public:
+            enum Kind {
+                ARGUMENT = 0,   ///< index of program argument
+                DATA = 1,       ///< index of program data segment
+                NODE = 2,       ///< index of node output
+            };
+
+            Value() = default;
+
+            Value(Kind kind, int index) : kind(kind), index(index) {}
+
+            Kind kind = ARGUMENT;
+            int index = 0;
+        };
+
+        class Node {
+        public:
+            int instruction = 0;    ///< index of OperatorInstruction in Program
+            std::vector<Value> inputs;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<Value> outputs;
+
+        /**
+         * @return max number of nodes those can run in the same time, by level of nodes
+         */
+        int width() const;
+    };
+
+    /**
+     * Run Program's dataflow in Workbench's ThreadPool, each ready node dispatched to an idle lane.
+     * Each lane has its own Stack, operator outputs are saved in value slots, and released after last reading.
+     */
+    class TS_DEBUG_API DataflowRunner {
+    public:
+        using self = DataflowRunner;
+
+        /**
+         * @param bench running workbench
+         * @param program program with dataflow
+         * @return if program can run in dataflow mode now
+         * @note profiler and hook are not thread safe, program will run in serial instructions if they are bound,
+         *       so profiler events and hooks are never skipped
+         * @note planned memory is allocated in serial order, so --dataflow turns memory plan off in compiling,
+         *       and is rejected with explicit --memory-plan
+         */
+        static bool Ready(Workbench &bench, const Program &program);
+
+        /**
+         * run program's dataflow, arguments are on the top of bench's stack.
+         * after running, arguments are replaced by outputs.
+         * @param bench running workbench
+         * @param program program with dataflow
+         * @param nargs number of arguments
+         * @return number of outputs
+         * @context bound by workbench
+         */
+        static int Run(Workbench &bench, const Program &program, int nargs);
+    };
+}
+
+
+#endif //TENSORSTACK_RUNTIME_DATAFLOW_H
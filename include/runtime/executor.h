@@ -0,0 +1,61 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_RUNTIME_EXECUTOR_H
+#define TENSORSTACK_RUNTIME_EXECUTOR_H
+
+#include "workbench.h"
+#include "async_run.h"
+#include "utils/implement.h"
+
+namespace ts {
+    /**
+     * Asynchronous runs of one program, in two pipelined stages:
+     * inputs filtering of next request is overlapped with running of current one.
+     * Each stage works in own thread on own shared workbench, with operators cloned from bench, see Workbench::share.
+     * At most capacity requests are in flight (queued, filtering or running), submit blocks until one finished.
+     */
+    class TS_DEBUG_API Executor {
+    public:
+        using self = Executor;
+        using shared = std::shared_ptr<self>;
+
+        /**
+         * @param bench workbench with program setup
+         * @param capacity max number of requests in flight, at least 1
+         */
+        Executor(const Workbench &bench, int capacity);
+
+        /**
+         * finish all queued requests before destroyed
+         */
+        ~Executor();
+
+        Executor(const self &) = delete;
+
+        Executor &operator=(const self &) = delete;
+
+        /**
+         * queue request
+         * @param inputs each input of program, in slot order
+         * @param callback called in executor thread once the request ready or cancelled, can be nullptr
+         * @return handle of request
+         * @note thread safe, blocks while capacity requests in flight
+         */
+        AsyncRun::shared submit(const std::vector<Tensor> &inputs, const AsyncRun::Callback &callback = nullptr);
+
+        int capacity() const;
+
+        /**
+         * @return number of requests in flight
+         */
+        int in_flight() const;
+
+    private:
+        class Implement;
+        Declare<Implement> m_impl;
+    };
+}
+
+#endif //TENSORSTACK_RUNTIME_EXECUTOR_H
@@ -89,6 +89,13 @@ namespace ts {
          */
         Tensor run(const Tensor &image);
 
+        /**
+         * Adjust image to the input format of filter program
+         * @param image shape in [height, width], [height, width, channels] or [batch, height, width, channels]
+         * @return image in [batch, height, width, channels]
+         */
+        static Tensor AdjustNHWC(const Tensor &image);
+
         shared clone() const;
 
         const Graph &graph() const;
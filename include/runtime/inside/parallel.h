@@ -7,10 +7,10 @@
 
 
 #include "thread_pool.h"
+#include "runtime/runtime.h"
 #include "utils/ctxmgr.h"
 #include "utils/box.h"
 #include "utils/log.h"
-#include <algorithm>
 
 #include <algorithm>
 
@@ -19,42 +19,58 @@
 namespace ts {
     using Range = std::pair<int, int>;
 
+    /**
+     * @return number of threads one parallel task can use in current context,
+     *         the computing thread number of context RuntimeContext, limited by the size of context ThreadPool
+     * @note the RuntimeContext budget matters when the ThreadPool is shared by several runtimes
+     */
+    inline int parallel_budget() {
+        auto gun = ctx::ptr<ThreadPool>();
+        if (gun == nullptr) return 1;
+        auto budget = int(std::max<size_t>(gun->size(), 1));
+        auto runtime = ctx::ptr<RuntimeContext>();
+        if (runtime != nullptr && runtime->get_computing_thread_number() > 0) {
+            budget = std::min(budget, runtime->get_computing_thread_number());
+        }
+        return budget;
+    }
+
     inline ThreadPool *try_parallel(int task_number) {
         if (task_number <= 1) return nullptr;
         auto gun = ctx::ptr<ThreadPool>();
-        if (gun != nullptr && gun->size() > 1) return gun;
+        if (gun != nullptr && parallel_budget() > 1) return gun;
         return nullptr;
     }
 
+    /**
+     * run range_solver(signet, first, second) over [begin, end) with the context ThreadPool
+     * @param range_solver range solver, called several times with sub ranges
+     * @param begin range begin
+     * @param end range end
+     * @param joinable keep for compatibility, parallel tasks are always finished when returned
+     * @note work stealing between threads, and nest calling is supported
+     */
     inline void parallel_run(const std::function<void(int, int, int)> &range_solver, int begin, int end, bool joinable = true) {
+        (void)(joinable);
         auto parallel_gun = ts::try_parallel(end - begin);
         if (parallel_gun) {
-            auto parallel_ranges = ts::split_bins(begin, end, int(parallel_gun->size()));
-            for (auto &parallel_range : parallel_ranges) {
-                parallel_gun->run([range_solver, parallel_range](int signet){
-                    range_solver(signet, parallel_range.first, parallel_range.second);
-                });
-            }
-            if (joinable) {
-                parallel_gun->join();
-            }
+            parallel_gun->parallel(begin, end, 0, range_solver, parallel_budget());
         } else {
             range_solver(0, begin, end);
         }
     }
 
+    /**
+     * run range_solver(signet, range) over [begin, end) with the context ThreadPool
+     * @see parallel_run
+     */
     inline void parallel_range(const std::function<void(int, const Range &)> &range_solver, int begin, int end, bool joinable = true) {
+        (void)(joinable);
         auto parallel_gun = ts::try_parallel(end - begin);
         if (parallel_gun) {
-            auto parallel_ranges = ts::split_bins(begin, end, int(parallel_gun->size()));
-            for (auto &parallel_range : parallel_ranges) {
-                parallel_gun->run([range_solver, parallel_range](int signet){
-                    range_solver(signet, parallel_range);
-                });
-            }
-            if (joinable) {
-                parallel_gun->join();
-            }
+            parallel_gun->parallel(begin, end, 0, [&range_solver](int signet, int first, int second) {
+                range_solver(signet, Range(first, second));
+            }, parallel_budget());
         } else {
             range_solver(0, Range(begin, end));
         }
@@ -65,9 +81,11 @@ namespace ts {
         if (gun) gun->join();
     }
 
+    /**
+     * @return max number of threads working on one parallel task, at least 1
+     */
     inline size_t parallel_size() {
-        auto gun = ctx::ptr<ThreadPool>();
-        return gun != nullptr ? (std::max<size_t>(gun->size(), 1)) : 1;
+        return size_t(parallel_budget());
     }
 }
 
@@ -78,7 +96,7 @@ namespace ts {
  * @param var_loop_value loop value name
  * @param var_loop_begin loop begin value
  * @param var_loop_end loop end value
- * @note the TS_PARALLEL_XXX block do NOT support nest
+ * @note the TS_PARALLEL_XXX block can be nested, inner block will be shared by idle threads
  * @note The input parameters over 3 are the closure value in parallel run
  * Usage:
  * ```
@@ -120,7 +138,7 @@ namespace ts {
  * @param var_range_value range parallel value name, is type of Range
  * @param var_range_begin range parallel begin value
  * @param var_rnage_end range parallel end value
- * @note the TS_PARALLEL_XXX block do NOT support nest
+ * @note the TS_PARALLEL_XXX block can be nested, inner block will be shared by idle threads
  * @note The input parameters over 3 are the closure value in parallel run
  * Usage:
  * ```
@@ -16,6 +16,7 @@
 
 #include <utils/api.h>
 #include "utils/ctxmgr_lite.h"
+#include "utils/implement.h"
 
 namespace ts {
     class TS_DEBUG_API Thread {
@@ -63,13 +64,22 @@ namespace ts {
     };
 
     /**
- * @brief The ThreadPool class the thread pool
- */
+     * @brief The ThreadPool class the thread pool
+     * Parallel ranges are scheduled by work stealing: each participant owns a part of the range,
+     * takes chunks from its front, and steals half of the biggest remaining part when it runs out.
+     * The calling thread works as one participant, so calling parallel in a running task (nest) is supported.
+     * Idle workers spin for a while before sleeping, to cut the wakeup latency of continuous dispatches.
+     */
     class TS_DEBUG_API ThreadPool : public SetupContext<ThreadPool> {
     public:
         using self = ThreadPool;
         using shared = std::shared_ptr<self>;
 
+        /**
+         * range task, called with (signet, begin, end), signet is in [0, size())
+         */
+        using range_task_type = std::function<void(int, int, int)>;
+
         /**
          * @brief Shotgun
          * @param pool_size The thread number in pool. Number of threads
@@ -83,20 +93,32 @@ namespace ts {
         const ThreadPool &operator=(const ThreadPool &) = delete;
 
         /**
-         * @brief run Find ready thread, build task and run.
+         * @brief run Asynchronous run task in any idle worker.
          * @param task the task ready to run
-         * @return The running thread
+         * @return nullptr, the task is queued, not bound to given thread
          */
         Thread *run(const Thread::task_type &task);
 
         /**
-         * @brief run Find ready thread, build task and run.
+         * @brief run Asynchronous run task in any idle worker.
          * @param task the task ready to run
          * @param after_task the work after task finished
-         * @return The running thread
+         * @return nullptr, the task is queued, not bound to given thread
          */
         Thread *run(const Thread::task_type &task, const Thread::after_task_type &after_task);
 
+        /**
+         * @brief parallel Run task over [begin, end) in parallel, return after all range finished.
+         * @param begin range begin
+         * @param end range end
+         * @param grain the size of chunk taken each time, 0 for automatically decided
+         * @param task range task, may be called several times by each signet
+         * @param parts max number of participants including the calling thread, 0 for size()
+         * @note can be called in task running in this pool
+         * @note parts is the thread budget of caller, so runtimes sharing one pool only use their own budget
+         */
+        void parallel(int begin, int end, int grain, const range_task_type &task, int parts = 0);
+
         /**
          * @brief join Wait all tasks working finish.
          */
@@ -114,25 +136,15 @@ namespace ts {
          */
         size_t size() const;
 
-    private:
-
-        /**
-         * @brief load Get thread ready to run
-         * @return Get ready thread
-         */
-        int load();
-
         /**
-         * @brief recycling_thread Recycle thread
-         * @param signet thread index
+         * @brief work_time Get total time all threads spent in tasks of this pool, including the calling thread's part of parallel
+         * @return microseconds
          */
-        void recycling_thread(int signet);
-
-        std::vector<Thread *> thread_pool;                     ///< all cartridges
+        int64_t work_time() const;
 
-        std::mutex running_core_mutex;                  ///< mutex to get cartridges
-        std::condition_variable running_core_cond;      ///< active when cartridge pushed in chest
-        std::deque<int> running_core;                  ///< save all cartridge ready to fire
+    private:
+        class Implement;
+        Declare<Implement> m_impl;
     };
 }
 
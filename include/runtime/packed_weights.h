@@ -0,0 +1,77 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_RUNTIME_PACKED_WEIGHTS_H
+#define TENSORSTACK_RUNTIME_PACKED_WEIGHTS_H
+
+#include "runtime/stack.h"
+
+#include <functional>
+#include <mutex>
+#include <map>
+#include <unordered_set>
+
+namespace ts {
+    /**
+     * Packed constant weights of one program, shared by programs cloned from it,
+     * so every gemm based operator packs its weight once, on any workbench running the program.
+     * Only tensors in the data segment are cached, the weight is identified by its memory and the packing layout,
+     * data segment is never changed after linked and lives as long as the cache.
+     */
+    class TS_DEBUG_API PackedWeights {
+    public:
+        using self = PackedWeights;
+        using shared = std::shared_ptr<self>;
+
+        /**
+         * return packed weight, the packed tensor must not be allocated in flow memory
+         */
+        using Packer = std::function<Tensor(const Tensor &weight)>;
+
+        explicit PackedWeights(Stack::shared data_segment);
+
+        /**
+         * @param weight weight tensor
+         * @param layout name of packing layout, like "pack8_B", same weight packed in different layouts is kept apart
+         * @param packer called once for each constant weight and layout, or every time for weight not in data segment
+         * @return packed weight
+         */
+        Tensor get(const Tensor &weight, const std::string &layout, const Packer &packer);
+
+        /**
+         * @return if weight is a tensor in data segment
+         */
+        bool constant(const Tensor &weight);
+
+        /**
+         * @return number of packed weights
+         */
+        size_t count() const;
+
+        /**
+         * @return bytes of packed weights
+         */
+        uint64_t memory() const;
+
+        /**
+         * @param weight weight tensor
+         * @param layout name of packing layout
+         * @param packer pack weight
+         * @return packed weight by packed weights of running program, or packer(weight) if there is no program running
+         * @context Workbench
+         */
+        static Tensor Get(const Tensor &weight, const std::string &layout, const Packer &packer);
+
+    private:
+        using Key = std::pair<const void *, std::string>;
+
+        Stack::shared m_data_segment;
+        bool m_indexed = false;
+        std::unordered_set<const void *> m_constants;
+        std::map<Key, Tensor> m_packed;
+        mutable std::mutex m_mutex;
+    };
+}
+
+#endif //TENSORSTACK_RUNTIME_PACKED_WEIGHTS_H
@@ -10,8 +10,13 @@
 #include "module/module.h"
 #include "runtime/stack.h"
 #include "runtime/instruction.h"
+#include "runtime/dataflow.h"
+#include "runtime/register_code.h"
+#include "runtime/packed_weights.h"
 
 namespace ts {
+    class InstructionBlock;
+
     class TS_DEBUG_API Program {
     public:
         using self = Program;
@@ -39,8 +44,37 @@ namespace ts {
          */
         static shared Compile(const Module::shared &module, const ComputingDevice &device, const std::string &options);
 
+        /**
+         * compile module to program, and give back the optimized module for caching
+         * @param module module to compile
+         * @param device computing device program running on
+         * @param options like --winograd
+         * @param [out] optimized translated and optimized module, which can be saved and linked
+         *              without translating and optimizing again, nullptr if outputs can not be saved
+         * @return compiled program
+         * @context Workbench for compile usage
+         */
+        static shared Compile(const Module::shared &module, const ComputingDevice &device, const std::string &options,
+                              Module::shared &optimized);
+
+        /**
+         * build program of optimized module, only generating instructions
+         * @param optimized module got in Compile
+         * @param device must be the device optimized on
+         * @param options must be the options optimized with
+         * @return linked program
+         * @context Workbench for compile usage
+         */
+        static shared Link(const Module::shared &optimized, const ComputingDevice &device, const std::string &options);
+
         shared clone() const;
 
+        /**
+         * @return program sharing instructions and data segment with this, but no input filter bound
+         * @note for running on inputs which already filtered
+         */
+        shared unfiltered() const;
+
         void bind_filter(int slot, shared filter);
 
         shared input_filter(int slot) const;
@@ -73,7 +107,37 @@ namespace ts {
 
         const std::vector<std::string> &output_names() const;
 
+        /**
+         * @return if running with planned flow memory, set by compile option --memory-plan or --no-memory-plan,
+         *         off with --dataflow
+         */
+        bool memory_plan() const { return m_memory_plan; }
+
+        /**
+         * @return dependency graph for running independent branches concurrently,
+         *         set by compile option --dataflow, nullptr if not set or not supported
+         */
+        const Dataflow::shared &dataflow() const { return m_dataflow; }
+
+        /**
+         * @return operator instructions with fixed value slots, running without stack shuffling,
+         *         set by compile option --register or --no-register, nullptr if not set or not supported
+         */
+        const RegisterCode::shared &register_code() const { return m_register_code; }
+
+        /**
+         * @return packed constant weights, shared with cloned programs
+         */
+        const PackedWeights::shared &packed_weights() const { return m_packed_weights; }
+
     private:
+        static shared Compile(const Module::shared &module, const ComputingDevice &device, const std::string &options,
+                              Module::shared *optimized);
+
+        static shared Link(InstructionBlock &block,
+                           const std::vector<Node> &module_inputs, const std::vector<Node> &module_outputs,
+                           const ComputingDevice &device, const std::string &options);
+
         Program(const ComputingDevice &device);
         Program(const ComputingDevice &device, const std::shared_ptr<std::mutex> &mutex);
 
@@ -98,6 +162,14 @@ namespace ts {
 
         std::vector<std::string> m_input_names;
         std::vector<std::string> m_output_names;
+
+        bool m_memory_plan = true;
+
+        Dataflow::shared m_dataflow;
+
+        RegisterCode::shared m_register_code;
+
+        PackedWeights::shared m_packed_weights;
     };
 
     class TS_DEBUG_API ProgramEnv {
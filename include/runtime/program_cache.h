@@ -0,0 +1,65 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_RUNTIME_PROGRAM_CACHE_H
+#define TENSORSTACK_RUNTIME_PROGRAM_CACHE_H
+
+#include "program.h"
+
+#include <string>
+
+namespace ts {
+    /**
+     * Ahead-of-time compiled program cache on disk.
+     * Module is cached after translating, zipping and const folding (packed weights included),
+     * keyed by model hash, device and options, so next launch only generates instructions.
+     */
+    class TS_DEBUG_API ProgramCache {
+    public:
+        using self = ProgramCache;
+
+        /**
+         * @param root directory of cached files, created if not exists
+         */
+        explicit ProgramCache(const std::string &root);
+
+        /**
+         * load cached program, or compile and cache it
+         * @param module module to compile
+         * @param device computing device program running on
+         * @param options compile options
+         * @return compiled program
+         * @context Workbench for compile usage
+         */
+        Program::shared compile(const Module::shared &module, const ComputingDevice &device, const std::string &options);
+
+        /**
+         * @param model model key, like model file hash, use it to skip hashing module
+         * @see compile
+         */
+        Program::shared compile(const std::string &model, const Module::shared &module,
+                                const ComputingDevice &device, const std::string &options);
+
+        /**
+         * @param module module to hash
+         * @return hash of module serialization
+         */
+        static std::string Hash(const Module::shared &module);
+
+        /**
+         * @param model model key, see Hash
+         * @param device computing device
+         * @param options compile options
+         * @return key of cached file, also depends on cache version and registered compiler options
+         */
+        static std::string Key(const std::string &model, const ComputingDevice &device, const std::string &options);
+
+        const std::string &root() const { return m_root; }
+
+    private:
+        std::string m_root;
+    };
+}
+
+#endif //TENSORSTACK_RUNTIME_PROGRAM_CACHE_H
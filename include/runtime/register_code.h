@@ -0,0 +1,99 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_RUNTIME_REGISTER_CODE_H
+#define TENSORSTACK_RUNTIME_REGISTER_CODE_H
+
+#include <memory>
+#include <vector>
+#include <string>
+
+#include "utils/api.h"
+#include "dataflow.h"
+
+namespace ts {
+    class Workbench;
+    class Program;
+
+    /**
+     * Register form of Program's operator instructions.
+     * Every value lives in a fixed slot, each step names its input and output slots directly,
+     * so running needs no stack shuffling. Slots are reused after the last reading of their values.
+     */
+    class TS_DEBUG_API RegisterCode {
+    public:
+        using self = RegisterCode;
+        using shared = std::shared_ptr<self>;
+
+        class Operand {
+        public:
+            enum Kind {
+                SLOT = 0,       ///< index of slot
+                DATA = 1,       ///< index of program data segment
+            };
+
+            Operand() = default;
+
+            Operand(Kind kind, int index) : kind(kind), index(index) {}
+
+            Kind kind = SLOT;
+            int index = 0;
+        };
+
+        class Step {
+        public:
+            int instruction = 0;        ///< index of OperatorInstruction in Program
+            std::vector<Operand> inputs;
+            int output = 0;             ///< slot of output
+            std::vector<int> release;   ///< slots not read after this step, released before running
+            bool discard = false;       ///< output not read after this step, released right after running
+        };
+
+        int slots = 0;      ///< number of slots, arguments are in slots [0, nargs) when starting
+        std::vector<Step> steps;
+        std::vector<Operand> outputs;
+
+        /**
+         * allocate slots for dataflow, in dataflow's node order
+         * @param dataflow dependency of operator instructions
+         * @param nargs number of arguments
+         * @return register code
+         */
+        static shared Allocate(const Dataflow &dataflow, int nargs);
+
+        /**
+         * @return readable code, one step each line
+         */
+        std::string str() const;
+    };
+
+    /**
+     * Run Program's register code in Workbench, instructions run in serial.
+     */
+    class TS_DEBUG_API RegisterRunner {
+    public:
+        using self = RegisterRunner;
+
+        /**
+         * @param bench running workbench
+         * @param program program to run
+         * @return if program can run in register mode
+         */
+        static bool Ready(Workbench &bench, const Program &program);
+
+        /**
+         * run program's register code, arguments are on the top of bench's stack.
+         * after running, arguments are replaced by outputs.
+         * @param bench running workbench
+         * @param program program with register code
+         * @param nargs number of arguments
+         * @return number of outputs
+         * @context bound by workbench
+         */
+        static int Run(Workbench &bench, const Program &program, int nargs);
+    };
+}
+
+
+#endif //TENSORSTACK_RUNTIME_REGISTER_CODE_H
@@ -34,8 +34,38 @@ namespace ts {
 
         self clone() const;
 
+        /**
+         * @return new context using the same thread pool, memory controllers not bound
+         * @note for workbenches serving concurrently in one process, so worker threads are not multiplied
+         */
+        self share() const;
+
         ThreadPool &thread_pool();
 
+        /**
+         * @return if this context is running in process-wide shared thread pool
+         */
+        bool using_shared_thread_pool() const;
+
+        /**
+         * Set if new computing thread number runs in process-wide shared thread pool.
+         * In shared mode, no threads are created for each context,
+         * the computing thread number only limits how many threads one parallel task can use.
+         * @param use true for using SharedThreadPool
+         * @note effect on later set_computing_thread_number and new contexts, default is false
+         */
+        static void UseSharedThreadPool(bool use);
+
+        /**
+         * @return if new contexts use process-wide shared thread pool
+         */
+        static bool UsingSharedThreadPool();
+
+        /**
+         * @return process-wide thread pool, created on first call with hardware concurrency threads
+         */
+        static ThreadPool::shared SharedThreadPool();
+
          void bind_flow(SyncMemoryController::shared flow);
 
          void bind_dynamic(SyncMemoryController::shared dynamic);
@@ -49,13 +79,20 @@ namespace ts {
         static SyncMemoryController::shared DynamicMemory();
 
     private:
+        RuntimeContext(ThreadPool::shared thread_pool, int computing_thread_number);
+
         /**
-         * Computing threads number. Used in OpenMP
+         * Computing threads number, the thread budget of parallel tasks
          */
         int m_computing_thread_number = 1;
 
         ThreadPool::shared m_thread_pool;
 
+        /**
+         * if m_thread_pool is SharedThreadPool
+         */
+        bool m_shared_thread_pool = false;
+
         SyncMemoryController::shared m_flow;
         SyncMemoryController::shared m_dynamic;
     };
@@ -0,0 +1,71 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_RUNTIME_SESSION_H
+#define TENSORSTACK_RUNTIME_SESSION_H
+
+#include "workbench.h"
+
+#include <memory>
+
+namespace ts {
+    /**
+     * Serving session, one compiled program and its weights shared by all requests,
+     * each request runs on pooled lightweight workbench, see Workbench::share
+     */
+    class TS_DEBUG_API Session {
+    public:
+        using self = Session;
+        using shared = std::shared_ptr<self>;
+
+        /**
+         * @param bench workbench with program setup, used as prototype of all workbenches
+         */
+        explicit Session(Workbench::shared bench);
+
+        ~Session();
+
+        Session(const self &) = delete;
+
+        Session &operator=(const self &) = delete;
+
+        static shared Load(const Module::shared &module, const ComputingDevice &device);
+
+        static shared Load(const Module::shared &module, const ComputingDevice &device, const std::string &options);
+
+        /**
+         * get idle workbench, or share new one if no idle
+         * @return workbench, given back to this session once released
+         * @note thread safe, the returned workbench can only be used in one thread at same time
+         */
+        Workbench::shared acquire();
+
+        /**
+         * prepare idle workbenches
+         * @param count number of idle workbenches at least
+         */
+        void reserve(size_t count);
+
+        /**
+         * release all idle workbenches
+         */
+        void clear();
+
+        /**
+         * @return number of idle workbenches
+         */
+        size_t idle() const;
+
+        /**
+         * @return prototype workbench
+         */
+        Workbench::shared prototype() const;
+
+    private:
+        class Implement;
+        std::shared_ptr<Implement> m_impl;  ///< shared with acquired workbenches, to give them back
+    };
+}
+
+#endif //TENSORSTACK_RUNTIME_SESSION_H
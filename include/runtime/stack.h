@@ -124,9 +124,7 @@ namespace ts {
          * @param shape new tensor's shape
          * @return pointer to new tensor
          */
-        Tensor *push(DTYPE dtype, const Shape &shape) {
-            return this->push(this->make(dtype, shape));
-        }
+        Tensor *push(DTYPE dtype, const Shape &shape);
 
         /**
          * Push tensor with dtype and shape on device
@@ -135,9 +133,7 @@ namespace ts {
          * @param shape new tensor's device
          * @return pointer to new tensor
          */
-        Tensor *push(DTYPE dtype, const Shape &shape, const MemoryDevice &device) {
-            return this->push(this->make(dtype, shape, device));
-        }
+        Tensor *push(DTYPE dtype, const Shape &shape, const MemoryDevice &device);
 
         /**
          * Push tensor with proto
@@ -338,6 +334,20 @@ namespace ts {
          */
         void pop_base();
 
+        /**
+         * preset memory for the tensor pushed into next slot of stack, with same dtype, count and device.
+         * used to let operator write its output into caller provided buffer directly.
+         * @param tensor preset tensor, empty tensor for clearing preset
+         * @note the preset is taken at most once, only by push with dtype and shape onto current top,
+         *       so temporary tensors got by make never take it
+         */
+        void preset(const Tensor &tensor);
+
+        /**
+         * @return if preset tensor has been taken, or no preset
+         */
+        bool preset_taken() const { return m_preset.empty(); }
+
         /**
          * get converter on stack's memory
          * @return memory converter
@@ -370,6 +380,15 @@ namespace ts {
         std::stack<size_t> m_base_stack;          ///< save each call base
 
         mutable HardConverter::function m_converter = nullptr;    ///< convert memory in stack
+
+        Tensor m_preset;                          ///< memory for matched pushing on m_preset_slot, see preset
+        size_t m_preset_slot = 0;                 ///< absolute index of slot the preset bound to
+
+        /**
+         * take preset if it matches wanted tensor pushing on its slot
+         * @return true if taken, and moved into tensor
+         */
+        bool take_preset(DTYPE dtype, const Shape &shape, const Device &device, Tensor &tensor);
     };
 }
 
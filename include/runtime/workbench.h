@@ -28,8 +28,14 @@
 
 #include "program.h"
 #include "runtime/switcher.h"
+#include "async_run.h"
 
 namespace ts {
+    class ProgramCache;
+
+    class PlannedMemoryController;
+    class Executor;
+
     class TS_DEBUG_API Workbench : public SetupContext<Workbench> {
     public:
         using self = Workbench;    ///< self class
@@ -80,18 +86,85 @@ namespace ts {
         // run graph
         void run();
 
+        /**
+         * @param capacity number of input shapes whose memory plan kept, least recently used plan dropped, at least 1
+         * @note each run replays the flow memory layout planned for its input shapes, see PlannedMemoryController
+         */
+        void set_plan_capacity(int capacity);
+
+        int plan_capacity() const;
+
+        /**
+         * run asynchronously on executor owned by this workbench, see Executor
+         * @param inputs each input of program, in slot order
+         * @param callback called in executor thread once the run ready or cancelled, can be nullptr
+         * @return handle of run, outputs got by AsyncRun::get
+         * @note blocks while async capacity runs in flight.
+         *       async runs work on shared workbenches, so the inputs, outputs and output buffers
+         *       of this workbench are not touched, and this workbench can run in the same time.
+         */
+        AsyncRun::shared run_async(const std::vector<Tensor> &inputs, const AsyncRun::Callback &callback = nullptr);
+
+        /**
+         * run asynchronously with inputs set now
+         * @see run_async
+         */
+        AsyncRun::shared run_async();
+
+        /**
+         * @param capacity max number of async runs in flight, at least 1, default is 2
+         * @note waits all async runs finished
+         */
+        void set_async_capacity(int capacity);
+
+        int async_capacity() const { return m_async_capacity; }
+
         // get output
         const Tensor &output(const std::string &name) const;
 
         const Tensor &output(int slot) const;
 
+        /**
+         * bind caller provided buffer to output,
+         * the operator producing the output allocates its result in buffer, so it is written directly,
+         * if the operator can not (in-place, packed or out of stack memory), output is copied into buffer after run.
+         * @param slot output slot
+         * @param buffer output buffer, must have the same dtype and count of output, empty tensor for unbinding
+         * @note buffer memory is borrowed, it must be alive until unbound, or another program setup
+         * @note after run, output(slot) shares memory with buffer, in output's shape
+         */
+        void bind_output(int slot, const Tensor &buffer);
+
+        void bind_output(const std::string &name, const Tensor &buffer);
+
+        /**
+         * @param op running operator
+         * @return output buffer the operator should write into, nullptr if not bound
+         */
+        const Tensor *output_buffer(const Operator *op) const;
+
         int input_count() const;
 
         int output_count() const;
 
+        /**
+         * @return program setup, nullptr if not setup
+         */
+        const Program::shared &desktop() const { return m_desktop; }
+
         // clone an Workbench which can run
         Workbench::shared clone() const;
 
+        /**
+         * create lightweight workbench running the same program
+         * @return new workbench with own stack, memory, inputs and outputs
+         * @note weights, packed weights and thread pool are shared by reference, not copied,
+         *       operators are cloned, so each workbench runs its own operator instances.
+         *       set operator param or bind filter before sharing, later changes are not seen by shared ones.
+         *       workbenches sharing one program can run concurrently in different threads.
+         */
+        Workbench::shared share() const;
+
         static shared Load(const Module::shared &module, const ComputingDevice &device);
 
         static shared Load(const Module::shared &module, const ComputingDevice &device, const std::string &options);
@@ -225,6 +298,15 @@ namespace ts {
 
         Program::shared compile(const Module::shared &module, const std::string &options);
 
+        /**
+         * compile module, or load it from cache
+         * @param module
+         * @param options
+         * @param cache ahead-of-time compiled program cache
+         * @return
+         */
+        Program::shared compile(const Module::shared &module, const std::string &options, ProgramCache &cache);
+
         /**
          * setup context DeviceContext
          */
@@ -253,10 +335,13 @@ namespace ts {
         SwitchControll::shared switch_controller();
 
     private:
+        Workbench(const ComputingDevice &device, RuntimeContext &&runtime);
+
         // size_t m_pointer = 0;   // pointer to running function
         // std::vector<Instruction::shared> m_program; // running function, program area
         SyncMemoryController::shared m_static_memory;
         SyncMemoryController::shared m_flow_memory;
+        std::shared_ptr<PlannedMemoryController> m_flow_planner;    // planner of m_flow_memory on running device
         SyncMemoryController::shared m_dynamic_memory;
         Stack::shared m_stack;  // save running memory, data area
         // Stack::shared m_data_sagment;   // save static area
@@ -266,6 +351,8 @@ namespace ts {
         // map tensor, means <tensor's index in stack, tensor>
         std::vector<Tensor> m_inputs;
         std::vector<Tensor> m_outputs;
+        std::vector<Tensor> m_output_buffers;   ///< caller provided buffer for each output, empty if not bound
+        std::unordered_map<const Operator *, int> m_output_buffer_slots;  ///< operator producing bound output
         // input and output dtype type
         // std::vector<DTYPE> m_input_dtypes;
         // std::vector<DTYPE> m_output_dtypes;
@@ -292,6 +379,9 @@ namespace ts {
         std::string m_summary;
 
         SwitchControll::shared m_switch_controller;
+
+        std::shared_ptr<Executor> m_executor;   ///< created at first run_async
+        int m_async_capacity = 2;
     private:
         Operator::shared m_cast_op; ///< for input cast
 
@@ -20,6 +20,11 @@ namespace ts{
         AVX = 12,
         AVX2 = 14,
         FMA = 15,
+        AVX512F = 16,
+        AVX512DQ = 17,
+        AVX512BW = 18,
+        AVX512VL = 19,
+        AES = 20,
     };
 
     inline const char *cpu_feature_str(CPUFeature feature) {
@@ -34,6 +39,11 @@ namespace ts{
         case ts::AVX: return "AVX";
         case ts::AVX2: return "AVX2";
         case ts::FMA: return "FMA";
+        case ts::AVX512F: return "AVX512F";
+        case ts::AVX512DQ: return "AVX512DQ";
+        case ts::AVX512BW: return "AVX512BW";
+        case ts::AVX512VL: return "AVX512VL";
+        case ts::AES: return "AES";
         default:break;
         }
         return "Unknown";
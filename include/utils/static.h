@@ -23,7 +23,7 @@ namespace ts {
     };
 }
 
-#define _ts_concat_name_core(x,y) (x##y)
+#define _ts_concat_name_core(x,y) x##y
 
 #define _ts_concat_name(x, y) _ts_concat_name_core(x,y)
 
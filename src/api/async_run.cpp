@@ -0,0 +1,76 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include <api/async_run.h>
+
+#include "declare_async_run.h"
+#include "declare_tensor.h"
+
+using namespace ts;
+
+/**
+ * get outputs, exceptions not from tennis are converted, so they can be caught by RETURN_OR_CATCH
+ */
+static const AsyncRun::Outputs &async_outputs(ts_AsyncRun *run) {
+    try {
+        return (*run)->get();
+    } catch (const Exception &) {
+        throw;
+    } catch (const std::exception &e) {
+        throw Exception(e.what());
+    }
+}
+
+void ts_free_AsyncRun(const ts_AsyncRun *run) {
+    TRY_HEAD
+    delete run;
+    TRY_TAIL
+}
+
+ts_AsyncRun_Status ts_AsyncRun_status(ts_AsyncRun *run) {
+    TRY_HEAD
+    if (!run) throw Exception("NullPointerException: @param: 1");
+    auto status = ts_AsyncRun_Status((*run)->status());
+    RETURN_OR_CATCH(status, TS_ASYNC_FAILED)
+}
+
+ts_bool ts_AsyncRun_wait(ts_AsyncRun *run) {
+    TRY_HEAD
+    if (!run) throw Exception("NullPointerException: @param: 1");
+    async_outputs(run);
+    RETURN_OR_CATCH(ts_true, ts_false)
+}
+
+ts_bool ts_AsyncRun_wait_for(ts_AsyncRun *run, int64_t milliseconds) {
+    TRY_HEAD
+    if (!run) throw Exception("NullPointerException: @param: 1");
+    auto ready = (*run)->wait_for(milliseconds);
+    RETURN_OR_CATCH(ts_bool(ready), ts_false)
+}
+
+ts_bool ts_AsyncRun_cancel(ts_AsyncRun *run) {
+    TRY_HEAD
+    if (!run) throw Exception("NullPointerException: @param: 1");
+    auto cancelled = (*run)->cancel();
+    RETURN_OR_CATCH(ts_bool(cancelled), ts_false)
+}
+
+int32_t ts_AsyncRun_output_count(ts_AsyncRun *run) {
+    TRY_HEAD
+    if (!run) throw Exception("NullPointerException: @param: 1");
+    auto count = int32_t(async_outputs(run).size());
+    RETURN_OR_CATCH(count, 0)
+}
+
+ts_bool ts_AsyncRun_output(ts_AsyncRun *run, int32_t i, ts_Tensor *tensor) {
+    TRY_HEAD
+    if (!run) throw Exception("NullPointerException: @param: 1");
+    if (!tensor) throw Exception("NullPointerException: @param: 3");
+    auto &outputs = async_outputs(run);
+    if (i < 0 || size_t(i) >= outputs.size()) {
+        TS_LOG_ERROR << "Output index out of range. with index=" << i << eject;
+    }
+    **tensor = outputs[i];
+    RETURN_OR_CATCH(ts_true, ts_false)
+}
@@ -0,0 +1,15 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENNIS_API_DECLARE_ASYNC_RUN_H
+#define TENNIS_API_DECLARE_ASYNC_RUN_H
+
+#include "api/async_run.h"
+#include "declaration.h"
+
+#include "runtime/async_run.h"
+
+DECLARE_API_TYPE(ts_AsyncRun, ts::AsyncRun)
+
+#endif //TENNIS_API_DECLARE_ASYNC_RUN_H
@@ -6,6 +6,7 @@
 #include "declaration.h"
 
 #include "global/setup.h"
+#include "runtime/runtime.h"
 
 using namespace ts;
 
@@ -15,3 +16,9 @@ ts_bool ts_setup() {
     RETURN_OR_CATCH(ts_true, ts_false);
 }
 
+
+ts_bool ts_use_shared_thread_pool(ts_bool use) {
+    TRY_HEAD
+    RuntimeContext::UseSharedThreadPool(bool(use));
+    RETURN_OR_CATCH(ts_true, ts_false);
+}
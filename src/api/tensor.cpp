@@ -8,6 +8,8 @@
 
 #include "core/tensor_builder.h"
 
+#include <cstdint>
+
 using namespace ts;
 
 ts_Tensor *ts_new_Tensor(const int32_t *shape, int32_t shape_len, ts_DTYPE dtype, const void *data) {
@@ -141,6 +143,21 @@ ts_new_Tensor_in_flow(ts_InFlow in_flow, const int32_t *shape, int32_t shape_len
     RETURN_OR_CATCH(tensor.release(), nullptr)
 }
 
+ts_Tensor *ts_new_Tensor_borrowed(const int32_t *shape, int32_t shape_len, ts_DTYPE dtype, void *data) {
+    TRY_HEAD
+        if (!data) throw Exception("NullPointerException: @param: 4");
+        if (shape == nullptr) shape_len = 0;
+        Tensor::Prototype proto(DTYPE(dtype), Shape(shape, shape + shape_len));
+        auto type_bytes = size_t(proto.type_bytes());
+        if (type_bytes == 0) TS_LOG_ERROR << "Not support dtype: " << dtype << eject;
+        if (reinterpret_cast<uintptr_t>(data) % type_bytes != 0) {
+            TS_LOG_ERROR << "Borrowed data " << data << " is not aligned to " << type_bytes << " bytes" << eject;
+        }
+        std::unique_ptr<ts_Tensor> tensor(new ts_Tensor());
+        **tensor = Tensor(Memory(MemoryDevice(CPU), data, type_bytes * proto.count()), proto);
+    RETURN_OR_CATCH(tensor.release(), nullptr)
+}
+
 ts_Tensor *ts_Tensor_field(ts_Tensor *tensor, int32_t index) {
     TRY_HEAD
         if (!tensor) throw Exception("NullPointerException: @param: 1");
@@ -9,6 +9,7 @@
 #include "declare_tensor.h"
 #include "declare_image_filter.h"
 #include "declare_program.h"
+#include "declare_async_run.h"
 
 using namespace ts;
 
@@ -34,6 +35,13 @@ ts_Workbench *ts_Workbench_clone(ts_Workbench *workbench) {
     RETURN_OR_CATCH(dolly.release(), nullptr)
 }
 
+ts_Workbench *ts_Workbench_share(ts_Workbench *workbench) {
+    TRY_HEAD
+    if (!workbench) throw Exception("NullPointerException: @param: 1");
+    std::unique_ptr<ts_Workbench> dolly(new ts_Workbench((*workbench)->share()));
+    RETURN_OR_CATCH(dolly.release(), nullptr)
+}
+
 ts_bool ts_Workbench_input(ts_Workbench *workbench, int32_t i, const ts_Tensor *tensor) {
     TRY_HEAD
     if (!workbench) throw Exception("NullPointerException: @param: 1");
@@ -58,6 +66,35 @@ ts_bool ts_Workbench_run(ts_Workbench *workbench) {
     RETURN_OR_CATCH(ts_true, ts_false)
 }
 
+ts_AsyncRun *ts_Workbench_run_async(ts_Workbench *workbench, const ts_Tensor *const *inputs, int32_t len,
+                                    ts_AsyncRun_callback callback, void *userdata) {
+    TRY_HEAD
+    if (!workbench) throw Exception("NullPointerException: @param: 1");
+    if (!inputs && len > 0) throw Exception("NullPointerException: @param: 2");
+    std::vector<Tensor> args;
+    for (int32_t i = 0; i < len; ++i) {
+        if (!inputs[i]) throw Exception("NullPointerException: @param: 2");
+        args.emplace_back(**inputs[i]);
+    }
+    AsyncRun::Callback run_callback = nullptr;
+    if (callback) {
+        run_callback = [callback, userdata](AsyncRun &run) {
+            // borrowed handle, not owning run
+            ts_AsyncRun handle(std::shared_ptr<AsyncRun>(&run, [](AsyncRun *) {}));
+            callback(&handle, userdata);
+        };
+    }
+    std::unique_ptr<ts_AsyncRun> run(new ts_AsyncRun((*workbench)->run_async(args, run_callback)));
+    RETURN_OR_CATCH(run.release(), nullptr)
+}
+
+ts_bool ts_Workbench_set_async_capacity(ts_Workbench *workbench, int32_t capacity) {
+    TRY_HEAD
+    if (!workbench) throw Exception("NullPointerException: @param: 1");
+    (*workbench)->set_async_capacity(capacity);
+    RETURN_OR_CATCH(ts_true, ts_false)
+}
+
 ts_bool ts_Workbench_output(ts_Workbench *workbench, int32_t i, ts_Tensor *tensor) {
     TRY_HEAD
     if (!workbench) throw Exception("NullPointerException: @param: 1");
@@ -75,6 +112,21 @@ ts_bool ts_Workbench_output_by_name(ts_Workbench *workbench, const char *name, t
     RETURN_OR_CATCH(ts_true, ts_false)
 }
 
+ts_bool ts_Workbench_bind_output(ts_Workbench *workbench, int32_t i, const ts_Tensor *buffer) {
+    TRY_HEAD
+    if (!workbench) throw Exception("NullPointerException: @param: 1");
+    (*workbench)->bind_output(i, buffer ? **buffer : Tensor());
+    RETURN_OR_CATCH(ts_true, ts_false)
+}
+
+ts_bool ts_Workbench_bind_output_by_name(ts_Workbench *workbench, const char *name, const ts_Tensor *buffer) {
+    TRY_HEAD
+    if (!workbench) throw Exception("NullPointerException: @param: 1");
+    if (!name) throw Exception("NullPointerException: @param: 2");
+    (*workbench)->bind_output(name, buffer ? **buffer : Tensor());
+    RETURN_OR_CATCH(ts_true, ts_false)
+}
+
 ts_bool ts_Workbench_set_computing_thread_number(ts_Workbench *workbench, int32_t number) {
     TRY_HEAD
     if (!workbench) throw Exception("NullPointerException: @param: 1");
@@ -22,6 +22,7 @@ namespace ts {
             field(name::dilation, OPTIONAL);
             field(name::typo::dialations, OPTIONAL);
             field(name::kernel_packed, OPTIONAL, tensor::from<bool>(false));
+            Conv2DEpilogue::Field(*this);
         }
 
         static std::string to_string(const std::valarray<int> &arr) {
@@ -48,6 +49,8 @@ namespace ts {
                 m_kernel_packed = tensor::to_bool(get(name::kernel_packed));
             }
 
+            m_epilogue = Conv2DEpilogue::Get(*this);
+
             Tensor dilation_tensor;
             if (has(name::dilation)) {
                 dilation_tensor = tensor::cast(INT32, get(name::dilation));
@@ -198,7 +201,14 @@ namespace ts {
 
                 TS_AUTO_CHECK(stack.size() == 0);
 
-                conv2d(x, padding, m_padding_value, w, stride, dilation, m_format, out, stack, m_kernel_packed);
+                if (m_epilogue.empty()) {
+                    conv2d(x, padding, m_padding_value, w, stride, dilation, m_format, out, stack, m_kernel_packed);
+                } else {
+                    auto channels = w.size(0);
+                    TS_AUTO_CHECK(m_epilogue.bias.empty() || m_epilogue.bias.count() == channels);
+                    TS_AUTO_CHECK(m_epilogue.slope.empty() || m_epilogue.slope.count() == 1 || m_epilogue.slope.count() == channels);
+                    conv2d(x, padding, m_padding_value, w, stride, dilation, m_format, out, stack, m_kernel_packed, m_epilogue);
+                }
 
                 stack.clear();
             }
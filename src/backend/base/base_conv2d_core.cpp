@@ -0,0 +1,46 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "backend/base/base_conv2d_core.h"
+
+#include "backend/name.h"
+#include "core/tensor_builder.h"
+
+namespace ts {
+    namespace base {
+        void Conv2DEpilogue::Field(Operator &op) {
+            op.field(name::fused_bias, Operator::OPTIONAL);
+            op.field(name::fused_activation, Operator::OPTIONAL, tensor::from(int(FusedActivation::NONE)));
+            op.field(name::fused_max, Operator::OPTIONAL, tensor::from(0.0f));
+            op.field(name::fused_slope, Operator::OPTIONAL);
+        }
+
+        Conv2DEpilogue Conv2DEpilogue::Get(const Operator &op) {
+            Conv2DEpilogue epilogue;
+            if (op.has(name::fused_bias)) {
+                epilogue.bias = tensor::cast(FLOAT32, op.get(name::fused_bias));
+            }
+            epilogue.activation = FusedActivation(tensor::to_int(op.get(name::fused_activation)));
+            epilogue.max = tensor::to_float(op.get(name::fused_max));
+            if (op.has(name::fused_slope)) {
+                epilogue.slope = tensor::cast(FLOAT32, op.get(name::fused_slope));
+            }
+            switch (epilogue.activation) {
+                case FusedActivation::NONE:
+                case FusedActivation::RELU:
+                case FusedActivation::RELU_MAX:
+                    break;
+                case FusedActivation::LEAKY_RELU:
+                    if (epilogue.slope.empty()) {
+                        TS_LOG_ERROR << op.op() << " must set " << name::fused_slope << " for leaky relu" << eject;
+                    }
+                    break;
+                default:
+                    TS_LOG_ERROR << op.op() << " do not support fused activation: " << int(epilogue.activation) << eject;
+                    break;
+            }
+            return epilogue;
+        }
+    }
+}
@@ -20,6 +20,7 @@ namespace ts {
 
             //field(name::quantize_scale, REQUIRED);
             field(name::dequantize_scales, REQUIRED);
+            field(name::requantize_scale, OPTIONAL);
         }
 
         static std::string to_string(const std::valarray<int> &arr) {
@@ -115,6 +116,9 @@ namespace ts {
                 m_dequantize_scales[i] = tensor::cast(FLOAT32, dequantize_scale_tensor).data<float>()[i];
             }
 
+            m_requantize = has(name::requantize_scale);
+            m_requantize_scale = m_requantize ? tensor::to_float(get(name::requantize_scale)) : 1.0f;
+
         }
 
         int Conv2DQuantized::infer(Stack &stack, std::vector<Tensor::Prototype> &output) {
@@ -160,15 +164,16 @@ namespace ts {
 
             Tensor::Prototype out_proto;
 
-            //TO DO:support requantize,so output type can be int8 too.
+            // requantized output keeps int8 for next quantized layer
+            auto out_dtype = m_requantize ? INT8 : FLOAT32;
             if (m_format == FORMAT_NCHW) {
                 out_proto = Tensor::Prototype(
-                    FLOAT32,
+                    out_dtype,
                     { x_tensor.size(0), w_tensor.size(0), y.height, y.width });
             }
             else if (m_format == FORMAT_NHWC) {
                 out_proto = Tensor::Prototype(
-                    FLOAT32,
+                    out_dtype,
                     { x_tensor.size(0), y.height, y.width, w_tensor.size(0) });
             }
 
@@ -210,7 +215,7 @@ namespace ts {
 
                 TS_AUTO_CHECK(stack.size() == 0);
 
-                conv2d(x, padding, m_padding_value, w, stride, dilation, m_format, m_dequantize_scales, out, stack);
+                conv2d(x, padding, m_padding_value, w, stride, dilation, m_format, m_dequantize_scales, m_requantize_scale, out, stack);
 
                 stack.clear();
             }
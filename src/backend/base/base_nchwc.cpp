@@ -0,0 +1,272 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "backend/base/base_nchwc.h"
+
+#include "backend/name.h"
+#include "core/tensor_builder.h"
+
+#include "backend/common_function.h"
+#include "utils/assert.h"
+
+namespace ts {
+    namespace base {
+        static std::vector<int32_t> get_ints(const Operator &op, const std::string &param, size_t size) {
+            auto value = tensor::array::to_int(op.get(param));
+            if (value.size() != size) {
+                TS_LOG_ERROR << op.op() << " must set " << param << " with " << size << " values" << eject;
+            }
+            return value;
+        }
+
+        static int blocks(int channels, int block) {
+            return (channels + block - 1) / block;
+        }
+
+        ToNCHWc::ToNCHWc() {
+            field(name::block, REQUIRED);
+        }
+
+        void ToNCHWc::init() {
+            supper::init();
+
+            m_block = tensor::to_int(get(name::block));
+            TS_AUTO_CHECK(m_block > 0);
+        }
+
+        int ToNCHWc::infer(Stack &stack, std::vector<Tensor::Prototype> &output) {
+            TS_AUTO_CHECK(stack.size() == 1);
+
+            auto &x = stack[0];
+            TS_AUTO_CHECK(x.dims() == 4);
+
+            output.resize(1);
+            output[0] = Tensor::Prototype(x.dtype(),
+                                          {x.size(0), blocks(x.size(1), m_block), x.size(2), x.size(3), m_block});
+            return 1;
+        }
+
+        int ToNCHWc::run(Stack &stack) {
+            std::vector<Tensor::Prototype> output_protos;
+            infer(stack, output_protos);
+
+            auto memory_device = running_memory_device();
+
+            auto x = stack[0].view(memory_device);
+            auto out = *stack.push(output_protos[0], memory_device);
+
+            to_nchwc(x, m_block, out);
+
+            return 1;
+        }
+
+        FromNCHWc::FromNCHWc() {
+            field(name::channels, REQUIRED);
+        }
+
+        void FromNCHWc::init() {
+            supper::init();
+
+            m_channels = tensor::to_int(get(name::channels));
+            TS_AUTO_CHECK(m_channels > 0);
+        }
+
+        int FromNCHWc::infer(Stack &stack, std::vector<Tensor::Prototype> &output) {
+            TS_AUTO_CHECK(stack.size() == 1);
+
+            auto &x = stack[0];
+            TS_AUTO_CHECK(x.dims() == 5);
+            if (blocks(m_channels, x.size(4)) != x.size(1)) {
+                TS_LOG_ERROR << op() << " can not get " << m_channels << " channels from " << x.proto() << eject;
+            }
+
+            output.resize(1);
+            output[0] = Tensor::Prototype(x.dtype(), {x.size(0), m_channels, x.size(2), x.size(3)});
+            return 1;
+        }
+
+        int FromNCHWc::run(Stack &stack) {
+            std::vector<Tensor::Prototype> output_protos;
+            infer(stack, output_protos);
+
+            auto memory_device = running_memory_device();
+
+            auto x = stack[0].view(memory_device);
+            auto out = *stack.push(output_protos[0], memory_device);
+
+            from_nchwc(x, m_channels, out);
+
+            return 1;
+        }
+
+        Conv2DNCHWc::Conv2DNCHWc() {
+            field(name::padding, REQUIRED);
+            field(name::stride, REQUIRED);
+            field(name::dilation, REQUIRED);
+            Conv2DEpilogue::Field(*this);
+        }
+
+        void Conv2DNCHWc::init() {
+            supper::init();
+
+            auto padding = get_ints(*this, name::padding, 4);
+            auto stride = get_ints(*this, name::stride, 2);
+            auto dilation = get_ints(*this, name::dilation, 2);
+            m_padding = Padding2D(padding[0], padding[1], padding[2], padding[3]);
+            m_stride = Stride2D(stride[0], stride[1]);
+            m_dilation = Dilation2D(dilation[0], dilation[1]);
+            m_epilogue = Conv2DEpilogue::Get(*this);
+        }
+
+        int Conv2DNCHWc::infer(Stack &stack, std::vector<Tensor::Prototype> &output) {
+            TS_AUTO_CHECK(stack.size() == 2);
+
+            auto &x = stack[0];
+            auto &w = stack[1];
+
+            TS_AUTO_CHECK(x.dims() == 5);
+            TS_AUTO_CHECK(w.dims() == 6);
+            TS_AUTO_CHECK(x.dtype() == w.dtype());
+
+            auto block = x.size(4);
+            if (w.size(1) != x.size(1) || w.size(4) != block || w.size(5) != block) {
+                TS_LOG_ERROR << op() << " assert failed when x=" << x.proto() << ", w=" << w.proto() << eject;
+            }
+
+            KSize2D ksize(w.size(2), w.size(3));
+            Size2D y = conv2d_forward(Size2D(x.size(2), x.size(3)), m_padding, ksize, m_stride, m_dilation);
+
+            output.resize(1);
+            output[0] = Tensor::Prototype(x.dtype(), {x.size(0), w.size(0), y.height, y.width, block});
+            return 1;
+        }
+
+        int Conv2DNCHWc::run(Stack &stack) {
+            std::vector<Tensor::Prototype> output_protos;
+            infer(stack, output_protos);
+
+            auto memory_device = running_memory_device();
+
+            auto x = stack[0].view(memory_device);
+            auto w = stack[1].view(memory_device);
+            auto out = *stack.push(output_protos[0], memory_device);
+
+            auto channels = w.size(0) * w.size(5);
+            TS_AUTO_CHECK(m_epilogue.bias.empty() || m_epilogue.bias.count() == channels);
+            TS_AUTO_CHECK(m_epilogue.slope.empty() || m_epilogue.slope.count() == 1 || m_epilogue.slope.count() == channels);
+
+            conv2d(x, m_padding, w, m_stride, m_dilation, m_epilogue, out);
+
+            return 1;
+        }
+
+        DepthwiseConv2DNCHWc::DepthwiseConv2DNCHWc() {
+            field(name::padding, REQUIRED);
+            field(name::stride, REQUIRED);
+            field(name::dilation, REQUIRED);
+            Conv2DEpilogue::Field(*this);
+        }
+
+        void DepthwiseConv2DNCHWc::init() {
+            supper::init();
+
+            auto padding = get_ints(*this, name::padding, 4);
+            auto stride = get_ints(*this, name::stride, 2);
+            auto dilation = get_ints(*this, name::dilation, 2);
+            m_padding = Padding2D(padding[0], padding[1], padding[2], padding[3]);
+            m_stride = Stride2D(stride[0], stride[1]);
+            m_dilation = Dilation2D(dilation[0], dilation[1]);
+            m_epilogue = Conv2DEpilogue::Get(*this);
+        }
+
+        int DepthwiseConv2DNCHWc::infer(Stack &stack, std::vector<Tensor::Prototype> &output) {
+            TS_AUTO_CHECK(stack.size() == 2);
+
+            auto &x = stack[0];
+            auto &w = stack[1];
+
+            TS_AUTO_CHECK(x.dims() == 5);
+            TS_AUTO_CHECK(w.dims() == 4);
+            TS_AUTO_CHECK(x.dtype() == w.dtype());
+
+            if (w.size(0) != x.size(1) || w.size(3) != x.size(4)) {
+                TS_LOG_ERROR << op() << " assert failed when x=" << x.proto() << ", w=" << w.proto() << eject;
+            }
+
+            KSize2D ksize(w.size(1), w.size(2));
+            Size2D y = conv2d_forward(Size2D(x.size(2), x.size(3)), m_padding, ksize, m_stride, m_dilation);
+
+            output.resize(1);
+            output[0] = Tensor::Prototype(x.dtype(), {x.size(0), x.size(1), y.height, y.width, x.size(4)});
+            return 1;
+        }
+
+        int DepthwiseConv2DNCHWc::run(Stack &stack) {
+            std::vector<Tensor::Prototype> output_protos;
+            infer(stack, output_protos);
+
+            auto memory_device = running_memory_device();
+
+            auto x = stack[0].view(memory_device);
+            auto w = stack[1].view(memory_device);
+            auto out = *stack.push(output_protos[0], memory_device);
+
+            auto channels = w.size(0) * w.size(3);
+            TS_AUTO_CHECK(m_epilogue.bias.empty() || m_epilogue.bias.count() == channels);
+            TS_AUTO_CHECK(m_epilogue.slope.empty() || m_epilogue.slope.count() == 1 || m_epilogue.slope.count() == channels);
+
+            conv2d(x, m_padding, w, m_stride, m_dilation, m_epilogue, out);
+
+            return 1;
+        }
+
+        Pooling2DNCHWc::Pooling2DNCHWc() {
+            field(name::type, REQUIRED);
+            field(name::padding, REQUIRED);
+            field(name::padding_type, OPTIONAL, tensor::from(int(Padding2DType::BLACK)));
+            field(name::ksize, REQUIRED);
+            field(name::stride, REQUIRED);
+        }
+
+        void Pooling2DNCHWc::init() {
+            supper::init();
+
+            m_type = static_cast<Pooling2DType>(tensor::to_int(get(name::type)));
+            m_padding_type = static_cast<Padding2DType>(tensor::to_int(get(name::padding_type)));
+            auto padding = get_ints(*this, name::padding, 4);
+            auto ksize = get_ints(*this, name::ksize, 2);
+            auto stride = get_ints(*this, name::stride, 2);
+            m_padding = Padding2D(padding[0], padding[1], padding[2], padding[3]);
+            m_ksize = KSize2D(ksize[0], ksize[1]);
+            m_stride = Stride2D(stride[0], stride[1]);
+        }
+
+        int Pooling2DNCHWc::infer(Stack &stack, std::vector<Tensor::Prototype> &output) {
+            TS_AUTO_CHECK(stack.size() == 1);
+
+            auto &x = stack[0];
+            TS_AUTO_CHECK(x.dims() == 5);
+
+            Size2D y = pooling2d_forward(Size2D(x.size(2), x.size(3)), m_padding, m_ksize, m_stride);
+
+            output.resize(1);
+            output[0] = Tensor::Prototype(x.dtype(), {x.size(0), x.size(1), y.height, y.width, x.size(4)});
+            return 1;
+        }
+
+        int Pooling2DNCHWc::run(Stack &stack) {
+            std::vector<Tensor::Prototype> output_protos;
+            infer(stack, output_protos);
+
+            auto memory_device = running_memory_device();
+
+            auto x = stack[0].view(memory_device);
+            auto out = *stack.push(output_protos[0], memory_device);
+
+            pooling2d(x, m_type, m_padding, m_padding_type, m_ksize, m_stride, out);
+
+            return 1;
+        }
+    }
+}
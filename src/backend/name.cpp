@@ -125,6 +125,12 @@ namespace ts {
             const string &proposal() TS_NOEXCEPT { static string str = "proposal"; return str; }
 
             const string &conv2d_winograd_v2() TS_NOEXCEPT { static string str = "conv2d_winograd_v2"; return str; }
+
+            const string &to_nchwc() TS_NOEXCEPT { static string str = "_to_nchwc"; return str; }
+            const string &from_nchwc() TS_NOEXCEPT { static string str = "_from_nchwc"; return str; }
+            const string &conv2d_nchwc() TS_NOEXCEPT { static string str = "_conv2d_nchwc"; return str; }
+            const string &depthwise_conv2d_nchwc() TS_NOEXCEPT { static string str = "_depthwise_conv2d_nchwc"; return str; }
+            const string &pooling2d_nchwc() TS_NOEXCEPT { static string str = "_pooling2d_nchwc"; return str; }
         }
 
         namespace typo {
@@ -205,6 +211,12 @@ namespace ts {
 
         string quantize_scale = "quantize_scale";
         string dequantize_scales = "dequantize_scales";
+        string requantize_scale = "requantize_scale";
+
+        string fused_bias = "fused_bias";
+        string fused_activation = "fused_activation";
+        string fused_max = "fused_max";
+        string fused_slope = "fused_slope";
 
         string dims = "dims";
         string repeats = "repeats";
@@ -212,5 +224,8 @@ namespace ts {
         string transpose = "transpose";
 
         string kernel_winograd_transformed = "kernel_winograd_transformed";
+
+        string block = "block";
+        string channels = "channels";
     }
 }
@@ -9,8 +9,11 @@
 #include <memory>
 #include <cstdio>
 #include <sstream>
+#include <algorithm>
+#include <map>
 
 #include "utils/ctxmgr_lite_support.h"
+#include "utils/log.h"
 
 #if _MSC_VER > 1600
 #define snprintf sprintf_s
@@ -18,6 +21,183 @@
 
 namespace ts {
 
+    Profiler::Profiler()
+            : m_epoch(std::chrono::steady_clock::now()) {
+    }
+
+    int64_t Profiler::now() const {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now() - m_epoch).count();
+    }
+
+    ProfileEvent &Profiler::begin_event(const std::string &op, const std::string &name) {
+        auto id = std::this_thread::get_id();
+        auto thread_it = std::find(m_threads.begin(), m_threads.end(), id);
+        if (thread_it == m_threads.end()) thread_it = m_threads.insert(m_threads.end(), id);
+
+        m_running.push_back(m_events.size());
+        m_events.emplace_back();
+        auto &event = m_events.back();
+        event.op = op;
+        event.name = name;
+        event.thread = int32_t(thread_it - m_threads.begin());
+        event.start = now();
+        return event;
+    }
+
+    ProfileEvent &Profiler::end_event() {
+        if (m_running.empty()) TS_LOG_ERROR << "Profiler has no running event" << eject;
+        auto &event = m_events[m_running.back()];
+        m_running.pop_back();
+        event.duration = now() - event.start;
+        return event;
+    }
+
+    void Profiler::alloc(size_t size) {
+        if (m_running.empty()) return;
+        auto &event = m_events[m_running.back()];
+        event.alloc_bytes += int64_t(size);
+        event.alloc_count += 1;
+    }
+
+    static void write_json_string(std::ostream &out, const std::string &str) {
+        out << '"';
+        for (auto ch : str) {
+            switch (ch) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if (uint8_t(ch) < 0x20) {
+                        char buffer[8];
+                        snprintf(buffer, sizeof(buffer), "\\u%04x", int(uint8_t(ch)));
+                        out << buffer;
+                    } else {
+                        out << ch;
+                    }
+                    break;
+            }
+        }
+        out << '"';
+    }
+
+    static double pool_utilization(int64_t pool_work, int64_t duration, int32_t pool_size) {
+        if (pool_size <= 0 || duration <= 0) return 0;
+        return double(pool_work) / (double(duration) * pool_size);
+    }
+
+    void Profiler::trace(std::ostream &out) const {
+        out << "{\"traceEvents\": [";
+        bool comma = false;
+        int64_t allocated = 0;
+        for (auto &event : m_events) {
+            if (comma) out << ",";
+            comma = true;
+            out << std::endl << "{\"name\": ";
+            write_json_string(out, event.name);
+            out << ", \"cat\": ";
+            write_json_string(out, event.op);
+            out << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << event.thread
+                << ", \"ts\": " << event.start << ", \"dur\": " << event.duration
+                << ", \"args\": {\"op\": ";
+            write_json_string(out, event.op);
+            out << ", \"flops\": " << int64_t(event.flops)
+                << ", \"bytes\": " << event.bytes
+                << ", \"alloc_bytes\": " << event.alloc_bytes
+                << ", \"alloc_count\": " << event.alloc_count
+                << ", \"pool_utilization\": "
+                << pool_utilization(event.pool_work, event.duration, event.pool_size)
+                << "}}";
+            if (event.alloc_count) {
+                allocated += event.alloc_bytes;
+                out << "," << std::endl << "{\"name\": \"allocated\", \"ph\": \"C\", \"pid\": 0"
+                    << ", \"ts\": " << event.start + event.duration
+                    << ", \"args\": {\"bytes\": " << allocated << "}}";
+            }
+        }
+        out << std::endl << "], \"displayTimeUnit\": \"ms\"}" << std::endl;
+    }
+
+    void Profiler::summary(std::ostream &out) const {
+        struct Aggregate {
+            std::string op;
+            int64_t count = 0;
+            int64_t duration = 0;
+            double flops = 0;
+            int64_t bytes = 0;
+            int64_t alloc_bytes = 0;
+            int64_t pool_work = 0;
+            int64_t pool_capacity = 0;
+        };
+        std::vector<Aggregate> table;
+        std::unordered_map<std::string, size_t> index;
+        int64_t total = 0;
+        for (auto &event : m_events) {
+            auto it = index.find(event.op);
+            if (it == index.end()) {
+                it = index.insert(std::make_pair(event.op, table.size())).first;
+                table.emplace_back();
+                table.back().op = event.op;
+            }
+            auto &line = table[it->second];
+            line.count += 1;
+            line.duration += event.duration;
+            line.flops += event.flops;
+            line.bytes += event.bytes;
+            line.alloc_bytes += event.alloc_bytes;
+            line.pool_work += event.pool_work;
+            line.pool_capacity += event.duration * event.pool_size;
+            total += event.duration;
+        }
+        std::sort(table.begin(), table.end(), [](const Aggregate &a, const Aggregate &b) {
+            return a.duration > b.duration;
+        });
+
+        auto flags = out.flags();
+        auto precision = out.precision();
+        out << std::left << std::setw(24) << "op"
+            << std::right << std::setw(8) << "count"
+            << std::setw(12) << "total(ms)"
+            << std::setw(10) << "avg(ms)"
+            << std::setw(8) << "%"
+            << std::setw(10) << "GFLOP/s"
+            << std::setw(10) << "GB/s"
+            << std::setw(12) << "alloc(MB)"
+            << std::setw(8) << "pool%" << std::endl;
+        out << std::fixed;
+        for (auto &line : table) {
+            // flops per microsecond / 1e3 = GFLOP/s
+            auto giga_scale = line.duration > 0 ? double(line.duration) * 1e3 : 0;
+            out << std::left << std::setw(24) << line.op
+                << std::right << std::setw(8) << line.count
+                << std::setprecision(3) << std::setw(12) << line.duration / 1000.0
+                << std::setw(10) << line.duration / 1000.0 / line.count
+                << std::setprecision(1) << std::setw(8) << (total > 0 ? 100.0 * line.duration / total : 0.0)
+                << std::setprecision(2) << std::setw(10) << (giga_scale > 0 ? line.flops / giga_scale : 0.0)
+                << std::setw(10) << (giga_scale > 0 ? line.bytes / giga_scale : 0.0)
+                << std::setw(12) << line.alloc_bytes / (1024.0 * 1024.0)
+                << std::setprecision(1) << std::setw(8)
+                << (line.pool_capacity > 0 ? 100.0 * line.pool_work / line.pool_capacity : 0.0)
+                << std::endl;
+        }
+        out << std::left << std::setw(24) << "total"
+            << std::right << std::setw(8) << m_events.size()
+            << std::setprecision(3) << std::setw(12) << total / 1000.0 << std::endl;
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    void Profiler::folded(std::ostream &out) const {
+        std::map<std::string, int64_t> stacks;
+        for (auto &event : m_events) {
+            stacks[event.op + ";" + event.name] += event.duration;
+        }
+        for (auto &stack : stacks) {
+            out << stack.first << " " << stack.second << std::endl;
+        }
+    }
+
     int32_t Profiler::serial_of(const std::string &name) {
         auto it = this->m_serial.find(name);
         if (it != this->m_serial.end()) return it->second;
@@ -67,6 +247,12 @@ namespace ts {
         return profiler->timer(name);
     }
 
+    void profiler_alloc(size_t size) {
+        auto profiler = ctx::ptr<Profiler>();
+        if (!profiler) return;
+        profiler->alloc(size);
+    }
+
     bool profiler_on() {
         return ctx::ptr<Profiler>() != nullptr;
     }
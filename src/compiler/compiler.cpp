@@ -42,23 +42,107 @@ namespace ts {
             : m_computing_device(computing_device) {
     }
 
-    // TODO: speed this function up
-    static map<Node, set<Node>> build_node_refs(const std::vector<Node> &nodes) {
-        auto computation_schedule = Module::list_reference_nodes(nodes);
+    /**
+     * ancestors of each node, saved in bitsets indexed by topological order
+     */
+    class NodeRefs {
+    public:
+        explicit NodeRefs(const std::vector<Node> &nodes) {
+            // inputs are listed before nodes reading them
+            auto computation_schedule = Module::list_reference_nodes(nodes);
+            auto size = computation_schedule.size();
+            m_words = (size + 63) / 64;
+            m_bits.assign(size * m_words, 0);
+            m_index.reserve(size);
+            for (size_t i = 0; i < size; ++i) {
+                auto &node = computation_schedule[i].first;
+                m_index.insert(std::make_pair(node, i));
+                auto refs = row(i);
+                for (auto &input : node.inputs()) {
+                    auto j = m_index.at(input);
+                    refs[j / 64] |= uint64_t(1) << (j % 64);
+                    // ancestors of j are all before j
+                    auto input_refs = row(j);
+                    for (size_t k = 0; k <= j / 64; ++k) refs[k] |= input_refs[k];
+                }
+            }
+        }
 
-        // build refs
-        map<Node, set<Node>> map_node_refs;
-        for (auto &node : computation_schedule) {
-            set<Node> refs;
-            for (auto &input : node.first.inputs()) {
-                refs.insert(input);
-                auto &input_refs = map_node_refs[input];
-                refs.insert(input_refs.begin(), input_refs.end());
+        /**
+         * @return topological index of node, or npos if not found
+         */
+        size_t index(const Node &node) const {
+            auto it = m_index.find(node);
+            return it == m_index.end() ? size_t(npos) : it->second;
+        }
+
+        /**
+         * @param i index of node
+         * @param j index of ref
+         * @return if node needs ref directly or indirectly
+         */
+        bool refs(size_t i, size_t j) const {
+            if (j >= i || i == npos) return false;
+            return (m_bits[i * m_words + j / 64] >> (j % 64)) & 1;
+        }
+
+        static const size_t npos = size_t(-1);
+
+    private:
+        uint64_t *row(size_t i) { return &m_bits[i * m_words]; }
+
+        map<Node, size_t> m_index;
+        size_t m_words = 0;
+        std::vector<uint64_t> m_bits;
+    };
+
+    /**
+     * build dependency graph of operator instructions
+     * @param inputs program inputs
+     * @param outputs program outputs
+     * @param length number of instructions
+     * @param map_node_instruction_index instruction index of node, in reversed order
+     * @param map_node_data_sagment_index data segment index of const node
+     * @return dataflow, nullptr if any node can not be found
+     */
+    static Dataflow::shared build_dataflow(const std::vector<Node> &inputs, const std::vector<Node> &outputs,
+                                           size_t length,
+                                           const map<Node, size_t> &map_node_instruction_index,
+                                           const map<Node, int> &map_node_data_sagment_index) {
+        auto dataflow = std::make_shared<Dataflow>();
+        map<Node, Dataflow::Value> map_node_value;
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            map_node_value.insert(std::make_pair(inputs[i], Dataflow::Value(Dataflow::Value::ARGUMENT, int(i))));
+        }
+        for (auto &pair : map_node_data_sagment_index) {
+            map_node_value.insert(std::make_pair(pair.first, Dataflow::Value(Dataflow::Value::DATA, pair.second)));
+        }
+
+        auto schedule = Module::list_reference_nodes(outputs);
+        for (auto &item : schedule) {
+            auto &node = item.first;
+            if (map_node_value.find(node) != map_node_value.end()) continue;
+            auto inst_it = map_node_instruction_index.find(node);
+            if (inst_it == map_node_instruction_index.end()) return nullptr;
+            Dataflow::Node flow_node;
+            flow_node.instruction = int(length - 1 - inst_it->second);
+            for (auto &input : node.inputs()) {
+                auto value_it = map_node_value.find(input);
+                if (value_it == map_node_value.end()) return nullptr;
+                flow_node.inputs.push_back(value_it->second);
             }
-            map_node_refs.insert(std::make_pair(node.first, std::move(refs)));
+            map_node_value.insert(std::make_pair(
+                    node, Dataflow::Value(Dataflow::Value::NODE, int(dataflow->nodes.size()))));
+            dataflow->nodes.emplace_back(std::move(flow_node));
+        }
+
+        for (auto &output : outputs) {
+            auto value_it = map_node_value.find(output);
+            if (value_it == map_node_value.end()) return nullptr;
+            dataflow->outputs.push_back(value_it->second);
         }
 
-        return map_node_refs;
+        return dataflow;
     }
 
     std::vector<Instruction::shared> Compiler::convert_operator_instruction(const Node &node) {
@@ -94,20 +178,15 @@ namespace ts {
         return std::move(instructions);
     }
 
-    // TODO: inputs only support Parameter, try support other op
-    InstructionBlock Compiler::compile(const std::vector<Node> &raw_inputs, const std::vector<Node> &raw_outputs,
-            const std::string &options) {
+    std::vector<Node> Compiler::optimize(const std::vector<Node> &raw_outputs, const std::string &options) {
         DeviceContext device_context(m_computing_device);
         ctx::bind<DeviceContext> _bind_device_context(device_context);
 
-        auto inputs = raw_inputs;
         auto outputs = raw_outputs;
 
         // std::cout << "+++++++++++++++++ original graph ++++++++++++++++++++++" << std::endl;
         // plot_graph(std::cout, outputs);
-        Graph temp_graph;
-        ctx::bind<Graph> _bind_graph(temp_graph);
-        
+
         // zip graph
         {
             Zipper zipper(m_computing_device, options);
@@ -126,6 +205,30 @@ namespace ts {
 
         // std::cout << "++++++++++++++++++++++++++++++++++++++++++++++++++++" << std::endl;
 
+        return outputs;
+    }
+
+    // TODO: inputs only support Parameter, try support other op
+    InstructionBlock Compiler::compile(const std::vector<Node> &raw_inputs, const std::vector<Node> &raw_outputs,
+            const std::string &options) {
+        Graph temp_graph;
+        ctx::bind<Graph> _bind_graph(temp_graph);
+
+        auto outputs = optimize(raw_outputs, options);
+
+        return generate(raw_inputs, outputs);
+    }
+
+    InstructionBlock Compiler::generate(const std::vector<Node> &raw_inputs, const std::vector<Node> &raw_outputs) {
+        DeviceContext device_context(m_computing_device);
+        ctx::bind<DeviceContext> _bind_device_context(device_context);
+
+        auto inputs = raw_inputs;
+        auto outputs = raw_outputs;
+
+        Graph temp_graph;
+        ctx::bind<Graph> _bind_graph(temp_graph);
+
         InstructionBlock block;
         block.nargs = int(inputs.size());
         block.nresults = int(outputs.size());
@@ -137,12 +240,16 @@ namespace ts {
 
         // build refs
         // save if compile a node, whose nodes needed directly or indirectly
-        map<Node, set<Node>> map_node_refs = build_node_refs(outputs);
+        NodeRefs node_refs(outputs);
 
         map<Node, int> map_node_data_sagment_index;
+        // operator instruction index(in reversed order) of each node, for building dataflow
+        map<Node, size_t> map_node_instruction_index;
+        bool dataflow_supported = true;
 
         // convert graph to instructions
         std::deque<Node> simulator;
+        std::deque<size_t> simulator_refs_index;    // index in node_refs of each node in simulator
         map<Node, size_t> working_nodes;
         size_t unsolved_node_count = 0;
 
@@ -184,6 +291,7 @@ namespace ts {
                 ++unsolved_node_count;
             }
             simulator.push_back(node);
+            simulator_refs_index.push_back(node_refs.index(node));
         };
 
         /**
@@ -202,6 +310,7 @@ namespace ts {
                 --unsolved_node_count;
             }
             simulator.pop_back();
+            simulator_refs_index.pop_back();
         };
 
         /**
@@ -229,6 +338,7 @@ namespace ts {
 
             simulator[index_i] = nodej;
             simulator[index_j] = nodei;
+            std::swap(simulator_refs_index[index_i], simulator_refs_index[index_j]);
         };
 
         /**
@@ -254,11 +364,10 @@ namespace ts {
          * \note return -1 if failed
          */
         auto simulator_find_last_ref_node_index = [&](Node ref) -> int64_t {
+            auto j = node_refs.index(ref);
             int64_t i = int64_t(simulator.size()) - 1;
             while (i >= 0) {
-                auto &node = simulator[size_t(i)];
-                auto &refs = map_node_refs[node];
-                if (refs.find(ref) != refs.end()) return i;
+                if (node_refs.refs(simulator_refs_index[size_t(i)], j)) return i;
                 --i;
             }
             return -1;
@@ -315,6 +424,12 @@ namespace ts {
 
             // case4: found a node need to be compute. query operator
             auto operator_instructions = convert_operator_instruction(node);
+            if (operator_instructions.size() == 1 &&
+                dynamic_cast<OperatorInstruction *>(operator_instructions[0].get()) != nullptr) {
+                map_node_instruction_index.insert(std::make_pair(node, block.instructions.size()));
+            } else {
+                dataflow_supported = false;
+            }
             for (auto inst_it = operator_instructions.rbegin(); inst_it != operator_instructions.rend(); ++inst_it) {
                 block.instructions.push_back(*inst_it);
             }
@@ -360,6 +475,11 @@ namespace ts {
         // reverse
         std::reverse(block.instructions.begin(), block.instructions.end());
 
+        if (dataflow_supported) {
+            block.dataflow = build_dataflow(inputs, outputs, block.instructions.size(),
+                                            map_node_instruction_index, map_node_data_sagment_index);
+        }
+
         return block;
     }
 
@@ -0,0 +1,280 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "compiler/option/fusion_translator_option.h"
+
+#include <cmath>
+#include <unordered_set>
+
+#include "backend/name.h"
+#include "backend/common_structure.h"
+#include "core/tensor_builder.h"
+#include "module/menu.h"
+
+namespace ts {
+    static const char *const leaky_relu = "leaky_relu";
+
+    static bool is_channel_dim(const Bubble &bubble) {
+        if (bubble.op() == name::layer::add_bias()) {
+            if (bubble.has(name::dim)) return bubble.get_int(name::dim) == 1;
+            return bubble.has(name::format) && bubble.get_string(name::format) == name::NCHW;
+        }
+        return bubble.has(name::dim) && bubble.get_int(name::dim) == 1;
+    }
+
+    static bool is_affine(const Node &node) {
+        auto &bubble = node.bubble();
+        auto &op = bubble.op();
+        if (op != name::layer::add_bias() && op != name::layer::batch_norm() &&
+            op != name::layer::fused_batch_norm() && op != name::layer::batch_scale())
+            return false;
+        return is_channel_dim(bubble);
+    }
+
+    static bool is_activation(const Node &node) {
+        auto &bubble = node.bubble();
+        auto &op = bubble.op();
+        if (op == name::layer::relu() || op == name::layer::relu_max() || op == leaky_relu) return true;
+        if (op == name::layer::prelu()) return is_channel_dim(bubble);
+        return false;
+    }
+
+    /**
+     * @param node const node
+     * @param channels accepted value count, or 1 for scalar when allow_scalar
+     * @param value read value
+     * @return false if node is not const or has wrong size
+     */
+    static bool read_channel_const(const Node &node, int channels, std::vector<float> &value,
+                                   bool allow_scalar = false) {
+        if (node.bubble().op() != Bubble::Const) return false;
+        auto tensor = tensor::cast(FLOAT32, node.bubble().get(name::value));
+        auto count = tensor.count();
+        if (count != channels && !(allow_scalar && count == 1)) return false;
+        value.assign(tensor.data<float>(), tensor.data<float>() + count);
+        return true;
+    }
+
+    /**
+     * y = x * scale + bias, per channel
+     */
+    class ChannelAffine {
+    public:
+        explicit ChannelAffine(int channels)
+                : scale(size_t(channels), 1.0f), bias(size_t(channels), 0.0f) {}
+
+        std::vector<float> scale;
+        std::vector<float> bias;
+
+        /**
+         * apply node on current affine
+         * @return false if node can not be folded
+         */
+        bool fold(const Node &node) {
+            auto &bubble = node.bubble();
+            auto &op = bubble.op();
+            auto channels = int(bias.size());
+            if (op == name::layer::add_bias()) {
+                std::vector<float> b;
+                if (!read_channel_const(node.input(1), channels, b)) return false;
+                for (int c = 0; c < channels; ++c) bias[c] += b[c];
+                return true;
+            }
+            if (op == name::layer::batch_scale()) {
+                std::vector<float> s, b;
+                if (!read_channel_const(node.input(1), channels, s)) return false;
+                if (!read_channel_const(node.input(2), channels, b)) return false;
+                for (int c = 0; c < channels; ++c) {
+                    scale[c] *= s[c];
+                    bias[c] = bias[c] * s[c] + b[c];
+                }
+                return true;
+            }
+            if (op == name::layer::batch_norm() || op == name::layer::fused_batch_norm()) {
+                float epsilon = 1e-5f;
+                if (bubble.has(name::epsilon)) epsilon = bubble.get_float(name::epsilon);
+                std::vector<float> mean, variance;
+                if (!read_channel_const(node.input(1), channels, mean)) return false;
+                if (!read_channel_const(node.input(2), channels, variance)) return false;
+                std::vector<float> s(size_t(channels), 1.0f), b(size_t(channels), 0.0f);
+                if (op == name::layer::fused_batch_norm()) {
+                    if (!read_channel_const(node.input(3), channels, s)) return false;
+                    if (!read_channel_const(node.input(4), channels, b)) return false;
+                }
+                for (int c = 0; c < channels; ++c) {
+                    auto inv = float(1) / std::sqrt(variance[c] + epsilon);
+                    scale[c] *= inv * s[c];
+                    bias[c] = (bias[c] - mean[c]) * inv * s[c] + b[c];
+                }
+                return true;
+            }
+            return false;
+        }
+    };
+
+    /**
+     * walk from top back to conv2d, over activation and affine ops used only by this chain
+     * @param top top node of chain
+     * @param outputs module outputs, which must be kept
+     * @param chain found nodes from top to bottom, ends with conv2d
+     * @return true if found conv2d with at least one fusible node
+     */
+    static bool match_chain(const Node &top, const std::unordered_set<Node> &outputs,
+                            std::vector<Node> &chain) {
+        auto only_used_in_chain = [&](const Node &node) {
+            return node.outputs().size() == 1 && outputs.find(node) == outputs.end();
+        };
+        Node x = top;
+        if (is_activation(x)) {
+            chain.emplace_back(x);
+            x = x.input(0);
+            if (!only_used_in_chain(x)) return false;
+        }
+        while (is_affine(x)) {
+            chain.emplace_back(x);
+            x = x.input(0);
+            if (!only_used_in_chain(x)) return false;
+        }
+        if (chain.empty()) return false;
+
+        auto &bubble = x.bubble();
+        if (bubble.op() != name::layer::conv2d()) return false;
+        if (bubble.has(name::kernel_packed) && bubble.get_bool(name::kernel_packed)) return false;
+        if (bubble.has(name::fused_bias) || bubble.has(name::fused_activation)) return false;
+        if (bubble.has(name::format) && bubble.get_string(name::format) != name::NCHW) return false;
+        auto weight = x.input(1);
+        if (weight.bubble().op() != Bubble::Const) return false;
+        auto weight_tensor = weight.bubble().get(name::value);
+        if (weight_tensor.dtype() != FLOAT32 || weight_tensor.dims() != 4) return false;
+
+        chain.emplace_back(x);
+        return true;
+    }
+
+    /**
+     * build fused conv2d of chain
+     * @param chain from top to bottom, ends with conv2d
+     * @param fused not linked fused conv2d and its folded weight
+     * @return false if chain can not be fused
+     */
+    static bool fuse_chain(const std::vector<Node> &chain, std::vector<Node> &fused) {
+        auto &conv = chain.back();
+        auto weight = conv.input(1);
+        auto weight_tensor = weight.bubble().get(name::value);
+        auto channels = weight_tensor.size(0);
+
+        ChannelAffine affine(channels);
+        bool has_affine = false;
+        FusedActivation activation = FusedActivation::NONE;
+        float max = 0;
+        Tensor slope;
+
+        for (auto it = chain.rbegin() + 1; it != chain.rend(); ++it) {
+            auto &node = *it;
+            if (is_affine(node)) {
+                if (!affine.fold(node)) return false;
+                has_affine = true;
+                continue;
+            }
+            // activation is always the top one
+            auto &bubble = node.bubble();
+            auto &op = bubble.op();
+            if (op == name::layer::relu()) {
+                activation = FusedActivation::RELU;
+            } else if (op == name::layer::relu_max()) {
+                activation = FusedActivation::RELU_MAX;
+                if (bubble.has(name::max)) max = bubble.get_float(name::max);
+            } else if (op == leaky_relu) {
+                activation = FusedActivation::LEAKY_RELU;
+                float scale = 0;
+                if (bubble.has(name::scale)) scale = bubble.get_float(name::scale);
+                slope = tensor::from<float>(scale);
+            } else if (op == name::layer::prelu()) {
+                std::vector<float> value;
+                if (!read_channel_const(node.input(1), channels, value, true)) return false;
+                activation = FusedActivation::LEAKY_RELU;
+                slope = tensor::from<float>(value);
+            } else {
+                return false;
+            }
+        }
+
+        auto fused_weight = bubble::bubble(weight.bubble());
+        if (has_affine) {
+            auto folded = weight_tensor.clone();
+            auto data = folded.data<float>();
+            auto kernel_size = folded.count() / channels;
+            for (int c = 0; c < channels; ++c) {
+                auto s = affine.scale[c];
+                auto w = data + c * kernel_size;
+                for (int i = 0; i < kernel_size; ++i) w[i] *= s;
+            }
+            fused_weight.bubble().set(name::value, folded);
+        }
+
+        auto fused_conv = bubble::bubble(conv.bubble(), chain.front().bubble().name());
+        if (has_affine) {
+            fused_conv.bubble().set(name::fused_bias, tensor::from<float>(affine.bias));
+        }
+        if (activation != FusedActivation::NONE) {
+            fused_conv.bubble().set(name::fused_activation, tensor::from<int32_t>(int32_t(activation)));
+            fused_conv.bubble().set(name::fused_max, tensor::from<float>(max));
+        }
+        if (!slope.empty()) {
+            fused_conv.bubble().set(name::fused_slope, slope);
+        }
+        fused = {fused_conv, fused_weight};
+        return true;
+    }
+
+    static Node fuse_node(const Node &node, std::unordered_map<Node, Node> &ready_map,
+                          const std::unordered_set<Node> &outputs) {
+        auto ready_it = ready_map.find(node);
+        if (ready_it != ready_map.end()) {
+            return ready_it->second;
+        }
+
+        std::vector<Node> chain;
+        std::vector<Node> fused;
+        if (match_chain(node, outputs, chain) && fuse_chain(chain, fused)) {
+            auto x = fuse_node(chain.back().input(0), ready_map, outputs);
+            Node::Link(fused[0], {x, fused[1]});
+            ready_map.insert(std::make_pair(node, fused[0]));
+            return fused[0];
+        }
+
+        auto translated_node = bubble::bubble(node.bubble());
+        std::vector<Node> translated_inputs;
+        for (auto &input : node.inputs()) {
+            translated_inputs.emplace_back(fuse_node(input, ready_map, outputs));
+        }
+        Node::Link(translated_node, translated_inputs);
+
+        ready_map.insert(std::make_pair(node, translated_node));
+        return translated_node;
+    }
+
+    Module::shared Conv2DFusionTranslatorOption::translate(const ComputingDevice &device,
+                                                           Module::shared module) const {
+        if (device.type() != CPU) return module;
+
+        auto &raw_outputs = module->outputs();
+        std::unordered_set<Node> outputs(raw_outputs.begin(), raw_outputs.end());
+
+        std::unordered_map<Node, Node> ready_map;
+        std::vector<Node> fused_outputs;
+        for (auto &output : raw_outputs) {
+            fused_outputs.emplace_back(fuse_node(output, ready_map, outputs));
+        }
+
+        std::vector<std::string> input_names;
+        for (auto &input : module->inputs()) {
+            input_names.emplace_back(input.bubble().name());
+        }
+
+        auto fused_module = Module::Load(ctx::of<Graph>::ref(), fused_outputs);
+        fused_module->sort_inputs(input_names);
+        return fused_module;
+    }
+}
@@ -0,0 +1,76 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "compiler/option/int8_zipper_option.h"
+
+#include "backend/name.h"
+#include "backend/common_structure.h"
+#include "core/tensor_builder.h"
+#include "module/menu.h"
+
+namespace ts {
+    static bool is_max_pooling(const Bubble &bubble) {
+        auto &op = bubble.op();
+        if (op == name::layer::pooling2d()) {
+            return bubble.has(name::type) && bubble.get_int(name::type) == int(Pooling2DType::MAX);
+        }
+        if (op == name::layer::pooling2d_v2()) {
+            return !bubble.has(name::type) || bubble.get_int(name::type) == int(Pooling2DType::MAX);
+        }
+        return false;
+    }
+
+    bool Int8ZipperOption::zip(const ComputingDevice &device, Node node, Node &zipped_node) const {
+        if (device.type() != CPU)
+            return false;
+
+        auto &bubble = node.bubble();
+        if (bubble.op() != name::layer::quantize())
+            return false;
+
+        auto quantize_scale = tensor::array::to_float(bubble.get(name::quantize_scale));
+        if (quantize_scale.size() != 1)
+            return false;
+
+        // walk back over int8 friendly ops, which only used by this chain
+        std::vector<Node> chain;
+        auto x = node.input(0);
+        while (true) {
+            if (x.outputs().size() != 1) return false;
+            auto &x_bubble = x.bubble();
+            if (x_bubble.op() == name::layer::conv2d_quantized()) break;
+            if (x_bubble.op() != name::layer::relu() && !is_max_pooling(x_bubble)) return false;
+            chain.emplace_back(x);
+            x = x.input(0);
+        }
+        if (x.bubble().has(name::requantize_scale))
+            return false;
+
+        auto conv = bubble::bubble(x.bubble());
+        conv.bubble().set(name::requantize_scale, tensor::from<float>(quantize_scale[0]));
+        if (conv.bubble().has(Bubble::RetentionParam::dtype)) {
+            conv.bubble().clear(Bubble::RetentionParam::dtype);
+        }
+        Node::Link(conv, x.inputs());
+
+        Node top = conv;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            auto int8_node = bubble::bubble(it->bubble());
+            if (int8_node.bubble().has(Bubble::RetentionParam::dtype)) {
+                int8_node.bubble().clear(Bubble::RetentionParam::dtype);
+            }
+            auto inputs = it->inputs();
+            inputs[0] = top;
+            Node::Link(int8_node, inputs);
+            top = int8_node;
+        }
+
+        top.bubble().name(bubble.name());
+        zipped_node = top;
+
+        return true;
+    }
+}
+
+TS_REGISTER_ZIPPER_OPTION(ts::Int8ZipperOption)
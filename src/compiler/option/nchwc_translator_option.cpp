@@ -0,0 +1,450 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "compiler/option/nchwc_translator_option.h"
+
+#include <unordered_set>
+
+#include "backend/name.h"
+#include "backend/common_structure.h"
+#include "core/tensor_builder.h"
+#include "module/menu.h"
+#include "kernels/cpu/isa.h"
+
+namespace ts {
+    /**
+     * ops computed on each element, or broadcast on whole tensors, so they work on any layout.
+     * Padded channels of blocked values are zeros, and blocked conv2d reads them,
+     * so only ops keeping zeros as zero are listed, no sigmoid, exp or div (0 / 0 is NaN).
+     */
+    static bool is_layout_free_unary(const std::string &op) {
+        static const std::unordered_set<std::string> ops = {
+                name::layer::relu(), name::layer::relu_max(), name::layer::copy(),
+                name::layer::square(), "tanh", "leaky_relu", "abs",
+        };
+        return ops.find(op) != ops.end();
+    }
+
+    static bool is_layout_free_binary(const std::string &op) {
+        static const std::unordered_set<std::string> ops = {
+                name::layer::add(), name::layer::sub(), name::layer::mul(), name::layer::maximum(),
+        };
+        return ops.find(op) != ops.end();
+    }
+
+    static int blocks(int channels, int block) {
+        return (channels + block - 1) / block;
+    }
+
+    static bool all_of(const std::vector<int32_t> &values, size_t begin, size_t end, int32_t value) {
+        if (values.size() < end) return false;
+        for (auto i = begin; i < end; ++i) {
+            if (values[i] != value) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @return values of given indices, for converting 4-D params of NCHW to 2-D params
+     */
+    static Tensor pick(const std::vector<int32_t> &values, std::initializer_list<size_t> indices) {
+        std::vector<int32_t> picked;
+        for (auto i : indices) picked.push_back(values[i]);
+        return tensor::from<int32_t>(picked);
+    }
+
+    static Tensor pad_channels(const Tensor &value, int channels, int block) {
+        auto padded_channels = blocks(channels, block) * block;
+        auto tensor = tensor::cast(FLOAT32, value);
+        std::vector<float> padded(size_t(padded_channels), 0.0f);
+        std::copy(tensor.data<float>(), tensor.data<float>() + channels, padded.begin());
+        return tensor::from<float>(padded);
+    }
+
+    /**
+     * node value in NCHW or NCHWc layout
+     */
+    class LayoutValue {
+    public:
+        Node node;
+        bool blocked = false;
+        int channels = 0;   ///< number of channels, only for blocked value
+
+        LayoutValue(const Node &node, bool blocked = false, int channels = 0)
+                : node(node), blocked(blocked), channels(channels) {}
+    };
+
+    class NCHWcConverter {
+    public:
+        NCHWcConverter(int block, const std::vector<Node> &outputs)
+                : m_block(block), m_outputs(outputs.begin(), outputs.end()) {}
+
+        /**
+         * @return output of module, always in NCHW
+         */
+        Node output(const Node &node) {
+            return nchw(convert(node), node);
+        }
+
+    private:
+        int m_block;
+        std::unordered_set<Node> m_outputs;
+        std::unordered_map<Node, LayoutValue> m_ready;
+        std::unordered_map<Node, Node> m_nchw;      ///< reorder back of blocked nodes
+        std::unordered_map<Node, Node> m_nchwc;     ///< reorder to blocked of NCHW nodes
+
+        /**
+         * @param value converted value
+         * @param origin original node of value, reorder back node uses its name
+         */
+        Node nchw(const LayoutValue &value, const Node &origin) {
+            if (!value.blocked) return value.node;
+            auto it = m_nchw.find(value.node);
+            if (it != m_nchw.end()) return it->second;
+            auto node = bubble::op(origin.bubble().name(), name::layer::from_nchwc(), {value.node});
+            node.bubble().set(name::channels, tensor::from<int32_t>(value.channels));
+            m_nchw.insert(std::make_pair(value.node, node));
+            return node;
+        }
+
+        Node nchwc(const LayoutValue &value, const Node &origin) {
+            if (value.blocked) return value.node;
+            auto it = m_nchwc.find(value.node);
+            if (it != m_nchwc.end()) return it->second;
+            auto node = bubble::op(origin.bubble().name() + "_nchwc", name::layer::to_nchwc(), {value.node});
+            node.bubble().set(name::block, tensor::from<int32_t>(m_block));
+            m_nchwc.insert(std::make_pair(value.node, node));
+            return node;
+        }
+
+        /**
+         * @return 2-D padding, stride and dilation of NCHW conv2d, or false if not supported
+         */
+        bool conv2d_params(const Bubble &bubble, Tensor &padding, Tensor &stride, Tensor &dilation) {
+            if (!bubble.has(name::format) || bubble.get_string(name::format) != name::NCHW) return false;
+            if (bubble.has(name::kernel_packed) && bubble.get_bool(name::kernel_packed)) return false;
+            if (bubble.has(name::padding_value) && bubble.get_float(name::padding_value) != 0) return false;
+            if (!bubble.has(name::padding) || !bubble.has(name::stride)) return false;
+
+            auto padding4x2 = bubble.get_int_list(name::padding);
+            auto stride4 = bubble.get_int_list(name::stride);
+            std::vector<int32_t> dilation4 = {1, 1, 1, 1};
+            if (bubble.has(name::dilation)) {
+                dilation4 = bubble.get_int_list(name::dilation);
+            } else if (bubble.has(name::typo::dialations)) {
+                dilation4 = bubble.get_int_list(name::typo::dialations);
+            }
+            if (padding4x2.size() != 8 || !all_of(padding4x2, 0, 4, 0)) return false;
+            if (stride4.size() != 4 || !all_of(stride4, 0, 2, 1)) return false;
+            if (dilation4.size() != 4 || !all_of(dilation4, 0, 2, 1)) return false;
+
+            padding = pick(padding4x2, {4, 5, 6, 7});
+            stride = pick(stride4, {2, 3});
+            dilation = pick(dilation4, {2, 3});
+            return true;
+        }
+
+        static bool float_weight(const Node &node, Tensor &weight) {
+            if (node.bubble().op() != Bubble::Const) return false;
+            weight = node.bubble().get(name::value);
+            return weight.dtype() == FLOAT32 && weight.dims() == 4;
+        }
+
+        /**
+         * [OC, IC, KH, KW] to [OC / block, IC / block, KH, KW, block of IC, block of OC]
+         */
+        Tensor pack_conv2d_weight(const Tensor &weight) {
+            auto B = m_block;
+            auto oc = weight.size(0), ic = weight.size(1), kh = weight.size(2), kw = weight.size(3);
+            auto ocb = blocks(oc, B), icb = blocks(ic, B);
+            auto kernel = kh * kw;
+            Tensor packed(FLOAT32, {ocb, icb, kh, kw, B, B});
+            auto src = weight.data<float>();
+            auto dst = packed.data<float>();
+            std::fill(dst, dst + packed.count(), 0.0f);
+            for (int o = 0; o < oc; ++o) {
+                for (int i = 0; i < ic; ++i) {
+                    for (int k = 0; k < kernel; ++k) {
+                        auto index = (((o / B) * icb + i / B) * kernel + k) * B * B + (i % B) * B + o % B;
+                        dst[index] = src[(o * ic + i) * kernel + k];
+                    }
+                }
+            }
+            return packed;
+        }
+
+        /**
+         * [1, C, KH, KW] to [C / block, KH, KW, block]
+         */
+        Tensor pack_depthwise_weight(const Tensor &weight) {
+            auto B = m_block;
+            auto c = weight.size(1), kh = weight.size(2), kw = weight.size(3);
+            auto kernel = kh * kw;
+            Tensor packed(FLOAT32, {blocks(c, B), kh, kw, B});
+            auto src = weight.data<float>();
+            auto dst = packed.data<float>();
+            std::fill(dst, dst + packed.count(), 0.0f);
+            for (int i = 0; i < c; ++i) {
+                for (int k = 0; k < kernel; ++k) {
+                    dst[((i / B) * kernel + k) * B + i % B] = src[i * kernel + k];
+                }
+            }
+            return packed;
+        }
+
+        bool convert_conv2d(const Node &node, const std::vector<LayoutValue> &inputs, LayoutValue &converted) {
+            auto &bubble = node.bubble();
+            Tensor weight, padding, stride, dilation;
+            if (!float_weight(node.input(1), weight)) return false;
+            if (!conv2d_params(bubble, padding, stride, dilation)) return false;
+            auto &x = inputs[0];
+            if (x.blocked && x.channels != weight.size(1)) return false;
+            auto channels = weight.size(0);
+
+            auto w = bubble::data(node.input(1).bubble().name() + "_nchwc", pack_conv2d_weight(weight));
+            auto conv = bubble::op(bubble.name() + "_nchwc", name::layer::conv2d_nchwc(),
+                                   {nchwc(x, node.input(0)), w});
+            conv.bubble().set(name::padding, padding);
+            conv.bubble().set(name::stride, stride);
+            conv.bubble().set(name::dilation, dilation);
+            if (bubble.has(name::fused_bias)) {
+                conv.bubble().set(name::fused_bias, pad_channels(bubble.get(name::fused_bias), channels, m_block));
+            }
+            if (bubble.has(name::fused_activation)) {
+                conv.bubble().set(name::fused_activation, bubble.get(name::fused_activation));
+            }
+            if (bubble.has(name::fused_max)) {
+                conv.bubble().set(name::fused_max, bubble.get(name::fused_max));
+            }
+            if (bubble.has(name::fused_slope)) {
+                auto slope = bubble.get(name::fused_slope);
+                if (slope.count() != 1) slope = pad_channels(slope, channels, m_block);
+                conv.bubble().set(name::fused_slope, slope);
+            }
+            converted = LayoutValue(conv, true, channels);
+            return true;
+        }
+
+        bool convert_depthwise_conv2d(const Node &node, const std::vector<LayoutValue> &inputs,
+                                      LayoutValue &converted) {
+            auto &bubble = node.bubble();
+            Tensor weight, padding, stride, dilation;
+            if (!float_weight(node.input(1), weight) || weight.size(0) != 1) return false;
+            if (!conv2d_params(bubble, padding, stride, dilation)) return false;
+            if (bubble.has(name::fused_bias) || bubble.has(name::fused_activation)) return false;
+            auto &x = inputs[0];
+            auto channels = weight.size(1);
+            if (x.blocked && x.channels != channels) return false;
+
+            auto w = bubble::data(node.input(1).bubble().name() + "_nchwc", pack_depthwise_weight(weight));
+            auto conv = bubble::op(bubble.name() + "_nchwc", name::layer::depthwise_conv2d_nchwc(),
+                                   {nchwc(x, node.input(0)), w});
+            conv.bubble().set(name::padding, padding);
+            conv.bubble().set(name::stride, stride);
+            conv.bubble().set(name::dilation, dilation);
+            converted = LayoutValue(conv, true, channels);
+            return true;
+        }
+
+        bool convert_pooling2d(const Node &node, const std::vector<LayoutValue> &inputs, LayoutValue &converted) {
+            auto &bubble = node.bubble();
+            auto &x = inputs[0];
+            if (!x.blocked) return false;
+            if (!bubble.has(name::format) || bubble.get_string(name::format) != name::NCHW) return false;
+            if (!bubble.has(name::type) || !bubble.has(name::padding) ||
+                !bubble.has(name::ksize) || !bubble.has(name::stride)) return false;
+            auto type = Pooling2DType(bubble.get_int(name::type));
+            if (type != Pooling2DType::MAX && type != Pooling2DType::AVG) return false;
+            auto padding_type = Padding2DType::BLACK;
+            if (bubble.has(name::padding_type)) padding_type = Padding2DType(bubble.get_int(name::padding_type));
+            if (padding_type != Padding2DType::BLACK && padding_type != Padding2DType::WHITE) return false;
+
+            auto padding4x2 = bubble.get_int_list(name::padding);
+            auto ksize4 = bubble.get_int_list(name::ksize);
+            auto stride4 = bubble.get_int_list(name::stride);
+            if (padding4x2.size() != 8 || !all_of(padding4x2, 0, 4, 0)) return false;
+            if (ksize4.size() != 4 || !all_of(ksize4, 0, 2, 1)) return false;
+            if (stride4.size() != 4 || !all_of(stride4, 0, 2, 1)) return false;
+
+            auto pooling = bubble::op(bubble.name() + "_nchwc", name::layer::pooling2d_nchwc(), {x.node});
+            pooling.bubble().set(name::type, tensor::from<int32_t>(int32_t(type)));
+            pooling.bubble().set(name::padding_type, tensor::from<int32_t>(int32_t(padding_type)));
+            pooling.bubble().set(name::padding, pick(padding4x2, {4, 5, 6, 7}));
+            pooling.bubble().set(name::ksize, pick(ksize4, {2, 3}));
+            pooling.bubble().set(name::stride, pick(stride4, {2, 3}));
+            converted = LayoutValue(pooling, true, x.channels);
+            return true;
+        }
+
+        /**
+         * @param node add_bias or activation on blocked conv2d
+         * @return true if its epilogue can be fused into blocked conv2d of input
+         */
+        bool fusible(const Node &node, const LayoutValue &x) {
+            if (!x.blocked) return false;
+            auto &op = x.node.bubble().op();
+            if (op != name::layer::conv2d_nchwc() && op != name::layer::depthwise_conv2d_nchwc()) return false;
+            if (x.node.bubble().has(name::fused_activation)) return false;
+            auto input = node.input(0);
+            return input.outputs().size() == 1 && m_outputs.find(input) == m_outputs.end();
+        }
+
+        bool fuse_activation(const Node &node, const LayoutValue &x, LayoutValue &converted) {
+            if (!fusible(node, x)) return false;
+            auto &bubble = node.bubble();
+            auto &op = bubble.op();
+            // blocked conv2d is created by this pass, so update it in place
+            auto conv = x.node;
+            if (op == name::layer::relu()) {
+                conv.bubble().set(name::fused_activation, tensor::from<int32_t>(int32_t(FusedActivation::RELU)));
+            } else if (op == name::layer::relu_max()) {
+                float max = 0;
+                if (bubble.has(name::max)) max = bubble.get_float(name::max);
+                conv.bubble().set(name::fused_activation, tensor::from<int32_t>(int32_t(FusedActivation::RELU_MAX)));
+                conv.bubble().set(name::fused_max, tensor::from<float>(max));
+            } else {
+                return false;
+            }
+            converted = x;
+            return true;
+        }
+
+        bool convert_add_bias(const Node &node, const std::vector<LayoutValue> &inputs, LayoutValue &converted) {
+            auto &bubble = node.bubble();
+            auto &x = inputs[0];
+            if (!x.blocked) return false;
+            bool channel_dim = bubble.has(name::dim) ? bubble.get_int(name::dim) == 1
+                                                     : bubble.has(name::format) &&
+                                                       bubble.get_string(name::format) == name::NCHW;
+            if (!channel_dim) return false;
+            auto bias = node.input(1);
+            if (bias.bubble().op() != Bubble::Const) return false;
+            auto value = bias.bubble().get(name::value);
+            if (value.count() != x.channels || value.dtype() != FLOAT32) return false;
+
+            // add_bias on blocked channels is a broadcast add of [1, C / block, 1, 1, block]
+            auto padded = pad_channels(value, x.channels, m_block);
+            if (fusible(node, x) && !x.node.bubble().has(name::fused_bias)) {
+                auto conv = x.node;
+                conv.bubble().set(name::fused_bias, padded);
+                converted = x;
+                return true;
+            }
+            padded = padded.reshape({1, blocks(x.channels, m_block), 1, 1, m_block});
+            auto b = bubble::data(bias.bubble().name() + "_nchwc", padded);
+            auto add = bubble::op(bubble.name() + "_nchwc", name::layer::add(), {x.node, b});
+            converted = LayoutValue(add, true, x.channels);
+            return true;
+        }
+
+        bool convert_concat(const Node &node, const std::vector<LayoutValue> &inputs, LayoutValue &converted) {
+            auto &bubble = node.bubble();
+            if (!bubble.has(name::dim) || bubble.get_int(name::dim) != 1) return false;
+            int channels = 0;
+            std::vector<Node> blocked_inputs;
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                auto &x = inputs[i];
+                if (!x.blocked) return false;
+                // padded channels can only be at the end
+                if (i + 1 < inputs.size() && x.channels % m_block != 0) return false;
+                channels += x.channels;
+                blocked_inputs.emplace_back(x.node);
+            }
+            auto concat = bubble::bubble(bubble, bubble.name() + "_nchwc");
+            Node::Link(concat, blocked_inputs);
+            converted = LayoutValue(concat, true, channels);
+            return true;
+        }
+
+        bool convert_element_wise(const Node &node, const std::vector<LayoutValue> &inputs, LayoutValue &converted) {
+            auto &op = node.bubble().op();
+            if (is_layout_free_unary(op)) {
+                if (inputs.size() != 1 || !inputs[0].blocked) return false;
+            } else if (is_layout_free_binary(op)) {
+                if (inputs.size() != 2 || !inputs[0].blocked || !inputs[1].blocked) return false;
+                if (inputs[0].channels != inputs[1].channels) return false;
+            } else {
+                return false;
+            }
+            auto element_wise = bubble::bubble(node.bubble(), node.bubble().name() + "_nchwc");
+            std::vector<Node> blocked_inputs;
+            for (auto &x : inputs) blocked_inputs.emplace_back(x.node);
+            Node::Link(element_wise, blocked_inputs);
+            converted = LayoutValue(element_wise, true, inputs[0].channels);
+            return true;
+        }
+
+        LayoutValue convert(const Node &node) {
+            auto ready_it = m_ready.find(node);
+            if (ready_it != m_ready.end()) return ready_it->second;
+
+            std::vector<LayoutValue> inputs;
+            for (auto &input : node.inputs()) {
+                inputs.emplace_back(convert(input));
+            }
+
+            auto &op = node.bubble().op();
+            LayoutValue converted(node);
+            bool done = false;
+            if (op == name::layer::conv2d()) {
+                done = convert_conv2d(node, inputs, converted);
+            } else if (op == name::layer::depthwise_conv2d()) {
+                done = convert_depthwise_conv2d(node, inputs, converted);
+            } else if (op == name::layer::pooling2d()) {
+                done = convert_pooling2d(node, inputs, converted);
+            } else if (op == name::layer::add_bias()) {
+                done = convert_add_bias(node, inputs, converted);
+            } else if (op == name::layer::concat()) {
+                done = convert_concat(node, inputs, converted);
+            } else if (op == name::layer::relu() || op == name::layer::relu_max()) {
+                done = fuse_activation(node, inputs[0], converted) ||
+                       convert_element_wise(node, inputs, converted);
+            } else if (!inputs.empty()) {
+                done = convert_element_wise(node, inputs, converted);
+            }
+
+            if (!done) {
+                auto translated = bubble::bubble(node.bubble());
+                std::vector<Node> nchw_inputs;
+                for (size_t i = 0; i < inputs.size(); ++i) {
+                    nchw_inputs.emplace_back(nchw(inputs[i], node.input(i)));
+                }
+                Node::Link(translated, nchw_inputs);
+                converted = LayoutValue(translated);
+            }
+
+            m_ready.insert(std::make_pair(node, converted));
+            return converted;
+        }
+    };
+
+    NCHWcTranslatorOption::NCHWcTranslatorOption(int block)
+            : m_block(block) {
+    }
+
+    int NCHWcTranslatorOption::Block() {
+        return cpu::cpu_isa() == cpu::ISA::GENERIC ? 4 : 8;
+    }
+
+    Module::shared NCHWcTranslatorOption::translate(const ComputingDevice &device, Module::shared module) const {
+        if (device.type() != CPU) return module;
+
+        auto &raw_outputs = module->outputs();
+        NCHWcConverter converter(m_block, raw_outputs);
+
+        std::vector<Node> converted_outputs;
+        for (auto &output : raw_outputs) {
+            converted_outputs.emplace_back(converter.output(output));
+        }
+
+        std::vector<std::string> input_names;
+        for (auto &input : module->inputs()) {
+            input_names.emplace_back(input.bubble().name());
+        }
+
+        auto converted_module = Module::Load(ctx::of<Graph>::ref(), converted_outputs);
+        converted_module->sort_inputs(input_names);
+        return converted_module;
+    }
+}
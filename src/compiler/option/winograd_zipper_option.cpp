@@ -26,6 +26,9 @@ namespace ts {
         auto format = tensor::to_string(format_tensor);
         if(format != name::NCHW)
             return false;
+        // winograd has no gemm epilogue, keep fused conv2d
+        if (bubble.has(name::fused_bias) || bubble.has(name::fused_activation))
+            return false;
         auto stride_tensor = tensor::cast(INT32, bubble.get(name::stride));
 
         std::valarray<int> dilation4;
@@ -8,6 +8,8 @@
 
 #include "compiler/option/fp16_translator_option.h"
 #include "compiler/option/pack_translator_option.h"
+#include "compiler/option/nchwc_translator_option.h"
+#include "compiler/option/fusion_translator_option.h"
 
 #include "module/menu.h"
 
@@ -70,6 +72,9 @@ namespace ts {
         for (auto &option : options_v2) {
             new_module = option->translate(m_device, new_module);
         }
+        for (auto &option : m_options_v2) {
+            new_module = option->translate(m_device, new_module);
+        }
 
         auto options = GetFullTranslateOptions();
         for (auto &option : m_options) {
@@ -91,7 +96,16 @@ namespace ts {
         //std::cout << "+++++++++++++++++ translated graph ++++++++++++++++++++++" << std::endl;
         //plot_graph(std::cout, traslated_nodes);
 
+        // Module::Load walks inputs in no order, keep the order of original module
+        std::vector<Node> translated_inputs;
+        for (auto &input : new_module->inputs()) {
+            auto ready_it = ready_map.find(input);
+            if (ready_it == ready_map.end()) continue;
+            translated_inputs.emplace_back(ready_it->second);
+        }
+
         new_module = Module::Load(temp_graph, traslated_nodes);
+        new_module->sort_inputs(translated_inputs);
         return new_module;
     }
 
@@ -101,11 +115,21 @@ namespace ts {
         ArgParser parser;
         parser.add({"--float16", "-fp16"}, {"--no-float16", "-no-fp16"}, false);
         parser.add({ "--pack" }, {"--no-pack"}, true);
+        parser.add({"--nchwc"}, {"--no-nchwc"}, false);
+        parser.add({"--fusion"}, {"--no-fusion"}, true);
         parser.parse(params);
         if (parser.get("--float16")) {
              TS_LOG_STATUS << "Compiling with --float16";
             m_options.push_back(new Fp16TranslatorOption);
         }
+        // fuse before NCHWc, so fused conv2d can be blocked
+        if (parser.get("--fusion")) {
+            m_options_v2.push_back(new Conv2DFusionTranslatorOption);
+        }
+        if (parser.get("--nchwc") && !parser.get("--float16")) {
+            TS_LOG_STATUS << "Compiling with --nchwc";
+            m_options_v2.push_back(new NCHWcTranslatorOption(NCHWcTranslatorOption::Block()));
+        }
 #ifndef TS_USE_CBLAS
         if (parser.get("--pack")) {
             TS_LOG_STATUS << "Compiling with --pack";
@@ -119,5 +143,9 @@ namespace ts {
             delete option;
         }
         m_options.clear();
+        for (auto &option : m_options_v2) {
+            delete option;
+        }
+        m_options_v2.clear();
     }
 }
\ No newline at end of file
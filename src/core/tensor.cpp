@@ -16,6 +16,7 @@
 #include <core/device_context.h>
 #include <runtime/runtime.h>
 #include <runtime/workbench.h>
+#include "module/blob.h"
 
 namespace ts {
     struct EmptyMemoryKeeper {
@@ -311,26 +312,42 @@ namespace ts {
         }
     }
 
+    /**
+     * mark in dtype byte, means tensor memory saved in blobs, see BlobWriter
+     */
+    static const uint8_t BLOB_DTYPE_FLAG = 0x80;
+
     static size_t serialize_prototype_memory(StreamWriter &stream,
                                              const Tensor::Prototype &proto, const Memory &memory) {
         size_t writen_size = 0;
+        Memory cpu_memory;
+        if (memory.device().type() == ts::CPU) {
+            cpu_memory = memory;
+        } else {
+            cpu_memory = Memory(memory.size());
+            memcpy(cpu_memory, memory);
+        }
+        // 0. try save memory in blobs
+        auto memory_size = size_t(proto.count()) * proto.type_bytes();
+        int64_t blob_offset = -1;
+        auto blobs = ctx::get<BlobWriter>();
+        if (blobs != nullptr) {
+            blob_offset = blobs->write(cpu_memory);
+        }
         // 1. write prototype
         // 1.1 write dtype
-        writen_size += binio::write<uint8_t>(stream, proto.dtype());
+        writen_size += binio::write<uint8_t>(stream, uint8_t(blob_offset < 0 ? proto.dtype() : proto.dtype() | BLOB_DTYPE_FLAG));
         // 1.2 write size
         writen_size += binio::write<uint32_t>(stream, uint32_t(proto.sizes().size()));
         for (auto &size : proto.sizes()) {
             writen_size += binio::write<uint32_t>(stream, uint32_t(size));
         }
-        Memory cpu_memory;
-        if (memory.device().type() == ts::CPU) {
-            cpu_memory = memory;
+        // 2. write memory, or offset in blobs
+        if (blob_offset < 0) {
+            writen_size += binio::write<char>(stream, cpu_memory.data<char>(), memory_size);
         } else {
-            cpu_memory = Memory(memory.size());
-            memcpy(cpu_memory, memory);
+            writen_size += binio::write<uint64_t>(stream, uint64_t(blob_offset));
         }
-        // 2. write memory
-        writen_size += binio::write<char>(stream, cpu_memory.data<char>(), size_t(proto.count()) * proto.type_bytes());
         return writen_size;
     }
 
@@ -345,7 +362,8 @@ namespace ts {
         // 1.1 read dtype
         uint8_t dtype_buffer;
         read_size += binio::read<uint8_t >(stream, dtype_buffer);
-        dtype = DTYPE(dtype_buffer);
+        bool in_blobs = (dtype_buffer & BLOB_DTYPE_FLAG) != 0;
+        dtype = DTYPE(dtype_buffer & ~BLOB_DTYPE_FLAG);
         TS_AUTO_CHECK(dtype >= 0);
         // 1.2 read sizes
         uint32_t size_buffer;
@@ -359,6 +377,16 @@ namespace ts {
         proto = Tensor::Prototype(dtype, shape);
 
         // 2. read memory
+        if (in_blobs) {
+            auto blobs = ctx::get<BlobReader>();
+            if (blobs == nullptr) {
+                TS_LOG_ERROR << "Can not read tensor saved in blobs, without BlobReader bound" << eject;
+            }
+            uint64_t blob_offset = 0;
+            read_size += binio::read<uint64_t>(stream, blob_offset);
+            memory = blobs->read(blob_offset, size_t(proto.count()) * proto.type_bytes());
+            return read_size;
+        }
         memory = controller->alloc(size_t(proto.count()) * proto.type_bytes());
         read_size += binio::read<char>(stream, memory.data<char>(), memory.size());
         return read_size;
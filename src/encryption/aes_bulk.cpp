@@ -0,0 +1,61 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "aes_bulk.h"
+
+#include "utils/cpu_info.h"
+#include "runtime/inside/parallel.h"
+
+#include <algorithm>
+
+namespace ts {
+    namespace aes {
+        static const int ROUNDS = AES_keyExpSize / AES_BLOCKLEN - 1;
+
+        /**
+         * blocks of one parallel part, smaller buffers are not worth a thread
+         */
+        static const size_t THREAD_BLOCKS = (size_t(1) << 20) / AES_BLOCKLEN;
+
+        static bool detect_aesni() {
+#if defined(TS_USE_CPU_DISPATCH) && TS_PLATFORM_IS_X86
+            return check_cpu_feature(AES) && check_cpu_feature(SSE2);
+#else
+            return false;
+#endif
+        }
+
+        bool use_aesni() {
+            static const bool aesni = detect_aesni();
+            return aesni;
+        }
+
+        void ecb_decrypt_blocks(const AES_ctx &ctx, uint8_t *buf, size_t blocks) {
+#if defined(TS_USE_CPU_DISPATCH) && TS_PLATFORM_IS_X86
+            if (use_aesni()) {
+                x86::ecb_decrypt_aesni(ctx.RoundKey, ROUNDS, buf, blocks);
+                return;
+            }
+#endif
+            // AES_ECB_decrypt only reads ctx, copy it to keep ctx const
+            auto local = ctx;
+            for (size_t i = 0; i < blocks; ++i) {
+                AES_ECB_decrypt(&local, buf + i * AES_BLOCKLEN);
+            }
+        }
+
+        void ecb_decrypt(const AES_ctx &ctx, uint8_t *buf, size_t blocks) {
+            auto parts = int((blocks + THREAD_BLOCKS - 1) / THREAD_BLOCKS);
+            if (parts <= 1) {
+                ecb_decrypt_blocks(ctx, buf, blocks);
+                return;
+            }
+            TS_PARALLEL_RANGE_BEGIN(range, 0, parts)
+                auto begin = size_t(range.first) * THREAD_BLOCKS;
+                auto end = std::min(blocks, size_t(range.second) * THREAD_BLOCKS);
+                ecb_decrypt_blocks(ctx, buf + begin * AES_BLOCKLEN, end - begin);
+            TS_PARALLEL_RANGE_END()
+        }
+    }
+}
@@ -0,0 +1,50 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_ENCRYPTION_AES_BULK_H
+#define TENSORSTACK_ENCRYPTION_AES_BULK_H
+
+#include <cstddef>
+#include <stdint.h>
+
+#include "aes.h"
+
+namespace ts {
+    namespace aes {
+        /**
+         * @return if AES-NI is built and supported by this cpu
+         */
+        bool use_aesni();
+
+        /**
+         * decrypt ECB blocks in place on calling thread, with AES-NI if supported
+         * @param ctx key expanded by AES_init_ctx
+         * @param buf blocks * AES_BLOCKLEN bytes
+         * @param blocks number of blocks
+         */
+        void ecb_decrypt_blocks(const AES_ctx &ctx, uint8_t *buf, size_t blocks);
+
+        /**
+         * decrypt ECB blocks in place, large buffers are split over context ThreadPool, as ECB blocks are independent
+         * @note serial if no ThreadPool bound or TS_DISABLE_PARALLEL defined, see parallel_budget
+         * @param ctx key expanded by AES_init_ctx
+         * @param buf blocks * AES_BLOCKLEN bytes
+         * @param blocks number of blocks
+         */
+        void ecb_decrypt(const AES_ctx &ctx, uint8_t *buf, size_t blocks);
+
+        namespace x86 {
+            /**
+             * built with AES-NI, only call it if cpu supports AES
+             * @param round_keys (rounds + 1) * AES_BLOCKLEN bytes, expanded encryption keys
+             * @param rounds number of rounds
+             * @param buf blocks * AES_BLOCKLEN bytes
+             * @param blocks number of blocks
+             */
+            void ecb_decrypt_aesni(const uint8_t *round_keys, int rounds, uint8_t *buf, size_t blocks);
+        }
+    }
+}
+
+#endif //TENSORSTACK_ENCRYPTION_AES_BULK_H
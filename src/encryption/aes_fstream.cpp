@@ -4,7 +4,9 @@
 
 #include <module/io/fstream.h>
 #include "aes_fstream.h"
+#include "aes_bulk.h"
 #include <string.h>
+#include <algorithm>
 #include <utils/assert.h>
 #include <utils/log.h>
 
@@ -13,104 +15,75 @@ namespace ts {
         return m_stream.is_open();
     }
 
-    size_t AESFileStreamReader::read(void *buffer, size_t size) {
-        if(m_master_datalen - m_master_offset >= size) {
-            memcpy(buffer, m_master + m_master_offset, size);
-            m_master_offset += int(size);
-            return size; 
-        }
+    /**
+     * encrypted bytes read and decrypted at once
+     */
+    static const size_t AES_CHUNK = size_t(4) << 20;
 
-        bool iseof = false;
-        int buffer_offset= 0;
-        if(m_master_datalen - m_master_offset > 0) {
-            memcpy(buffer, m_master + m_master_offset, m_master_datalen - m_master_offset);
-            buffer_offset = m_master_datalen - m_master_offset;
-            m_master_offset = 0;
-            m_master_datalen = 0;
+    void AESFileStreamReader::load(uint8_t *buffer, size_t blocks) {
+        auto size = blocks * AES_BLOCKLEN;
+        m_stream.read(reinterpret_cast<char *>(buffer), size);
+        if (size_t(m_stream.gcount()) != size) {
+            TS_LOG_ERROR << "mode file read format is error!" << eject;
         }
+        m_remaining -= size;
+        aes::ecb_decrypt(m_ctx, buffer, blocks);
+    }
 
-        if(m_stream.eof()) {
-            if(buffer_offset > 0) {
-                return size_t(buffer_offset);
-            }else
-            {
-                TS_LOG_ERROR << "mode file is eof!" << eject;
-                return 0;
-            }
+    void AESFileStreamReader::refill() {
+        if (m_remaining < AES_BLOCKLEN) {
+            TS_LOG_ERROR << "mode file read format is error!" << eject;
         }
- 
-        while(buffer_offset < size) {    
-            if(m_second_datalen == 0 ) {
-                m_stream.read(reinterpret_cast<char *>(m_second), AES_BLOCKLEN);
-                m_second_datalen = int(m_stream.gcount());
-                if(m_second_datalen == 0 ) {
-                    if(m_stream.eof()) {
-                        break;
-                    }else {
-                        TS_LOG_ERROR << "mode file read format is error!" << eject;
-                        return 0;
-                    }
-                }else {
-                    if(m_second_datalen != AES_BLOCKLEN) {
-                        TS_LOG_ERROR << "mode file read format is error!" << eject;
-                        return 0;
-                    }
-                    AES_ECB_decrypt(&m_ctx, m_second);  
-                }
+        auto blocks = size_t(std::min<uint64_t>(AES_CHUNK, m_remaining) / AES_BLOCKLEN);
+        if (m_buffer.size() < blocks * AES_BLOCKLEN) m_buffer.resize(blocks * AES_BLOCKLEN);
+        load(m_buffer.data(), blocks);
+        m_offset = 0;
+        m_size = blocks * AES_BLOCKLEN;
+        if (m_remaining == 0) {
+            // last block is padded with the number of padding bytes
+            auto padding = size_t(m_buffer[m_size - 1]);
+            if (padding == 0 || padding > AES_BLOCKLEN) {
+                TS_LOG_ERROR << "mode file read format is error!" << eject;
             }
+            m_size -= padding;
+        }
+    }
 
-            memcpy(m_master, m_second, AES_BLOCKLEN);
-            m_master_datalen = AES_BLOCKLEN;
-            m_master_offset = 0;
-
-            m_second_datalen = 0; 
-            m_stream.read(reinterpret_cast<char *>(m_second), AES_BLOCKLEN);
-            m_second_datalen = int(m_stream.gcount());
-            if(m_second_datalen == 0 ) {
-                if(m_stream.eof()) {
-                    iseof = true;
-                }else {
-                    TS_LOG_ERROR << "mode file read format is error!" << eject;
-                    return 0;
-                }
-            }else {
-                if(m_second_datalen != AES_BLOCKLEN) {
-                    TS_LOG_ERROR << "mode file read format is error!" << eject;
-                    return 0;
-                }
-                AES_ECB_decrypt(&m_ctx, m_second);  
+    size_t AESFileStreamReader::read(void *buffer, size_t size) {
+        auto out = reinterpret_cast<uint8_t *>(buffer);
+        size_t copied = 0;
+        while (copied < size) {
+            if (m_offset < m_size) {
+                auto count = std::min(size - copied, m_size - m_offset);
+                memcpy(out + copied, m_buffer.data() + m_offset, count);
+                m_offset += count;
+                copied += count;
+                continue;
             }
- 
-            if(iseof) {
-                m_master_datalen -= (int)(m_master[AES_BLOCKLEN - 1]); 
-            } 
-
-            
-            if(buffer_offset + m_master_datalen >= size) {
-                memcpy(reinterpret_cast<char*>(buffer) + buffer_offset, m_master, size - buffer_offset);
-                m_master_offset = int(size) - buffer_offset;
-                buffer_offset += m_master_offset;
-                break;
-            }else {
-                memcpy(reinterpret_cast<char*>(buffer) + buffer_offset, m_master, m_master_datalen);
-                buffer_offset += m_master_datalen;
-                m_master_offset = 0;
-                m_master_datalen = 0;
-            } 
-
-            if(iseof){
-                break;
+            if (m_remaining == 0) break;
+            // large reads are decrypted in caller's buffer, the last block is kept for removing padding
+            auto direct = size_t(std::min<uint64_t>((size - copied) / AES_BLOCKLEN,
+                                                    (m_remaining - 1) / AES_BLOCKLEN));
+            if (direct * AES_BLOCKLEN >= AES_CHUNK) {
+                load(out + copied, direct);
+                copied += direct * AES_BLOCKLEN;
+                continue;
             }
+            refill();
         }
-        
-        return size_t(buffer_offset);
+        if (copied == 0 && size > 0) {
+            TS_LOG_ERROR << "mode file is eof!" << eject;
+        }
+        return copied;
     }
 
     AESFileStreamReader::AESFileStreamReader(const std::string &path, const std::string &key)
             : m_stream(path, std::ios::binary) {
-         m_master_offset = 0;
-         m_master_datalen = 0;
-         m_second_datalen = 0;
+        if (m_stream.is_open()) {
+            m_stream.seekg(0, std::ios::end);
+            m_remaining = uint64_t(m_stream.tellg());
+            m_stream.seekg(0, std::ios::beg);
+        }
 
         if (key.length() > AES_KEYLEN) {
             TS_LOG_ERROR << "Using key over " << AES_KEYLEN << " will be ignored.";
@@ -41,14 +41,23 @@ namespace ts {
         const std_stream &stream() const { return m_stream; }
 
     private:
-        std_stream m_stream;
-        uint8_t m_master[AES_BLOCKLEN];
-        uint8_t m_second[AES_BLOCKLEN];
+        /**
+         * read and decrypt blocks from file
+         * @param buffer blocks * AES_BLOCKLEN bytes
+         * @param blocks number of blocks
+         */
+        void load(uint8_t *buffer, size_t blocks);
+
+        /**
+         * decrypt next chunk into m_buffer, padding removed at the end of file
+         */
+        void refill();
 
-        int        m_master_datalen;
-        int        m_master_offset;
-
-        int        m_second_datalen;
+        std_stream m_stream;
+        std::vector<uint8_t> m_buffer;  ///< decrypted data
+        size_t m_offset = 0;            ///< read offset in m_buffer
+        size_t m_size = 0;              ///< decrypted size in m_buffer
+        uint64_t m_remaining = 0;       ///< encrypted bytes not read from file
         struct AES_ctx m_ctx;
     };
 
@@ -0,0 +1,58 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+// Only this file is built with AES-NI, see ts_add_source_instruction_support.
+// Do not include headers with inline code here, the linker may keep the AES-NI copy for the whole library.
+
+#include "../aes_bulk.h"
+#include "utils/platform.h"
+
+#if defined(TS_USE_CPU_DISPATCH) && TS_PLATFORM_IS_X86
+
+#include <wmmintrin.h>
+
+namespace ts {
+    namespace aes {
+        namespace x86 {
+            static const int MAX_ROUNDS = 14;
+
+            /**
+             * interleave blocks, so aesdec latency of one block is hidden by others
+             */
+            static inline void decrypt8(const __m128i *keys, int rounds, uint8_t *buf) {
+                __m128i *p = reinterpret_cast<__m128i *>(buf);
+                __m128i x[8];
+                for (int i = 0; i < 8; ++i) x[i] = _mm_xor_si128(_mm_loadu_si128(p + i), keys[0]);
+                for (int r = 1; r < rounds; ++r) {
+                    for (int i = 0; i < 8; ++i) x[i] = _mm_aesdec_si128(x[i], keys[r]);
+                }
+                for (int i = 0; i < 8; ++i) _mm_storeu_si128(p + i, _mm_aesdeclast_si128(x[i], keys[rounds]));
+            }
+
+            static inline void decrypt1(const __m128i *keys, int rounds, uint8_t *buf) {
+                __m128i *p = reinterpret_cast<__m128i *>(buf);
+                __m128i x = _mm_xor_si128(_mm_loadu_si128(p), keys[0]);
+                for (int r = 1; r < rounds; ++r) x = _mm_aesdec_si128(x, keys[r]);
+                _mm_storeu_si128(p, _mm_aesdeclast_si128(x, keys[rounds]));
+            }
+
+            void ecb_decrypt_aesni(const uint8_t *round_keys, int rounds, uint8_t *buf, size_t blocks) {
+                // decryption keys of equivalent inverse cipher, in using order
+                __m128i keys[MAX_ROUNDS + 1];
+                auto encrypt_keys = reinterpret_cast<const __m128i *>(round_keys);
+                keys[0] = _mm_loadu_si128(encrypt_keys + rounds);
+                for (int r = 1; r < rounds; ++r) {
+                    keys[r] = _mm_aesimc_si128(_mm_loadu_si128(encrypt_keys + rounds - r));
+                }
+                keys[rounds] = _mm_loadu_si128(encrypt_keys);
+
+                size_t i = 0;
+                for (; i + 8 <= blocks; i += 8) decrypt8(keys, rounds, buf + i * AES_BLOCKLEN);
+                for (; i < blocks; ++i) decrypt1(keys, rounds, buf + i * AES_BLOCKLEN);
+            }
+        }
+    }
+}
+
+#endif
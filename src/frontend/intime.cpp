@@ -12,28 +12,268 @@
 #include "runtime/stack.h"
 
 #include "utils/ctxmgr_lite.h"
+#include "utils/ctxmgr_lite_support.h"
 #include "utils/need.h"
+#include "backend/name.h"
+#include "module/menu.h"
+
+#include <list>
+#include <unordered_map>
 
 namespace ts {
     namespace intime {
+        template <typename T>
+        static void append_pod(std::string &key, const T &value) {
+            key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        static void append_tensor(std::string &key, const Tensor &value) {
+            auto fields_count = value.fields_count();
+            append_pod(key, fields_count);
+            for (size_t i = 0; i < fields_count; ++i) {
+                auto field = value.field(i).view(MemoryDevice(CPU));
+                append_pod(key, field.dtype());
+                append_pod(key, field.dims());
+                for (auto size : field.sizes()) append_pod(key, size);
+                key.append(field.data<char>(), size_t(field.count()) * type_bytes(field.dtype()));
+            }
+        }
+
+        /**
+         * @return key of bubble on device, params are compared by content
+         */
+        static std::string operator_key(const ComputingDevice &device, const Bubble &bubble) {
+            std::string key = bubble.op();
+            key.push_back('\0');
+            key += device.type().c_str();
+            append_pod(key, device.id());
+            // params are in ordered map, so equal params got equal key
+            for (auto &param : bubble.params()) {
+                key.push_back('\0');
+                key += param.first;
+                key.push_back('\0');
+                append_tensor(key, param.second);
+            }
+            return key;
+        }
+
+        class OperatorCache::Implement {
+        public:
+            using Entry = std::pair<std::string, Operator::shared>;
+
+            std::list<Entry> entries;   ///< most recently used first
+            std::unordered_map<std::string, std::list<Entry>::iterator> index;
+            size_t capacity = 64;
+            size_t hits = 0;
+            size_t misses = 0;
+
+            void shrink() {
+                while (entries.size() > capacity) {
+                    index.erase(entries.back().first);
+                    entries.pop_back();
+                }
+            }
+        };
+
+        OperatorCache::OperatorCache(size_t capacity) {
+            set_capacity(capacity);
+        }
+
+        OperatorCache::~OperatorCache() = default;
+
+        Operator::shared OperatorCache::get(Workbench &bench, const Bubble &bubble) {
+            auto &impl = *m_impl;
+            auto key = operator_key(bench.device().computing_device, bubble);
+            auto it = impl.index.find(key);
+            if (it != impl.index.end()) {
+                ++impl.hits;
+                impl.entries.splice(impl.entries.begin(), impl.entries, it->second);
+                return it->second->second;
+            }
+            ++impl.misses;
+            auto op = bench.online_create(bubble);
+            if (op == nullptr) {
+                TS_LOG_ERROR << "Not supported operator \"" << bubble.op() << "\" on "
+                             << bench.device().computing_device << eject;
+            }
+            impl.entries.emplace_front(key, op);
+            impl.index[key] = impl.entries.begin();
+            impl.shrink();
+            return op;
+        }
+
+        void OperatorCache::clear() {
+            m_impl->entries.clear();
+            m_impl->index.clear();
+        }
+
+        size_t OperatorCache::size() const {
+            return m_impl->entries.size();
+        }
+
+        size_t OperatorCache::capacity() const {
+            return m_impl->capacity;
+        }
+
+        void OperatorCache::set_capacity(size_t capacity) {
+            m_impl->capacity = std::max<size_t>(capacity, 1);
+            m_impl->shrink();
+        }
+
+        size_t OperatorCache::hits() const {
+            return m_impl->hits;
+        }
+
+        size_t OperatorCache::misses() const {
+            return m_impl->misses;
+        }
+
+        class Capture::Implement {
+        public:
+            class Value {
+            public:
+                Tensor tensor;  ///< keep memory of tensor, so its address is not reused while capturing
+                Node node;
+            };
+
+            Graph graph;
+            std::vector<Node> inputs;
+            size_t calls = 0;
+            size_t nodes = 0;
+            std::unordered_map<const void *, std::vector<Value>> values;  ///< values by memory address
+
+            std::string next_name(const std::string &op) {
+                return "intime/" + std::to_string(nodes++) + "/" + op;
+            }
+
+            static bool same(const Tensor &lhs, const Tensor &rhs) {
+                return lhs.dtype() == rhs.dtype() && lhs.sizes() == rhs.sizes();
+            }
+
+            const Node *find(const Tensor &tensor) const {
+                auto it = values.find(tensor.data());
+                if (it == values.end()) return nullptr;
+                // the latest value wins, as views with the same memory and shape hold the same content
+                for (auto value = it->second.rbegin(); value != it->second.rend(); ++value) {
+                    if (same(value->tensor, tensor)) return &value->node;
+                }
+                return nullptr;
+            }
+
+            void bind(const Tensor &tensor, const Node &node) {
+                auto &slot = values[tensor.data()];
+                for (auto &value : slot) {
+                    if (!same(value.tensor, tensor)) continue;
+                    value.tensor = tensor;
+                    value.node = node;
+                    return;
+                }
+                slot.push_back(Value{tensor, node});
+            }
+
+            /**
+             * @return node of tensor, frozen as constant if not captured
+             */
+            Node node(const Tensor &tensor) {
+                auto found = find(tensor);
+                if (found) return *found;
+                ctx::bind<Graph> _bind_graph(graph);
+                auto data = bubble::data(next_name("data"), tensor.clone());
+                bind(tensor, data);
+                return data;
+            }
+        };
+
+        Capture::Capture() = default;
+
+        Capture::~Capture() = default;
+
+        const Tensor &Capture::input(const Tensor &x) {
+            auto &impl = *m_impl;
+            ctx::bind<Graph> _bind_graph(impl.graph);
+            auto node = bubble::param(impl.next_name("input"), x.dtype());
+            impl.inputs.push_back(node);
+            impl.bind(x, node);
+            return x;
+        }
+
+        void Capture::record(const Bubble &bubble, const std::vector<Tensor> &inputs, const Tensor &output) {
+            auto &impl = *m_impl;
+            std::vector<Node> input_nodes;
+            input_nodes.reserve(inputs.size());
+            for (auto &input : inputs) {
+                input_nodes.push_back(impl.node(input));
+            }
+
+            ctx::bind<Graph> _bind_graph(impl.graph);
+            auto node = bubble::bubble(bubble, impl.next_name(bubble.op()));
+            Node::Link(node, input_nodes);
+            ++impl.calls;
+
+            auto fields_count = output.fields_count();
+            if (fields_count == 1) {
+                impl.bind(output, node);
+                return;
+            }
+            for (size_t i = 0; i < fields_count; ++i) {
+                auto field = bubble::op(impl.next_name(name::layer::field()), name::layer::field(), {node});
+                field.bubble().set(name::offset, tensor::from<int32_t>(int32_t(i)));
+                impl.bind(output.field(i), field);
+            }
+        }
+
+        size_t Capture::size() const {
+            return m_impl->calls;
+        }
+
+        Module::shared Capture::module(const std::vector<Tensor> &outputs) const {
+            auto &impl = *m_impl;
+            std::vector<Node> output_nodes;
+            for (auto &output : outputs) {
+                auto found = impl.find(output);
+                if (found == nullptr) {
+                    TS_LOG_ERROR << "Output " << to_string(output.sizes()) << " is not captured or marked as input" << eject;
+                }
+                output_nodes.push_back(*found);
+            }
+            auto module = Module::Load(impl.graph, output_nodes);
+            module->sort_inputs(impl.inputs);
+            return module;
+        }
+
+        Program::shared Capture::compile(const std::vector<Tensor> &outputs, const ComputingDevice &device,
+                                         const std::string &options) const {
+            return Program::Compile(module(outputs), device, options);
+        }
+
         Tensor run(Workbench &bench, const Bubble &bubble, const std::vector<Tensor> &inputs) {
             auto &stack = bench.stack();
             stack.push_base(int(stack.size()));
             need pop_base(&Stack::pop_base, &stack);
             need clear_stack(&Stack::clear, &stack);
 
-            bench.online_run(bubble, inputs);
+            auto cache = ctx::get<OperatorCache>();
+            if (cache) {
+                bench.online_run(cache->get(bench, bubble), inputs);
+            } else {
+                bench.online_run(bubble, inputs);
+            }
 
+            Tensor output;
             auto fields_count = stack.size();
             if (fields_count == 1) {
-                return stack[0];
-            }
-            std::vector<Tensor> fields(fields_count);
-            for (int i = 0; i < fields_count; ++i) {
-                fields[i] = stack[i];
+                output = stack[0];
+            } else {
+                std::vector<Tensor> fields(fields_count);
+                for (int i = 0; i < fields_count; ++i) {
+                    fields[i] = stack[i];
+                }
+                output.pack(fields);
             }
-            Tensor output;
-            output.pack(fields);
+
+            auto capture = ctx::get<Capture>();
+            if (capture) capture->record(bubble, inputs, output);
+
             return std::move(output);
         }
 
@@ -191,3 +431,6 @@ namespace ts {
         }
     }
 }
+
+TS_LITE_CONTEXT(ts::intime::OperatorCache)
+TS_LITE_CONTEXT(ts::intime::Capture)
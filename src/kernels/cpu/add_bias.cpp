@@ -6,9 +6,7 @@
 #include <core/device.h>
 
 #include "kernels/common/simd.h"
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "runtime/inside/parallel.h"
 
 /////////////////////////////////////////////////
 namespace ts {
@@ -66,10 +64,7 @@ namespace ts {
 
         const int stridedims = back_dims * shape[dim];
         for (int i = 0; i < pre_dims; i++) {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int k = 0; k < shape[dim]; k++) {
+            TS_PARALLEL_FOR_BEGIN(k, 0, shape[dim])
                 float32x4 bias_x4(pbias[k]);
                 auto offset = i * stridedims + k * back_dims;
                 for (int m = 0; m < back_dims - 3; m += 4) {
@@ -80,7 +75,7 @@ namespace ts {
                 for (int m = back_dims/4*4; m < back_dims; m++) {
                     pdst[offset + m] = psrc[offset + m] + pbias[k];
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
     }
 
@@ -7,9 +7,7 @@
 #include <core/device.h>
 #include <vector>
 #include <algorithm>
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "runtime/inside/parallel.h"
 
 
 namespace ts {
@@ -57,14 +55,7 @@ namespace ts {
             const T *src_im = x->data<T>() + x_offset;
             T *dst_im = y->data<T>() + y_offset;
 
-#ifdef TS_USE_OPENMP
-//Note:Using both openmp and neon on armv7 could cause crashes.
-#ifdef TS_ON_ARMV7
-#else
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-#endif
-            for (int n_y_d = 0; n_y_d < dst_height; n_y_d++) {
+            TS_PARALLEL_FOR_BEGIN(n_y_d, 0, dst_height)
                 for (int n_x_d = 0; n_x_d < dst_width; n_x_d++) {
                     vec3d<float> cur(n_x_d, n_y_d, 1);
                     auto location = transform<float>(rz00, rz01, rz02, rz10, rz11, rz12, rz20, rz21, rz22, cur);
@@ -106,7 +97,7 @@ namespace ts {
 
                     } //end for c
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
 
         template<typename T>
@@ -120,14 +111,7 @@ namespace ts {
             const T *src_im = x->data<T>() + x_offset;
             T *dst_im = y->data<T>() + y_offset;
 
-#ifdef TS_USE_OPENMP
-//Note:Using both openmp and neon on armv7 could cause crashes.
-#ifdef TS_ON_ARMV7
-#else
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-#endif
-            for (int n_y_d = 0; n_y_d < dst_height; n_y_d++) {
+            TS_PARALLEL_FOR_BEGIN(n_y_d, 0, dst_height)
                 for (int n_x_d = 0; n_x_d < dst_width; n_x_d++) {
 
                     vec3d<float> cur(n_x_d, n_y_d, 1);
@@ -159,7 +143,7 @@ namespace ts {
                                 src_im[(n_y_s * src_width + n_x_s) * channels + c];
                     }//end for c
                 }
-            }
+            TS_PARALLEL_FOR_END()
 
         }
 
@@ -174,14 +158,7 @@ namespace ts {
             const T *src_im = x->data<T>() + x_offset;
             T *dst_im = y->data<T>() + y_offset;
 
-#ifdef TS_USE_OPENMP
-//Note:Using both openmp and neon on armv7 could cause crashes.
-#ifdef TS_ON_ARMV7
-#else
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-#endif
-            for (int n_y_d = 0; n_y_d < dst_height; n_y_d++) {
+            TS_PARALLEL_FOR_BEGIN(n_y_d, 0, dst_height)
                 for (int n_x_d = 0; n_x_d < dst_width; n_x_d++) {
 
                     vec3d<float> cur(n_x_d, n_y_d, 1);
@@ -213,7 +190,7 @@ namespace ts {
                                 src_im[(n_y_s * src_width + n_x_s) * channels + c];
                     }//end for c
                 }
-            }
+            TS_PARALLEL_FOR_END()
 
         }
 
@@ -231,14 +208,7 @@ namespace ts {
             const int srcrows = x_width * channels;
             const int dstrows = y_width * channels;
 
-#ifdef TS_USE_OPENMP
-//Note:Using both openmp and neon on armv7 could cause crashes.
-#ifdef TS_ON_ARMV7
-#else
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-#endif
-            for (int m = 0; m < y_height; m++) {
+            TS_PARALLEL_FOR_BEGIN(m, 0, y_height)
                 double coeffsY[4];
                 double coeffsX[4];
                 for (int n = 0; n < y_width; n++) {
@@ -314,7 +284,7 @@ namespace ts {
                         }
                     }
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
 
 
@@ -9,6 +9,7 @@
 #include <vector>
 #include <iterator>
 #include "bbox_util.hpp"
+#include "kernels/cpu/nms.h"
 
 #define CPU_ONLY
 
@@ -1834,40 +1835,26 @@ namespace ts {
 
         void GetMaxScoreIndex(const vector<float> &scores, const float threshold,
                               const int top_k, vector<pair<float, int> > *score_index_vec) {
-            // Generate index score pairs.
-            for (int i = 0; i < scores.size(); ++i) {
-                if (scores[i] > threshold) {
-                    score_index_vec->push_back(std::make_pair(scores[i], i));
-                }
-            }
+            // Sort the scores above threshold in descending order, only top_k of them if needed.
+            vector<int> index;
+            cpu::sorted_scores_index(scores.data(), int(scores.size()), threshold, top_k, index);
 
-            // Sort the score pair according to the scores in descending order
-            std::stable_sort(score_index_vec->begin(), score_index_vec->end(),
-                             SortScorePairDescend<int>);
-
-            // Keep top_k scores if needed.
-            if (top_k > -1 && top_k < score_index_vec->size()) {
-                score_index_vec->resize(top_k);
+            // Generate index score pairs.
+            for (auto i : index) {
+                score_index_vec->push_back(std::make_pair(scores[i], i));
             }
         }
 
         template<typename Dtype>
         void GetMaxScoreIndex(const Dtype *scores, const int num, const float threshold,
                               const int top_k, vector<pair<Dtype, int> > *score_index_vec) {
-            // Generate index score pairs.
-            for (int i = 0; i < num; ++i) {
-                if (scores[i] > threshold) {
-                    score_index_vec->push_back(std::make_pair(scores[i], i));
-                }
-            }
-
-            // Sort the score pair according to the scores in descending order
-            std::sort(score_index_vec->begin(), score_index_vec->end(),
-                      SortScorePairDescend<int>);
+            // Sort the scores above threshold in descending order, only top_k of them if needed.
+            vector<int> index;
+            cpu::sorted_scores_index(scores, num, Dtype(threshold), top_k, index);
 
-            // Keep top_k scores if needed.
-            if (top_k > -1 && top_k < score_index_vec->size()) {
-                score_index_vec->resize(top_k);
+            // Generate index score pairs.
+            for (auto i : index) {
+                score_index_vec->push_back(std::make_pair(scores[i], i));
             }
         }
 
@@ -2000,28 +1987,22 @@ namespace ts {
                     << "bboxes and scores have different size." << eject;
 
             // Get top_k scores (with corresponding indices).
-            vector<pair<float, int> > score_index_vec;
-            GetMaxScoreIndex(scores, score_threshold, top_k, &score_index_vec);
+            vector<int> score_index;
+            cpu::sorted_scores_index(scores.data(), int(scores.size()), score_threshold, top_k, score_index);
 
             // Do nms.
             float adaptive_threshold = nms_threshold;
             indices->clear();
-            while (score_index_vec.size() != 0) {
-                const int idx = score_index_vec.front().second;
-                bool keep = true;
-                for (int k = 0; k < indices->size(); ++k) {
-                    if (keep) {
-                        const int kept_idx = (*indices)[k];
-                        float overlap = JaccardOverlap(bboxes[idx], bboxes[kept_idx]);
-                        keep = overlap <= adaptive_threshold;
-                    } else {
-                        break;
-                    }
-                }
+            cpu::NMSKept kept;
+            for (auto idx : score_index) {
+                const NormalizedBBox &bbox = bboxes[idx];
+                const float size = BBoxSize(bbox);
+                bool keep = !kept.overlapped(bbox.xmin(), bbox.ymin(), bbox.xmax(), bbox.ymax(),
+                                             size, adaptive_threshold);
                 if (keep) {
                     indices->push_back(idx);
+                    kept.keep(bbox.xmin(), bbox.ymin(), bbox.xmax(), bbox.ymax(), size);
                 }
-                score_index_vec.erase(score_index_vec.begin());
                 if (keep && eta < 1 && adaptive_threshold > 0.5) {
                     adaptive_threshold *= eta;
                 }
@@ -2033,28 +2014,22 @@ namespace ts {
                           const float score_threshold, const float nms_threshold,
                           const float eta, const int top_k, vector<int> *indices) {
             // Get top_k scores (with corresponding indices).
-            vector<pair<Dtype, int> > score_index_vec;
-            GetMaxScoreIndex(scores, num, score_threshold, top_k, &score_index_vec);
+            vector<int> score_index;
+            cpu::sorted_scores_index(scores, num, Dtype(score_threshold), top_k, score_index);
 
             // Do nms.
             float adaptive_threshold = nms_threshold;
             indices->clear();
-            while (score_index_vec.size() != 0) {
-                const int idx = score_index_vec.front().second;
-                bool keep = true;
-                for (int k = 0; k < indices->size(); ++k) {
-                    if (keep) {
-                        const int kept_idx = (*indices)[k];
-                        float overlap = JaccardOverlap(bboxes + idx * 4, bboxes + kept_idx * 4);
-                        keep = overlap <= adaptive_threshold;
-                    } else {
-                        break;
-                    }
-                }
+            cpu::NMSKept kept;
+            for (auto idx : score_index) {
+                const Dtype *bbox = bboxes + idx * 4;
+                const float size = float(BBoxSize(bbox));
+                bool keep = !kept.overlapped(float(bbox[0]), float(bbox[1]), float(bbox[2]), float(bbox[3]),
+                                             size, adaptive_threshold);
                 if (keep) {
                     indices->push_back(idx);
+                    kept.keep(float(bbox[0]), float(bbox[1]), float(bbox[2]), float(bbox[3]), size);
                 }
-                score_index_vec.erase(score_index_vec.begin());
                 if (keep && eta < 1 && adaptive_threshold > 0.5) {
                     adaptive_threshold *= eta;
                 }
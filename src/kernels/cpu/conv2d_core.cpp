@@ -10,6 +10,7 @@
 #include <kernels/cblas/math_cblas.h>
 #endif
 #include "kernels/cpu/conv2d_algorithm.h"
+#include "runtime/packed_weights.h"
 
 namespace ts {
     namespace cpu {
@@ -17,7 +18,8 @@ namespace ts {
         template<typename T>
         static void cpu_conv2d_nchw_compute_run(const Tensor &x, const Padding2D &padding, float padding_value,
                                            const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
-                                           Tensor &out, Stack &stack, bool kernel_packed) {
+                                           Tensor &out, Stack &stack, bool kernel_packed,
+                                           const GemmEpilogue<T> *epilogue) {
             auto weight_shape = w.sizes();
             auto output_shape = out.sizes();
             auto x_shape = x.sizes();
@@ -55,6 +57,19 @@ namespace ts {
                 col_buffer = col_tensor.data<T>();
             }
 
+#ifndef TS_USE_CBLAS
+            // constant kernel is packed once for all workbenches running this program
+            Tensor packed_kernel = w;
+            if (!kernel_packed) {
+                packed_kernel = PackedWeights::Get(w, "pack8_A", [&](const Tensor &weight) {
+                    Tensor packed(MemoryDevice(CPU), weight.dtype(), weight.sizes());
+                    cpu::math<T, T>::pack8_A(weight_shape[0], kernel_dims, weight.data<T>(), kernel_dims,
+                                             packed.data<T>());
+                    return packed;
+                });
+            }
+#endif
+
             for (int i = 0; i < number; i++) {
                 if (is_1x1_conv) {
                     //std::memcpy(col_buffer,pinput,sizeof(T)*col_buffer_size);
@@ -75,15 +90,15 @@ namespace ts {
                 const T *pweight = w.data<T>();
                 cblas::math<T>::gemm(ts::blas::NoTrans, ts::blas::NoTrans, weight_shape[0], conv_out_spatial_dim,
                                      kernel_dims, 1.0, pweight, col_buffer, 0, poutput);
+                if (epilogue) {
+                    for (int c = 0; c < weight_shape[0]; ++c) {
+                        (*epilogue)(c, poutput + c * conv_out_spatial_dim, conv_out_spatial_dim);
+                    }
+                }
 #else
                 packed_col = stack.make(x.dtype(), packed_shape, MemoryDevice(CPU));
-                Tensor packed_tensor;
-                auto kernel_need_pack = !kernel_packed;
-                if (kernel_need_pack) {
-                    packed_tensor = stack.make(w.dtype(), w.sizes(), MemoryDevice(CPU));
-                }
-                cpu::math<T, T>::gemm(weight_shape[0], conv_out_spatial_dim, kernel_dims, (T)1, w.data<T>(), packed_tensor.data<T>(),
-                                      col_buffer, packed_col.data<T>(), T(0), poutput, kernel_need_pack, true);
+                cpu::math<T, T>::gemm(weight_shape[0], conv_out_spatial_dim, kernel_dims, (T)1, packed_kernel.data<T>(), nullptr,
+                                      col_buffer, packed_col.data<T>(), T(0), poutput, false, true, epilogue);
 
                 //Tensor kernel_packed = stack.make(w.dtype(), w.sizes(), MemoryDevice(CPU));
                 //Conv2dAlgorithm<T>::kernel_pack8x8(w, kernel_packed);
@@ -98,16 +113,48 @@ namespace ts {
             }
         }
 
+        template<typename T>
+        static void cpu_conv2d_nchw_compute_run(const Tensor &x, const Padding2D &padding, float padding_value,
+                                                const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
+                                                Tensor &out, Stack &stack, bool kernel_packed,
+                                                const base::Conv2DEpilogue &epilogue) {
+            if (epilogue.empty()) {
+                cpu_conv2d_nchw_compute_run<T>(x, padding, padding_value, w, stride, dilation, out, stack, kernel_packed, nullptr);
+                return;
+            }
+            auto dtype = dtypeid<T>::id;
+            Tensor bias, slope;
+            GemmEpilogue<T> gemm_epilogue;
+            if (!epilogue.bias.empty()) {
+                bias = tensor::cast(dtype, epilogue.bias);
+                gemm_epilogue.bias = bias.data<T>();
+            }
+            gemm_epilogue.activation = epilogue.activation;
+            gemm_epilogue.max = T(epilogue.max);
+            if (!epilogue.slope.empty()) {
+                slope = tensor::cast(dtype, epilogue.slope);
+                gemm_epilogue.slope = slope.data<T>();
+                gemm_epilogue.slope_step = slope.count() == 1 ? 0 : 1;
+            }
+            cpu_conv2d_nchw_compute_run<T>(x, padding, padding_value, w, stride, dilation, out, stack, kernel_packed, &gemm_epilogue);
+        }
+
+        void Conv2DCore::conv2d(const Tensor &x, const Padding2D &padding, float padding_value, const Tensor &w,
+                                const Stride2D &stride, const Dilation2D &dilation, Conv2DFormat format, Tensor &out,
+                                Stack &stack, bool kernel_packed) {
+            conv2d(x, padding, padding_value, w, stride, dilation, format, out, stack, kernel_packed, base::Conv2DEpilogue());
+        }
+
         void Conv2DCore::conv2d(const Tensor &x, const Padding2D &padding, float padding_value, const Tensor &w,
                             const Stride2D &stride, const Dilation2D &dilation, Conv2DFormat format, Tensor &out,
-                            Stack &stack, bool kernel_packed) {
+                            Stack &stack, bool kernel_packed, const base::Conv2DEpilogue &epilogue) {
             if (format != FORMAT_NCHW) {
                 TS_LOG_ERROR << "Conv2D only support NCHW" << eject;
             }
             DTYPE dtype = out.dtype();
             switch (dtype) {
 #define DECLARE_COMPUTE_RUN(DTYPE, TYPE) \
-        case DTYPE: { cpu_conv2d_nchw_compute_run<TYPE>(x, padding, padding_value, w, stride, dilation, out, stack, kernel_packed); break; }
+        case DTYPE: { cpu_conv2d_nchw_compute_run<TYPE>(x, padding, padding_value, w, stride, dilation, out, stack, kernel_packed, epilogue); break; }
                 DECLARE_COMPUTE_RUN(FLOAT32, float);
                 DECLARE_COMPUTE_RUN(FLOAT64, double);
 #undef DECLARE_COMPUTE_RUN
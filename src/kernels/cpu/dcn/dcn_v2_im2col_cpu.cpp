@@ -6,10 +6,7 @@
 
 #include <cmath>
 
-#include <kernels/common/openmp.h>
-
-#define CPU_KERNEL_LOOP(i, n)                          \
-  for (int i = 0; i < (n); ++i)
+#include "runtime/inside/parallel.h"
 
 static float dmcn_im2col_bilinear(const float *bottom_data, const int data_width,
                            const int height, const int width, float h, float w) {
@@ -55,12 +52,7 @@ static void modulated_deformable_im2col_gpu_kernel(const int n,
     // launch channels * batch_size * height_col * width_col cores
 
 
-    // add openmp
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(ts::openmp_threads())
-#endif
-    CPU_KERNEL_LOOP(index, n)
-    {
+    TS_PARALLEL_FOR_BEGIN(index, 0, n)
         // NOTE(CharlesShang): different from Dai Jifeng's MXNet implementation, col_buffer is of shape (c*kw*kh, N, oh, ow)
         // here columns is of shape (N, c*kw*kh, oh * ow), need to adapt axis
 
@@ -116,7 +108,7 @@ static void modulated_deformable_im2col_gpu_kernel(const int n,
                 data_col_ptr += height_col * width_col;
             }
         }
-    }
+    TS_PARALLEL_FOR_END()
 }
 
 void modulated_deformable_im2col_cpu(const float* data_im, const float* data_offset, const float* data_mask,
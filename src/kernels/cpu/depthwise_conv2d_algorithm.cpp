@@ -1,9 +1,7 @@
 #include "kernels/cpu/depthwise_conv2d_algorithm.h"
 #include "kernels/common/simd.h"
 
-#ifdef TS_USE_OPENMP
-#include "kernels/common/openmp.h"
-#endif
+#include "runtime/inside/parallel.h"
 
 namespace ts {
     namespace cpu{
@@ -132,14 +130,7 @@ namespace ts {
             float *poutput = out.data<float>();
 
             for (int n = 0; n < input_shape[0]; n++){
-#ifdef TS_USE_OPENMP
-//Note:Using both openmp and neon on armv7 could cause crashes.
-#ifdef TS_ON_ARMV7
-#else
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-#endif
-                for (int c = 0; c < output_shape[1]; c++){
+                TS_PARALLEL_FOR_BEGIN(c, 0, output_shape[1])
                     const float* input_at = pinput + n * input_num_offset + c * input_channel_offset;
                     const float* kernel_at = pkernel + c * 9;
 
@@ -258,7 +249,7 @@ namespace ts {
                                 output_width, out_at);
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -310,13 +301,7 @@ namespace ts {
             float *poutput = out.data<float>();
 
             for (int n = 0; n < input_shape[0]; n++) {
-#ifdef TS_USE_OPENMP
-#ifdef TS_ON_ARMV7
-#else
-#pragma omp parallel for num_threads(openmp_threads()) 
-#endif
-#endif
-                for (int c = 0; c < output_shape[1]; c++) {
+                TS_PARALLEL_FOR_BEGIN(c, 0, output_shape[1])
                     const float* input_at = pinput + n * input_num_offset + c * input_channel_offset;
                     const float* kernel_at = pkernel + c * 9;
 
@@ -390,7 +375,7 @@ namespace ts {
                                 output_width, out_at);
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -432,13 +417,7 @@ namespace ts {
             float *poutput = out.data<float>();
 
             for (int n = 0; n < input_shape[0]; n++) {
-#ifdef TS_USE_OPENMP
-#ifdef TS_ON_ARMV7
-#else
-#pragma omp parallel for num_threads(openmp_threads()) 
-#endif
-#endif
-                for (int c = 0; c < output_shape[1]; c++) {
+                TS_PARALLEL_FOR_BEGIN(c, 0, output_shape[1])
                     const float* input_at = pinput + n * input_num_offset + c * input_channel_offset;
                     const float* kernel_at = pkernel + c * 9;
 
@@ -542,7 +521,7 @@ namespace ts {
                                 output_width, out_at);
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
     }
@@ -9,6 +9,7 @@
 
 #include "kernels/cpu/caffe/bbox_util.hpp"
 #include "utils/need.h"
+#include "runtime/inside/parallel.h"
 
 #include <functional>
 #include <algorithm>
@@ -180,6 +181,12 @@ namespace ts {
                     const map<int, vector<float> >& conf_scores = all_conf_scores[i];
                     map<int, vector<int> > indices;
                     int num_det = 0;
+                    struct ClassNMS {
+                        const vector<NormalizedBBox> *bboxes;
+                        const vector<float> *scores;
+                        vector<int> *indices;
+                    };
+                    vector<ClassNMS> class_nms;
                     for (int c = 0; c < num_classes_; ++c) {
                         if (c == background_label_id_) {
                             // Ignore background class.
@@ -197,9 +204,16 @@ namespace ts {
                             continue;
                         }
                         const vector<NormalizedBBox>& bboxes = decode_bboxes.find(label)->second;
-                        ApplyNMSFast(bboxes, scores, confidence_threshold_, nms_threshold_, eta_,
-                                     top_k_, &(indices[c]));
-                        num_det += indices[c].size();
+                        class_nms.push_back({&bboxes, &scores, &(indices[c])});
+                    }
+                    // classes are independent, map nodes are all created above
+                    TS_PARALLEL_FOR_BEGIN(k, 0, int(class_nms.size()))
+                        auto &task = class_nms[k];
+                        ApplyNMSFast(*task.bboxes, *task.scores, confidence_threshold_, nms_threshold_, eta_,
+                                     top_k_, task.indices);
+                    TS_PARALLEL_FOR_END()
+                    for (auto &task : class_nms) {
+                        num_det += int(task.indices->size());
                     }
                     if (keep_top_k_ > -1 && num_det > keep_top_k_) {
                         vector<pair<float, pair<int, int> > > score_index_pairs;
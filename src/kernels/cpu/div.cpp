@@ -1,4 +1,5 @@
 #include <kernels/cpu/div.h>
+#include <kernels/cpu/element_wise_broadcast.h>
 #include <core/tensor_builder.h>
 #include <backend/name.h>
 #include <utils/assert.h>
@@ -22,31 +23,20 @@ namespace ts {
                 : x / y;
         }
 
-        static inline int to_mod_index(const HypeShape &hype, const Shape &coordinate) {
-            auto temp = coordinate;
-            for (size_t i = 0; i < temp.size(); ++i) {
-                temp[i] %= hype.shape(i);
+        struct DivFunctor {
+            static const bool vectorized = false;
+
+            template <typename T>
+            T operator()(T lhs, T rhs) const {
+                T x;
+                reduce_operator(x, lhs, rhs);
+                return x;
             }
-            return hype.to_index(temp);
-        }
+        };
 
         template<typename T>
         static inline void compute_run(const Tensor &lhs, const Tensor &rhs, Tensor &out) {
-            HypeShape lhs_hype(lhs.sizes());
-            HypeShape rhs_hype(rhs.sizes());
-            //HypeShape out_hype(out.sizes());
-            ShapeIterator out_iterator(out.sizes());
-
-            auto plhs = lhs.data<T>();
-            auto prhs = rhs.data<T>();
-            auto pout = out.data<T>();
-
-            auto ncount = out.count();
-            for(int i = 0; i < ncount; i++) {
-                auto &tmpshape = out_iterator.coordinate();
-                reduce_operator(pout[i], plhs[to_mod_index(lhs_hype, tmpshape)], prhs[to_mod_index(rhs_hype, tmpshape)]);
-                ++out_iterator;
-            }
+            broadcast<T>(lhs, rhs, out, DivFunctor());
         }
 
         template<typename T>
@@ -0,0 +1,75 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "kernels/cpu/element_wise_broadcast.h"
+
+#include "utils/assert.h"
+
+namespace ts {
+    namespace cpu {
+        BroadcastPlan::BroadcastPlan(const Shape &lhs, const Shape &rhs, const Shape &out) {
+            auto dims = int(out.size());
+            TS_AUTO_CHECK(int(lhs.size()) <= dims && int(rhs.size()) <= dims);
+
+            // align shapes to out, and get strides of each input, 0 for broadcast axis
+            auto aligned_strides = [&](const Shape &shape) {
+                std::vector<int> strides(size_t(dims), 0);
+                auto offset = dims - int(shape.size());
+                int step = 1;
+                for (int i = int(shape.size()) - 1; i >= 0; --i) {
+                    auto size = shape[i];
+                    if (size != 1) {
+                        TS_AUTO_CHECK(size == out[i + offset]);
+                        strides[i + offset] = step;
+                    }
+                    step *= size;
+                }
+                return strides;
+            };
+            auto lhs_strides = aligned_strides(lhs);
+            auto rhs_strides = aligned_strides(rhs);
+
+            m_count = 1;
+            for (int i = 0; i < dims; ++i) {
+                auto size = out[i];
+                m_count *= size;
+                if (size == 1) continue;
+                if (!m_shape.empty()) {
+                    auto &last = m_shape.back();
+                    auto &last_lhs = m_lhs_strides.back();
+                    auto &last_rhs = m_rhs_strides.back();
+                    // outer axis can be merged, if it steps over whole inner axis in both inputs
+                    if (last_lhs == lhs_strides[i] * size && last_rhs == rhs_strides[i] * size) {
+                        last *= size;
+                        last_lhs = lhs_strides[i];
+                        last_rhs = rhs_strides[i];
+                        continue;
+                    }
+                }
+                m_shape.push_back(size);
+                m_lhs_strides.push_back(lhs_strides[i]);
+                m_rhs_strides.push_back(rhs_strides[i]);
+            }
+
+            if (m_shape.empty()) {
+                // single element, or empty output
+                m_shape.push_back(m_count);
+                m_lhs_strides.push_back(0);
+                m_rhs_strides.push_back(0);
+            }
+        }
+
+        void BroadcastPlan::offset(int outer, int &lhs_offset, int &rhs_offset) const {
+            lhs_offset = 0;
+            rhs_offset = 0;
+            for (int i = int(m_shape.size()) - 2; i >= 0; --i) {
+                auto size = m_shape[i];
+                auto coordinate = outer % size;
+                outer /= size;
+                lhs_offset += coordinate * m_lhs_strides[i];
+                rhs_offset += coordinate * m_rhs_strides[i];
+            }
+        }
+    }
+}
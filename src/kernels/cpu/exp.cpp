@@ -3,9 +3,8 @@
 
 #include "backend/name.h"
 #include "global/operator_factory.h"
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "kernels/cpu/element_wise_unary.h"
+#include "runtime/inside/parallel.h"
 
 
 namespace ts {
@@ -19,12 +18,15 @@ namespace ts {
             int count = out.count();
 
 //            std::memcpy(output_data, input_data, count * sizeof(T));
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int i = 0; i < count; i++) {
+            TS_PARALLEL_FOR_BEGIN(i, 0, count)
                 output_data[i] = exp(input_data[i]);
-            }
+            TS_PARALLEL_FOR_END()
+        }
+
+        template<>
+        void cpu_exp_compute_run<float>(const Tensor &x, Tensor &out) {
+            unary_float32x4(x.data<float>(), out.data<float>(), out.count(),
+                            [](const float32x4 &value) { return exp_float32x4(value); });
         }
 
 
@@ -7,7 +7,7 @@
 
 #include "runtime/inside/thread_pool.h"
 #include "utils/box.h"
-#include "kernels/common/openmp.h"
+#include "runtime/inside/parallel.h"
 
 namespace ts {
 
@@ -75,12 +75,7 @@ void im2col_cpu(const Dtype* data_im, const int channels,
     }
 #else
     auto col_size = kernel_h * kernel_w * output_h * output_w;
-    //Note:Using both openmp and neon on armv7 could cause crashes.
-#ifdef TS_ON_ARMV7
-#else
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-    for (int channel = 0; channel < channels; ++channel) {
+    TS_PARALLEL_FOR_BEGIN(channel, 0, channels)
         auto local_data_im = data_im + channel * channel_size;
         auto local_data_col = data_col + channel * col_size;
         for (int kernel_row = 0; kernel_row < kernel_h; kernel_row++) {
@@ -106,7 +101,7 @@ void im2col_cpu(const Dtype* data_im, const int channels,
                 }
             }
         }
-    }
+    TS_PARALLEL_FOR_END()
 #endif
 }
 
@@ -5,7 +5,7 @@
 #include <backend/name.h>
 #include <core/device.h>
 #include <utils/assert.h>
-#include <frontend/intime.h>
+#include <runtime/packed_weights.h>
 
 #ifdef TS_USE_CBLAS
 #include <kernels/cblas/math_cblas.h>
@@ -35,17 +35,28 @@ namespace ts {
                  TS_LOG_ERROR << "What a Terrible Failure: dealing transpose weights without transpose support, because supporting pack" << eject;
             }
 
-            auto no_trasposed_rhs = rhs;
-            if (transpose) {
-                no_trasposed_rhs = intime::transpose(rhs, {1, 0});
+            auto K = lhs_shape[1];
+            Tensor lhs_packed = stack.make(lhs.dtype(), lhs_shape, MemoryDevice(CPU));
+
+            // constant weight is packed once for all workbenches running this program
+            Tensor rhs_packed = rhs;
+            if (!kernel_packed) {
+                auto layout = transpose ? "transpose_pack8_B" : "pack8_B";
+                rhs_packed = PackedWeights::Get(rhs, layout, [&](const Tensor &weight) {
+                    Tensor packed(MemoryDevice(CPU), weight.dtype(), {K, N});
+                    if (transpose) {
+                        Tensor transposed(MemoryDevice(CPU), weight.dtype(), {K, N});
+                        cpu::math<T, T>::matrix_transpose(weight.data<T>(), transposed.data<T>(), N, K);
+                        cpu::math<T, T>::pack8_B(K, N, transposed.data<T>(), N, packed.data<T>());
+                    } else {
+                        cpu::math<T, T>::pack8_B(K, N, weight.data<T>(), N, packed.data<T>());
+                    }
+                    return packed;
+                });
             }
-            auto rhs_data = no_trasposed_rhs.data<T>();
 
-            Tensor lhs_packed = stack.make(lhs.dtype(), lhs_shape, MemoryDevice(CPU));
-            Tensor rhs_packed = stack.make(rhs.dtype(), rhs_shape, MemoryDevice(CPU));
-            
-            cpu::math<T, T>::gemm(lhs_shape[0], N, lhs_shape[1], (T)1, lhs.data<T>(), lhs_packed.data<T>(),
-                                  rhs_data, rhs_packed.data<T>(), T(0), pdst, true, !kernel_packed);
+            cpu::math<T, T>::gemm(lhs_shape[0], N, K, (T)1, lhs.data<T>(), lhs_packed.data<T>(),
+                                  rhs_packed.data<T>(), nullptr, T(0), pdst, true, false);
             //cpu::math<T, T>::gemm(blas::NoTrans, rhs_transpose, lhs_shape[0], N, lhs_shape[1],
             //                   (T) 1, psrc, pdot, (T) 0, pdst);
 #endif
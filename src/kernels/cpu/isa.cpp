@@ -0,0 +1,90 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "kernels/cpu/isa.h"
+
+#include "utils/cpu_info.h"
+#include "utils/log.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace ts {
+    namespace cpu {
+        const char *isa_str(ISA isa) {
+            switch (isa) {
+                case ISA::GENERIC: return "generic";
+                case ISA::AVX2: return "avx2";
+                case ISA::AVX512: return "avx512";
+            }
+            return "unknown";
+        }
+
+        static const ISAKernels *built_kernels(ISA isa) {
+#if defined(TS_USE_CPU_DISPATCH) && TS_PLATFORM_IS_X86
+            switch (isa) {
+                case ISA::AVX2: return x86::kernels_avx2();
+                case ISA::AVX512: return x86::kernels_avx512();
+                default: break;
+            }
+#endif
+            return nullptr;
+        }
+
+        static bool support_isa(ISA isa) {
+            switch (isa) {
+                case ISA::GENERIC:
+                    return true;
+                case ISA::AVX2:
+                    return check_cpu_feature(AVX2) && check_cpu_feature(FMA);
+                case ISA::AVX512:
+                    return support_isa(ISA::AVX2) &&
+                           check_cpu_feature(AVX512F) && check_cpu_feature(AVX512DQ) &&
+                           check_cpu_feature(AVX512BW) && check_cpu_feature(AVX512VL);
+            }
+            return false;
+        }
+
+        /**
+         * @return limit set by environment TS_CPU_ISA, AVX512 if not set
+         */
+        static ISA isa_limit() {
+            auto env = std::getenv("TS_CPU_ISA");
+            if (env == nullptr || *env == '\0') return ISA::AVX512;
+            for (auto isa : {ISA::GENERIC, ISA::AVX2, ISA::AVX512}) {
+                if (std::strcmp(env, isa_str(isa)) == 0) return isa;
+            }
+            TS_LOG_ERROR << "Ignore unknown TS_CPU_ISA=" << env << ", use one of generic, avx2 or avx512";
+            return ISA::AVX512;
+        }
+
+        static ISA detect_isa() {
+            auto limit = isa_limit();
+            auto best = ISA::GENERIC;
+            for (auto isa : {ISA::AVX2, ISA::AVX512}) {
+                if (int(isa) > int(limit)) break;
+                if (!support_isa(isa) || built_kernels(isa) == nullptr) break;
+                best = isa;
+            }
+            TS_LOG_STATUS << "Use " << isa_str(best) << " cpu kernels";
+            return best;
+        }
+
+        ISA cpu_isa() {
+            static const ISA isa = detect_isa();
+            return isa;
+        }
+
+        const ISAKernels &isa_kernels(ISA isa) {
+            static const ISAKernels generic = {nullptr, 1, nullptr, nullptr, 1};
+            auto kernels = built_kernels(isa);
+            return kernels ? *kernels : generic;
+        }
+
+        const ISAKernels &isa_kernels() {
+            static const ISAKernels &kernels = isa_kernels(cpu_isa());
+            return kernels;
+        }
+    }
+}
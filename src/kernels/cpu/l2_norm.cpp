@@ -8,6 +8,7 @@
 #include <math.h>
 
 #include <kernels/common/simd.h>
+#include "runtime/inside/parallel.h"
 
 namespace ts {
     namespace cpu {
@@ -83,6 +84,100 @@ namespace ts {
             }
         }
 
+        /**
+         * 4 l2 normalize in lanes, each over body_num values with step tail_num
+         */
+        static inline void cpu_l2_normalize_lanes_float(const float *in, float *out, int body_num, int tail_num,
+                                                        float epsilon) {
+            float32x4 sum_x4(0.0f);
+            for (int i = 0; i < body_num; ++i) {
+                float32x4 data(&in[i * tail_num]);
+                sum_x4 = fmadd(data, data, sum_x4);
+            }
+            float32x4 scale_x4 = rsqrt_float32x4(sum_x4 + float32x4(epsilon));
+            for (int i = 0; i < body_num; ++i) {
+                (float32x4(&in[i * tail_num]) * scale_x4).store(&out[i * tail_num]);
+            }
+        }
+
+        /**
+         * l2 normalize on contiguous data
+         */
+        static inline void cpu_l2_normalize_row_float(const float *in, float *out, int count, float epsilon) {
+            int body = count / 4 * 4;
+            float32x4 sum_x4(0.0f);
+            for (int i = 0; i < body; i += 4) {
+                float32x4 data(&in[i]);
+                sum_x4 = fmadd(data, data, sum_x4);
+            }
+            float sum = ts::sum(sum_x4);
+            for (int i = body; i < count; ++i) {
+                sum += in[i] * in[i];
+            }
+            float scale = 1.0f / std::sqrt(sum + epsilon);
+            float32x4 scale_x4(scale);
+            for (int i = 0; i < body; i += 4) {
+                (float32x4(&in[i]) * scale_x4).store(&out[i]);
+            }
+            for (int i = body; i < count; ++i) {
+                out[i] = in[i] * scale;
+            }
+        }
+
+        template<>
+        void cpu_l2_normalize_compute_run<float>(const Tensor &x, int m_dim, float epsilon, Tensor &out) {
+            auto &output_shape = out.sizes();
+
+            auto input_data = x.data<float>();
+            auto output_data = out.data<float>();
+
+            int body_num = output_shape[m_dim];
+
+            if (body_num == 1) {
+                float one(1);
+                memset(output_data, out.device(), out.count() * out.proto().type_bytes(),
+                       &one, Device(CPU), sizeof(float));
+                return;
+            }
+
+            int head_num = 1;
+            for (int i = 0; i < m_dim; i++) {
+                head_num *= output_shape[i];
+            }
+            int tail_num = 1;
+            for (int i = m_dim + 1; i < output_shape.size(); i++) {
+                tail_num *= output_shape[i];
+            }
+
+            if (tail_num == 1) {
+                TS_PARALLEL_FOR_BEGIN(n, 0, head_num)
+                    cpu_l2_normalize_row_float(&input_data[n * body_num], &output_data[n * body_num], body_num, epsilon);
+                TS_PARALLEL_FOR_END()
+                return;
+            }
+
+            // as NCW format, W is vectorized by 4, the left W use scalar version
+            int tail_blocks = (tail_num + 3) / 4;
+            int block_count = head_num * tail_blocks;
+            TS_PARALLEL_FOR_BEGIN(b, 0, block_count)
+                int n = b / tail_blocks;
+                int w = b % tail_blocks * 4;
+                auto channel_index = (n * body_num) * tail_num + w;
+                auto in = &input_data[channel_index];
+                auto out = &output_data[channel_index];
+                if (w + 4 <= tail_num) {
+                    cpu_l2_normalize_lanes_float(in, out, body_num, tail_num, epsilon);
+                    continue;
+                }
+                for (; w < tail_num; ++w, ++in, ++out) {
+                    float sum = 0;
+                    for (int i = 0; i < body_num; ++i) sum += in[i * tail_num] * in[i * tail_num];
+                    float scale = 1.0f / std::sqrt(sum + epsilon);
+                    for (int i = 0; i < body_num; ++i) out[i * tail_num] = in[i * tail_num] * scale;
+                }
+            TS_PARALLEL_FOR_END()
+        }
+
 		template<typename T>
 		void cpu_l2_norm_compute_run(const Tensor &x, int m_dim, float epsilon, Tensor &out) {
 		    return cpu_l2_normalize_compute_run<T>(x, m_dim, epsilon, out);
@@ -6,9 +6,7 @@
 #include "global/operator_factory.h"
 
 #include "kernels/common/simd.h"
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "runtime/inside/parallel.h"
 
 namespace ts {
 	namespace cpu {
@@ -27,13 +25,10 @@ namespace ts {
 			int count = out.count();
 
             T casted_scale = T(scale);
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-			for (int i = 0; i < count; i++) {
+			TS_PARALLEL_FOR_BEGIN(i, 0, count)
                 T val = input_data[i];
                 output_data[i] = val > 0 ? val : val * casted_scale;
-            }
+            TS_PARALLEL_FOR_END()
 		}
 
         template<>
@@ -48,10 +43,7 @@ namespace ts {
             float32x4 casted_scale_x4(casted_scale);
             int counts = out.count();
             float32x4 const_num_x4(float(0.0));
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int i = 0; i < count_4; ++i) {
+            TS_PARALLEL_FOR_BEGIN(i, 0, count_4)
                 auto input_at = input_data + i * 4;
                 auto output_at = output_data + i * 4;
 
@@ -59,7 +51,7 @@ namespace ts {
                 float32x4 output_data_x4 = max_float32x4(input_data_x4, const_num_x4) + casted_scale_x4 * min_float32x4(input_data_x4, const_num_x4);
 
                 output_data_x4.store(output_at);
-            }
+            TS_PARALLEL_FOR_END()
             for (int i = count_4 * 4; i < counts; i++) {
                 float val = input_data[i];
                 output_data[i] = val > 0 ? val : val * casted_scale;
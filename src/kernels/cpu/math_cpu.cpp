@@ -12,11 +12,12 @@
 #include <iostream>
 
 #include <cmath>
+#include <algorithm>
 
 #include <runtime/inside/parallel.h>
 
-#include "kernels/common/openmp.h"
 #include "kernels/common/simd.h"
+#include "kernels/cpu/isa.h"
 
 
 #include <core/dtype.h>
@@ -249,10 +250,7 @@ namespace ts {
             int remain = out_loop << 3;
 
             //T_OUT* to_at = to;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int nn = 0; nn < out_loop; nn++) {
+            TS_PARALLEL_FOR_BEGIN(nn, 0, out_loop)
                 int n = nn * 8;
                 const T_IN* k0 = from + n * lda;
                 const T_IN* k1 = k0 + lda;
@@ -275,20 +273,17 @@ namespace ts {
                     *to_at++ = *k6++;
                     *to_at++ = *k7++;
                 }
-            }
+            TS_PARALLEL_FOR_END()
 
             //NOTE:Maybe i should pack 4x4 on remain size
             //to_at = to + remain * col;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int n = remain; n < row; n++) {
+            TS_PARALLEL_FOR_BEGIN(n, remain, row)
                 const T_IN* k0 = from + n * lda;
                 T_IN* to_at = to + n * col;
                 for (int i = 0; i < col; i++) {
                     *to_at++ = *k0++;
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
 
         template<typename T_IN, typename T_OUT>
@@ -297,10 +292,7 @@ namespace ts {
             int remain = out_loop << 3;
 
             //T_OUT* to_at = to;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int nn = 0; nn < out_loop; nn++) {
+            TS_PARALLEL_FOR_BEGIN(nn, 0, out_loop)
                 int n = nn * 8;
                 const T_IN* from_at = from + n;
                 T_IN* to_at = to + n * row;
@@ -317,13 +309,10 @@ namespace ts {
 
                     from_at += ldb;
                 }
-            }
+            TS_PARALLEL_FOR_END()
 
             //to_at = to + remain * row;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int n = remain; n < col; n++) {
+            TS_PARALLEL_FOR_BEGIN(n, remain, col)
                 const T_IN* from_at = from + n;
                 T_IN* to_at = to + n * row;
 
@@ -331,7 +320,7 @@ namespace ts {
                     *to_at++ = from_at[0];
                     from_at += ldb;
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
 
         template<>
@@ -340,10 +329,7 @@ namespace ts {
             int remain = out_loop << 3;
 
             //float* to_at = to;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int nn = 0; nn < out_loop; nn++) {
+            TS_PARALLEL_FOR_BEGIN(nn, 0, out_loop)
                 int n = nn * 8;
                 const float* from_at = from + n;
                 float* to_at = to + n * row;
@@ -355,13 +341,10 @@ namespace ts {
                     from_at += ldb;
                     to_at += 8;
                 }
-            }
+            TS_PARALLEL_FOR_END()
 
             //to_at = to + remain * row;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int n = remain; n < col; n++) {
+            TS_PARALLEL_FOR_BEGIN(n, remain, col)
                 const float* from_at = from + n;
                 float* to_at = to + n * row;
 
@@ -369,7 +352,7 @@ namespace ts {
                     *to_at++ = from_at[0];
                     from_at += ldb;
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
 
         template<typename T_IN, typename T_OUT>
@@ -378,12 +361,14 @@ namespace ts {
         }
 
         template<typename T_IN, typename T_OUT>
-        inline void kernel_8x8(int M, int K, int N, T_IN alpha, const T_IN *A, const T_IN *B, T_IN beta, T_OUT *C, int ldc) {
+        inline void kernel_8x8(int M, int K, int N, T_IN alpha, const T_IN *A, const T_IN *B, T_IN beta, T_OUT *C, int ldc,
+                               const GemmEpilogue<T_OUT> *epilogue) {
 
         }
 
         template<>
-        inline void kernel_8x8<float, float>(int M, int K, int N, float alpha, const float *A, const float *B, float beta, float *C, int ldc) {
+        inline void kernel_8x8<float, float>(int M, int K, int N, float alpha, const float *A, const float *B, float beta, float *C, int ldc,
+                                             const GemmEpilogue<float> *epilogue) {
             const float* p_A = A;
             const float* p_B = B;
             float* p_C = C;
@@ -391,10 +376,10 @@ namespace ts {
             int out_loop = M >> 3;
             int remain = out_loop << 3;
             float* output_at = p_C;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int mm = 0; mm < out_loop; mm++) {
+            // micro kernel of cpu instruction set if specialized
+            auto tile8 = isa_kernels().gemm_tile8;
+            auto tile8_panels = isa_kernels().gemm_tile8_panels;
+            TS_PARALLEL_FOR_BEGIN(mm, 0, out_loop)
                 int m = mm * 8;
                 float* output_row0 = output_at + m * ldc;
                 float* output_row1 = output_row0 + ldc;
@@ -409,7 +394,24 @@ namespace ts {
 
                 int n_loop = N >> 3;
                 int n_remain = n_loop << 3;
-                for (int nn = 0; nn < n_loop; nn++)
+                int nn = 0;
+                if (tile8) {
+                    for (; nn < n_loop; nn += tile8_panels) {
+                        int n = nn * 8;
+                        int panels = std::min(tile8_panels, n_loop - nn);
+                        tile8(K, A_store, p_B + n * K, panels, output_row0 + n, ldc);
+                        if (epilogue) {
+                            for (int i = 0; i < 8; ++i) {
+                                (*epilogue)(m + i, output_row0 + i * ldc + n, panels * 8);
+                            }
+                        }
+                    }
+                    output_row0 += n_remain; output_row1 += n_remain;
+                    output_row2 += n_remain; output_row3 += n_remain;
+                    output_row4 += n_remain; output_row5 += n_remain;
+                    output_row6 += n_remain; output_row7 += n_remain;
+                }
+                for (; nn < n_loop; nn++)
                 {
                     int n = nn * 8;
 
@@ -548,6 +550,13 @@ namespace ts {
                     c4.store(output_row4); c5.store(output_row5);
                     c6.store(output_row6); c7.store(output_row7);
 
+                    if (epilogue) {
+                        (*epilogue)(m, output_row0, 8); (*epilogue)(m + 1, output_row1, 8);
+                        (*epilogue)(m + 2, output_row2, 8); (*epilogue)(m + 3, output_row3, 8);
+                        (*epilogue)(m + 4, output_row4, 8); (*epilogue)(m + 5, output_row5, 8);
+                        (*epilogue)(m + 6, output_row6, 8); (*epilogue)(m + 7, output_row7, 8);
+                    }
+
                     output_row0 += 8; output_row1 += 8;
                     output_row2 += 8; output_row3 += 8;
                     output_row4 += 8; output_row5 += 8;
@@ -609,12 +618,15 @@ namespace ts {
                     *output_row6++ = *(((float*)&sum_col.value) + 6);
                     *output_row7++ = *(((float*)&sum_col.value) + 7);
                 }
-            }
 
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int m = remain; m < M; m++) {
+                if (epilogue && n_remain < N) {
+                    for (int i = 0; i < 8; ++i) {
+                        (*epilogue)(m + i, output_at + (m + i) * ldc + n_remain, N - n_remain);
+                    }
+                }
+            TS_PARALLEL_FOR_END()
+
+            TS_PARALLEL_FOR_BEGIN(m, remain, M)
                 float* output_row0 = output_at + m * ldc;
                 const float* A_store = p_A + m * K;
 
@@ -696,12 +708,15 @@ namespace ts {
                     *output_row0 = sum0;
                     output_row0++;
                 }
-            }
+
+                if (epilogue) (*epilogue)(m, output_at + m * ldc, N);
+            TS_PARALLEL_FOR_END()
         }
 
         template<typename T_IN, typename T_OUT>
         void math<T_IN, T_OUT>::gemm(int M, int N, int K, T_IN alpha, const T_IN *A, const T_IN *B,
-                                     T_IN beta, T_OUT *C, bool A_need_pack, bool B_need_pack) {
+                                     T_IN beta, T_OUT *C, bool A_need_pack, bool B_need_pack,
+                                     const GemmEpilogue<T_OUT> *epilogue) {
             Tensor A_packed;
             Tensor B_packed;
             if (A_need_pack) {
@@ -710,12 +725,13 @@ namespace ts {
             if (B_need_pack) {
                 B_packed = Tensor(Tensor::InFlow::HOST, dtypeid<T_IN>::id, {int32_t(N * K),});
             }
-            self::gemm(M, N, K, alpha, A, A_packed.data<T_IN>(), B, B_packed.data<T_IN>(), beta, C, A_need_pack, B_need_pack);
+            self::gemm(M, N, K, alpha, A, A_packed.data<T_IN>(), B, B_packed.data<T_IN>(), beta, C, A_need_pack, B_need_pack, epilogue);
         }
 
         template<typename T_IN, typename T_OUT>
         void math<T_IN, T_OUT>::gemm(int M, int N, int K, T_IN alpha, const T_IN *A, T_IN *A_packed, const T_IN *B, T_IN *B_packed,
-                           T_IN beta, T_OUT *C, bool A_need_pack, bool B_need_pack) {
+                           T_IN beta, T_OUT *C, bool A_need_pack, bool B_need_pack,
+                           const GemmEpilogue<T_OUT> *epilogue) {
 
             if (!ts::near(alpha, T_IN(1)) || !ts::near(beta, T_IN(0))) {
                 TS_LOG_ERROR << "alpha should be one and beta should be zero now!"<< eject;
@@ -729,16 +745,16 @@ namespace ts {
             }
 
             if (A_need_pack && B_need_pack) {
-                kernel_8x8<T_IN, T_OUT>(M, K, N, alpha, A_packed, B_packed, beta, C, N);
+                kernel_8x8<T_IN, T_OUT>(M, K, N, alpha, A_packed, B_packed, beta, C, N, epilogue);
             }
             else if (A_need_pack && !B_need_pack) {
-                kernel_8x8<T_IN, T_OUT>(M, K, N, alpha, A_packed, B, beta, C, N);
+                kernel_8x8<T_IN, T_OUT>(M, K, N, alpha, A_packed, B, beta, C, N, epilogue);
             }
             else if (!A_need_pack && B_need_pack) {
-                kernel_8x8<T_IN, T_OUT>(M, K, N, alpha, A, B_packed, beta, C, N);
+                kernel_8x8<T_IN, T_OUT>(M, K, N, alpha, A, B_packed, beta, C, N, epilogue);
             }
             else {
-                kernel_8x8<T_IN, T_OUT>(M, K, N, alpha, A, B, beta, C, N);
+                kernel_8x8<T_IN, T_OUT>(M, K, N, alpha, A, B, beta, C, N, epilogue);
             }       
         }
 
@@ -7,8 +7,22 @@
 #include "global/memory_device.h"
 
 #include "utils/assert.h"
+#include "utils/box.h"
+#include "utils/log.h"
 
 #include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define TS_CPU_USE_MMAP
+#endif
 
 namespace ts {
     void *cpu_allocator(int id, size_t new_size, void *mem, size_t mem_size) {
@@ -31,16 +45,275 @@ namespace ts {
         return new_mem;
     }
 
+    namespace {
+        const size_t ALIGNMENT = 64;
+        const size_t HUGE_PAGE = size_t(2) << 20;
+
+        /**
+         * header in front of each aligned block, or in side table for mapped block
+         */
+        struct BlockHeader {
+            void *raw;          ///< pointer to free
+            size_t size;        ///< usable size
+            size_t mapped;      ///< mapped size, 0 if block is from malloc
+            bool numa;          ///< if bound to numa node
+        };
+
+        std::atomic<uint64_t> g_blocks(0);
+        std::atomic<uint64_t> g_memory(0);
+        std::atomic<uint64_t> g_peak(0);
+        std::atomic<uint64_t> g_huge(0);
+        std::atomic<uint64_t> g_numa(0);
+
+        std::atomic<size_t> g_huge_page_threshold(HUGE_PAGE);
+        std::atomic<int> g_numa_node(CpuAllocator::NUMA_NONE);
+
+        BlockHeader *header_of(void *mem) {
+            return reinterpret_cast<BlockHeader *>(mem) - 1;
+        }
+
+#ifdef TS_CPU_USE_MMAP
+        const size_t PAGE = 4096;
+
+        /**
+         * headers of mapped blocks, kept out of mapping, so whole huge pages are usable.
+         * never destroyed, blocks may be freed in other static destructors
+         */
+        std::unordered_map<void *, BlockHeader> &mapped_headers() {
+            static auto headers = new std::unordered_map<void *, BlockHeader>;
+            return *headers;
+        }
+
+        std::mutex &mapped_mutex() {
+            static auto mutex = new std::mutex;
+            return *mutex;
+        }
+#endif
+
+        /**
+         * @return header of block, mapped blocks start at page boundary with header in side table
+         */
+        BlockHeader block_of(void *mem) {
+#ifdef TS_CPU_USE_MMAP
+            if (reinterpret_cast<uintptr_t>(mem) % PAGE == 0) {
+                std::lock_guard<std::mutex> _lock(mapped_mutex());
+                auto &headers = mapped_headers();
+                auto it = headers.find(mem);
+                if (it != headers.end()) return it->second;
+            }
+#endif
+            return *header_of(mem);
+        }
+
+        void count_in(const BlockHeader &header) {
+            ++g_blocks;
+            auto memory = g_memory += header.size;
+            auto peak = g_peak.load();
+            while (memory > peak && !g_peak.compare_exchange_weak(peak, memory)) {}
+            if (header.mapped) g_huge += header.size;
+            if (header.numa) g_numa += header.size;
+        }
+
+        void count_out(const BlockHeader &header) {
+            --g_blocks;
+            g_memory -= header.size;
+            if (header.mapped) g_huge -= header.size;
+            if (header.numa) g_numa -= header.size;
+        }
+
+#ifdef TS_CPU_USE_MMAP
+        int local_numa_node() {
+#ifdef SYS_getcpu
+            unsigned cpu = 0, node = 0;
+            if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return int(node);
+#endif
+            return CpuAllocator::NUMA_NONE;
+        }
+
+        /**
+         * prefer node for pages in [addr, addr + size), must be called before first touching
+         * @return if bound
+         */
+        bool bind_numa_node(void *addr, size_t size, int node) {
+#ifdef SYS_mbind
+            if (node == CpuAllocator::NUMA_LOCAL) node = local_numa_node();
+            if (node < 0 || node >= int(sizeof(unsigned long) * 8)) return false;
+            const int MPOL_PREFERRED_MODE = 1;
+            unsigned long mask = 1UL << node;
+            return syscall(SYS_mbind, addr, size, MPOL_PREFERRED_MODE, &mask, sizeof(mask) * 8 + 1, 0) == 0;
+#else
+            (void)(addr), (void)(size), (void)(node);
+            return false;
+#endif
+        }
+
+        void *mapped_alloc(int id, size_t size) {
+            auto mapped = (size + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+            auto raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) throw OutOfMemoryException(MemoryDevice(CPU, id), size);
+#ifdef MADV_HUGEPAGE
+            madvise(raw, mapped, MADV_HUGEPAGE);
+#endif
+            auto numa = g_numa_node.load();
+            auto bound = numa != CpuAllocator::NUMA_NONE && bind_numa_node(raw, mapped, numa);
+            auto header = BlockHeader{raw, size, mapped, bound};
+            {
+                std::lock_guard<std::mutex> _lock(mapped_mutex());
+                mapped_headers()[raw] = header;
+            }
+            count_in(header);
+            return raw;
+        }
+#endif
+
+        void *aligned_alloc(int id, size_t size) {
+            // room for header and padding must not overflow
+            if (size > SIZE_MAX - HUGE_PAGE) throw OutOfMemoryException(MemoryDevice(CPU, id), size);
+#ifdef TS_CPU_USE_MMAP
+            auto threshold = g_huge_page_threshold.load();
+            if (threshold && size >= threshold) {
+                return mapped_alloc(id, size);
+            }
+#endif
+            auto raw = std::malloc(size + sizeof(BlockHeader) + ALIGNMENT - 1);
+            if (raw == nullptr) throw OutOfMemoryException(MemoryDevice(CPU, id), size);
+            auto begin = reinterpret_cast<uintptr_t>(raw) + sizeof(BlockHeader);
+            auto mem = reinterpret_cast<void *>((begin + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT);
+            *header_of(mem) = BlockHeader{raw, size, 0, false};
+            count_in(*header_of(mem));
+            return mem;
+        }
+
+        void aligned_free(void *mem) {
+            auto header = block_of(mem);
+            count_out(header);
+#ifdef TS_CPU_USE_MMAP
+            if (header.mapped) {
+                {
+                    std::lock_guard<std::mutex> _lock(mapped_mutex());
+                    mapped_headers().erase(mem);
+                }
+                munmap(header.raw, header.mapped);
+                return;
+            }
+#endif
+            std::free(header.raw);
+        }
+    }
+
+    void *cpu_aligned_allocator(int id, size_t new_size, void *mem, size_t mem_size) {
+        if (new_size == 0) {
+            if (mem != nullptr) aligned_free(mem);
+            return nullptr;
+        }
+        auto new_mem = aligned_alloc(id, new_size);
+        if (mem != nullptr) {
+            // keep content only if mem_size given, as cpu_allocator does
+            if (mem_size) std::memcpy(new_mem, mem, std::min(new_size, block_of(mem).size));
+            aligned_free(mem);
+        }
+        return new_mem;
+    }
+
     void
     cpu_converter(int dst_id, void *dst, int src_id, const void *src, size_t size) {
         TS_UNUSED(dst_id);
         TS_UNUSED(src_id);
         std::memcpy(dst, src, size);
     }
+
+    size_t CpuAllocator::Alignment() {
+        return ALIGNMENT;
+    }
+
+    static std::atomic<bool> &selected_system() {
+        static std::atomic<bool> system(false);
+        return system;
+    }
+
+    void CpuAllocator::Select(const std::string &name) {
+        if (name == "aligned") {
+            HardAllocator::Register(CPU, cpu_aligned_allocator);
+            selected_system() = false;
+        } else if (name == "system") {
+            HardAllocator::Register(CPU, cpu_allocator);
+            selected_system() = true;
+        } else {
+            TS_LOG_ERROR << "Unknown cpu allocator \"" << name << "\", use one of aligned or system" << eject;
+        }
+    }
+
+    std::string CpuAllocator::Selected() {
+        return selected_system() ? "system" : "aligned";
+    }
+
+    void CpuAllocator::SetHugePageThreshold(size_t threshold) {
+        g_huge_page_threshold = threshold;
+    }
+
+    size_t CpuAllocator::GetHugePageThreshold() {
+        return g_huge_page_threshold;
+    }
+
+    void CpuAllocator::SetNumaNode(int node) {
+        g_numa_node = node < 0 && node != NUMA_LOCAL ? int(NUMA_NONE) : node;
+    }
+
+    int CpuAllocator::GetNumaNode() {
+        return g_numa_node;
+    }
+
+    CpuAllocator::Stats CpuAllocator::GetStats() {
+        Stats stats;
+        stats.blocks = g_blocks;
+        stats.memory = g_memory;
+        stats.peak = g_peak;
+        stats.huge = g_huge;
+        stats.numa = g_numa;
+        return stats;
+    }
+
+    std::string CpuAllocator::Summary() {
+        auto stats = GetStats();
+        std::ostringstream oss;
+        oss << "{\"name\": \"" << Selected() << "\""
+            << ", \"blocks\": " << stats.blocks
+            << ", \"memory\": \"" << memory_size_string(stats.memory) << "\""
+            << ", \"peak\": \"" << memory_size_string(stats.peak) << "\""
+            << ", \"huge\": \"" << memory_size_string(stats.huge) << "\""
+            << ", \"numa\": \"" << memory_size_string(stats.numa) << "\""
+            << "}";
+        return oss.str();
+    }
+
+    /**
+     * register CPU allocator, with settings from environment
+     */
+    static void register_cpu_allocator() {
+        auto allocator = std::getenv("TS_CPU_ALLOCATOR");
+        if (allocator != nullptr && std::strcmp(allocator, "system") == 0) {
+            CpuAllocator::Select("system");
+        } else {
+            if (allocator != nullptr && *allocator != '\0' && std::strcmp(allocator, "aligned") != 0) {
+                TS_LOG_ERROR << "Ignore unknown TS_CPU_ALLOCATOR=" << allocator << ", use one of aligned or system";
+            }
+            CpuAllocator::Select("aligned");
+        }
+        auto huge_page = std::getenv("TS_CPU_HUGE_PAGE");
+        if (huge_page != nullptr && *huge_page != '\0') {
+            CpuAllocator::SetHugePageThreshold(size_t(std::strtoull(huge_page, nullptr, 10)));
+        }
+        auto numa = std::getenv("TS_CPU_NUMA");
+        if (numa != nullptr && *numa != '\0') {
+            CpuAllocator::SetNumaNode(std::strcmp(numa, "local") == 0
+                                      ? int(CpuAllocator::NUMA_LOCAL)
+                                      : std::atoi(numa));
+        }
+    }
 }
 
-TS_STATIC_ACTION(ts::HardAllocator::Register, ts::CPU, ts::cpu_allocator)
+TS_STATIC_ACTION(ts::register_cpu_allocator)
 
 TS_STATIC_ACTION(ts::HardConverter::Register, ts::CPU, ts::CPU, ts::cpu_converter)
 
-TS_STATIC_ACTION(ts::ComputingMemory::Register, ts::CPU, ts::CPU)
\ No newline at end of file
+TS_STATIC_ACTION(ts::ComputingMemory::Register, ts::CPU, ts::CPU)
@@ -0,0 +1,459 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "kernels/cpu/nchwc.h"
+
+#include "backend/name.h"
+#include "global/operator_factory.h"
+#include "runtime/inside/parallel.h"
+#include "kernels/cpu/isa.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace ts {
+    namespace cpu {
+        static void check_nchwc(const Operator &op, const Tensor &x, int block) {
+            if (x.dtype() != FLOAT32) {
+                TS_LOG_ERROR << op.op() << " not support data type(" << x.dtype() << "): " << type_str(x.dtype()) << eject;
+            }
+            if (block != 4 && block != 8) {
+                TS_LOG_ERROR << op.op() << " not support block: " << block << eject;
+            }
+        }
+
+        void ToNCHWc::to_nchwc(const Tensor &x, int block, Tensor &out) {
+            check_nchwc(*this, x, block);
+
+            auto number = x.size(0);
+            auto channels = x.size(1);
+            auto spatial = x.size(2) * x.size(3);
+            auto channel_blocks = out.size(1);
+            auto px = x.data<float>();
+            auto pout = out.data<float>();
+
+            TS_PARALLEL_FOR_BEGIN(nb, 0, number * channel_blocks)
+                auto n = nb / channel_blocks;
+                auto c = nb % channel_blocks * block;
+                auto valid = std::min(block, channels - c);
+                auto src = px + (n * channels + c) * spatial;
+                auto dst = pout + nb * spatial * block;
+                for (int i = 0; i < spatial; ++i) {
+                    for (int b = 0; b < valid; ++b) dst[b] = src[b * spatial + i];
+                    for (int b = valid; b < block; ++b) dst[b] = 0;
+                    dst += block;
+                }
+            TS_PARALLEL_FOR_END()
+        }
+
+        void FromNCHWc::from_nchwc(const Tensor &x, int channels, Tensor &out) {
+            auto block = x.size(4);
+            check_nchwc(*this, x, block);
+
+            auto number = x.size(0);
+            auto spatial = x.size(2) * x.size(3);
+            auto channel_blocks = x.size(1);
+            auto px = x.data<float>();
+            auto pout = out.data<float>();
+
+            TS_PARALLEL_FOR_BEGIN(nb, 0, number * channel_blocks)
+                auto n = nb / channel_blocks;
+                auto c = nb % channel_blocks * block;
+                auto valid = std::min(block, channels - c);
+                auto src = px + nb * spatial * block;
+                auto dst = pout + (n * channels + c) * spatial;
+                for (int i = 0; i < spatial; ++i) {
+                    for (int b = 0; b < valid; ++b) dst[b * spatial + i] = src[b];
+                    src += block;
+                }
+            TS_PARALLEL_FOR_END()
+        }
+
+        /**
+         * out[p][o] = sum_t sum_b inputs[t][offset + p * step + b] * weights[t][weight_offset + b * B + o]
+         */
+        template<int B, int P>
+        static inline void conv2d_nchwc_pixels(int taps, const float *const *inputs, int offset,
+                                               const float *const *weights, int weight_offset, int step, float *out) {
+            float sum[P][B] = {};
+            for (int t = 0; t < taps; ++t) {
+                auto in = inputs[t] + offset;
+                auto w = weights[t] + weight_offset;
+                for (int b = 0; b < B; ++b) {
+                    for (int p = 0; p < P; ++p) {
+                        auto v = in[p * step + b];
+                        for (int o = 0; o < B; ++o) sum[p][o] += v * w[o];
+                    }
+                    w += B;
+                }
+            }
+            for (int p = 0; p < P; ++p) {
+                for (int o = 0; o < B; ++o) out[p * B + o] = sum[p][o];
+            }
+        }
+
+        /**
+         * generic version of ISAKernels::conv2d_nchw8c_tile for any block
+         */
+        template<int B>
+        static void conv2d_nchwc_tile(int taps, const float *const *inputs, int offset,
+                                      const float *const *weights, int weight_stride, int step, int pixels,
+                                      int blocks, float *out, int out_stride) {
+            // keep P * B accumulators in registers
+            static const int P = 32 / B;
+            for (int j = 0; j < blocks; ++j) {
+                auto weight_offset = j * weight_stride;
+                auto out_block = out + j * out_stride;
+                int p = 0;
+                for (; p + P <= pixels; p += P) {
+                    conv2d_nchwc_pixels<B, P>(taps, inputs, offset + p * step, weights, weight_offset, step,
+                                              out_block + p * B);
+                }
+                for (; p < pixels; ++p) {
+                    conv2d_nchwc_pixels<B, 1>(taps, inputs, offset + p * step, weights, weight_offset, step,
+                                              out_block + p * B);
+                }
+            }
+        }
+
+        /**
+         * epilogue of one output block, values of blocked channels are interleaved
+         */
+        template<int B>
+        class BlockEpilogue {
+        public:
+            BlockEpilogue(const base::Conv2DEpilogue &epilogue, int block_index)
+                    : activation(epilogue.activation), max(epilogue.max) {
+                auto c = block_index * B;
+                for (int o = 0; o < B; ++o) {
+                    bias[o] = epilogue.bias.empty() ? 0.0f : epilogue.bias.data<float>()[c + o];
+                    if (epilogue.slope.empty()) {
+                        slope[o] = 0;
+                    } else if (epilogue.slope.count() == 1) {
+                        slope[o] = epilogue.slope.data<float>()[0];
+                    } else {
+                        slope[o] = epilogue.slope.data<float>()[c + o];
+                    }
+                }
+            }
+
+            /**
+             * apply on pixels of out in place
+             */
+            void operator()(int pixels, float *out) const {
+                for (int p = 0; p < pixels; ++p) {
+                    for (int o = 0; o < B; ++o) {
+                        auto v = out[o] + bias[o];
+                        switch (activation) {
+                            default: break;
+                            case FusedActivation::RELU: v = std::max(v, 0.0f); break;
+                            case FusedActivation::RELU_MAX: v = std::min(std::max(v, 0.0f), max); break;
+                            case FusedActivation::LEAKY_RELU: v = v > 0 ? v : v * slope[o]; break;
+                        }
+                        out[o] = v;
+                    }
+                    out += B;
+                }
+            }
+
+        private:
+            FusedActivation activation;
+            float max;
+            float bias[B];
+            float slope[B];
+        };
+
+        /**
+         * @return [begin, end) of output index, where all kernel taps are in input
+         */
+        static std::pair<int, int> inside_range(int input, int output, int pad, int kernel, int stride, int dilation) {
+            int begin = (pad + stride - 1) / stride;
+            int last = input - 1 + pad - (kernel - 1) * dilation;
+            int end = last < 0 ? 0 : last / stride + 1;
+            begin = std::min(begin, output);
+            end = std::max(std::min(end, output), begin);
+            return std::make_pair(begin, end);
+        }
+
+        template<int B>
+        static void cpu_conv2d_nchwc_compute_run(const Tensor &x, const Padding2D &padding, const Tensor &w,
+                                                 const Stride2D &stride, const Dilation2D &dilation,
+                                                 const base::Conv2DEpilogue &epilogue, Tensor &out) {
+            auto number = x.size(0);
+            auto input_blocks = x.size(1);
+            auto input_height = x.size(2);
+            auto input_width = x.size(3);
+            auto output_blocks = w.size(0);
+            auto kernel_height = w.size(2);
+            auto kernel_width = w.size(3);
+            auto output_height = out.size(2);
+            auto output_width = out.size(3);
+
+            // pointwise conv2d on contiguous plane is conv2d on one row, so tiles are not cut at row ends
+            if (kernel_height == 1 && kernel_width == 1 && stride.height == 1 && stride.width == 1 &&
+                padding.top == 0 && padding.bottom == 0 && padding.left == 0 && padding.right == 0) {
+                input_width *= input_height;
+                output_width *= output_height;
+                input_height = output_height = 1;
+            }
+
+            auto px = x.data<float>();
+            auto pw = w.data<float>();
+            auto pout = out.data<float>();
+
+            auto inside = inside_range(input_width, output_width, padding.left, kernel_width,
+                                       stride.width, dilation.width);
+            auto step = stride.width * B;
+            auto taps_count = input_blocks * kernel_height * kernel_width;
+            auto weight_stride = taps_count * B * B;
+            auto out_stride = output_height * output_width * B;
+
+            // micro kernel of cpu instruction set computes group_blocks output blocks at once
+            auto tile = conv2d_nchwc_tile<B>;
+            int group_blocks = 1;
+            auto &kernels = isa_kernels();
+            if (B == 8 && kernels.conv2d_nchw8c_tile) {
+                tile = kernels.conv2d_nchw8c_tile;
+                group_blocks = kernels.conv2d_nchw8c_blocks;
+            }
+            auto groups = (output_blocks + group_blocks - 1) / group_blocks;
+
+            TS_PARALLEL_RANGE_BEGIN(range, 0, number * groups * output_height)
+                std::vector<const float *> row_inputs(taps_count), row_weights(taps_count);
+                std::vector<const float *> pixel_inputs(taps_count), pixel_weights(taps_count);
+                for (auto row = range.first; row < range.second; ++row) {
+                    auto oh = row % output_height;
+                    auto group = row / output_height % groups;
+                    auto n = row / output_height / groups;
+                    auto ob = group * group_blocks;
+                    auto blocks = std::min(group_blocks, output_blocks - ob);
+
+                    auto out_row = pout + ((n * output_blocks + ob) * output_height + oh) * output_width * B;
+                    auto ih0 = oh * stride.height - padding.top;
+                    auto iw0 = -padding.left;
+
+                    // taps of pixel at output 0, move by step for next pixels
+                    int taps = 0;
+                    for (int ib = 0; ib < input_blocks; ++ib) {
+                        auto in_plane = px + (n * input_blocks + ib) * input_height * input_width * B;
+                        auto w_block = pw + (ob * input_blocks + ib) * kernel_height * kernel_width * B * B;
+                        for (int kh = 0; kh < kernel_height; ++kh) {
+                            auto ih = ih0 + kh * dilation.height;
+                            if (ih < 0 || ih >= input_height) continue;
+                            for (int kw = 0; kw < kernel_width; ++kw) {
+                                row_inputs[taps] = in_plane + (ih * input_width + iw0 + kw * dilation.width) * B;
+                                row_weights[taps] = w_block + (kh * kernel_width + kw) * B * B;
+                                ++taps;
+                            }
+                        }
+                    }
+
+                    auto apply_epilogue = [&](int ow, int pixels) {
+                        for (int j = 0; j < blocks; ++j) {
+                            BlockEpilogue<B> apply(epilogue, ob + j);
+                            apply(pixels, out_row + j * out_stride + ow * B);
+                        }
+                    };
+
+                    auto compute_pixel = [&](int ow) {
+                        int pixel_taps = 0;
+                        auto offset = ow * step;
+                        for (int t = 0; t < taps; ++t) {
+                            auto kw = t % kernel_width;
+                            auto iw = ow * stride.width + iw0 + kw * dilation.width;
+                            if (iw < 0 || iw >= input_width) continue;
+                            pixel_inputs[pixel_taps] = row_inputs[t] + offset;
+                            pixel_weights[pixel_taps] = row_weights[t];
+                            ++pixel_taps;
+                        }
+                        tile(pixel_taps, pixel_inputs.data(), 0, pixel_weights.data(), weight_stride, step, 1,
+                             blocks, out_row + ow * B, out_stride);
+                        apply_epilogue(ow, 1);
+                    };
+
+                    int ow = 0;
+                    for (; ow < inside.first; ++ow) compute_pixel(ow);
+                    if (ow < inside.second) {
+                        auto pixels = inside.second - ow;
+                        tile(taps, row_inputs.data(), ow * step, row_weights.data(), weight_stride, step, pixels,
+                             blocks, out_row + ow * B, out_stride);
+                        apply_epilogue(ow, pixels);
+                        ow += pixels;
+                    }
+                    for (; ow < output_width; ++ow) compute_pixel(ow);
+                }
+            TS_PARALLEL_RANGE_END()
+        }
+
+        void Conv2DNCHWc::conv2d(const Tensor &x, const Padding2D &padding, const Tensor &w,
+                                 const Stride2D &stride, const Dilation2D &dilation,
+                                 const base::Conv2DEpilogue &epilogue, Tensor &out) {
+            auto block = x.size(4);
+            check_nchwc(*this, x, block);
+            if (block == 8) {
+                cpu_conv2d_nchwc_compute_run<8>(x, padding, w, stride, dilation, epilogue, out);
+            } else {
+                cpu_conv2d_nchwc_compute_run<4>(x, padding, w, stride, dilation, epilogue, out);
+            }
+        }
+
+        template<int B>
+        static void cpu_depthwise_conv2d_nchwc_compute_run(const Tensor &x, const Padding2D &padding, const Tensor &w,
+                                                           const Stride2D &stride, const Dilation2D &dilation,
+                                                           const base::Conv2DEpilogue &epilogue, Tensor &out) {
+            auto number = x.size(0);
+            auto blocks = x.size(1);
+            auto input_height = x.size(2);
+            auto input_width = x.size(3);
+            auto kernel_height = w.size(1);
+            auto kernel_width = w.size(2);
+            auto output_height = out.size(2);
+            auto output_width = out.size(3);
+
+            auto px = x.data<float>();
+            auto pw = w.data<float>();
+            auto pout = out.data<float>();
+
+            auto inside = inside_range(input_width, output_width, padding.left, kernel_width,
+                                       stride.width, dilation.width);
+
+            TS_PARALLEL_FOR_BEGIN(row, 0, number * blocks * output_height)
+                auto oh = row % output_height;
+                auto nb = row / output_height;
+                auto b = nb % blocks;
+                auto in_plane = px + nb * input_height * input_width * B;
+                auto w_block = pw + b * kernel_height * kernel_width * B;
+                auto out_row = pout + row * output_width * B;
+                auto ih0 = oh * stride.height - padding.top;
+                BlockEpilogue<B> apply(epilogue, b);
+                for (int ow = 0; ow < output_width; ++ow) {
+                    float acc[B] = {};
+                    auto iw0 = ow * stride.width - padding.left;
+                    for (int kh = 0; kh < kernel_height; ++kh) {
+                        auto ih = ih0 + kh * dilation.height;
+                        if (ih < 0 || ih >= input_height) continue;
+                        auto in_row = in_plane + ih * input_width * B;
+                        auto w_row = w_block + kh * kernel_width * B;
+                        if (ow >= inside.first && ow < inside.second) {
+                            auto in = in_row + iw0 * B;
+                            for (int kw = 0; kw < kernel_width; ++kw) {
+                                auto wk = w_row + kw * B;
+                                for (int o = 0; o < B; ++o) acc[o] += in[o] * wk[o];
+                                in += dilation.width * B;
+                            }
+                            continue;
+                        }
+                        for (int kw = 0; kw < kernel_width; ++kw) {
+                            auto iw = iw0 + kw * dilation.width;
+                            if (iw < 0 || iw >= input_width) continue;
+                            auto in = in_row + iw * B;
+                            auto wk = w_row + kw * B;
+                            for (int o = 0; o < B; ++o) acc[o] += in[o] * wk[o];
+                        }
+                    }
+                    for (int o = 0; o < B; ++o) out_row[o] = acc[o];
+                    out_row += B;
+                }
+                apply(output_width, out_row - output_width * B);
+            TS_PARALLEL_FOR_END()
+        }
+
+        void DepthwiseConv2DNCHWc::conv2d(const Tensor &x, const Padding2D &padding, const Tensor &w,
+                                          const Stride2D &stride, const Dilation2D &dilation,
+                                          const base::Conv2DEpilogue &epilogue, Tensor &out) {
+            auto block = x.size(4);
+            check_nchwc(*this, x, block);
+            if (block == 8) {
+                cpu_depthwise_conv2d_nchwc_compute_run<8>(x, padding, w, stride, dilation, epilogue, out);
+            } else {
+                cpu_depthwise_conv2d_nchwc_compute_run<4>(x, padding, w, stride, dilation, epilogue, out);
+            }
+        }
+
+        template<int B>
+        static void cpu_pooling2d_nchwc_compute_run(const Tensor &x, Pooling2DType type, const Padding2D &padding,
+                                                    Padding2DType padding_type, const KSize2D &ksize,
+                                                    const Stride2D &stride, Tensor &out) {
+            auto number = x.size(0);
+            auto blocks = x.size(1);
+            auto input_height = x.size(2);
+            auto input_width = x.size(3);
+            auto output_height = out.size(2);
+            auto output_width = out.size(3);
+
+            auto px = x.data<float>();
+            auto pout = out.data<float>();
+
+            bool is_max = type == Pooling2DType::MAX;
+            // black padding is not counted in average, white padding is counted as zero
+            bool count_padding = padding_type == Padding2DType::WHITE;
+
+            TS_PARALLEL_FOR_BEGIN(row, 0, number * blocks * output_height)
+                auto oh = row % output_height;
+                auto nb = row / output_height;
+                auto in_plane = px + nb * input_height * input_width * B;
+                auto out_row = pout + row * output_width * B;
+                auto ih_begin = oh * stride.height - padding.top;
+                auto ih_end = std::min(ih_begin + ksize.height, input_height);
+                ih_begin = std::max(ih_begin, 0);
+                for (int ow = 0; ow < output_width; ++ow) {
+                    auto iw_begin = ow * stride.width - padding.left;
+                    auto iw_end = std::min(iw_begin + ksize.width, input_width);
+                    iw_begin = std::max(iw_begin, 0);
+
+                    float acc[B];
+                    for (int o = 0; o < B; ++o) acc[o] = is_max ? -std::numeric_limits<float>::infinity() : 0.0f;
+                    for (int ih = ih_begin; ih < ih_end; ++ih) {
+                        for (int iw = iw_begin; iw < iw_end; ++iw) {
+                            auto in = in_plane + (ih * input_width + iw) * B;
+                            if (is_max) {
+                                for (int o = 0; o < B; ++o) acc[o] = std::max(acc[o], in[o]);
+                            } else {
+                                for (int o = 0; o < B; ++o) acc[o] += in[o];
+                            }
+                        }
+                    }
+
+                    auto count = std::max(ih_end - ih_begin, 0) * std::max(iw_end - iw_begin, 0);
+                    if (count == 0) {
+                        for (int o = 0; o < B; ++o) out_row[o] = 0;
+                    } else if (is_max) {
+                        for (int o = 0; o < B; ++o) out_row[o] = acc[o];
+                    } else {
+                        float scale = 1.0f / (count_padding ? ksize.height * ksize.width : count);
+                        for (int o = 0; o < B; ++o) out_row[o] = acc[o] * scale;
+                    }
+                    out_row += B;
+                }
+            TS_PARALLEL_FOR_END()
+        }
+
+        void Pooling2DNCHWc::pooling2d(const Tensor &x, Pooling2DType type, const Padding2D &padding,
+                                       Padding2DType padding_type, const KSize2D &ksize, const Stride2D &stride,
+                                       Tensor &out) {
+            auto block = x.size(4);
+            check_nchwc(*this, x, block);
+            if (type != Pooling2DType::MAX && type != Pooling2DType::AVG) {
+                TS_LOG_ERROR << op() << " only support MAX and AVG pooling" << eject;
+            }
+            if (padding_type != Padding2DType::BLACK && padding_type != Padding2DType::WHITE) {
+                TS_LOG_ERROR << op() << " only support BLACK and WHITE padding" << eject;
+            }
+            if (block == 8) {
+                cpu_pooling2d_nchwc_compute_run<8>(x, type, padding, padding_type, ksize, stride, out);
+            } else {
+                cpu_pooling2d_nchwc_compute_run<4>(x, type, padding, padding_type, ksize, stride, out);
+            }
+        }
+    }
+}
+
+using namespace ts;
+using namespace cpu;
+TS_REGISTER_OPERATOR(ToNCHWc, CPU, name::layer::to_nchwc())
+TS_REGISTER_OPERATOR(FromNCHWc, CPU, name::layer::from_nchwc())
+TS_REGISTER_OPERATOR(Conv2DNCHWc, CPU, name::layer::conv2d_nchwc())
+TS_REGISTER_OPERATOR(DepthwiseConv2DNCHWc, CPU, name::layer::depthwise_conv2d_nchwc())
+TS_REGISTER_OPERATOR(Pooling2DNCHWc, CPU, name::layer::pooling2d_nchwc())
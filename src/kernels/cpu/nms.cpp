@@ -0,0 +1,60 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "kernels/cpu/nms.h"
+#include "kernels/common/simd.h"
+
+namespace ts {
+    namespace cpu {
+        void NMSKept::clear() {
+            m_x1.clear();
+            m_y1.clear();
+            m_x2.clear();
+            m_y2.clear();
+            m_area.clear();
+        }
+
+        void NMSKept::reserve(size_t n) {
+            m_x1.reserve(n);
+            m_y1.reserve(n);
+            m_x2.reserve(n);
+            m_y2.reserve(n);
+            m_area.reserve(n);
+        }
+
+        void NMSKept::keep(float x1, float y1, float x2, float y2, float area) {
+            m_x1.push_back(x1);
+            m_y1.push_back(y1);
+            m_x2.push_back(x2);
+            m_y2.push_back(y2);
+            m_area.push_back(area);
+        }
+
+        bool NMSKept::overlapped(float x1, float y1, float x2, float y2, float area, float threshold) const {
+            auto count = int(m_x1.size());
+            int i = 0;
+
+            // NaN of zero union never greater than threshold
+            float32x4 box_x1(x1), box_y1(y1), box_x2(x2), box_y2(y2), box_area(area);
+            float32x4 zero(0.0f);
+            float iou[4];
+            for (; i + 3 < count; i += 4) {
+                float32x4 inter_w = max_float32x4(
+                        min_float32x4(box_x2, float32x4(&m_x2[i])) - max_float32x4(box_x1, float32x4(&m_x1[i])), zero);
+                float32x4 inter_h = max_float32x4(
+                        min_float32x4(box_y2, float32x4(&m_y2[i])) - max_float32x4(box_y1, float32x4(&m_y1[i])), zero);
+                float32x4 inter = inter_w * inter_h;
+                (inter / (box_area + float32x4(&m_area[i]) - inter)).store(iou);
+                if (iou[0] > threshold || iou[1] > threshold || iou[2] > threshold || iou[3] > threshold) return true;
+            }
+            for (; i < count; ++i) {
+                float inter_w = std::max(std::min(x2, m_x2[i]) - std::max(x1, m_x1[i]), 0.0f);
+                float inter_h = std::max(std::min(y2, m_y2[i]) - std::max(y1, m_y1[i]), 0.0f);
+                float inter = inter_w * inter_h;
+                if (inter / (area + m_area[i] - inter) > threshold) return true;
+            }
+            return false;
+        }
+    }
+}
@@ -1,60 +1,29 @@
 #include "kernels/cpu/non_max_suppression_v3.h"
 #include "global/operator_factory.h"
 #include "backend/name.h"
+#include "kernels/cpu/nms.h"
 #include <vector>
 #include <numeric>
-#include <queue>
+#include <cstring>
 
 namespace ts {
     namespace cpu {
 
+        /**
+         * get box i in corner form, xywh of mode 1 or xyxy of mode 0
+         */
         template <typename T>
-        static inline bool check_suppress(
-                            const T* boxes, int i, int j, T iou_threshold, int mode) {
-
-            T ymin_i,xmin_i,ymax_i,xmax_i;
-            T ymin_j,xmin_j,ymax_j,xmax_j;
-            T area_i,area_j;
-
-            if(mode == 1) {
-                ymin_i = std::min<T>(boxes[i * 4 + 0], boxes[i * 4 + 0] + boxes[i * 4 + 2]);
-                xmin_i = std::min<T>(boxes[i * 4 + 1], boxes[i * 4 + 1] + boxes[i * 4 + 3]);
-                ymax_i = std::max<T>(boxes[i * 4 + 0], boxes[i * 4 + 0] + boxes[i * 4 + 2]);
-                xmax_i = std::max<T>(boxes[i * 4 + 1], boxes[i * 4 + 1] + boxes[i * 4 + 3]);
-
-                ymin_j = std::min<T>(boxes[j * 4 + 0], boxes[j * 4 + 0] + boxes[j * 4 + 2]);
-                xmin_j = std::min<T>(boxes[j * 4 + 1], boxes[j * 4 + 1] + boxes[j * 4 + 3]);
-                ymax_j = std::max<T>(boxes[j * 4 + 0], boxes[j * 4 + 0] + boxes[j * 4 + 2]);
-                xmax_j = std::max<T>(boxes[j * 4 + 1], boxes[j * 4 + 1] + boxes[j * 4 + 3]);
-
-            }else {
-                ymin_i = std::min<T>(boxes[i * 4 + 0], boxes[i * 4 + 2]);
-                xmin_i = std::min<T>(boxes[i * 4 + 1], boxes[i * 4 + 3]);
-                ymax_i = std::max<T>(boxes[i * 4 + 0], boxes[i * 4 + 2]);
-                xmax_i = std::max<T>(boxes[i * 4 + 1], boxes[i * 4 + 3]);
-                ymin_j = std::min<T>(boxes[j * 4 + 0], boxes[j * 4 + 2]);
-                xmin_j = std::min<T>(boxes[j * 4 + 1], boxes[j * 4 + 3]);
-                ymax_j = std::max<T>(boxes[j * 4 + 0], boxes[j * 4 + 2]);
-                xmax_j = std::max<T>(boxes[j * 4 + 1], boxes[j * 4 + 3]);
-            }
-
-            area_i = (ymax_i - ymin_i  ) * (xmax_i - xmin_i );
-            area_j = (ymax_j - ymin_j  ) * (xmax_j - xmin_j );
-
-            if (area_i <= static_cast<T>(0) || area_j <= static_cast<T>(0)) return 0;
-            const T intersection_ymin = std::max<T>(ymin_i, ymin_j);
-            const T intersection_xmin = std::max<T>(xmin_i, xmin_j);
-            const T intersection_ymax = std::min<T>(ymax_i, ymax_j);
-            const T intersection_xmax = std::min<T>(xmax_i, xmax_j);
-
-            const T intersection_area =
-            std::max<T>(intersection_ymax - intersection_ymin  , static_cast<T>(0.0)) *
-            std::max<T>(intersection_xmax - intersection_xmin  , static_cast<T>(0.0));
-            const T iou = intersection_area / (area_i + area_j - intersection_area);
-
-            return iou > iou_threshold;
-       }
-
+        static inline void get_corners(const T *boxes, int i, int mode,
+                                       float &ymin, float &xmin, float &ymax, float &xmax) {
+            T y0 = boxes[i * 4 + 0];
+            T x0 = boxes[i * 4 + 1];
+            T y1 = mode == 1 ? T(y0 + boxes[i * 4 + 2]) : boxes[i * 4 + 2];
+            T x1 = mode == 1 ? T(x0 + boxes[i * 4 + 3]) : boxes[i * 4 + 3];
+            ymin = float(std::min<T>(y0, y1));
+            xmin = float(std::min<T>(x0, x1));
+            ymax = float(std::max<T>(y0, y1));
+            xmax = float(std::max<T>(x0, x1));
+        }
 
         template <typename T>
         static void cpu_non_max_suppression_v3_compute_run(const Tensor &x, const Tensor &scores,
@@ -70,43 +39,35 @@ namespace ts {
                 nmode = 0;
             }
 
-            struct Candidate {
-                int box_index;
-                float score;
-            };
-
-            auto cmp = [](const Candidate bs_i, const Candidate bs_j) {
-                return bs_i.score < bs_j.score;
-            };
-            std::priority_queue<Candidate, std::deque<Candidate>, decltype(cmp)>
-                 candidate_priority_queue(cmp);
+            std::vector<int> candidates;
             for (int i = 0; i < scores.count(); ++i) {
-                if (scores_data[i] > score_threshold) {
-                    candidate_priority_queue.emplace(Candidate({i, scores_data[i]}));
-                }
+                if (scores_data[i] > score_threshold) candidates.push_back(i);
             }
+            auto cmp = [scores_data](int a, int b) {
+                return scores_data[a] > scores_data[b] || (scores_data[a] == scores_data[b] && a < b);
+            };
 
-            std::vector<int> selected;
-            std::vector<float> selected_scores;
-            Candidate next_candidate;
- 
-            while (selected.size() < max_output && !candidate_priority_queue.empty()) {
-                next_candidate = candidate_priority_queue.top();
-                candidate_priority_queue.pop();
-
-                bool should_select = true;
+            // most candidates are never visited once max_output boxes selected, so sort them chunk by chunk
+            const size_t chunk = std::max<size_t>(size_t(std::max(max_output, 0)) * 4, 256);
+            size_t sorted = 0;
 
-                for (int j = static_cast<int>(selected.size()) - 1; j >= 0; --j) {
-                    if (check_suppress<T>(p_xdata, next_candidate.box_index, selected[j], T(iou_threshold), nmode)) {
-                        should_select = false;
-                        break;
-                    }
-                }
+            NMSKept kept;
+            kept.reserve(size_t(std::max(max_output, 0)));
+            std::vector<int> selected;
 
-                if (should_select) {
-                    selected.push_back(next_candidate.box_index);
-                    selected_scores.push_back(next_candidate.score);
+            for (size_t c = 0; c < candidates.size() && selected.size() < size_t(max_output); ++c) {
+                if (c == sorted) {
+                    sorted = std::min(candidates.size(), sorted + chunk);
+                    select_sort(candidates.begin() + c, candidates.begin() + sorted, candidates.end(), cmp);
                 }
+                auto index = candidates[c];
+                float ymin, xmin, ymax, xmax;
+                get_corners(p_xdata, index, nmode, ymin, xmin, ymax, xmax);
+                float area = (ymax - ymin) * (xmax - xmin);
+                // box with no area suppress nothing and never be suppressed
+                if (area > 0 && kept.overlapped(xmin, ymin, xmax, ymax, area, iou_threshold)) continue;
+                selected.push_back(index);
+                if (area > 0) kept.keep(xmin, ymin, xmax, ymax, area);
             }
 
             ::memset(p_outdata, -1, sizeof(int32_t) * max_output);
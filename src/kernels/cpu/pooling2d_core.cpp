@@ -243,6 +243,15 @@ namespace ts {
                 DECLARE_COMPUTE_RUN(FLOAT32, float);
                 DECLARE_COMPUTE_RUN(FLOAT64, double);
 #undef DECLARE_COMPUTE_RUN
+                case INT8: {
+                    // max pooling commutes with quantization, so int8 activations can be pooled directly
+                    if (type != Pooling2DType::MAX) {
+                        TS_LOG_ERROR << "Pooling2D only support MAX pooling on int8" << eject;
+                    }
+                    cpu_max_pooling(x.data<int8_t>(), out.data<int8_t>(), x.sizes(), out.sizes(),
+                                    ksize, stride, padding);
+                    break;
+                }
                 default: {
                     TS_LOG_ERROR << "Pooling2D not support data type(" << dtype << "): " << type_str(dtype) << eject;
                     break;
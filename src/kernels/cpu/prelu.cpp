@@ -7,9 +7,7 @@
 #include <algorithm>
 
 #include "kernels/common/simd.h"
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "runtime/inside/parallel.h"
 
 namespace ts {
 	namespace cpu {
@@ -66,10 +64,7 @@ namespace ts {
             }
 
             for (int i = 0; i < pre_dims; i++) {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int j = 0; j < output_shape[dim]; j++) {
+                TS_PARALLEL_FOR_BEGIN(j, 0, output_shape[dim])
                     int offset = i * output_shape[dim] * last_dims + j * last_dims;
                     float val = slope_data[j];
                     float32x4 val_x4(val);
@@ -89,7 +84,7 @@ namespace ts {
                         output_data[k + offset] = std::max(input_data[k + offset], float(0)) +
                             val * std::min(input_data[k + offset], float(0));
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -6,9 +6,7 @@
 #include "global/operator_factory.h"
 
 #include "kernels/common/simd.h"
-#ifdef TS_USE_OPENMP
-#include "kernels/common/openmp.h"
-#endif
+#include "runtime/inside/parallel.h"
 
 namespace ts {
     namespace cpu {
@@ -44,12 +42,9 @@ namespace ts {
             float quantize_scale;
             if (quantize_group == 1) {
                 quantize_scale = quantize_scales[0];
-#ifdef TS_USE_OPENMP
-                #pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int i = 0; i < count; i++) {
+                TS_PARALLEL_FOR_BEGIN(i, 0, count)
                     output_data[i] = to_int8(input_data[i] * quantize_scale);
-                }
+                TS_PARALLEL_FOR_END()
             }
             else {
                 auto loop_count = int(std::ceil(static_cast<float>(count) / quantize_group));
@@ -79,10 +74,7 @@ namespace ts {
             int remain = count_4 << 3;
 
             float32x4x2 scale_x4x2(quantize_scale);
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int i = 0; i < count_4; i++){
+                TS_PARALLEL_FOR_BEGIN(i, 0, count_4)
                     int ii = i * 8;
                     float32x4x2 input_x4x2(&input_data[ii]);  
                     float32x4x2 output_x4x2 = input_x4x2 * scale_x4x2;
@@ -104,7 +96,7 @@ namespace ts {
                     //*(output_data + ii + 5) = to_int8(*(((float*)&(output_x4x2.value)) + 5));
                     //*(output_data + ii + 6) = to_int8(*(((float*)&(output_x4x2.value)) + 6));
                     //*(output_data + ii + 7) = to_int8(*(((float*)&(output_x4x2.value)) + 7));
-                }
+                TS_PARALLEL_FOR_END()
                 for (int i = remain; i < count; i++){
                     output_data[i] = to_int8(input_data[i] * quantize_scale);
                 }
@@ -2,10 +2,12 @@
 #include <core/tensor_builder.h>
 #include <kernels/cpu/math_cpu.h>
 #include <kernels/cpu/im2col.h>
+#include <kernels/cpu/quantized/int8_gemm.h>
 #include <global/operator_factory.h>
 #include <backend/name.h>
 #include <core/device.h>
 #include <utils/assert.h>
+#include <runtime/packed_weights.h>
 
 #include "kernels/common/simd.h"
 #ifdef TS_USE_OPENMP
@@ -18,7 +20,8 @@ namespace ts {
         template<typename T>
         static void cpu_conv2d_nchw_compute_run(const Tensor &x, const Padding2D &padding, float padding_value,
                                            const Tensor &w, const Stride2D &stride, const Dilation2D &dilation,
-                                           std::vector<float>dequantize_scales, Tensor &out, Stack &stack) {
+                                           std::vector<float>dequantize_scales, float requantize_scale,
+                                           Tensor &out, Stack &stack) {
             auto weight_shape = w.sizes();
             auto output_shape = out.sizes();
             auto x_shape = x.sizes();
@@ -35,10 +38,8 @@ namespace ts {
 
             const T *pinput = x.data<T>();
             const int8_t *pweight = w.data<T>();
-            float *poutput = out.data<float>(); 
 
-            Tensor output_int32 = stack.make(INT32, out.sizes(), MemoryDevice(CPU));
-            int32_t* poutput_int32 = output_int32.data<int32_t>();
+            bool requantize = out.dtype() == INT8;
 
             Tensor col_tensor;
             T *col_buffer = nullptr;
@@ -57,6 +58,16 @@ namespace ts {
                 col_buffer = col_tensor.data<T>();
             }
 
+            // pack int8 operands into int16 pairs for int8 gemm, constant weight is packed once for all workbenches
+            Tensor packed_weight_tensor = PackedWeights::Get(w, "int8_pack_A", [&](const Tensor &) {
+                Tensor packed(MemoryDevice(CPU), INT16, {int(Int8Gemm::pack_A_size(weight_shape[0], kernel_dims))});
+                Int8Gemm::pack_A(weight_shape[0], kernel_dims, pweight, kernel_dims, packed.data<int16_t>());
+                return packed;
+            });
+            auto packed_col_tensor = stack.make(INT16, {int(Int8Gemm::pack_B_size(kernel_dims, conv_out_spatial_dim))}, MemoryDevice(CPU));
+            auto packed_weight = packed_weight_tensor.data<int16_t>();
+            auto packed_col = packed_col_tensor.data<int16_t>();
+
             for (int i = 0; i < number; i++) {
                 if (is_1x1_conv) {
                     //std::memcpy(col_buffer,pinput,sizeof(T)*col_buffer_size);
@@ -71,70 +82,31 @@ namespace ts {
                                dilation.height, dilation.width,
                                col_buffer, T(padding_value));
                 }
-                cpu::math<T, int32_t>::gemm(ts::blas::NoTrans,ts::blas::NoTrans, weight_shape[0], conv_out_spatial_dim,
-                               kernel_dims, 1, pweight, col_buffer, 0, poutput_int32);
-                pinput += input_number_offset;
-                poutput_int32 += output_number_offset;
-            }
-
-            //NOTE:fuse Dequantize(int32 to fp32) in conv2d_quantize now.
-            auto input_data = output_int32.data<int32_t>();
-            auto out_shape = out.sizes();
-            int channal_offset = out_shape[2] * out_shape[3];
-            int num_offset = out_shape[1] * channal_offset;
-            for (int n = 0; n < out_shape[0]; n++){
-#ifdef TS_USE_OPENMP
-                #pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int c = 0; c < out_shape[1]; c++){
-                    auto input_cur = input_data + n * num_offset + c * channal_offset;
-                    float dequantize_scale = dequantize_scales[c];
-                    float32x4x2 dequantize_scale_x4x2(dequantize_scale);
-                    int count = channal_offset;
-                    int count_x8 = count >> 3;
-                    int remain = count_x8 << 3;
-                    for (int i = 0; i < count_x8; i++){
-                        int ii = i * 8;
-                        float32x4x2 input_x4x2 = intx4x2_to_float32x4x2(int32x4x2(&input_cur[ii]));
-                        float32x4x2 out_x4x2 = input_x4x2 * dequantize_scale_x4x2;
-                        out_x4x2.store(poutput);
-                        poutput += 8;
-                    }
-                    for (int i = remain; i < count; i++){
-                        *poutput++ = input_cur[i] * dequantize_scale;
-                    }
+                Int8Gemm::pack_B(kernel_dims, conv_out_spatial_dim, col_buffer, conv_out_spatial_dim, packed_col);
+                //NOTE: fuse Dequantize(int32 to fp32), or requantize(int32 to int8) in gemm epilogue
+                if (requantize) {
+                    Int8Gemm::requantize(weight_shape[0], conv_out_spatial_dim, kernel_dims, packed_weight, packed_col,
+                                         dequantize_scales.data(), requantize_scale,
+                                         out.data<int8_t>() + i * output_number_offset, conv_out_spatial_dim);
+                } else {
+                    Int8Gemm::dequantize(weight_shape[0], conv_out_spatial_dim, kernel_dims, packed_weight, packed_col,
+                                         dequantize_scales.data(),
+                                         out.data<float>() + i * output_number_offset, conv_out_spatial_dim);
                 }
+                pinput += input_number_offset;
             }
-
-//            auto input_data = output_int32.data<int32_t>();
-//            int dequantize_group = dequantize_scales.size();
-//            int output_count = out.count();
-//            int loop_count = std::ceil(static_cast<float>(output_count) / dequantize_group);
-//            int index = 0;
-//#ifdef TS_USE_OPENMP
-//            #pragma omp parallel for num_threads(openmp_threads())
-//#endif
-//            for (int n = 0; n < dequantize_group; n++) {
-//                float dequantize_scale = dequantize_scales[n];
-//                int loop_count_temp = loop_count;
-//                while (index < output_count && loop_count_temp) {
-//                    poutput[index] = input_data[index] * dequantize_scale;
-//                    index++;
-//                    loop_count_temp--;
-//                }
-//            }
         }
 
         void Conv2DQuantizedCore::conv2d(const Tensor &x, const Padding2D &padding, float padding_value, const Tensor &w,
                             const Stride2D &stride, const Dilation2D &dilation, Conv2DFormat format, 
-                            std::vector<float>dequantize_scales,Tensor &out,Stack &stack) {
+                            std::vector<float>dequantize_scales, float requantize_scale, Tensor &out, Stack &stack) {
             if (format != FORMAT_NCHW) {
                 TS_LOG_ERROR << "Conv2D_quantized only support NCHW" << eject;
             }
             DTYPE dtype = x.dtype();
             switch (dtype) {
 #define DECLARE_COMPUTE_RUN(DTYPE, TYPE) \
-        case DTYPE: { cpu_conv2d_nchw_compute_run<TYPE>(x, padding, padding_value, w, stride, dilation, dequantize_scales, out, stack);; break; }
+        case DTYPE: { cpu_conv2d_nchw_compute_run<TYPE>(x, padding, padding_value, w, stride, dilation, dequantize_scales, requantize_scale, out, stack); break; }
                 //DECLARE_COMPUTE_RUN(FLOAT32, float);
                 //DECLARE_COMPUTE_RUN(FLOAT64, double);
                 DECLARE_COMPUTE_RUN(INT8, int8_t);
@@ -0,0 +1,200 @@
+#include <kernels/cpu/quantized/int8_gemm.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "runtime/inside/parallel.h"
+
+#if defined(TS_USE_AVX) && defined(__AVX2__)
+#include <immintrin.h>
+#define TS_INT8_GEMM_AVX2
+#elif defined(TS_USE_AVX) || defined(TS_USE_SSE) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TS_INT8_GEMM_SSE2
+#elif defined(TS_USE_NEON)
+#include <arm_neon.h>
+#define TS_INT8_GEMM_NEON
+#endif
+
+namespace ts {
+    namespace cpu {
+        static inline int pairs(int K) { return (K + 1) / 2; }
+
+        size_t Int8Gemm::pack_A_size(int M, int K) {
+            return size_t((M + MR - 1) / MR) * pairs(K) * MR * 2;
+        }
+
+        size_t Int8Gemm::pack_B_size(int K, int N) {
+            return size_t((N + NR - 1) / NR) * pairs(K) * NR * 2;
+        }
+
+        void Int8Gemm::pack_A(int M, int K, const int8_t *A, int lda, int16_t *packed) {
+            auto K2 = pairs(K);
+            auto panels = (M + MR - 1) / MR;
+            TS_PARALLEL_FOR_BEGIN(p, 0, panels)
+                auto out = packed + size_t(p) * K2 * MR * 2;
+                for (int k2 = 0; k2 < K2; ++k2) {
+                    for (int r = 0; r < MR; ++r) {
+                        int i = p * MR + r;
+                        int k = k2 * 2;
+                        *out++ = i < M ? A[i * lda + k] : 0;
+                        *out++ = i < M && k + 1 < K ? A[i * lda + k + 1] : 0;
+                    }
+                }
+            TS_PARALLEL_FOR_END()
+        }
+
+        void Int8Gemm::pack_B(int K, int N, const int8_t *B, int ldb, int16_t *packed) {
+            auto K2 = pairs(K);
+            auto panels = (N + NR - 1) / NR;
+            TS_PARALLEL_FOR_BEGIN(p, 0, panels)
+                auto out = packed + size_t(p) * K2 * NR * 2;
+                int j0 = p * NR;
+                int cols = std::min(NR, N - j0);
+                for (int k2 = 0; k2 < K2; ++k2) {
+                    int k = k2 * 2;
+                    auto b0 = B + k * ldb + j0;
+                    auto b1 = k + 1 < K ? b0 + ldb : nullptr;
+                    for (int c = 0; c < cols; ++c) {
+                        *out++ = b0[c];
+                        *out++ = b1 ? b1[c] : 0;
+                    }
+                    for (int c = cols; c < NR; ++c) {
+                        *out++ = 0;
+                        *out++ = 0;
+                    }
+                }
+            TS_PARALLEL_FOR_END()
+        }
+
+        /**
+         * compute MR x NR tile of int32
+         */
+        static inline void micro_kernel(int K2, const int16_t *pa, const int16_t *pb, int32_t *tile) {
+#if defined(TS_INT8_GEMM_AVX2)
+            __m256i acc0 = _mm256_setzero_si256();
+            __m256i acc1 = _mm256_setzero_si256();
+            __m256i acc2 = _mm256_setzero_si256();
+            __m256i acc3 = _mm256_setzero_si256();
+            for (int k2 = 0; k2 < K2; ++k2) {
+                int32_t a[4];
+                std::memcpy(a, pa, sizeof(a));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pb));
+                acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_set1_epi32(a[0]), b));
+                acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_set1_epi32(a[1]), b));
+                acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_set1_epi32(a[2]), b));
+                acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_set1_epi32(a[3]), b));
+                pa += 8;
+                pb += 16;
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(tile + 0), acc0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(tile + 8), acc1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(tile + 16), acc2);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(tile + 24), acc3);
+#elif defined(TS_INT8_GEMM_SSE2)
+            __m128i acc[4][2];
+            for (int r = 0; r < 4; ++r) acc[r][0] = acc[r][1] = _mm_setzero_si128();
+            for (int k2 = 0; k2 < K2; ++k2) {
+                int32_t a[4];
+                std::memcpy(a, pa, sizeof(a));
+                __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pb));
+                __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pb + 8));
+                for (int r = 0; r < 4; ++r) {
+                    __m128i ar = _mm_set1_epi32(a[r]);
+                    acc[r][0] = _mm_add_epi32(acc[r][0], _mm_madd_epi16(ar, b0));
+                    acc[r][1] = _mm_add_epi32(acc[r][1], _mm_madd_epi16(ar, b1));
+                }
+                pa += 8;
+                pb += 16;
+            }
+            for (int r = 0; r < 4; ++r) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(tile + r * 8), acc[r][0]);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(tile + r * 8 + 4), acc[r][1]);
+            }
+#elif defined(TS_INT8_GEMM_NEON)
+            int32x4_t acc[4][2];
+            for (int r = 0; r < 4; ++r) acc[r][0] = acc[r][1] = vdupq_n_s32(0);
+            for (int k2 = 0; k2 < K2; ++k2) {
+                // deinterleave pairs, val[0] is row k of B, val[1] is row k + 1
+                int16x8x2_t b = vld2q_s16(pb);
+                int16x4_t b0l = vget_low_s16(b.val[0]), b0h = vget_high_s16(b.val[0]);
+                int16x4_t b1l = vget_low_s16(b.val[1]), b1h = vget_high_s16(b.val[1]);
+                for (int r = 0; r < 4; ++r) {
+                    acc[r][0] = vmlal_n_s16(vmlal_n_s16(acc[r][0], b0l, pa[2 * r]), b1l, pa[2 * r + 1]);
+                    acc[r][1] = vmlal_n_s16(vmlal_n_s16(acc[r][1], b0h, pa[2 * r]), b1h, pa[2 * r + 1]);
+                }
+                pa += 8;
+                pb += 16;
+            }
+            for (int r = 0; r < 4; ++r) {
+                vst1q_s32(tile + r * 8, acc[r][0]);
+                vst1q_s32(tile + r * 8 + 4, acc[r][1]);
+            }
+#else
+            std::memset(tile, 0, sizeof(int32_t) * Int8Gemm::MR * Int8Gemm::NR);
+            for (int k2 = 0; k2 < K2; ++k2) {
+                for (int r = 0; r < Int8Gemm::MR; ++r) {
+                    int32_t a0 = pa[2 * r], a1 = pa[2 * r + 1];
+                    auto t = tile + r * Int8Gemm::NR;
+                    for (int c = 0; c < Int8Gemm::NR; ++c) {
+                        t[c] += a0 * pb[2 * c] + a1 * pb[2 * c + 1];
+                    }
+                }
+                pa += 8;
+                pb += 16;
+            }
+#endif
+        }
+
+        static inline int8_t saturate_int8(float value) {
+            auto rounded = int32_t(std::round(value));
+            if (rounded > 127) return 127;
+            if (rounded < -128) return -128;
+            return static_cast<int8_t>(rounded);
+        }
+
+        template<typename T, typename Epilogue>
+        static void int8_gemm(int M, int N, int K, const int16_t *packed_A, const int16_t *packed_B,
+                              T *C, int ldc, Epilogue epilogue) {
+            auto K2 = pairs(K);
+            auto m_panels = (M + Int8Gemm::MR - 1) / Int8Gemm::MR;
+            auto n_panels = (N + Int8Gemm::NR - 1) / Int8Gemm::NR;
+            // B panel of K x NR keeps in cache, A panels are streamed over it
+            TS_PARALLEL_FOR_BEGIN(np, 0, n_panels)
+                int32_t tile[Int8Gemm::MR * Int8Gemm::NR];
+                auto pb = packed_B + size_t(np) * K2 * Int8Gemm::NR * 2;
+                int j0 = np * Int8Gemm::NR;
+                int cols = std::min(Int8Gemm::NR, N - j0);
+                for (int mp = 0; mp < m_panels; ++mp) {
+                    auto pa = packed_A + size_t(mp) * K2 * Int8Gemm::MR * 2;
+                    micro_kernel(K2, pa, pb, tile);
+                    int i0 = mp * Int8Gemm::MR;
+                    int rows = std::min(Int8Gemm::MR, M - i0);
+                    for (int r = 0; r < rows; ++r) {
+                        auto t = tile + r * Int8Gemm::NR;
+                        auto c = C + size_t(i0 + r) * ldc + j0;
+                        for (int j = 0; j < cols; ++j) {
+                            c[j] = epilogue(i0 + r, t[j]);
+                        }
+                    }
+                }
+            TS_PARALLEL_FOR_END()
+        }
+
+        void Int8Gemm::dequantize(int M, int N, int K, const int16_t *packed_A, const int16_t *packed_B,
+                                  const float *scales, float *C, int ldc) {
+            int8_gemm(M, N, K, packed_A, packed_B, C, ldc, [scales](int i, int32_t value) -> float {
+                return value * scales[i];
+            });
+        }
+
+        void Int8Gemm::requantize(int M, int N, int K, const int16_t *packed_A, const int16_t *packed_B,
+                                  const float *scales, float requantize_scale, int8_t *C, int ldc) {
+            int8_gemm(M, N, K, packed_A, packed_B, C, ldc, [scales, requantize_scale](int i, int32_t value) -> int8_t {
+                float dequantized = value * scales[i];
+                return saturate_int8(dequantized * requantize_scale);
+            });
+        }
+    }
+}
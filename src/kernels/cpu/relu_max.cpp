@@ -5,9 +5,7 @@
 #include "global/operator_factory.h"
 
 #include "kernels/common/simd.h"
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "runtime/inside/parallel.h"
 
 namespace ts {
 	namespace cpu {
@@ -40,16 +38,13 @@ namespace ts {
             float32x4 casted_max_x4(casted_max);
             int counts = out.count();
             float32x4 const_num_x4(float(0.0));
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int i = 0; i < count_4; ++i) {
+            TS_PARALLEL_FOR_BEGIN(i, 0, count_4)
                 auto input_at = input_data + i * 4;
                 auto output_at = output_data + i * 4;
                 float32x4 val_x4(input_at);
                 float32x4 output_x4 = min_float32x4(max_float32x4(val_x4, const_num_x4), casted_max_x4);
                 output_x4.store(output_at);
-            }
+            TS_PARALLEL_FOR_END()
             for (int i = count_4 * 4; i < counts; i++) {
                 float val = input_data[i];
                 output_data[i] = std::min(std::max(val, float(0)), casted_max);
@@ -5,9 +5,7 @@
 #include <backend/name.h>
 #include <core/device.h>
 #include <utils/assert.h>
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "runtime/inside/parallel.h"
 
 namespace ts {
     namespace cpu {
@@ -26,10 +24,7 @@ namespace ts {
             double bias_x = lfx_scl / 2 - 0.5;
             double bias_y = lfy_scl / 2 - 0.5;
 
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int n_y_d = 0; n_y_d < dst_height; n_y_d++) {
+            TS_PARALLEL_FOR_BEGIN(n_y_d, 0, dst_height)
                 for (int n_x_d = 0; n_x_d < dst_width; n_x_d++) {
                     double lf_x_s = lfx_scl * n_x_d + bias_x;
                     double lf_y_s = lfy_scl * n_y_d + bias_y;
@@ -58,7 +53,7 @@ namespace ts {
 
                     }//end for c
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
 
 
@@ -71,10 +66,7 @@ namespace ts {
             int srcrows = src_width * channels;
             int dstrows = dst_width * channels;
 
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int j = 0; j < dst_height; ++j) {
+            TS_PARALLEL_FOR_BEGIN(j, 0, dst_height)
                 double fy = (double) ((j + 0.5) * scale_y - 0.5);
                 int sy = int(floor(fy));
                 fy -= sy;
@@ -139,7 +131,7 @@ namespace ts {
 
                     }//end k
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
 
 
@@ -156,10 +148,7 @@ namespace ts {
             const float lfx_scl = float(src_width) / dst_width;
             const float lfy_scl = float(src_height) / dst_height;
 
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int n_y_d = 0; n_y_d < dst_height; n_y_d++) {
+            TS_PARALLEL_FOR_BEGIN(n_y_d, 0, dst_height)
                 for (int n_x_d = 0; n_x_d < dst_width; n_x_d++) {
                     float lf_x_s = lfx_scl * n_x_d;
                     float lf_y_s = lfy_scl * n_y_d;
@@ -177,7 +166,7 @@ namespace ts {
                                 (n_y_s * src_width + n_x_s) * channels + c];
                     }//end for c
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
 
 
@@ -197,10 +186,7 @@ namespace ts {
             double bias_x = lfx_scl / 2 - 0.5;
             double bias_y = lfy_scl / 2 - 0.5;
 
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int n_y_d = 0; n_y_d < dst_height; n_y_d++) {
+            TS_PARALLEL_FOR_BEGIN(n_y_d, 0, dst_height)
                 for (int n_x_d = 0; n_x_d < dst_width; n_x_d++) {
                     double lf_x_s = lfx_scl * n_x_d + bias_x;
                     double lf_y_s = lfy_scl * n_y_d + bias_y;
@@ -217,7 +203,7 @@ namespace ts {
                         dst_im[(n_y_d * dst_width + n_x_d) * channels + c] = src_im[(n_y_s * src_width + n_x_s) * channels + c];
                     }//end for c
                 }
-            }
+            TS_PARALLEL_FOR_END()
         }
 
 
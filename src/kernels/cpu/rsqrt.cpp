@@ -3,6 +3,7 @@
 
 #include "backend/name.h"
 #include "global/operator_factory.h"
+#include "kernels/cpu/element_wise_unary.h"
 
 
 namespace ts {
@@ -44,6 +45,12 @@ double InvSqrt(double number)
             }
         }
 
+        template<>
+        void cpu_rsqrt_compute_run<float>(const Tensor &x, Tensor &out) {
+            unary_float32x4(x.data<float>(), out.data<float>(), out.count(),
+                            [](const float32x4 &value) { return rsqrt_float32x4(value); });
+        }
+
 
         void Rsqrt::active(const Tensor &x, Tensor &out) {
             // Notice: the all tensor' memory device are CPU, as given in running_memory_device
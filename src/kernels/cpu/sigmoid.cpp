@@ -5,9 +5,8 @@
 #include "global/operator_factory.h"
 
 #include "kernels/common/simd.h"
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "kernels/cpu/element_wise_unary.h"
+#include "runtime/inside/parallel.h"
 
 namespace ts {
     namespace cpu {
@@ -26,38 +25,17 @@ namespace ts {
             int count = out.count();
 
             //std::memcpy(output_data, input_data, count * sizeof(T));
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-            for (int i = 0; i < count; i++) {
+            TS_PARALLEL_FOR_BEGIN(i, 0, count)
 
                 output_data[i] = T(1. / (1. + exp(neg(input_data[i]))));
-            }
+            TS_PARALLEL_FOR_END()
         }
 
-//#ifdef TS_USE_SSE
-//        template<>
-//        static void cpu_sigmoid_compute_run<float>(const Tensor &x, Tensor &out) {
-//            const float *input_data = x.data<float>();
-//            float *output_data = out.data<float>();
-//            int count = out.count();
-//            //std::memcpy(output_data, input_data, count * sizeof(float));
-//            float32x4 const_one(float(1.0));
-//            for (int i = 0; i < count - 3; i += 4) {
-//                float32x4 val_x4(input_data);
-//                float32x4 exp_val_x4(exp(-(input_data[i])), exp(-(input_data[i+1])), exp(-(input_data[i+2])), exp(-(input_data[i+3])));
-//                float32x4 output_x4 = const_one / (const_one + exp_val_x4);
-//                output_x4.store(output_data);
-//                output_data += 4;
-//            }
-//            for (int i = count/4*4; i < count; i++)
-//            {
-//                float val = *input_data++;
-//                *output_data = 1. / (1. + exp(-(val)));
-//                output_data++;
-//            }
-//        }
-//#endif
+        template<>
+        void cpu_sigmoid_compute_run<float>(const Tensor &x, Tensor &out) {
+            unary_float32x4(x.data<float>(), out.data<float>(), out.count(),
+                            [](const float32x4 &value) { return sigmoid_float32x4(value); });
+        }
 
         void Sigmoid::active(const Tensor &x, Tensor &out) {
             // Notice: the all tensor' memory device are CPU, as given in running_memory_device
@@ -6,9 +6,7 @@
 #include <math.h>
 
 #include <kernels/common/simd.h>
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "runtime/inside/parallel.h"
 
 namespace ts {
 	namespace cpu {
@@ -42,10 +40,7 @@ namespace ts {
 
             // as NCW format
             for (int n = 0; n < head_num; ++n) {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int w = 0; w < tail_num; ++w) {
+                TS_PARALLEL_FOR_BEGIN(w, 0, tail_num)
                     auto channel_index = hype.to_index(n, 0, w);
                     const T *input_channel_data = &input_data[channel_index];
                     T *output_channel_data = &output_data[channel_index];
@@ -68,7 +63,7 @@ namespace ts {
                         loop_in += tail_num;
                         loop_out += tail_num;
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -102,10 +97,7 @@ namespace ts {
 
             // as NCW format
             for (int n = 0; n < head_num; ++n) {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int w = 0; w < tail_num; ++w) {
+                TS_PARALLEL_FOR_BEGIN(w, 0, tail_num)
                     auto channel_index = hype.to_index(n, 0, w);
                     const T *input_channel_data = &input_data[channel_index];
                     T *output_channel_data = &output_data[channel_index];
@@ -135,7 +127,7 @@ namespace ts {
                         loop_in += tail_num;
                         loop_out += tail_num;
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -148,104 +140,135 @@ namespace ts {
 		    }
 		}
 
-//        template<>
-//        void cpu_softmax_compute_run<float>(const Tensor &x, int m_dim, bool m_smooth, Tensor &out) {
-//            auto output_shape = out.sizes();
-//
-//            int pre_num = 1;
-//            for (int i = 0; i < m_dim; i++) {
-//                pre_num *= output_shape[i];
-//            }
-//            int inner_num = 1;
-//            for (int i = m_dim + 1; i < output_shape.size(); i++) {
-//                inner_num *= output_shape[i];
-//            }
-//
-//            int axis = output_shape[m_dim];
-//
-//            auto device_type = x.device();
-//            const float *input_data = x.data<float>();
-//            float *output_data = out.data<float>();
-//
-//            //memcpy(output_data, device_type, count * sizeof(float), input_data, device_type, count * sizeof(float));
-//
-//            int scale_data_size = out.count() / axis;
-//            int denominator_data_size = scale_data_size;
-//
-//            Shape scale_shape;
-//            scale_shape.resize(1);
-//            scale_shape[0] = scale_data_size;
-//            Tensor scale_tensor(Tensor::InFlow::HOST, out.dtype(), scale_shape);
-//            float *scale_data = scale_tensor.data<float>();
-//
-//            Shape denominator_shape;
-//            denominator_shape.resize(1);
-//            denominator_shape[0] = denominator_data_size;
-//            Tensor denominator_tensor(Tensor::InFlow::HOST, out.dtype(), denominator_shape);
-//            float *denominator_data = denominator_tensor.data<float>();
-//
-//            for (int i = 0; i < pre_num; i++) {
-//                std::memset(denominator_data, 0, scale_data_size * sizeof(float));
-//                int pre_offset = i * axis * inner_num;
-//                if (m_smooth) {
-//                    //Caculate max value
-//                    memcpy(scale_data, device_type, inner_num * sizeof(float), input_data + pre_offset,
-//                        device_type, inner_num * sizeof(float));
-//                    //std::memcpy(scale_data,input_data + i * axis * inner_num, inner_num * sizeof(float));
-//                    for (int j = 0; j < axis; j++) {
-//                        int post_offset = j * inner_num;
-//                        for (int k = 0; k < inner_num - 3; k += 4) {
-//                            float *scale_temp = &scale_data[k];
-//                            float32x4 scale_data_x4(scale_temp);
-//                            float32x4 input_data_x4(&input_data[pre_offset + post_offset + k]);
-//                            scale_data_x4 = max_float32x4(scale_data_x4, input_data_x4);
-//                            scale_data_x4.store(scale_temp);
-//                        }
-//                        for (int k = inner_num/4*4; k < inner_num; k++) {
-//                            scale_data[k] = std::max(scale_data[k],
-//                                input_data[pre_offset + post_offset + k]);
-//                        }
-//                    }
-//                    //Caculate numerator and denominator
-//                    for (int j = 0; j < axis; j++) {
-//                        int post_offset = j * inner_num;
-//                        for (int k = 0; k < inner_num; k++) {
-//                            output_data[pre_offset + post_offset + k] = exp(
-//                                input_data[pre_offset + post_offset + k] - scale_data[k]);
-//                            denominator_data[k] += output_data[pre_offset + post_offset + k];
-//                        }
-//                    }
-//                }
-//                else {
-//                    //Caculate numerator and denominator
-//                    for (int j = 0; j < axis; j++) {
-//                        int post_offset = j * inner_num;
-//                        for (int k = 0; k < inner_num; k++) {
-//                            output_data[pre_offset + post_offset + k] = exp(
-//                                input_data[pre_offset + post_offset + k]);
-//                            denominator_data[k] += output_data[pre_offset + post_offset + k];
-//                        }
-//                    }
-//                }
-//                //Caculte output
-//                for (int j = 0; j < axis; j++) {
-//                    int post_offset = j * inner_num;
-//                    for (int k = 0; k < inner_num - 3; k += 4) {
-//                        float *output_temp = &output_data[pre_offset + post_offset + k];
-//                        float32x4 output_data_x4(output_temp);
-//                        float32x4 denominator_data_x4(&denominator_data[k]);
-//                        output_data_x4 = output_data_x4 / denominator_data_x4;
-//                        output_data_x4.store(output_temp);
-//                    }
-//                    for (int k = inner_num/4*4; k < inner_num; k++)
-//                    {
-//                        output_data[pre_offset + post_offset + k] =
-//                            output_data[pre_offset + post_offset + k] / denominator_data[k];
-//                    }
-//                }
-//
-//            }
-//        }
+        /**
+         * softmax on contiguous data
+         */
+        static inline void cpu_softmax_row_float(const float *in, float *out, int count, bool smooth) {
+            int body = count / 4 * 4;
+            float max = 0;
+            if (smooth) {
+                max = in[0];
+                if (body) {
+                    float32x4 max_x4(in);
+                    for (int i = 4; i < body; i += 4) max_x4 = max_float32x4(max_x4, float32x4(&in[i]));
+                    float lanes[4];
+                    max_x4.store(lanes);
+                    max = *std::max_element(lanes, lanes + 4);
+                }
+                for (int i = body; i < count; ++i) max = std::max(max, in[i]);
+            }
+            float32x4 max_x4(max);
+            float32x4 sum_x4(0.0f);
+            for (int i = 0; i < body; i += 4) {
+                float32x4 data = exp_float32x4(float32x4(&in[i]) - max_x4);
+                sum_x4 += data;
+                data.store(&out[i]);
+            }
+            float sum = ts::sum(sum_x4);
+            for (int i = body; i < count; ++i) {
+                out[i] = std::exp(in[i] - max);
+                sum += out[i];
+            }
+            float scale = 1.0f / sum;
+            float32x4 scale_x4(scale);
+            for (int i = 0; i < body; i += 4) {
+                (float32x4(&out[i]) * scale_x4).store(&out[i]);
+            }
+            for (int i = body; i < count; ++i) {
+                out[i] *= scale;
+            }
+        }
+
+        /**
+         * one softmax over body_num values with step tail_num
+         */
+        static inline void cpu_softmax_lane_float(const float *in, float *out, int body_num, int tail_num, bool smooth) {
+            float max = 0;
+            if (smooth) {
+                max = in[0];
+                for (int i = 1; i < body_num; ++i) max = std::max(max, in[i * tail_num]);
+            }
+            float sum = 0;
+            for (int i = 0; i < body_num; ++i) {
+                out[i * tail_num] = std::exp(in[i * tail_num] - max);
+                sum += out[i * tail_num];
+            }
+            for (int i = 0; i < body_num; ++i) {
+                out[i * tail_num] /= sum;
+            }
+        }
+
+        /**
+         * 4 softmax in lanes, each over body_num values with step tail_num
+         */
+        static inline void cpu_softmax_lanes_float(const float *in, float *out, int body_num, int tail_num, bool smooth) {
+            float32x4 max_x4(0.0f);
+            if (smooth) {
+                max_x4 = float32x4(in);
+                for (int i = 1; i < body_num; ++i) max_x4 = max_float32x4(max_x4, float32x4(&in[i * tail_num]));
+            }
+            float32x4 sum_x4(0.0f);
+            for (int i = 0; i < body_num; ++i) {
+                float32x4 data = exp_float32x4(float32x4(&in[i * tail_num]) - max_x4);
+                sum_x4 += data;
+                data.store(&out[i * tail_num]);
+            }
+            float32x4 scale_x4 = float32x4(1.0f) / sum_x4;
+            for (int i = 0; i < body_num; ++i) {
+                (float32x4(&out[i * tail_num]) * scale_x4).store(&out[i * tail_num]);
+            }
+        }
+
+        template<>
+        void cpu_softmax_compute_run<float>(const Tensor &x, int m_dim, bool m_smooth, Tensor &out) {
+            auto &output_shape = out.sizes();
+
+            auto input_data = x.data<float>();
+            auto output_data = out.data<float>();
+
+            int body_num = output_shape[m_dim];
+
+            if (body_num == 1) {
+                float one(1);
+                memset(output_data, out.device(), out.count() * out.proto().type_bytes(),
+                       &one, Device(CPU), sizeof(float));
+                return;
+            }
+
+            int head_num = 1;
+            for (int i = 0; i < m_dim; i++) {
+                head_num *= output_shape[i];
+            }
+            int tail_num = 1;
+            for (int i = m_dim + 1; i < output_shape.size(); i++) {
+                tail_num *= output_shape[i];
+            }
+
+            if (tail_num == 1) {
+                TS_PARALLEL_FOR_BEGIN(n, 0, head_num)
+                    cpu_softmax_row_float(&input_data[n * body_num], &output_data[n * body_num], body_num, m_smooth);
+                TS_PARALLEL_FOR_END()
+                return;
+            }
+
+            // as NCW format, W is vectorized by 4, the left W use scalar version
+            int tail_blocks = (tail_num + 3) / 4;
+            int block_count = head_num * tail_blocks;
+            TS_PARALLEL_FOR_BEGIN(b, 0, block_count)
+                int n = b / tail_blocks;
+                int w = b % tail_blocks * 4;
+                auto channel_index = (n * body_num) * tail_num + w;
+                auto in = &input_data[channel_index];
+                auto out = &output_data[channel_index];
+                if (w + 4 <= tail_num) {
+                    cpu_softmax_lanes_float(in, out, body_num, tail_num, m_smooth);
+                    continue;
+                }
+                for (; w < tail_num; ++w, ++in, ++out) {
+                    cpu_softmax_lane_float(in, out, body_num, tail_num, m_smooth);
+                }
+            TS_PARALLEL_FOR_END()
+        }
 
 		void Softmax::softmax(const Tensor &x, int dim, bool smooth, Tensor &out) {
 			// Notice: the all tensor' memory device are CPU, as given in running_memory_device
@@ -8,6 +8,7 @@
 
 #include "kernels/cpu/operator_on_cpu.h"
 #include "kernels/common/math.h"
+#include "kernels/cpu/element_wise_unary.h"
 
 #include "backend/name.h"
 
@@ -26,6 +27,12 @@ namespace ts {
             }
         }
 
+        template<>
+        void cpu_sqrt_compute_run<float>(const Tensor &x, Tensor &out) {
+            unary_float32x4(x.data<float>(), out.data<float>(), out.count(),
+                            [](const float32x4 &value) { return sqrt_float32x4(value); });
+        }
+
         class Sqrt : public OperatorOnCPU<base::Activation> {
         public:
             void active(const Tensor &x, Tensor &out) final {
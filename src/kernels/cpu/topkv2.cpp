@@ -1,8 +1,11 @@
 #include "kernels/cpu/topkv2.h"
 #include "global/operator_factory.h"
 #include "backend/name.h"
+#include "kernels/cpu/nms.h"
+#include "runtime/inside/parallel.h"
 
 #include <numeric>
+#include <cstring>
 #include <algorithm>
 
 namespace ts {
@@ -54,20 +57,27 @@ namespace ts {
         static void cpu_topkv2_sorted_compute_run(const Tensor &x, int K, Tensor &values, Tensor &indices) {
             auto N = std::accumulate(x.sizes().begin(), x.sizes().end() - 1, 1, std::multiplies<int32_t>());
             auto W = x.sizes().back();
-            std::vector<int32_t> indices_temp(W);
-            for (int n = 0; n < N; ++n) {
-                auto data = x.data<T>() + n * W;
-                for (int w = 0; w < W; ++w) indices_temp[w] = w;
-                std::partial_sort(indices_temp.begin(), indices_temp.begin() + K, indices_temp.end(),
-                                  [data](int32_t a, int32_t b) { return data[a] > data[b]; });
-                auto values_data = values.data<T>() + n * K;
-                auto indices_data = indices.data<int32_t>() + n * K;
-                std::memcpy(indices_data, indices_temp.data(), K * sizeof(int32_t));
-                for (int k = 0; k < K; ++k) {
-                    *values_data = data[indices_data[k]];
-                    ++values_data;
+            auto x_data = x.data<T>();
+            auto values_data = values.data<T>();
+            auto indices_data = indices.data<int32_t>();
+            // rows are independent, each thread sorts its rows in own index buffer
+            TS_PARALLEL_RANGE_BEGIN(range, 0, N)
+                std::vector<int32_t> indices_temp(W);
+                for (int n = range.first; n < range.second; ++n) {
+                    auto data = x_data + n * W;
+                    for (int w = 0; w < W; ++w) indices_temp[w] = w;
+                    select_sort(indices_temp.begin(), indices_temp.begin() + K, indices_temp.end(),
+                                [data](int32_t a, int32_t b) {
+                                    return data[a] > data[b] || (data[a] == data[b] && a < b);
+                                });
+                    auto values_row = values_data + n * K;
+                    auto indices_row = indices_data + n * K;
+                    std::memcpy(indices_row, indices_temp.data(), K * sizeof(int32_t));
+                    for (int k = 0; k < K; ++k) {
+                        values_row[k] = data[indices_row[k]];
+                    }
                 }
-            }
+            TS_PARALLEL_RANGE_END()
         }
 
 
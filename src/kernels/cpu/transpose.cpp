@@ -6,9 +6,7 @@
 #include <utils/assert.h>
 #include <core/tensor_builder.h>
 #include <kernels/common/simd.h>
-#ifdef TS_USE_OPENMP
-#include <kernels/common/openmp.h>
-#endif
+#include "runtime/inside/parallel.h"
 
 namespace ts {
     namespace cpu {
@@ -49,10 +47,7 @@ namespace ts {
             for (int n = 0; n < input_shape[0]; ++n) {
                 const T* src_at = psrc + n * num_offset;
                 T* dst_at = pdst + n * num_offset;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int h = 0; h < height; ++h) {
+                TS_PARALLEL_FOR_BEGIN(h, 0, height)
                     auto src_tmp = src_at + h * width;
                     auto dst_tmp = dst_at + h * channel * width;
                     for (int w = 0; w < width; ++w) {
@@ -60,7 +55,7 @@ namespace ts {
                             dst_tmp[w * channel + c] = src_tmp[c * channel_offset + w];
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -73,10 +68,7 @@ namespace ts {
             for (int n = 0; n < input_shape[0]; ++n) {
                 const float *src_at = psrc + n * num_offset;
                 float *dst_at = pdst + n * num_offset;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int h = 0; h < height; ++h) {
+                TS_PARALLEL_FOR_BEGIN(h, 0, height)
                     auto src_tmp = src_at + h * width;
                     auto dst_tmp = dst_at + h * out_h_offset;
                     int w = 0;
@@ -93,7 +85,7 @@ namespace ts {
                             dst_at[h * out_h_offset + w * channel + c] = src_at[h * width + c * channel_offset + w];
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -106,10 +98,7 @@ namespace ts {
             for (int n = 0; n < input_shape[0]; ++n) {
                 const T* src_at = psrc + n * num_offset;
                 T* dst_at = pdst + n * num_offset;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int h = 0; h < height; ++h) {
+                TS_PARALLEL_FOR_BEGIN(h, 0, height)
                     auto src_tmp = src_at + h * h_offset;
                     auto dst_tmp = dst_at + h * width;
                     for (int w = 0; w < width; ++w) {
@@ -117,7 +106,7 @@ namespace ts {
                             dst_tmp[c * channel_offset + w] = src_tmp[w * channel + c];
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -130,10 +119,7 @@ namespace ts {
             for (int n = 0; n < input_shape[0]; ++n) {
                 const float *src_at = psrc + n * num_offset;
                 float *dst_at = pdst + n * num_offset;
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int h = 0; h < height; ++h) {
+                TS_PARALLEL_FOR_BEGIN(h, 0, height)
                     auto src_tmp = src_at + h * h_offset;
                     auto dst_tmp = dst_at + h * width;
 
@@ -152,7 +138,7 @@ namespace ts {
                             dst_at[h * width + c * channel_offset + w] = src_at[h * h_offset + w * channel + c];
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -7,9 +7,8 @@
 #include "kernels/common/function.h"
 #include "kernels/cpu/math_cpu.h"
 #include "kernels/cpu/pad2d_algorithm.h"
-#ifdef TS_USE_OPENMP
-#include "kernels/common/openmp.h"
-#endif
+#include "kernels/cpu/isa.h"
+#include "runtime/inside/parallel.h"
 #include <array>
 
 namespace ts{
@@ -75,11 +74,7 @@ namespace ts{
 
             for (int p = 0; p < out_channel; p++)
             {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int q = 0; q < input_channel; q++)
-                {
+                TS_PARALLEL_FOR_BEGIN(q, 0, input_channel)
                     const float *kernel_at = p_kernel + p * kernel_num_offset + q * 9;
                     float *kernel_trans_at = p_kernel_trans + p * input_channel + q;
 
@@ -104,7 +99,7 @@ namespace ts{
                             kernel_trans_at[(i * 4 + j) * stride] = tmp[0][j] * G[i][0] + tmp[1][j] * G[i][1] + tmp[2][j] * G[i][2];
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
 
             //gemm pack A
@@ -171,10 +166,7 @@ namespace ts{
             float *out_ptr = x_tm.data<float>();
 
             for (int n = 0; n < num; ++n) {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int c = 0; c < input_channel; ++c) {
+                TS_PARALLEL_FOR_BEGIN(c, 0, input_channel)
 
                     float t00,t01,t02,t03;
                     float t10,t11,t12,t13;
@@ -239,7 +231,7 @@ namespace ts{
                             ++tile_index;
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -291,10 +283,7 @@ namespace ts{
             float *out_ptr = out.data<float>();
 
             for (int n = 0; n < num; ++n) {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int c = 0; c < out_channel; ++c) {
+                TS_PARALLEL_FOR_BEGIN(c, 0, out_channel)
                     int tile_offset = 0;
                     const float *out_tm_cur = out_tm_ptr + n * out_tm_num_offset + c * tile_count;
                     float *out_cur = out_ptr + n * out_num_offset + c * out_channel_offset;
@@ -339,7 +328,7 @@ namespace ts{
                             ++tile_offset;
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -525,10 +514,7 @@ namespace ts{
             };
 
             for (int p = 0; p < out_channel; ++p) {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int q = 0; q < input_channel; ++q) {
+                TS_PARALLEL_FOR_BEGIN(q, 0, input_channel)
                     const float *kernel_at = p_kernel + p * kernel_num_offset + q * 9;
                     float *kernel_trans_at = p_kernel_trans + p * input_channel + q;
 
@@ -550,7 +536,7 @@ namespace ts{
                             kernel_trans_at[(i * 8 + j) * stride] = tmp[0][j] * G[i][0] + tmp[1][j] * G[i][1] + tmp[2][j] * G[i][2];
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
 
             //gemm pack A
@@ -619,14 +605,24 @@ namespace ts{
             const float *input_ptr = x.data<float>();
             float *out_ptr = x_tm.data<float>();
 
+            // micro kernel of cpu instruction set if specialized
+            auto transform = isa_kernels().winograd_f63_input;
+            int tiles_w = (input_width - 2) / 6;
+
             for (int n = 0; n < num; ++n) {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int c = 0; c < input_channel; ++c) {
+                TS_PARALLEL_FOR_BEGIN(c, 0, input_channel)
                     const float *input_cur = input_ptr + n * input_num_offset + c * input_channel_offset;
                     float *out_cur = out_ptr + n * out_num_offset + c * tile_count;
 
+                    if (transform) {
+                        int tile_index = 0;
+                        for (int h = 0; h + 2 < input_height; h += 6) {
+                            transform(input_cur + h * input_width, input_width, tiles_w, out_cur + tile_index, stride);
+                            tile_index += tiles_w;
+                        }
+                        continue;
+                    }
+
                     int tile_index = 0;
                     float dB[8][8];
                     for (int h = 0; h + 2 < input_height ; h += 6) {
@@ -694,7 +690,7 @@ namespace ts{
                             ++tile_index;
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
@@ -751,10 +747,7 @@ namespace ts{
             float *out_ptr = out.data<float>();
 
             for (int n = 0; n < num; ++n) {
-#ifdef TS_USE_OPENMP
-#pragma omp parallel for num_threads(openmp_threads())
-#endif
-                for (int c = 0; c < out_channel; ++c) {
+                TS_PARALLEL_FOR_BEGIN(c, 0, out_channel)
                     float tmpA[8][6];
                     int tile_offset = 0;
                     const float *out_tm_cur = out_tm_ptr + n * out_tm_num_offset + c * tile_count;
@@ -828,7 +821,7 @@ namespace ts{
                             ++tile_offset;
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
         }
 
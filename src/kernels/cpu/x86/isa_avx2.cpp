@@ -0,0 +1,163 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+// Only this file is built with AVX2 and FMA, see ts_add_source_instruction_support.
+// Do not include headers with inline code here, the linker may keep the AVX2 copy for the whole library.
+
+#include "kernels/cpu/isa.h"
+
+#if defined(TS_USE_CPU_DISPATCH) && TS_PLATFORM_IS_X86
+
+#include <immintrin.h>
+
+namespace ts {
+    namespace cpu {
+        namespace x86 {
+            /**
+             * C[8, 8] = A * B, accumulators of more panels do not fit in 16 ymm registers
+             */
+            static inline void gemm_8x8(int K, const float *A, const float *B, float *C, int ldc) {
+                __m256 c[8];
+                for (int i = 0; i < 8; ++i) c[i] = _mm256_setzero_ps();
+                for (int k = 0; k < K; ++k) {
+                    __m256 b = _mm256_loadu_ps(B);
+                    for (int i = 0; i < 8; ++i) c[i] = _mm256_fmadd_ps(_mm256_broadcast_ss(A + i), b, c[i]);
+                    A += 8;
+                    B += 8;
+                }
+                for (int i = 0; i < 8; ++i) _mm256_storeu_ps(C + i * ldc, c[i]);
+            }
+
+            static void gemm_tile8(int K, const float *A, const float *B, int panels, float *C, int ldc) {
+                for (int p = 0; p < panels; ++p) {
+                    gemm_8x8(K, A, B + p * 8 * K, C + p * 8, ldc);
+                }
+            }
+
+            /**
+             * w = BT * d, where d[i] is the i-th row
+             */
+            static inline void winograd_f63_bt(const __m256 *d, __m256 *w) {
+                const __m256 c0_25 = _mm256_set1_ps(0.25f);
+                const __m256 c0_5 = _mm256_set1_ps(0.5f);
+                const __m256 c1_25 = _mm256_set1_ps(1.25f);
+                const __m256 c2 = _mm256_set1_ps(2.f);
+                const __m256 c2_5 = _mm256_set1_ps(2.5f);
+                const __m256 c4 = _mm256_set1_ps(4.f);
+                const __m256 c4_25 = _mm256_set1_ps(4.25f);
+                const __m256 c5_25 = _mm256_set1_ps(5.25f);
+
+                w[0] = _mm256_fmadd_ps(_mm256_sub_ps(d[4], d[2]), c5_25, _mm256_sub_ps(d[0], d[6]));
+                w[7] = _mm256_fmadd_ps(_mm256_sub_ps(d[3], d[5]), c5_25, _mm256_sub_ps(d[7], d[1]));
+
+                __m256 tmp12_a = _mm256_fnmadd_ps(d[4], c4_25, _mm256_add_ps(d[2], d[6]));
+                __m256 tmp12_b = _mm256_fnmadd_ps(d[3], c4_25, _mm256_add_ps(d[1], d[5]));
+                w[1] = _mm256_add_ps(tmp12_a, tmp12_b);
+                w[2] = _mm256_sub_ps(tmp12_a, tmp12_b);
+
+                __m256 tmp34_a = _mm256_fnmadd_ps(d[4], c1_25, _mm256_fmadd_ps(d[2], c0_25, d[6]));
+                __m256 tmp34_b = _mm256_fmadd_ps(d[5], c2, _mm256_fnmadd_ps(d[3], c2_5, _mm256_mul_ps(d[1], c0_5)));
+                w[3] = _mm256_add_ps(tmp34_a, tmp34_b);
+                w[4] = _mm256_sub_ps(tmp34_a, tmp34_b);
+
+                __m256 tmp56_a = _mm256_fmadd_ps(_mm256_fnmadd_ps(d[4], c1_25, d[2]), c4, d[6]);
+                __m256 tmp56_b = _mm256_fmadd_ps(d[5], c0_5, _mm256_fnmadd_ps(d[3], c2_5, _mm256_mul_ps(d[1], c2)));
+                w[5] = _mm256_add_ps(tmp56_a, tmp56_b);
+                w[6] = _mm256_sub_ps(tmp56_a, tmp56_b);
+            }
+
+            static inline void transpose8x8(__m256 *r) {
+                __m256 t[8], s[8];
+                for (int i = 0; i < 8; i += 2) {
+                    t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+                    t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+                }
+                for (int i = 0; i < 8; i += 4) {
+                    s[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+                    s[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+                    s[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+                    s[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+                }
+                for (int i = 0; i < 4; ++i) {
+                    r[i] = _mm256_permute2f128_ps(s[i], s[i + 4], 0x20);
+                    r[i + 4] = _mm256_permute2f128_ps(s[i], s[i + 4], 0x31);
+                }
+            }
+
+            static void winograd_f63_input(const float *input, int input_width, int tiles, float *output, int stride) {
+                for (int t = 0; t < tiles; ++t) {
+                    const float *input_at = input + t * 6;
+                    __m256 d[8], w[8];
+                    for (int i = 0; i < 8; ++i) d[i] = _mm256_loadu_ps(input_at + i * input_width);
+                    winograd_f63_bt(d, w);
+                    transpose8x8(w);
+                    // d[j][i] = V[i][j] now
+                    winograd_f63_bt(w, d);
+
+                    float *output_at = output + t;
+                    float buffer[8];
+                    for (int j = 0; j < 8; ++j) {
+                        _mm256_storeu_ps(buffer, d[j]);
+                        for (int i = 0; i < 8; ++i) output_at[(i * 8 + j) * stride] = buffer[i];
+                    }
+                }
+            }
+
+            /**
+             * P pixels of NCHW8c conv2d, P ymm accumulators, up to 12 with 16 ymm registers
+             */
+            template <int P>
+            static inline void conv2d_nchw8c_pixels(int taps, const float *const *inputs, int offset,
+                                                    const float *const *weights, int weight_offset, int step,
+                                                    float *out) {
+                __m256 c[P];
+                for (int p = 0; p < P; ++p) c[p] = _mm256_setzero_ps();
+                for (int t = 0; t < taps; ++t) {
+                    const float *in = inputs[t] + offset;
+                    const float *w = weights[t] + weight_offset;
+                    for (int b = 0; b < 8; ++b) {
+                        __m256 wb = _mm256_loadu_ps(w + b * 8);
+                        for (int p = 0; p < P; ++p) {
+                            c[p] = _mm256_fmadd_ps(_mm256_broadcast_ss(in + p * step + b), wb, c[p]);
+                        }
+                    }
+                }
+                for (int p = 0; p < P; ++p) _mm256_storeu_ps(out + p * 8, c[p]);
+            }
+
+            static void conv2d_nchw8c_tile(int taps, const float *const *inputs, int offset,
+                                           const float *const *weights, int weight_stride, int step, int pixels,
+                                           int blocks, float *out, int out_stride) {
+                for (int j = 0; j < blocks; ++j) {
+                    auto weight_offset = j * weight_stride;
+                    auto out_block = out + j * out_stride;
+                    int p = 0;
+                    for (; p + 12 <= pixels; p += 12) {
+                        conv2d_nchw8c_pixels<12>(taps, inputs, offset + p * step, weights, weight_offset, step,
+                                                 out_block + p * 8);
+                    }
+                    for (; p + 4 <= pixels; p += 4) {
+                        conv2d_nchw8c_pixels<4>(taps, inputs, offset + p * step, weights, weight_offset, step,
+                                                out_block + p * 8);
+                    }
+                    for (; p < pixels; ++p) {
+                        conv2d_nchw8c_pixels<1>(taps, inputs, offset + p * step, weights, weight_offset, step,
+                                                out_block + p * 8);
+                    }
+                }
+            }
+
+            const ISAKernels *kernels_avx2() {
+                static const ISAKernels kernels = {
+                        gemm_tile8, 1,
+                        winograd_f63_input,
+                        conv2d_nchw8c_tile, 1,
+                };
+                return &kernels;
+            }
+        }
+    }
+}
+
+#endif
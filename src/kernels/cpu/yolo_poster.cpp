@@ -7,6 +7,8 @@
 #include "backend/name.h"
 #include "core/tensor_builder.h"
 #include "runtime/stack.h"
+#include "runtime/inside/parallel.h"
+#include "kernels/cpu/nms.h"
 #include <algorithm>
 
 #include <cstring>
@@ -217,66 +219,42 @@ namespace ts {
                 // return count;
             }
 
-            static float overlap(float x1, float w1, float x2, float w2)
-            {
-                float l1 = x1 - w1/2;
-                float l2 = x2 - w2/2;
-                float left = l1 > l2 ? l1 : l2;
-                float r1 = x1 + w1/2;
-                float r2 = x2 + w2/2;
-                float right = r1 < r2 ? r1 : r2;
-                return right - left;
-            }
-
-            static float box_intersection(box a, box b)
-            {
-                float w = overlap(a.x, a.w, b.x, b.w);
-                float h = overlap(a.y, a.h, b.y, b.h);
-                if(w < 0 || h < 0) return 0;
-                float area = w*h;
-                return area;
-            }
-
-            static float box_union(box a, box b)
-            {
-                float i = box_intersection(a, b);
-                float u = a.w*a.h + b.w*b.h - i;
-                return u;
-            }
-
-            static float box_iou(box a, box b)
-            {
-                return box_intersection(a, b)/box_union(a, b);
-            }
-
+            /**
+             * greedy nms of each class, in parallel over classes
+             */
             static void do_nms_sort(detection_list &dets, int total, int classes, float thresh)
             {
-                int i, j, k;
-
-                std::vector<int> sorted_template(total);
-                for (i = 0; i < total; ++i) {
-                    sorted_template[i] = i;
+                // corners and area of boxes, for IoU of kept boxes in SIMD
+                std::vector<float> x1(total), y1(total), x2(total), y2(total), area(total);
+                for (int i = 0; i < total; ++i) {
+                    auto &b = dets[i].bbox;
+                    x1[i] = b.x - b.w/2;
+                    y1[i] = b.y - b.h/2;
+                    x2[i] = b.x + b.w/2;
+                    y2[i] = b.y + b.h/2;
+                    area[i] = b.w*b.h;
                 }
 
-                for(k = 0; k < classes; ++k){
-                    int sort_class = k;
-                    auto sorted = sorted_template;
+                TS_PARALLEL_FOR_BEGIN(k, 0, classes)
+                    // boxes with zero prob suppress nothing, and need not to be suppressed
+                    std::vector<int> sorted;
+                    for (int i = 0; i < total; ++i) {
+                        if (dets[i].prob[k] != 0) sorted.push_back(i);
+                    }
                     std::sort(sorted.begin(), sorted.end(), [&](int a, int b) -> bool {
-                        return dets[a].prob[sort_class] > dets[b].prob[sort_class];
+                        auto prob_a = dets[a].prob[k];
+                        auto prob_b = dets[b].prob[k];
+                        return prob_a > prob_b || (prob_a == prob_b && a < b);
                     });
-                    for(i = 0; i < total; ++i){
-                        auto sorted_i = sorted[i];
-                        if(dets[sorted_i].prob[k] == 0) continue;
-                        box a = dets[sorted_i].bbox;
-                        for(j = i+1; j < total; ++j){
-                            auto sorted_j = sorted[j];
-                            box b = dets[sorted_j].bbox;
-                            if (box_iou(a, b) > thresh){
-                                dets[sorted_j].prob[k] = 0;
-                            }
+                    NMSKept kept;
+                    for (auto i : sorted) {
+                        if (kept.overlapped(x1[i], y1[i], x2[i], y2[i], area[i], thresh)) {
+                            dets[i].prob[k] = 0;
+                        } else {
+                            kept.keep(x1[i], y1[i], x2[i], y2[i], area[i]);
                         }
                     }
-                }
+                TS_PARALLEL_FOR_END()
             }
 
             static float clamp(float x, float min, float max) {
@@ -11,6 +11,9 @@
 #include "orz/vat.h"
 
 #include <list>
+#include <algorithm>
+#include <climits>
+#include <mutex>
 
 namespace ts {
     class VatMemoryController::Implement {
@@ -180,4 +183,400 @@ namespace ts {
     Memory StackMemoryController::alloc(size_t size) {
         return Memory();
     }
-}
\ No newline at end of file
+
+    static const size_t PLANNED_MEMORY_ALIGN = 64;
+
+    static inline size_t planned_align(size_t size) {
+        return (size + PLANNED_MEMORY_ALIGN - 1) / PLANNED_MEMORY_ALIGN * PLANNED_MEMORY_ALIGN;
+    }
+
+    /**
+     * allocation trace of one run, time is logic clock of alloc and free events
+     */
+    class PlannedTrace {
+    public:
+        using self = PlannedTrace;
+        using shared = std::shared_ptr<self>;
+
+        class Record {
+        public:
+            size_t size;
+            int64_t alloc;
+            int64_t free;
+        };
+
+        size_t alloc(size_t size) {
+            std::unique_lock<std::mutex> _lock(m_mutex);
+            m_records.push_back({size, m_clock++, -1});
+            return m_records.size() - 1;
+        }
+
+        void free(size_t index) {
+            std::unique_lock<std::mutex> _lock(m_mutex);
+            if (m_closed) return;
+            m_records[index].free = m_clock++;
+        }
+
+        /**
+         * stop tracing, memory still alive will be treated as alive to the end
+         */
+        void close() {
+            std::unique_lock<std::mutex> _lock(m_mutex);
+            m_closed = true;
+            for (auto &record : m_records) {
+                if (record.free < 0) record.free = LLONG_MAX;
+            }
+        }
+
+        const std::vector<Record> &records() const { return m_records; }
+
+    private:
+        std::vector<Record> m_records;
+        int64_t m_clock = 0;
+        bool m_closed = false;
+        std::mutex m_mutex;
+    };
+
+    /**
+     * offsets of every traced allocation in one slab
+     */
+    class PlannedLayout {
+    public:
+        using self = PlannedLayout;
+        using shared = std::shared_ptr<self>;
+
+        class Block {
+        public:
+            size_t size = 0;
+            size_t offset = 0;
+            /**
+             * earlier blocks sharing memory with this block, they must be freed before this block is used
+             */
+            std::vector<size_t> conflicts;
+        };
+
+        std::vector<Block> blocks;
+        size_t arena = 0;
+
+        /**
+         * Build layout by greedy packing, larger blocks placed first at the lowest offset
+         * which not overlapped with any placed block alive in the same time.
+         * @param trace traced run
+         * @param hint last layout, block size will be at least as it was, for tolerating jittered sizes
+         * @return layout
+         */
+        static shared Build(const PlannedTrace &trace, const self *hint) {
+            auto &records = trace.records();
+            auto n = records.size();
+
+            shared layout = std::make_shared<self>();
+            auto &blocks = layout->blocks;
+            blocks.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                auto size = records[i].size;
+                if (hint && i < hint->blocks.size()) size = std::max(size, hint->blocks[i].size);
+                blocks[i].size = planned_align(size);
+            }
+
+            std::vector<size_t> order(n);
+            for (size_t i = 0; i < n; ++i) order[i] = i;
+            std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                return blocks[a].size > blocks[b].size;
+            });
+
+            auto live_overlap = [&](size_t a, size_t b) {
+                return records[a].alloc < records[b].free && records[b].alloc < records[a].free;
+            };
+
+            std::vector<size_t> placed;
+            std::vector<std::pair<size_t, size_t>> occupied;
+            for (auto i : order) {
+                occupied.clear();
+                for (auto j : placed) {
+                    if (!live_overlap(i, j)) continue;
+                    occupied.emplace_back(blocks[j].offset, blocks[j].size);
+                }
+                std::sort(occupied.begin(), occupied.end());
+                size_t offset = 0;
+                for (auto &range : occupied) {
+                    if (offset + blocks[i].size <= range.first) break;
+                    offset = std::max(offset, range.first + range.second);
+                }
+                blocks[i].offset = offset;
+                layout->arena = std::max(layout->arena, offset + blocks[i].size);
+                placed.push_back(i);
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+                auto &block = blocks[i];
+                for (size_t j = 0; j < i; ++j) {
+                    auto &other = blocks[j];
+                    if (block.offset < other.offset + other.size && other.offset < block.offset + block.size) {
+                        block.conflicts.push_back(j);
+                    }
+                }
+            }
+
+            return layout;
+        }
+    };
+
+    /**
+     * one arena memory, with the alive state of each planned block
+     */
+    class PlannedSlab {
+    public:
+        using self = PlannedSlab;
+        using shared = std::shared_ptr<self>;
+
+        PlannedSlab(HardMemory::shared memory, size_t count)
+                : memory(std::move(memory)), alive(count, 0) {}
+
+        bool acquire(const PlannedLayout::Block &block, size_t index) {
+            std::unique_lock<std::mutex> _lock(mutex);
+            for (auto conflict : block.conflicts) {
+                if (alive[conflict]) return false;
+            }
+            alive[index] = 1;
+            ++live;
+            return true;
+        }
+
+        void release(size_t index) {
+            std::unique_lock<std::mutex> _lock(mutex);
+            alive[index] = 0;
+            --live;
+        }
+
+        bool idle() {
+            std::unique_lock<std::mutex> _lock(mutex);
+            return live == 0;
+        }
+
+        HardMemory::shared memory;
+        std::vector<char> alive;
+        size_t live = 0;
+        std::mutex mutex;
+    };
+
+    /**
+     * layout and slabs of one signature
+     */
+    class PlannedEntry {
+    public:
+        using self = PlannedEntry;
+        using shared = std::shared_ptr<self>;
+
+        std::string signature;
+        PlannedLayout::shared layout;
+        std::vector<PlannedSlab::shared> slabs;
+
+        PlannedSlab::shared idle_slab(const MemoryDevice &device) {
+            for (auto &slab : slabs) {
+                if (slab->idle()) return slab;
+            }
+            // all slabs are held, like outputs of last run still in using
+            auto slab = std::make_shared<PlannedSlab>(
+                    std::make_shared<HardMemory>(device, layout->arena), layout->blocks.size());
+            slabs.push_back(slab);
+            return slab;
+        }
+
+        /**
+         * keep all slabs in using, and at most one idle slab for next run
+         */
+        void trim_slabs() {
+            std::vector<PlannedSlab::shared> kept_slabs;
+            bool kept_idle = false;
+            for (auto &slab : slabs) {
+                if (slab->idle()) {
+                    if (kept_idle) continue;
+                    kept_idle = true;
+                }
+                kept_slabs.push_back(slab);
+            }
+            slabs.swap(kept_slabs);
+        }
+    };
+
+    class PlannedMemoryController::Implement {
+    public:
+        using self = Implement;
+
+        MemoryDevice m_device;
+        std::shared_ptr<VatMemoryController> m_fallback;
+
+        std::list<PlannedEntry::shared> m_entries;  ///< most recently used first
+        size_t m_capacity = 4;
+
+        // running status
+        bool m_running = false;
+        bool m_diverged = false;
+        PlannedEntry::shared m_entry;
+        PlannedTrace::shared m_trace;
+        PlannedSlab::shared m_slab;
+
+        /**
+         * @return entry of signature, moved to front, created if not exist
+         */
+        PlannedEntry::shared touch(const std::string &signature) {
+            for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+                if ((*it)->signature != signature) continue;
+                auto entry = *it;
+                m_entries.erase(it);
+                m_entries.push_front(entry);
+                return entry;
+            }
+            auto entry = std::make_shared<PlannedEntry>();
+            entry->signature = signature;
+            m_entries.push_front(entry);
+            evict();
+            return entry;
+        }
+
+        /**
+         * drop least recently used entries out of capacity, memory in using keeps their slabs alive
+         */
+        void evict() {
+            while (m_entries.size() > m_capacity) m_entries.pop_back();
+        }
+
+        const PlannedLayout *layout() const {
+            return m_entry ? m_entry->layout.get() : nullptr;
+        }
+    };
+
+    PlannedMemoryController::PlannedMemoryController(const MemoryDevice &device) {
+        TS_AUTO_CHECK(m_impl.get() != nullptr);
+        m_impl->m_device = device;
+        m_impl->m_fallback = std::make_shared<VatMemoryController>(device);
+    }
+
+    PlannedMemoryController::~PlannedMemoryController() = default;
+
+    Memory PlannedMemoryController::alloc(size_t size) {
+        auto &impl = *m_impl;
+        if (!impl.m_running || size == 0) return impl.m_fallback->alloc(size);
+
+        auto trace = impl.m_trace;
+        auto index = trace->alloc(size);
+
+        auto layout = impl.layout();
+        if (layout && !impl.m_diverged) {
+            auto &blocks = layout->blocks;
+            if (index < blocks.size() && size <= blocks[index].size) {
+                auto &block = blocks[index];
+                auto slab = impl.m_slab;
+                if (slab->acquire(block, index)) {
+                    Memory memory(slab->memory, size, block.offset);
+                    memory.destructor([slab, trace, index]() {
+                        slab->release(index);
+                        trace->free(index);
+                    });
+                    return memory;
+                }
+                // the planned block is still overlapped by alive memory, only this memory go dynamic
+            } else {
+                // the allocation sequence changed, the rest of this run go dynamic
+                impl.m_diverged = true;
+            }
+        }
+
+        auto memory = impl.m_fallback->alloc(size);
+        memory.destructor([trace, index]() {
+            trace->free(index);
+        });
+        return memory;
+    }
+
+    uint64_t PlannedMemoryController::summary() const {
+        uint64_t sum = m_impl->m_fallback->summary();
+        for (auto &entry : m_impl->m_entries) {
+            for (auto &slab : entry->slabs) {
+                sum += slab->memory->capacity();
+            }
+        }
+        return sum;
+    }
+
+    void PlannedMemoryController::begin() {
+        begin("");
+    }
+
+    void PlannedMemoryController::begin(const std::string &signature) {
+        auto &impl = *m_impl;
+        if (impl.m_running) {
+            TS_LOG_ERROR << "PlannedMemoryController can not begin twice before end." << eject;
+        }
+        impl.m_running = true;
+        impl.m_diverged = false;
+        impl.m_trace = std::make_shared<PlannedTrace>();
+        impl.m_entry = impl.touch(signature);
+        if (impl.m_entry->layout) {
+            impl.m_slab = impl.m_entry->idle_slab(impl.m_device);
+        }
+    }
+
+    void PlannedMemoryController::end() {
+        auto &impl = *m_impl;
+        if (!impl.m_running) return;
+        impl.m_running = false;
+        impl.m_slab.reset();
+
+        auto entry = impl.m_entry;
+        impl.m_entry.reset();
+
+        auto trace = impl.m_trace;
+        impl.m_trace.reset();
+        trace->close();
+
+        if (entry == nullptr) return;   // reset while running
+        if (entry->layout && !impl.m_diverged && trace->records().size() == entry->layout->blocks.size()) {
+            entry->trim_slabs();
+            return;
+        }
+        // first run or the allocation sequence changed, build new layout.
+        // slabs of old layout are released, memory in using keeps them alive.
+        entry->layout = PlannedLayout::Build(*trace, entry->layout.get());
+        entry->slabs.clear();
+        // release cached heap of traced run, memory still in using will be freed dynamically
+        impl.m_fallback = std::make_shared<VatMemoryController>(impl.m_device);
+        if (entry->layout->blocks.empty()) entry->layout.reset();
+    }
+
+    void PlannedMemoryController::reset() {
+        auto &impl = *m_impl;
+        impl.m_entries.clear();
+        impl.m_entry.reset();
+        impl.m_slab.reset();
+    }
+
+    bool PlannedMemoryController::planned() const {
+        auto &entries = m_impl->m_entries;
+        return !entries.empty() && entries.front()->layout != nullptr;
+    }
+
+    uint64_t PlannedMemoryController::arena() const {
+        auto &entries = m_impl->m_entries;
+        return planned() ? entries.front()->layout->arena : 0;
+    }
+
+    size_t PlannedMemoryController::plans() const {
+        size_t count = 0;
+        for (auto &entry : m_impl->m_entries) {
+            if (entry->layout) ++count;
+        }
+        return count;
+    }
+
+    void PlannedMemoryController::set_capacity(size_t capacity) {
+        auto &impl = *m_impl;
+        impl.m_capacity = std::max<size_t>(capacity, 1);
+        // running entry is at front, never evicted
+        impl.evict();
+    }
+
+    size_t PlannedMemoryController::capacity() const {
+        return m_impl->m_capacity;
+    }
+}
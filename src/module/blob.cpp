@@ -0,0 +1,54 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "module/blob.h"
+
+#include "utils/assert.h"
+#include "utils/ctxmgr_lite_support.h"
+
+#include <vector>
+
+namespace ts {
+    static inline uint64_t align_up(uint64_t size, uint64_t alignment) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    BlobWriter::BlobWriter(size_t alignment, size_t threshold)
+            : m_alignment(std::max<size_t>(alignment, 1)), m_threshold(threshold) {
+    }
+
+    int64_t BlobWriter::write(const Memory &memory) {
+        if (memory.size() < m_threshold) return -1;
+        TS_AUTO_CHECK(memory.device().type() == CPU);
+        auto offset = align_up(m_size, m_alignment);
+        m_blobs.push_back(memory);
+        m_size = offset + memory.size();
+        return int64_t(offset);
+    }
+
+    size_t BlobWriter::serialize(StreamWriter &stream) const {
+        std::vector<char> padding(m_alignment, 0);
+        uint64_t writen_size = 0;
+        for (auto &blob : m_blobs) {
+            auto offset = align_up(writen_size, m_alignment);
+            writen_size += binio::write<char>(stream, padding.data(), size_t(offset - writen_size));
+            writen_size += binio::write<char>(stream, blob.data<char>(), blob.size());
+        }
+        return size_t(writen_size);
+    }
+
+    BlobReader::BlobReader(HardMemory::shared hard, size_t shift, uint64_t size)
+            : m_hard(std::move(hard)), m_shift(shift), m_size(size) {
+    }
+
+    Memory BlobReader::read(uint64_t offset, size_t size) const {
+        if (offset + size > m_size) {
+            TS_LOG_ERROR << "Blob [" << offset << ", " << offset + size << ") out of range " << m_size << eject;
+        }
+        return Memory(m_hard, size, m_shift + size_t(offset));
+    }
+}
+
+TS_LITE_CONTEXT(ts::BlobWriter)
+TS_LITE_CONTEXT(ts::BlobReader)
@@ -0,0 +1,93 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "module/io/mstream.h"
+
+#include "utils/platform.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if TS_PLATFORM_OS_WINDOWS
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ts {
+    MemoryStreamReader::MemoryStreamReader(const void *data, size_t size)
+            : m_data(reinterpret_cast<const char *>(data)), m_size(size) {
+    }
+
+    size_t MemoryStreamReader::read(void *buffer, size_t size) {
+        size = std::min(size, m_size - m_position);
+        std::memcpy(buffer, m_data + m_position, size);
+        m_position += size;
+        return size;
+    }
+
+    size_t MemoryStreamReader::skip(size_t size) {
+        size = std::min(size, m_size - m_position);
+        m_position += size;
+        return size;
+    }
+
+    static HardMemory::shared read_file(const std::string &path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return nullptr;
+        auto size = size_t(file.tellg());
+        file.seekg(0, std::ios::beg);
+        auto memory = std::make_shared<HardMemory>(MemoryDevice(CPU), size);
+        file.read(memory->data<char>(), size);
+        if (size_t(file.gcount()) != size) return nullptr;
+        return memory;
+    }
+
+#if TS_PLATFORM_OS_WINDOWS
+    HardMemory::shared map_file(const std::string &path) {
+        auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return nullptr;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            CloseHandle(file);
+            return read_file(path);
+        }
+        auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr) return read_file(path);
+        auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (data == nullptr) return read_file(path);
+        auto size = size_t(file_size.QuadPart);
+        return HardMemory::shared(new HardMemory(MemoryDevice(CPU), data, size), [](HardMemory *memory) {
+            UnmapViewOfFile(memory->data());
+            delete memory;
+        });
+    }
+#else
+    HardMemory::shared map_file(const std::string &path) {
+        auto fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return nullptr;
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+            close(fd);
+            return read_file(path);
+        }
+        auto size = size_t(file_stat.st_size);
+        // read only, so stray writing into weights shared in data segment faults instead of changing them
+        auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) return read_file(path);
+        return HardMemory::shared(new HardMemory(MemoryDevice(CPU), data, size), [size](HardMemory *memory) {
+            munmap(memory->data(), size);
+            delete memory;
+        });
+    }
+#endif
+}
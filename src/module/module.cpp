@@ -16,6 +16,9 @@
 #include "utils/box.h"
 #include "core/tensor_builder.h"
 #include "module/io/fstream.h"
+#include "module/io/sstream.h"
+#include "module/io/mstream.h"
+#include "module/blob.h"
 #include "module/menu.h"
 #include "module/header.h"
 
@@ -195,14 +198,40 @@ namespace ts {
     using set = std::unordered_set<K>;
 
     std::vector<std::pair<Node, int>> Module::list_reference_nodes(const std::vector<Node> &nodes) {
+        // number of reading edges from found nodes, walk node after all its readers walked
+        map<Node, int> map_node_readers;
+        std::vector<Node> found_nodes;
+        std::vector<Node> node_finder;
+
+        for (auto &node : nodes) {
+            if (map_node_readers.find(node) != map_node_readers.end()) continue;
+            map_node_readers.insert(std::make_pair(node, 0));
+            found_nodes.push_back(node);
+            node_finder.push_back(node);
+        }
+
+        while (!node_finder.empty()) {
+            auto node = node_finder.back();
+            node_finder.pop_back();
+            for (auto &input : node.inputs()) {
+                auto input_readers_pair = map_node_readers.find(input);
+                if (input_readers_pair == map_node_readers.end()) {
+                    map_node_readers.insert(std::make_pair(input, 1));
+                    found_nodes.push_back(input);
+                    node_finder.push_back(input);
+                } else {
+                    ++input_readers_pair->second;
+                }
+            }
+        }
+
+        // depth is the longest distance to given nodes, given nodes' depth at least 1
         map<Node, int> map_node_depth;
         std::deque<Node> node_walker; // top_down
-
         for (auto &node : nodes) {
-            auto it = map_node_depth.find(node);
-            if (it != map_node_depth.end()) continue;
-            node_walker.push_back(node);
+            if (map_node_depth.find(node) != map_node_depth.end()) continue;
             map_node_depth.insert(std::make_pair(node, 1));
+            if (map_node_readers[node] == 0) node_walker.push_back(node);
         }
 
         while (!node_walker.empty()) {
@@ -210,32 +239,34 @@ namespace ts {
             node_walker.pop_front();
             auto depth = map_node_depth[node];
             for (auto &input : node.inputs()) {
-                auto input_depth_pair = map_node_depth.find(input);
-                if (input_depth_pair == map_node_depth.end()) {
-                    map_node_depth.insert(std::make_pair(input, depth + 1));
-                    node_walker.push_back(input);
-                } else {
-                    auto this_input_depth = depth + 1;
-                    if (input_depth_pair->second < this_input_depth) {
-                        input_depth_pair->second = this_input_depth;
-                        node_walker.push_back(input);   // re-walk nodes
-                    }
-                }
+                auto &input_depth = map_node_depth[input];
+                input_depth = std::max(input_depth, depth + 1);
+                if (--map_node_readers[input] == 0) node_walker.push_back(input);
             }
         }
 
-        std::vector<std::pair<Node, int>> computation_schedule(map_node_depth.begin(), map_node_depth.end());
-        std::sort(computation_schedule.begin(), computation_schedule.end(),
-                  [](const std::pair<Node, int> &lhs, const std::pair<Node, int> &rhs){
-                      return lhs.second > rhs.second;
-                  });
+        std::vector<std::pair<Node, int>> computation_schedule;
+        computation_schedule.reserve(found_nodes.size());
+        for (auto &node : found_nodes) {
+            computation_schedule.emplace_back(node, map_node_depth[node]);
+        }
+        std::stable_sort(computation_schedule.begin(), computation_schedule.end(),
+                         [](const std::pair<Node, int> &lhs, const std::pair<Node, int> &rhs){
+                             return lhs.second > rhs.second;
+                         });
 
         return std::move(computation_schedule);
     }
 
-    void Module::Save(StreamWriter &stream, Module::shared module, Module::SerializationFormat format) {
-        TS_AUTO_CHECK(format == BINARY);
-        auto valued_nodes = list_reference_nodes(module->outputs());
+    static inline size_t align_up(size_t size, size_t alignment) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * serialize inputs, outputs and graph of module
+     */
+    static size_t serialize_module(StreamWriter &stream, Module::shared module) {
+        auto valued_nodes = Module::list_reference_nodes(module->outputs());
         std::vector<Node> nodes;
         std::unordered_map<Node, size_t> map_node_index;
         size_t index = 0;
@@ -251,27 +282,61 @@ namespace ts {
             nodes.emplace_back(node);
         }
 
-        // 0. save header
-        Header header;
-        header.code = TS_MODULE_CODE_V1;
-        header.serialize(stream);
-
+        size_t writen_size = 0;
         // 1. save inputs
-        binio::write<uint32_t>(stream, uint32_t(module->inputs().size()));
+        writen_size += binio::write<uint32_t>(stream, uint32_t(module->inputs().size()));
         for (auto &node : module->inputs()) {
-            binio::write<uint32_t>(stream, uint32_t(map_node_index[node]));
+            writen_size += binio::write<uint32_t>(stream, uint32_t(map_node_index[node]));
         }
         // 2. save outputs
-        binio::write<uint32_t>(stream, uint32_t(module->outputs().size()));
+        writen_size += binio::write<uint32_t>(stream, uint32_t(module->outputs().size()));
         for (auto &node : module->outputs()) {
-            binio::write<uint32_t>(stream, uint32_t(map_node_index[node]));
+            writen_size += binio::write<uint32_t>(stream, uint32_t(map_node_index[node]));
         }
         // 3. save graphs
-        serialize_nodes(stream, nodes);
+        writen_size += serialize_nodes(stream, nodes);
+        return writen_size;
+    }
+
+    void Module::Save(StreamWriter &stream, Module::shared module, Module::SerializationFormat format) {
+        TS_AUTO_CHECK(format == BINARY || format == BINARY_V2);
+
+        if (format == BINARY) {
+            // 0. save header
+            Header header;
+            header.code = TS_MODULE_CODE_V1;
+            header.serialize(stream);
+
+            serialize_module(stream, module);
+            return;
+        }
+
+        // v2: weights are saved in blobs before graph, each one aligned in file
+        BlobWriter blobs;
+        StringStreamWriter graph;
+        {
+            ctx::bind<BlobWriter> _bind_blobs(blobs);
+            serialize_module(graph, module);
+        }
+
+        size_t writen_size = 0;
+        // 0. save header
+        Header header;
+        header.code = TS_MODULE_CODE_V2;
+        writen_size += header.serialize(stream);
+        // 1. save blobs
+        writen_size += binio::write<uint64_t>(stream, blobs.size());
+        writen_size += binio::write<uint32_t>(stream, uint32_t(blobs.alignment()));
+        std::vector<char> padding(align_up(writen_size, blobs.alignment()) - writen_size, 0);
+        writen_size += binio::write<char>(stream, padding.data(), padding.size());
+        writen_size += blobs.serialize(stream);
+        // 2. save inputs, outputs and graph
+        auto graph_buffer = graph.str();
+        writen_size += binio::write<char>(stream, graph_buffer.data(), graph_buffer.size());
     }
 
     void Module::Save(const std::string &filename, Module::shared module, Module::SerializationFormat format) {
-        TS_AUTO_CHECK(format == BINARY);
+        TS_AUTO_CHECK(format == BINARY || format == BINARY_V2);
         FileStreamWriter stream(filename);
 
         TS_CHECK(stream.is_open()) << "Can not access: " << filename << eject;
@@ -289,16 +354,40 @@ namespace ts {
         return read_size;
     }
 
-    Module::shared Module::Load(StreamReader &stream, Module::SerializationFormat format) {
-        TS_AUTO_CHECK(format == BINARY);
-        //FileStreamReader stream(filename);
-        //TS_CHECK(stream.is_open()) << "Can not access: " << filename << eject;
+    /**
+     * @param stream module stream
+     * @param mapped mapped file if stream reading it, then blobs are used without copy
+     * @return module
+     */
+    static Module::shared externalize_module(StreamReader &stream, MemoryStreamReader *mapped_stream,
+                                             const HardMemory::shared &mapped) {
         size_t read_size = 0;
 
         // 0. read header
         Header header;
         read_size += header.externalize(stream);
-        TS_AUTO_CHECK(header.code == TS_MODULE_CODE_V1);
+        TS_AUTO_CHECK(header.code == TS_MODULE_CODE_V1 || header.code == TS_MODULE_CODE_V2);
+
+        // 0.x read blobs
+        std::unique_ptr<BlobReader> blobs;
+        if (header.code == TS_MODULE_CODE_V2) {
+            uint64_t blobs_size = 0;
+            uint32_t alignment = 1;
+            read_size += binio::read<uint64_t>(stream, blobs_size);
+            read_size += binio::read<uint32_t>(stream, alignment);
+            TS_AUTO_CHECK(alignment > 0);
+            std::vector<char> padding(align_up(read_size, alignment) - read_size);
+            read_size += binio::read<char>(stream, padding.data(), padding.size());
+            if (mapped_stream != nullptr) {
+                blobs.reset(new BlobReader(mapped, mapped_stream->position(), blobs_size));
+                read_size += mapped_stream->skip(size_t(blobs_size));
+            } else {
+                auto memory = std::make_shared<HardMemory>(MemoryDevice(CPU), size_t(blobs_size));
+                read_size += binio::read<char>(stream, memory->data<char>(), size_t(blobs_size));
+                blobs.reset(new BlobReader(memory, 0, blobs_size));
+            }
+        }
+        ctx::bind<BlobReader> _bind_blobs(blobs.get());
 
         // 1. read inputs
         // read node index
@@ -322,11 +411,18 @@ namespace ts {
         return module;
     }
 
+    Module::shared Module::Load(StreamReader &stream, Module::SerializationFormat format) {
+        TS_AUTO_CHECK(format == BINARY || format == BINARY_V2);
+        return externalize_module(stream, nullptr, nullptr);
+    }
+
     Module::shared Module::Load(const std::string &filename, Module::SerializationFormat format) {
-        TS_AUTO_CHECK(format == BINARY);
-        FileStreamReader stream(filename);
-        TS_CHECK(stream.is_open()) << "Can not access: " << filename << eject;
-        return Load(stream, format);
+        TS_AUTO_CHECK(format == BINARY || format == BINARY_V2);
+        // mapping file, so weights in blobs are shared with page cache
+        auto mapped = map_file(filename);
+        TS_CHECK(mapped != nullptr) << "Can not access: " << filename << eject;
+        MemoryStreamReader stream(mapped->data(), mapped->capacity());
+        return externalize_module(stream, &stream, mapped);
     }
 
     void Module::set_param(const std::string &node_name, const std::string &param, const Tensor &value) {
@@ -0,0 +1,113 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "runtime/async_run.h"
+
+#include "utils/except.h"
+#include "utils/log.h"
+
+#include <mutex>
+#include <chrono>
+
+namespace ts {
+    class AsyncRun::Implement {
+    public:
+        mutable std::mutex mutex;
+        Status status = QUEUED;
+        std::promise<Outputs> promise;
+        std::shared_future<Outputs> future;
+        Callback callback;
+        std::function<void()> release;
+    };
+
+    AsyncRun::AsyncRun(const Callback &callback) {
+        m_impl->callback = callback;
+        m_impl->future = m_impl->promise.get_future().share();
+    }
+
+    AsyncRun::~AsyncRun() = default;
+
+    AsyncRun::Status AsyncRun::status() const {
+        std::unique_lock<std::mutex> _lock(m_impl->mutex);
+        return m_impl->status;
+    }
+
+    bool AsyncRun::ready() const {
+        return status() >= DONE;
+    }
+
+    void AsyncRun::wait() const {
+        m_impl->future.wait();
+    }
+
+    bool AsyncRun::wait_for(int64_t milliseconds) const {
+        return m_impl->future.wait_for(std::chrono::milliseconds(milliseconds)) == std::future_status::ready;
+    }
+
+    const AsyncRun::Outputs &AsyncRun::get() const {
+        return m_impl->future.get();
+    }
+
+    std::shared_future<AsyncRun::Outputs> AsyncRun::future() const {
+        return m_impl->future;
+    }
+
+    /**
+     * give back executor slot, then notify caller
+     */
+    static void complete(AsyncRun &run, std::function<void()> &release, const AsyncRun::Callback &callback) {
+        if (release) {
+            release();
+            release = nullptr;
+        }
+        if (callback == nullptr) return;
+        try {
+            callback(run);
+        } catch (const std::exception &e) {
+            TS_LOG_ERROR << "Exception in async run callback: " << e.what();
+        } catch (...) {
+            TS_LOG_ERROR << "Unknown exception in async run callback";
+        }
+    }
+
+    bool AsyncRun::cancel() {
+        {
+            std::unique_lock<std::mutex> _lock(m_impl->mutex);
+            if (m_impl->status != QUEUED) return false;
+            m_impl->status = CANCELLED;
+        }
+        m_impl->promise.set_exception(std::make_exception_ptr(Exception("Async run cancelled")));
+        complete(*this, m_impl->release, m_impl->callback);
+        return true;
+    }
+
+    bool AsyncRun::start() {
+        std::unique_lock<std::mutex> _lock(m_impl->mutex);
+        if (m_impl->status != QUEUED) return false;
+        m_impl->status = RUNNING;
+        return true;
+    }
+
+    void AsyncRun::finish(Outputs outputs) {
+        {
+            std::unique_lock<std::mutex> _lock(m_impl->mutex);
+            m_impl->status = DONE;
+        }
+        m_impl->promise.set_value(std::move(outputs));
+        complete(*this, m_impl->release, m_impl->callback);
+    }
+
+    void AsyncRun::fail(std::exception_ptr exception) {
+        {
+            std::unique_lock<std::mutex> _lock(m_impl->mutex);
+            m_impl->status = FAILED;
+        }
+        m_impl->promise.set_exception(exception);
+        complete(*this, m_impl->release, m_impl->callback);
+    }
+
+    void AsyncRun::bind_release(std::function<void()> release) {
+        m_impl->release = std::move(release);
+    }
+}
@@ -0,0 +1,287 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "runtime/batcher.h"
+
+#include "utils/need.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <chrono>
+
+namespace ts {
+    struct BatchRequest {
+        std::vector<Tensor> inputs;
+        std::promise<Batcher::Outputs> promise;
+        std::chrono::steady_clock::time_point arrival;
+        int batch = 0;  ///< samples count, set after filtered
+    };
+
+    /**
+     * @return if tensors can be concatenated along first dim
+     */
+    static bool batchable(const Tensor &lhs, const Tensor &rhs) {
+        if (lhs.dtype() != rhs.dtype() || lhs.dims() != rhs.dims() || lhs.dims() == 0) return false;
+        for (size_t i = 1; i < lhs.dims(); ++i) {
+            if (lhs.size(i) != rhs.size(i)) return false;
+        }
+        return true;
+    }
+
+    class Batcher::Implement {
+    public:
+        Implement(const Workbench::shared &bench, int max_batch_size, int latency,
+                  const std::vector<bool> &batch_outputs)
+                : m_max_batch_size(std::max(1, max_batch_size))
+                , m_latency(std::max(0, latency)) {
+            if (bench == nullptr || bench->desktop() == nullptr) {
+                TS_LOG_ERROR << "Can not batch on workbench with no program setup" << eject;
+            }
+            m_bench = bench->share();
+
+            auto program = m_bench->desktop();
+            m_filters.resize(size_t(program->input_count()));
+            bool filtered = false;
+            for (int i = 0; i < program->input_count(); ++i) {
+                m_filters[i] = program->input_filter(i);
+                if (m_filters[i] != nullptr) filtered = true;
+            }
+            // inputs are filtered one by one, so run program without filter on batch
+            if (filtered) m_bench->setup(program->unfiltered());
+
+            if (batch_outputs.empty()) {
+                m_batch_outputs.resize(size_t(program->output_count()), true);
+            } else if (batch_outputs.size() == size_t(program->output_count())) {
+                m_batch_outputs = batch_outputs;
+            } else {
+                TS_LOG_ERROR << "Batcher need batch axis flag of " << program->output_count()
+                             << " outputs, got " << batch_outputs.size() << eject;
+            }
+
+            m_worker = std::thread(&Implement::operating, this);
+        }
+
+        ~Implement() {
+            {
+                std::unique_lock<std::mutex> _lock(m_mutex);
+                m_stopped = true;
+            }
+            m_cond.notify_all();
+            m_worker.join();
+        }
+
+        std::future<Outputs> submit(const std::vector<Tensor> &inputs) {
+            if (inputs.size() != m_filters.size()) {
+                TS_LOG_ERROR << "Batcher need " << m_filters.size() << " inputs, got " << inputs.size() << eject;
+            }
+            std::unique_ptr<BatchRequest> request(new BatchRequest);
+            request->inputs = inputs;
+            request->arrival = std::chrono::steady_clock::now();
+            auto future = request->promise.get_future();
+            {
+                std::unique_lock<std::mutex> _lock(m_mutex);
+                if (m_stopped) {
+                    TS_LOG_ERROR << "Can not submit to stopped batcher" << eject;
+                }
+                m_queue.emplace_back(std::move(request));
+            }
+            m_cond.notify_one();
+            return future;
+        }
+
+        int max_batch_size() const { return m_max_batch_size; }
+
+        int latency() const { return m_latency; }
+
+    private:
+        void operating() {
+            while (true) {
+                std::vector<std::unique_ptr<BatchRequest>> requests;
+                {
+                    std::unique_lock<std::mutex> _lock(m_mutex);
+                    while (!m_stopped && m_queue.empty()) m_cond.wait(_lock);
+                    if (m_queue.empty()) break;
+                    // wait others until batch full or the oldest request out of time
+                    auto deadline = m_queue.front()->arrival + std::chrono::microseconds(m_latency);
+                    while (!m_stopped && m_queue.size() < size_t(m_max_batch_size)) {
+                        if (m_cond.wait_until(_lock, deadline) == std::cv_status::timeout) break;
+                    }
+                    while (!m_queue.empty() && requests.size() < size_t(m_max_batch_size)) {
+                        requests.emplace_back(std::move(m_queue.front()));
+                        m_queue.pop_front();
+                    }
+                }
+                process(requests);
+            }
+        }
+
+        /**
+         * filter inputs of request, set exception if failed
+         */
+        bool filter(BatchRequest &request) {
+            try {
+                for (size_t i = 0; i < m_filters.size(); ++i) {
+                    auto &input = request.inputs[i];
+                    if (m_filters[i] == nullptr) continue;
+                    input = m_bench->launch_offline(m_filters[i], std::vector<Tensor>({ImageFilter::AdjustNHWC(input)}))[0];
+                }
+                // every input must carry the same samples in first dim
+                for (size_t i = 0; i < request.inputs.size(); ++i) {
+                    auto &input = request.inputs[i];
+                    if (input.dims() == 0) {
+                        TS_LOG_ERROR << "Batcher input " << i << " has no batch axis" << eject;
+                    }
+                    if (i == 0) {
+                        request.batch = input.size(0);
+                    } else if (input.size(0) != request.batch) {
+                        TS_LOG_ERROR << "Batcher input " << i << " has batch " << input.size(0)
+                                     << ", mismatch input 0 with batch " << request.batch << eject;
+                    }
+                }
+                return true;
+            } catch (...) {
+                request.promise.set_exception(std::current_exception());
+                return false;
+            }
+        }
+
+        void process(std::vector<std::unique_ptr<BatchRequest>> &requests) {
+            std::deque<BatchRequest *> pending;
+            for (auto &request : requests) {
+                if (filter(*request)) pending.push_back(request.get());
+            }
+            // group requests can be concatenated, in arrival order
+            while (!pending.empty()) {
+                std::vector<BatchRequest *> group;
+                std::deque<BatchRequest *> rest;
+                int batch = 0;
+                for (auto request : pending) {
+                    if (group.empty()) {
+                        group.push_back(request);
+                        batch = request->batch;
+                        continue;
+                    }
+                    bool ok = batch + request->batch <= m_max_batch_size;
+                    for (size_t i = 0; ok && i < request->inputs.size(); ++i) {
+                        ok = batchable(group[0]->inputs[i], request->inputs[i]);
+                    }
+                    if (ok) {
+                        group.push_back(request);
+                        batch += request->batch;
+                    } else {
+                        rest.push_back(request);
+                    }
+                }
+                run(group, batch);
+                pending.swap(rest);
+            }
+        }
+
+        void run(const std::vector<BatchRequest *> &group, int batch) {
+            try {
+                if (group.size() == 1) {
+                    group[0]->promise.set_value(launch(group[0]->inputs, batch));
+                    return;
+                }
+
+                auto &memory_device = m_bench->device().memory_device;
+                std::vector<Tensor> inputs(m_filters.size());
+                for (size_t i = 0; i < inputs.size(); ++i) {
+                    auto &first = group[0]->inputs[i];
+                    auto shape = first.sizes();
+                    shape[0] = 0;
+                    for (auto request : group) shape[0] += request->inputs[i].size(0);
+                    Tensor input(memory_device, first.dtype(), shape);
+                    auto data = input.data<char>();
+                    for (auto request : group) {
+                        auto &part = request->inputs[i];
+                        auto bytes = size_t(part.count()) * part.proto().type_bytes();
+                        memcpy(data, input.device(), bytes, part.data(), part.device(), bytes);
+                        data += bytes;
+                    }
+                    inputs[i] = input;
+                }
+
+                auto outputs = launch(inputs, batch);
+
+                int offset = 0;
+                for (auto request : group) {
+                    Outputs slices;
+                    for (size_t i = 0; i < outputs.size(); ++i) {
+                        auto &output = outputs[i];
+                        if (m_batch_outputs[i]) {
+                            slices.emplace_back(output.slice(offset, offset + request->batch).clone());
+                        } else {
+                            slices.emplace_back(output);
+                        }
+                    }
+                    offset += request->batch;
+                    request->promise.set_value(std::move(slices));
+                }
+            } catch (...) {
+                for (auto request : group) {
+                    request->promise.set_exception(std::current_exception());
+                }
+            }
+        }
+
+        /**
+         * run inputs, check outputs with batch axis have batch samples, so no output is sliced by guess
+         */
+        Outputs launch(const std::vector<Tensor> &inputs, int batch) {
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                m_bench->input(int(i), inputs[i]);
+            }
+            m_bench->run();
+            Outputs outputs(size_t(m_bench->output_count()));
+            for (size_t i = 0; i < outputs.size(); ++i) {
+                outputs[i] = m_bench->output(int(i));
+                if (!m_batch_outputs[i]) continue;
+                if (outputs[i].dims() == 0 || outputs[i].size(0) != batch) {
+                    TS_LOG_ERROR << "Batcher output " << i << " with shape " << to_string(outputs[i].sizes())
+                                 << " has no batch axis of " << batch
+                                 << ", flag it in batch_outputs if it is not sliced by samples" << eject;
+                }
+            }
+            return outputs;
+        }
+
+        Workbench::shared m_bench;
+        std::vector<Program::shared> m_filters;
+        std::vector<bool> m_batch_outputs;
+        int m_max_batch_size;
+        int m_latency;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        std::deque<std::unique_ptr<BatchRequest>> m_queue;
+        bool m_stopped = false;
+        std::thread m_worker;
+    };
+
+    Batcher::Batcher(const Workbench::shared &bench, int max_batch_size, int latency)
+            : m_impl(bench, max_batch_size, latency, std::vector<bool>()) {
+    }
+
+    Batcher::Batcher(const Workbench::shared &bench, int max_batch_size, int latency,
+                     const std::vector<bool> &batch_outputs)
+            : m_impl(bench, max_batch_size, latency, batch_outputs) {
+    }
+
+    Batcher::~Batcher() = default;
+
+    std::future<Batcher::Outputs> Batcher::submit(const std::vector<Tensor> &inputs) {
+        return m_impl->submit(inputs);
+    }
+
+    int Batcher::max_batch_size() const {
+        return m_impl->max_batch_size();
+    }
+
+    int Batcher::latency() const {
+        return m_impl->latency();
+    }
+}
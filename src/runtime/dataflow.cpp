@@ -0,0 +1,247 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "runtime/dataflow.h"
+
+#include "runtime/workbench.h"
+#include "runtime/program.h"
+#include "runtime/instruction.h"
+#include "board/profiler.h"
+#include "board/hook.h"
+#include "utils/need.h"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <algorithm>
+
+namespace ts {
+    int Dataflow::width() const {
+        std::vector<int> node_level(nodes.size(), 0);
+        std::vector<int> level_width;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            int level = 0;
+            for (auto &input : nodes[i].inputs) {
+                if (input.kind != Value::NODE) continue;
+                level = std::max(level, node_level[input.index] + 1);
+            }
+            node_level[i] = level;
+            if (size_t(level) >= level_width.size()) level_width.resize(level + 1, 0);
+            ++level_width[level];
+        }
+        return level_width.empty() ? 0 : *std::max_element(level_width.begin(), level_width.end());
+    }
+
+    bool DataflowRunner::Ready(Workbench &bench, const Program &program) {
+        auto dataflow = program.dataflow();
+        if (dataflow == nullptr || dataflow->nodes.size() < 2) return false;
+        if (bench.runtime().thread_pool().size() <= 1) return false;
+        if (bench.switch_controller()->is_load_dll()) return false;
+#ifdef TS_USE_PROFILER
+        if (profiler_on()) return false;
+#endif
+#ifdef TS_USE_HOOK
+        if (ctx::get<Hook>() != nullptr) return false;
+#endif
+        return true;
+    }
+
+    /**
+     * shared status of running dataflow
+     */
+    class DataflowStatus {
+    public:
+        using self = DataflowStatus;
+
+        DataflowStatus(const Dataflow &dataflow, const Program &program)
+                : dataflow(dataflow), program(program)
+                , values(dataflow.nodes.size())
+                , pending(dataflow.nodes.size())
+                , readers(dataflow.nodes.size())
+                , consumers(dataflow.nodes.size())
+                , is_output(dataflow.nodes.size(), 0) {
+            auto &nodes = dataflow.nodes;
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                pending[i] = 0;
+                readers[i] = 0;
+            }
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                for (auto &input : nodes[i].inputs) {
+                    if (input.kind != Dataflow::Value::NODE) continue;
+                    ++pending[i];
+                    ++readers[input.index];
+                    consumers[input.index].push_back(int(i));
+                }
+            }
+            for (auto &output : dataflow.outputs) {
+                if (output.kind != Dataflow::Value::NODE) continue;
+                is_output[output.index] = 1;
+            }
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (pending[i] == 0) ready.push_back(int(i));
+            }
+        }
+
+        Tensor value(const Dataflow::Value &value) const {
+            switch (value.kind) {
+                case Dataflow::Value::ARGUMENT:
+                    return arguments[value.index];
+                case Dataflow::Value::DATA:
+                    return program.data_segment(value.index);
+                case Dataflow::Value::NODE:
+                    return values[value.index];
+            }
+            return Tensor();
+        }
+
+        /**
+         * @param [out] index got ready node
+         * @return false if all nodes finished or failed
+         */
+        bool next(int &index) {
+            std::unique_lock<std::mutex> _lock(mutex);
+            while (!failed && ready.empty() && finished < dataflow.nodes.size()) cond.wait(_lock);
+            if (failed || ready.empty()) return false;
+            index = ready.front();
+            ready.pop_front();
+            return true;
+        }
+
+        void finish(int index) {
+            // release inputs not needed any more
+            for (auto &input : dataflow.nodes[index].inputs) {
+                if (input.kind != Dataflow::Value::NODE) continue;
+                if (--readers[input.index] == 0 && !is_output[input.index]) {
+                    values[input.index] = Tensor();
+                }
+            }
+            size_t new_ready = 0;
+            {
+                std::unique_lock<std::mutex> _lock(mutex);
+                ++finished;
+                for (auto consumer : consumers[index]) {
+                    if (--pending[consumer] == 0) {
+                        ready.push_back(consumer);
+                        ++new_ready;
+                    }
+                }
+            }
+            if (new_ready > 1 || finished == dataflow.nodes.size()) {
+                cond.notify_all();
+            } else if (new_ready == 1) {
+                cond.notify_one();
+            }
+        }
+
+        void fail() {
+            {
+                std::unique_lock<std::mutex> _lock(mutex);
+                if (!failed) exception = std::current_exception();
+                failed = true;
+            }
+            cond.notify_all();
+        }
+
+        const Dataflow &dataflow;
+        const Program &program;
+
+        std::vector<Tensor> arguments;
+        std::vector<Tensor> values;
+        std::vector<std::atomic<int>> pending;
+        std::vector<std::atomic<int>> readers;
+        std::vector<std::vector<int>> consumers;
+        std::vector<char> is_output;
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<int> ready;
+        size_t finished = 0;
+        bool failed = false;
+        std::exception_ptr exception;
+    };
+
+    /**
+     * bind workbench's context in lane thread
+     */
+    class BindDataflowLane {
+    public:
+        BindDataflowLane(Workbench &bench)
+                : bind_thread_pool(bench.runtime().thread_pool())
+                , bind_runtime_context(bench.runtime())
+                , bind_work_bench(bench) {
+            m_pre_device_context = DeviceContext::Switch(&bench.device());
+        }
+
+        ~BindDataflowLane() {
+            DeviceContext::Switch(m_pre_device_context);
+        }
+
+    private:
+        ctx::bind<ThreadPool> bind_thread_pool;
+        ctx::bind<RuntimeContext> bind_runtime_context;
+        ctx::bind<Workbench> bind_work_bench;
+        DeviceContext *m_pre_device_context = nullptr;
+    };
+
+    int DataflowRunner::Run(Workbench &bench, const Program &program, int nargs) {
+        auto &dataflow = *program.dataflow();
+        auto &stack = bench.stack();
+        auto &runtime = bench.runtime();
+        auto &thread_pool = runtime.thread_pool();
+        auto &memory_device = bench.device().memory_device;
+
+        TS_AUTO_CHECK(stack.size() == size_t(nargs));
+
+        DataflowStatus status(dataflow, program);
+        for (int i = 0; i < nargs; ++i) {
+            status.arguments.emplace_back(stack[i]);
+        }
+        stack.clear();
+
+        // flow memory is not thread safe, lanes use locked dynamic memory
+        auto lane_memory = DynamicSyncMemoryController::Make(memory_device, true);
+        auto flow_memory = runtime.flow();
+        runtime.bind_flow(lane_memory);
+        ts::need restore_flow([&]() { runtime.bind_flow(flow_memory); });
+
+        auto lanes = std::min<int>(int(thread_pool.size()), dataflow.width());
+        thread_pool.parallel(0, lanes, 1, [&](int, int, int) {
+            BindDataflowLane _bind_lane(bench);
+            Stack lane_stack(memory_device, lane_memory);
+            int index;
+            while (status.next(index)) {
+                try {
+                    auto &node = dataflow.nodes[index];
+                    auto &inst = program.instruction(size_t(node.instruction));
+                    auto op_inst = dynamic_cast<OperatorInstruction *>(inst.get());
+                    TS_AUTO_CHECK(op_inst != nullptr);
+                    lane_stack.clear();
+                    for (auto &input : node.inputs) {
+                        lane_stack.push(status.value(input));
+                    }
+                    auto nresults = RunOperator(op_inst->op(), lane_stack, int(node.inputs.size()));
+                    if (nresults != 1) {
+                        TS_LOG_ERROR << "Operator " << op_inst->op()->name() << "<" << op_inst->op()->op()
+                                     << "> expected 1 output, got " << nresults << eject;
+                    }
+                    status.values[index] = lane_stack[0];
+                    lane_stack.clear();
+                } catch (...) {
+                    status.fail();
+                    break;
+                }
+                status.finish(index);
+            }
+        });
+
+        if (status.exception) std::rethrow_exception(status.exception);
+
+        for (auto &output : dataflow.outputs) {
+            stack.push(status.value(output));
+        }
+        return int(dataflow.outputs.size());
+    }
+}
@@ -0,0 +1,215 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "runtime/executor.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace ts {
+    struct AsyncRequest {
+        std::vector<Tensor> inputs;
+        AsyncRun::shared run;
+    };
+
+    /**
+     * in flight counter, shared with runs, so a run can give back its slot after executor released
+     */
+    struct AsyncSlots {
+        std::mutex mutex;
+        std::condition_variable cond;
+        int count = 0;
+    };
+
+    class Executor::Implement {
+    public:
+        Implement(const Workbench &bench, int capacity)
+                : m_capacity(std::max(1, capacity))
+                , m_slots(std::make_shared<AsyncSlots>()) {
+            if (bench.desktop() == nullptr) {
+                TS_LOG_ERROR << "Can not execute on workbench with no program setup" << eject;
+            }
+            // each stage works on own workbench, which runs own cloned operators, see Workbench::share
+            m_compute_bench = bench.share();
+
+            auto program = m_compute_bench->desktop();
+            bool filtered = false;
+            for (int i = 0; i < program->input_count(); ++i) {
+                if (program->input_filter(i) != nullptr) filtered = true;
+            }
+            m_filters.resize(size_t(program->input_count()));
+            // inputs are filtered in own stage, so run program without filter
+            if (filtered) {
+                m_filter_bench = bench.share();
+                auto filter_program = m_filter_bench->desktop();
+                for (int i = 0; i < filter_program->input_count(); ++i) {
+                    m_filters[i] = filter_program->input_filter(i);
+                }
+                m_compute_bench->setup(program->unfiltered());
+                m_filter_worker = std::thread(&Implement::filtering, this);
+            }
+            m_compute_worker = std::thread(&Implement::computing, this);
+        }
+
+        ~Implement() {
+            {
+                std::unique_lock<std::mutex> _lock(m_mutex);
+                m_filter_stopped = true;
+            }
+            m_cond.notify_all();
+            if (m_filter_worker.joinable()) m_filter_worker.join();
+            {
+                std::unique_lock<std::mutex> _lock(m_mutex);
+                m_compute_stopped = true;
+            }
+            m_cond.notify_all();
+            m_compute_worker.join();
+        }
+
+        AsyncRun::shared submit(const std::vector<Tensor> &inputs, const AsyncRun::Callback &callback) {
+            if (inputs.size() != m_filters.size()) {
+                TS_LOG_ERROR << "Executor need " << m_filters.size() << " inputs, got " << inputs.size() << eject;
+            }
+            std::unique_ptr<AsyncRequest> request(new AsyncRequest);
+            request->inputs = inputs;
+            request->run = std::make_shared<AsyncRun>(callback);
+
+            // wait for slot
+            auto slots = m_slots;
+            {
+                std::unique_lock<std::mutex> _lock(slots->mutex);
+                while (slots->count >= m_capacity) slots->cond.wait(_lock);
+                ++slots->count;
+            }
+            request->run->bind_release([slots]() {
+                {
+                    std::unique_lock<std::mutex> _lock(slots->mutex);
+                    --slots->count;
+                }
+                slots->cond.notify_one();
+            });
+
+            auto run = request->run;
+            {
+                std::unique_lock<std::mutex> _lock(m_mutex);
+                if (m_filter_stopped) {
+                    _lock.unlock();
+                    run->cancel();
+                    TS_LOG_ERROR << "Can not submit to stopped executor" << eject;
+                }
+                if (m_filter_bench) {
+                    m_filter_queue.emplace_back(std::move(request));
+                } else {
+                    m_compute_queue.emplace_back(std::move(request));
+                }
+            }
+            m_cond.notify_all();
+            return run;
+        }
+
+        int capacity() const { return m_capacity; }
+
+        int in_flight() const {
+            std::unique_lock<std::mutex> _lock(m_slots->mutex);
+            return m_slots->count;
+        }
+
+    private:
+        /**
+         * pop request from queue
+         * @return nullptr if stopped and no request left
+         */
+        std::unique_ptr<AsyncRequest> pop(std::deque<std::unique_ptr<AsyncRequest>> &queue, const bool &stopped) {
+            std::unique_lock<std::mutex> _lock(m_mutex);
+            while (!stopped && queue.empty()) m_cond.wait(_lock);
+            if (queue.empty()) return nullptr;
+            auto request = std::move(queue.front());
+            queue.pop_front();
+            return request;
+        }
+
+        void filtering() {
+            while (true) {
+                auto request = pop(m_filter_queue, m_filter_stopped);
+                if (request == nullptr) break;
+                if (!request->run->start()) continue;   // cancelled
+                try {
+                    for (size_t i = 0; i < m_filters.size(); ++i) {
+                        auto &input = request->inputs[i];
+                        if (m_filters[i] == nullptr) continue;
+                        input = m_filter_bench->launch_offline(
+                                m_filters[i], std::vector<Tensor>({ImageFilter::AdjustNHWC(input)}))[0];
+                    }
+                } catch (...) {
+                    request->run->fail(std::current_exception());
+                    continue;
+                }
+                {
+                    std::unique_lock<std::mutex> _lock(m_mutex);
+                    m_compute_queue.emplace_back(std::move(request));
+                }
+                m_cond.notify_all();
+            }
+        }
+
+        void computing() {
+            while (true) {
+                auto request = pop(m_compute_queue, m_compute_stopped);
+                if (request == nullptr) break;
+                // started in filtering stage if there is one
+                if (!m_filter_bench && !request->run->start()) continue;
+                try {
+                    for (size_t i = 0; i < request->inputs.size(); ++i) {
+                        m_compute_bench->input(int(i), request->inputs[i]);
+                    }
+                    request->inputs.clear();
+                    m_compute_bench->run();
+                    AsyncRun::Outputs outputs(size_t(m_compute_bench->output_count()));
+                    for (size_t i = 0; i < outputs.size(); ++i) {
+                        outputs[i] = m_compute_bench->output(int(i));
+                    }
+                    request->run->finish(std::move(outputs));
+                } catch (...) {
+                    request->run->fail(std::current_exception());
+                }
+            }
+        }
+
+        int m_capacity;
+        std::shared_ptr<AsyncSlots> m_slots;
+
+        Workbench::shared m_filter_bench;   ///< nullptr if no input filtered
+        Workbench::shared m_compute_bench;
+        std::vector<Program::shared> m_filters;     ///< owned by filter bench
+
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        std::deque<std::unique_ptr<AsyncRequest>> m_filter_queue;
+        std::deque<std::unique_ptr<AsyncRequest>> m_compute_queue;
+        bool m_filter_stopped = false;
+        bool m_compute_stopped = false;
+        std::thread m_filter_worker;
+        std::thread m_compute_worker;
+    };
+
+    Executor::Executor(const Workbench &bench, int capacity)
+            : m_impl(bench, capacity) {
+    }
+
+    Executor::~Executor() = default;
+
+    AsyncRun::shared Executor::submit(const std::vector<Tensor> &inputs, const AsyncRun::Callback &callback) {
+        return m_impl->submit(inputs, callback);
+    }
+
+    int Executor::capacity() const {
+        return m_impl->capacity();
+    }
+
+    int Executor::in_flight() const {
+        return m_impl->in_flight();
+    }
+}
@@ -200,6 +200,19 @@ namespace ts {
 
     }
 
+    Tensor ImageFilter::AdjustNHWC(const Tensor &image) {
+        if (image.dims() < 2 || image.dims() > 4) {
+            TS_LOG_ERROR << "Can not filter input with shape: " << to_string(image.sizes()) << eject;
+        }
+        if (image.dims() == 2) {
+            return image.reshape({1, image.size(0), image.size(1), 1});
+        }
+        if (image.dims() == 3) {
+            return image.reshape({1, image.size(0), image.size(1), image.size(2)});
+        }
+        return image;
+    }
+
     ImageFilter::shared ImageFilter::clone() const {
         ImageFilter::shared dolly(new ImageFilter(*this->m_impl));
         return dolly;
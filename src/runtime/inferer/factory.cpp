@@ -1097,7 +1097,7 @@ namespace ts {
                         stide[dim]);
             }
 
-            return {FLOAT32, y_shape};
+            return {node->has("requantize_scale") ? INT8 : FLOAT32, y_shape};
         }
 
         TS_STATIC_ACTION(ShapeInferer::Register, "conv2d_quantized", conv2d_quantized)
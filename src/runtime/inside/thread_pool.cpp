@@ -4,9 +4,26 @@
 
 #include "runtime/inside/thread_pool.h"
 #include "utils/ctxmgr_lite_support.h"
+#include "utils/box.h"
+
+#include <exception>
+#include <algorithm>
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TS_CPU_RELAX() _mm_pause()
+#else
+#define TS_CPU_RELAX() std::this_thread::yield()
+#endif
 
 namespace ts {
 
+    static inline int64_t now_microseconds() {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
     Thread::Thread()
             : is_running(true), task(nullptr), after_task(nullptr) {
         this->core = std::thread(&Thread::operating, this);
@@ -51,77 +68,375 @@ namespace ts {
         }
     }
 
-    ThreadPool::ThreadPool(size_t pool_size)
-            : thread_pool(pool_size) {
-        for (int i = 0; i < static_cast<int>(pool_size); ++i) {
-            thread_pool[i] = new Thread();
-            running_core.push_back(i);   // push all cartridge into chest
+    /**
+     * One parallel range, split into one part for each participant.
+     * Each part is packed [begin, end) in one 64-bit atomic, so taking and stealing are single CAS.
+     */
+    class ParallelJob {
+    public:
+        using self = ParallelJob;
+
+        ParallelJob(int begin, int end, int grain, int parts, const ThreadPool::range_task_type &task)
+                : m_parts(new Part[parts]), m_part_count(parts), m_grain(grain), m_task(task) {
+            auto bins = split_bins(begin, end, parts);
+            for (int i = 0; i < parts; ++i) {
+                if (i < int(bins.size())) {
+                    m_parts[i].range.store(pack(bins[i].first, bins[i].second));
+                } else {
+                    m_parts[i].range.store(pack(end, end));
+                }
+            }
+            // part 0 is reserved for the calling thread
+            m_next_part.store(1);
         }
-    }
 
-    ThreadPool::~ThreadPool() {
-        for (int i = 0; i < static_cast<int>(thread_pool.size()); ++i) {
-            delete thread_pool[i];
+        /**
+         * @return part index for new participant, -1 if there is no part left
+         */
+        int join() {
+            if (m_next_part.load(std::memory_order_relaxed) >= m_part_count) return -1;
+            auto part = m_next_part.fetch_add(1);
+            return part < m_part_count ? part : -1;
         }
-    }
 
-    Thread *ThreadPool::run(const Thread::task_type &task) {
-        if (thread_pool.size() == 0) {
-            task(0);
+        /**
+         * work on own part until no range left in all parts
+         * @param part own part index, also used as signet
+         */
+        void work(int part) {
+            int begin, end;
+            while (!m_failed.load(std::memory_order_relaxed)) {
+                if (!take(part, begin, end) && !steal(part, begin, end)) break;
+                try {
+                    m_task(part, begin, end);
+                } catch (...) {
+                    std::unique_lock<std::mutex> _lock(m_exception_mutex);
+                    if (!m_failed.load()) m_exception = std::current_exception();
+                    m_failed.store(true);
+                }
+            }
+        }
+
+        void rethrow() {
+            if (m_exception) std::rethrow_exception(m_exception);
+        }
+
+    private:
+        struct Part {
+            std::atomic<uint64_t> range;
+            char padding[64 - sizeof(std::atomic<uint64_t>)];
+        };
+
+        static uint64_t pack(int begin, int end) {
+            return (uint64_t(uint32_t(begin)) << 32) | uint64_t(uint32_t(end));
+        }
+
+        static void unpack(uint64_t range, int &begin, int &end) {
+            begin = int(uint32_t(range >> 32));
+            end = int(uint32_t(range & 0xFFFFFFFFU));
+        }
+
+        /**
+         * take one chunk from the front of part
+         */
+        bool take(int part, int &begin, int &end) {
+            auto &range = m_parts[part].range;
+            auto packed = range.load();
+            while (true) {
+                int first, second;
+                unpack(packed, first, second);
+                if (first >= second) return false;
+                auto next = std::min(second, first + m_grain);
+                if (range.compare_exchange_weak(packed, pack(next, second))) {
+                    begin = first;
+                    end = next;
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * steal back half of the biggest part, put it into own part, then take one chunk
+         */
+        bool steal(int part, int &begin, int &end) {
+            while (true) {
+                int victim = -1;
+                int victim_size = 0;
+                for (int i = 0; i < m_part_count; ++i) {
+                    if (i == part) continue;
+                    int first, second;
+                    unpack(m_parts[i].range.load(std::memory_order_relaxed), first, second);
+                    if (second - first > victim_size) {
+                        victim = i;
+                        victim_size = second - first;
+                    }
+                }
+                if (victim < 0) return false;
+
+                auto &range = m_parts[victim].range;
+                auto packed = range.load();
+                int first, second;
+                unpack(packed, first, second);
+                if (first >= second) continue;
+                auto middle = second - first > m_grain ? first + (second - first) / 2 : first;
+                if (!range.compare_exchange_strong(packed, pack(first, middle))) continue;
+
+                // only owner write empty part, thieves ignore it, so store directly
+                m_parts[part].range.store(pack(middle, second));
+                if (take(part, begin, end)) return true;
+            }
+        }
+
+        std::unique_ptr<Part[]> m_parts;
+        int m_part_count;
+        int m_grain;
+        std::atomic<int> m_next_part;
+        const ThreadPool::range_task_type &m_task;
+
+        std::atomic<bool> m_failed{false};
+        std::mutex m_exception_mutex;
+        std::exception_ptr m_exception;
+    };
+
+    class ThreadPool::Implement {
+    public:
+        using self = Implement;
+
+        static const int MAX_JOB_COUNT = 64;
+        static const int SPIN_COUNT = 1 << 14;
+
+        /**
+         * published job, users count the workers reading this slot,
+         * the job owner must wait users to be zero before job released.
+         */
+        struct JobSlot {
+            std::atomic<bool> taken{false};
+            std::atomic<ParallelJob *> job{nullptr};
+            std::atomic<int> users{0};
+        };
+
+        explicit Implement(size_t size) : m_size(size) {
+            for (size_t i = 0; i < size; ++i) {
+                m_workers.emplace_back(&Implement::operating, this, int(i));
+            }
+        }
+
+        ~Implement() {
+            {
+                std::unique_lock<std::mutex> _lock(m_sleep_mutex);
+                m_running.store(false);
+                m_epoch.fetch_add(1);
+            }
+            m_sleep_cond.notify_all();
+            for (auto &worker : m_workers) worker.join();
+        }
+
+        void notify() {
+            m_epoch.fetch_add(1);
+            if (m_sleepers.load() > 0) {
+                std::unique_lock<std::mutex> _lock(m_sleep_mutex);
+                m_sleep_cond.notify_all();
+            }
+        }
+
+        JobSlot *publish(ParallelJob *job) {
+            for (auto &slot : m_slots) {
+                bool expected = false;
+                if (!slot.taken.compare_exchange_strong(expected, true)) continue;
+                slot.job.store(job);
+                notify();
+                return &slot;
+            }
             return nullptr;
-        } else {
-            int signet = load();
-            Thread *cart = this->thread_pool[signet];
-            cart->run(signet, task,
-                      Thread::after_task_type(std::bind(&ThreadPool::recycling_thread, this, std::placeholders::_1)));
-            return cart;
         }
 
+        void withdraw(JobSlot *slot) {
+            slot->job.store(nullptr);
+            int spin = 0;
+            while (slot->users.load() != 0) {
+                if (++spin < SPIN_COUNT) TS_CPU_RELAX();
+                else std::this_thread::yield();
+            }
+            slot->taken.store(false);
+        }
+
+        void parallel(int begin, int end, int grain, const range_task_type &task, int limit) {
+            auto count = end - begin;
+            if (count <= 0) return;
+            auto parts = int(std::min<size_t>(m_size, size_t(count)));
+            if (limit > 0) parts = std::min(parts, limit);
+            if (grain <= 0) {
+                // more chunks than parts, so stealing can balance uneven work
+                grain = std::max(1, count / (parts * 4));
+            }
+            if (parts <= 1) {
+                task(0, begin, end);
+                return;
+            }
+
+            ParallelJob job(begin, end, grain, parts, task);
+            auto slot = publish(&job);
+            if (slot == nullptr) {
+                task(0, begin, end);
+                return;
+            }
+
+            auto start = now_microseconds();
+            job.work(0);
+            m_work_time.fetch_add(now_microseconds() - start, std::memory_order_relaxed);
+            withdraw(slot);
+            job.rethrow();
+        }
+
+        void queue(const Thread::task_type &task) {
+            if (m_size == 0) {
+                task(0);
+                return;
+            }
+            {
+                std::unique_lock<std::mutex> _lock(m_queue_mutex);
+                m_queue.push_back(task);
+                m_pending.fetch_add(1);
+            }
+            notify();
+        }
+
+        void join() {
+            std::unique_lock<std::mutex> _lock(m_queue_mutex);
+            while (m_pending.load() != 0) m_queue_cond.wait(_lock);
+        }
+
+        bool busy() {
+            if (m_pending.load() != 0) return true;
+            for (auto &slot : m_slots) {
+                if (slot.taken.load()) return true;
+            }
+            return false;
+        }
+
+        size_t size() const { return m_size; }
+
+        int64_t work_time() const { return m_work_time.load(std::memory_order_relaxed); }
+
+    private:
+        bool run_queued(int signet) {
+            if (m_pending.load(std::memory_order_relaxed) == 0) return false;
+            Thread::task_type task;
+            {
+                std::unique_lock<std::mutex> _lock(m_queue_mutex);
+                if (m_queue.empty()) return false;
+                task = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            auto start = now_microseconds();
+            task(signet);
+            m_work_time.fetch_add(now_microseconds() - start, std::memory_order_relaxed);
+            {
+                std::unique_lock<std::mutex> _lock(m_queue_mutex);
+                m_pending.fetch_sub(1);
+            }
+            m_queue_cond.notify_all();
+            return true;
+        }
+
+        bool run_parallel() {
+            bool worked = false;
+            for (auto &slot : m_slots) {
+                if (slot.job.load(std::memory_order_relaxed) == nullptr) continue;
+                slot.users.fetch_add(1);
+                auto job = slot.job.load();
+                if (job != nullptr) {
+                    auto part = job->join();
+                    if (part >= 0) {
+                        auto start = now_microseconds();
+                        job->work(part);
+                        m_work_time.fetch_add(now_microseconds() - start, std::memory_order_relaxed);
+                        worked = true;
+                    }
+                }
+                slot.users.fetch_sub(1);
+            }
+            return worked;
+        }
+
+        void operating(int signet) {
+            while (m_running.load()) {
+                auto epoch = m_epoch.load();
+
+                if (run_queued(signet)) continue;
+                if (run_parallel()) continue;
+
+                // spinning before sleep
+                int spin = 0;
+                while (spin < SPIN_COUNT && m_epoch.load(std::memory_order_relaxed) == epoch) {
+                    TS_CPU_RELAX();
+                    ++spin;
+                }
+                if (spin < SPIN_COUNT) continue;
+
+                std::unique_lock<std::mutex> _lock(m_sleep_mutex);
+                m_sleepers.fetch_add(1);
+                while (m_running.load() && m_epoch.load() == epoch) m_sleep_cond.wait(_lock);
+                m_sleepers.fetch_sub(1);
+            }
+        }
+
+        size_t m_size;
+        std::vector<std::thread> m_workers;
+
+        JobSlot m_slots[MAX_JOB_COUNT];
+
+        std::atomic<bool> m_running{true};
+        std::atomic<uint64_t> m_epoch{0};
+        std::atomic<int> m_sleepers{0};
+        std::mutex m_sleep_mutex;
+        std::condition_variable m_sleep_cond;
+
+        std::mutex m_queue_mutex;
+        std::condition_variable m_queue_cond;
+        std::deque<Thread::task_type> m_queue;
+        std::atomic<int> m_pending{0};
+
+        std::atomic<int64_t> m_work_time{0};
+    };
+
+    ThreadPool::ThreadPool(size_t pool_size)
+            : m_impl(pool_size) {
+    }
+
+    ThreadPool::~ThreadPool() = default;
+
+    Thread *ThreadPool::run(const Thread::task_type &task) {
+        m_impl->queue(task);
+        return nullptr;
     }
 
     Thread *ThreadPool::run(const Thread::task_type &task, const Thread::after_task_type &after_task) {
-        if (thread_pool.size() == 0) {
-            task(0);
-            return nullptr;
-        } else {
-            int signet = load();
-            Thread *cart = this->thread_pool[signet];
-            cart->run(signet, task, [this, after_task](int id) -> void {
-                after_task(id);
-                this->recycling_thread(id);
-            });
-            return cart;
-        }
+        m_impl->queue([task, after_task](int signet) {
+            task(signet);
+            if (after_task) after_task(signet);
+        });
+        return nullptr;
     }
 
-    int ThreadPool::load() {
-        std::unique_lock<std::mutex> locker(running_core_mutex);
-        while (this->running_core.empty()) running_core_cond.wait(locker);
-        int signet = this->running_core.front();
-        this->running_core.pop_front();
-        return signet;
+    void ThreadPool::parallel(int begin, int end, int grain, const range_task_type &task, int parts) {
+        m_impl->parallel(begin, end, grain, task, parts);
     }
 
     void ThreadPool::join() {
-        std::unique_lock<std::mutex> locker(running_core_mutex);
-        while (this->running_core.size() != this->thread_pool.size()) running_core_cond.wait(locker);
+        m_impl->join();
     }
 
     bool ThreadPool::busy() {
-        if (!running_core_mutex.try_lock()) return false;
-        bool is_busy = this->running_core.size() != this->thread_pool.size();
-        running_core_mutex.unlock();
-        return is_busy;
+        return m_impl->busy();
     }
 
     size_t ThreadPool::size() const {
-        return thread_pool.size();
+        return m_impl->size();
     }
 
-    void ThreadPool::recycling_thread(int signet) {
-        std::unique_lock<std::mutex> locker(running_core_mutex);
-        this->running_core.push_front(signet);
-        running_core_cond.notify_all();
+    int64_t ThreadPool::work_time() const {
+        return m_impl->work_time();
     }
 }
 
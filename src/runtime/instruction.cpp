@@ -14,6 +14,8 @@
 #include "module/bubble.h"
 
 #include "board/hook.h"
+#include "backend/name.h"
+#include "runtime/inside/thread_pool.h"
 
 namespace ts {
 
@@ -31,6 +33,99 @@ namespace ts {
         return profiler_serial_timer(oss.str());
     }
 
+    static int64_t tensor_bytes(const Tensor &tensor) {
+        if (tensor.packed()) {
+            int64_t bytes = 0;
+            for (size_t i = 0; i < tensor.fields_count(); ++i) bytes += tensor_bytes(tensor.field(i));
+            return bytes;
+        }
+        return int64_t(tensor.count()) * tensor.proto().type_bytes();
+    }
+
+    /**
+     * estimate floating point operations from running shapes, multiply-add counts 2
+     * @param op operator type
+     * @param inputs input tensors
+     * @param output first output
+     * @return flops, output elements for operators not listed
+     */
+    static double estimate_flops(const std::string &op, const std::vector<const Tensor *> &inputs,
+                                 const Tensor &output) {
+        auto weight_of = [&](size_t i) -> const Tensor * {
+            if (i >= inputs.size() || inputs[i]->dims() != 4 || inputs[i]->size(0) == 0) return nullptr;
+            return inputs[i];
+        };
+        auto conv_flops = [&](size_t i) -> double {
+            auto w = weight_of(i);
+            if (!w) return output.count();
+            return 2.0 * output.count() * (w->count() / w->size(0));
+        };
+        if (op == name::layer::conv2d() || op == name::layer::conv2d_winograd() ||
+            op == name::layer::conv2d_quantized()) {
+            return conv_flops(1);
+        }
+        if (op == name::layer::conv2d_v2() || op == name::layer::conv2d_winograd_v2()) {
+            return conv_flops(2);
+        }
+        if (op == name::layer::depthwise_conv2d() || op == name::layer::depthwise_conv2d_v2()) {
+            auto w = weight_of(op == name::layer::depthwise_conv2d() ? 1 : 2);
+            if (!w) return output.count();
+            return 2.0 * output.count() * w->size(2) * w->size(3);
+        }
+        if (op == name::layer::transpose_conv2d()) {
+            auto w = weight_of(1);
+            if (!w) return output.count();
+            return 2.0 * inputs[0]->count() * (w->count() / w->size(0));
+        }
+        if (op == name::layer::inner_prod() || op == name::layer::gemm()) {
+            if (inputs.empty() || output.dims() < 1 || output.size(0) == 0) return output.count();
+            // A is [M, K], output is [M, N]
+            auto K = inputs[0]->count() / output.size(0);
+            return 2.0 * output.count() * K;
+        }
+        return output.count();
+    }
+
+    /**
+     * record operator running event in bound profiler
+     * @param op running operator
+     * @param stack running stack, with base at arguments
+     * @param nargs number of arguments
+     * @param return_size read when event finished
+     * @return event finisher
+     */
+    static Later profiler_event(const Operator::shared &op, Stack &stack, int nargs, const int &return_size) {
+        auto profiler = ctx::ptr<Profiler>();
+        if (!profiler) return Later();
+        auto pool = ctx::ptr<ThreadPool>();
+        auto pool_work = pool ? pool->work_time() : 0;
+        profiler->begin_event(op->op(), op->name());
+        return Later([=, &stack, &return_size]() {
+            auto &event = profiler->end_event();
+            if (pool) {
+                event.pool_size = int32_t(pool->size());
+                event.pool_work = pool->work_time() - pool_work;
+            }
+            std::vector<const Tensor *> inputs;
+            int64_t bytes = 0;
+            for (int i = 0; i < nargs; ++i) {
+                inputs.push_back(&stack[i]);
+                bytes += tensor_bytes(stack[i]);
+            }
+            auto outputs_begin = int(stack.size()) - return_size;
+            if (return_size <= 0 || outputs_begin < 0) {
+                event.bytes = bytes;
+                return;
+            }
+            for (int i = outputs_begin; i < int(stack.size()); ++i) {
+                bytes += tensor_bytes(stack[i]);
+            }
+            event.bytes = bytes;
+            auto &output = stack[outputs_begin];
+            event.flops = estimate_flops(event.op, inputs, output.packed() ? output.field(0) : output);
+        });
+    }
+
     void OperatorInstruction::run(Workbench &workbench) {
         auto &stack = workbench.stack();
 
@@ -47,11 +142,17 @@ namespace ts {
         };
 #endif
 
+        // let operator allocate its output in caller provided buffer, bound to the slot right after arguments
+        auto output_buffer = m_nresults == 1 ? workbench.output_buffer(m_func.get()) : nullptr;
+        if (output_buffer) stack.preset(*output_buffer);
+        ts::need clear_preset([&]() { if (output_buffer) stack.preset(Tensor()); });
+
         // call function
         int return_size = 0;
         {
 #ifdef TS_USE_PROFILER
             auto _timer = profiler_run(this->m_func);
+            auto _event = profiler_event(this->m_func, stack, m_nargs, return_size);
 #endif
             return_size = m_func->run(stack);
         }
@@ -0,0 +1,86 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "runtime/packed_weights.h"
+#include "runtime/workbench.h"
+#include "utils/ctxmgr_lite.h"
+
+#include <sstream>
+
+namespace ts {
+    PackedWeights::PackedWeights(Stack::shared data_segment)
+            : m_data_segment(std::move(data_segment)) {
+    }
+
+    bool PackedWeights::constant(const Tensor &weight) {
+        if (weight.fields_count() != 1) return false;
+        auto data = weight.data();
+        if (data == nullptr) return false;
+
+        std::unique_lock<std::mutex> _lock(m_mutex);
+        if (!m_indexed) {
+            // data segment is filled when program linked, index it at the first running
+            auto size = int(m_data_segment->size());
+            for (int i = 0; i < size; ++i) {
+                auto &tensor = *m_data_segment->index(i);
+                for (size_t j = 0; j < tensor.fields_count(); ++j) {
+                    auto field = tensor.field(j);
+                    if (field.data() != nullptr) m_constants.insert(field.data());
+                }
+            }
+            m_indexed = true;
+        }
+        return m_constants.find(data) != m_constants.end();
+    }
+
+    static std::string layout_key(const Tensor &weight, const std::string &layout) {
+        std::ostringstream oss;
+        oss << layout << ":" << type_str(weight.dtype()) << to_string(weight.sizes());
+        return oss.str();
+    }
+
+    Tensor PackedWeights::get(const Tensor &weight, const std::string &layout, const Packer &packer) {
+        if (!constant(weight)) return packer(weight);
+
+        Key key(weight.data(), layout_key(weight, layout));
+        {
+            std::unique_lock<std::mutex> _lock(m_mutex);
+            auto it = m_packed.find(key);
+            if (it != m_packed.end()) return it->second;
+        }
+        // pack without lock, packer may run in thread pool
+        auto packed = packer(weight);
+        {
+            std::unique_lock<std::mutex> _lock(m_mutex);
+            auto it = m_packed.insert(std::make_pair(key, packed)).first;
+            return it->second;
+        }
+    }
+
+    size_t PackedWeights::count() const {
+        std::unique_lock<std::mutex> _lock(m_mutex);
+        return m_packed.size();
+    }
+
+    uint64_t PackedWeights::memory() const {
+        std::unique_lock<std::mutex> _lock(m_mutex);
+        uint64_t bytes = 0;
+        for (auto &pair : m_packed) {
+            auto &packed = pair.second;
+            for (size_t i = 0; i < packed.fields_count(); ++i) {
+                auto field = packed.field(i);
+                bytes += uint64_t(field.count()) * uint64_t(field.proto().type_bytes());
+            }
+        }
+        return bytes;
+    }
+
+    Tensor PackedWeights::Get(const Tensor &weight, const std::string &layout, const Packer &packer) {
+        auto bench = ctx::get<Workbench>();
+        if (bench == nullptr) return packer(weight);
+        auto &program = bench->desktop();
+        if (program == nullptr) return packer(weight);
+        return program->packed_weights()->get(weight, layout, packer);
+    }
+}
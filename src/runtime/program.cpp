@@ -11,6 +11,8 @@
 #include "core/device_context.h"
 #include "global/memory_device.h"
 
+#include <unordered_set>
+
 namespace ts {
     static std::string fuzzy_name(const Program::map<std::string, int> &map_name_slot, const std::string &name) {
         if (map_name_slot.empty()) return "";
@@ -51,25 +53,109 @@ namespace ts {
         }
     }
 
+    static void check_workbench_context() {
+        auto bench = ctx::of<Workbench>::get();
+        if (bench == nullptr) {
+            TS_LOG_ERROR << "Context<Workbench> need, but not bind." << eject;
+        }
+    }
+
+    /**
+     * copy optimized graph into new module, outputs named as module outputs, so it can be saved
+     * @return nullptr if outputs can not be named
+     */
+    static Module::shared optimized_module(const std::vector<Node> &module_inputs,
+                                           const std::vector<Node> &module_outputs,
+                                           const std::vector<Node> &outputs) {
+        Graph g;
+        ctx::bind<Graph> _bind_graph(g);
+        std::unordered_map<Node, Node> cloned_nodes;
+        auto schedule = Module::list_reference_nodes(outputs);
+        for (auto &item : schedule) {
+            auto &node = item.first;
+            auto dolly = g.make(node.bubble());
+            std::vector<Node> dolly_inputs;
+            for (auto &input : node.inputs()) dolly_inputs.emplace_back(cloned_nodes.at(input));
+            Node::Link(dolly, dolly_inputs);
+            cloned_nodes.insert(std::make_pair(node, dolly));
+        }
+        std::vector<Node> inputs;
+        for (auto &input : module_inputs) {
+            auto it = cloned_nodes.find(input);
+            if (it == cloned_nodes.end()) {
+                // not used input, still keep the slot
+                it = cloned_nodes.insert(std::make_pair(input, g.make(input.bubble()))).first;
+            }
+            inputs.emplace_back(it->second);
+        }
+        std::unordered_set<Node> named;
+        for (auto &input : inputs) named.insert(input);
+        std::vector<Node> named_outputs;
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            auto output = cloned_nodes.at(outputs[i]);
+            auto &origin = module_outputs[i].bubble();
+            auto &bubble = output.bubble();
+            if (bubble.name() != origin.name() || bubble.has(Bubble::RetentionParam::dtype) != origin.has(Bubble::RetentionParam::dtype)) {
+                if (named.find(output) != named.end()) return nullptr;
+                bubble.name(origin.name());
+                if (origin.has(Bubble::RetentionParam::dtype)) {
+                    bubble.set(Bubble::RetentionParam::dtype, origin.get(Bubble::RetentionParam::dtype));
+                }
+            }
+            named.insert(output);
+            named_outputs.emplace_back(output);
+        }
+        auto module = std::make_shared<Module>();
+        module->load(g, named_outputs);
+        module->sort_inputs(inputs);
+        return module;
+    }
+
     Program::shared Program::Compile(const Module::shared &module, const ComputingDevice &device, const std::string &options) {
-        Program::shared program(new Program(device));
+        Module::shared *no_optimized = nullptr;
+        return Compile(module, device, options, no_optimized);
+    }
+
+    Program::shared Program::Compile(const Module::shared &module, const ComputingDevice &device, const std::string &options,
+                                     Module::shared &optimized) {
+        return Compile(module, device, options, &optimized);
+    }
+
+    Program::shared Program::Compile(const Module::shared &module, const ComputingDevice &device, const std::string &options,
+                                     Module::shared *optimized) {
+        check_workbench_context();
+
         // translate module
         auto translated_module = Module::Translate(module, device, options);
         // TODO: support RNN
         Compiler compiler(device);
         auto module_inputs = translated_module->inputs();
         auto module_outputs = translated_module->outputs();
-        InstructionBlock block;
 
-        // check workbench context
-        {
-            auto bench = ctx::of<Workbench>::get();
-            if (bench == nullptr) {
-                TS_LOG_ERROR << "Context<Workbench> need, but not bind." << eject;
-            }
-        }
+        Graph temp_graph;
+        ctx::bind<Graph> _bind_graph(temp_graph);
 
-        block = compiler.compile(module_inputs, module_outputs, options);
+        auto outputs = compiler.optimize(module_outputs, options);
+        if (optimized != nullptr) *optimized = optimized_module(module_inputs, module_outputs, outputs);
+
+        auto block = compiler.generate(module_inputs, outputs);
+
+        return Link(block, module_inputs, module_outputs, device, options);
+    }
+
+    Program::shared Program::Link(const Module::shared &optimized, const ComputingDevice &device, const std::string &options) {
+        check_workbench_context();
+
+        Compiler compiler(device);
+        auto block = compiler.generate(optimized->inputs(), optimized->outputs());
+
+        return Link(block, optimized->inputs(), optimized->outputs(), device, options);
+    }
+
+    Program::shared Program::Link(InstructionBlock &block,
+                                  const std::vector<Node> &module_inputs, const std::vector<Node> &module_outputs,
+                                  const ComputingDevice &device, const std::string &options) {
+        Program::shared program(new Program(device));
 
         // link data sagment
         // TODO: link multi-data-sagment
@@ -82,12 +168,59 @@ namespace ts {
 
         ArgParser parser;
         parser.add({"--filter", "-flt"}, {"--no-filter", "-no-flt"}, false);
+        parser.add({"--memory-plan", "-mp"}, {"--no-memory-plan", "-no-mp"}, true);
+        parser.add({"--dataflow", "-df"}, {"--no-dataflow", "-no-df"}, false);
+        parser.add({"--register", "-reg"}, {"--no-register", "-no-reg"}, true);
         parser.parse(options);
         auto do_filter = parser.get("--filter");
+        program->m_memory_plan = parser.get("--memory-plan");
+
+        // dataflow lanes allocate concurrently, out of the planned order, so --dataflow turns memory plan off,
+        // only --memory-plan given explicitly is rejected
+        if (parser.get("--dataflow")) {
+            ArgParser explicit_parser;
+            explicit_parser.add({"--memory-plan", "-mp"}, {}, false);
+            explicit_parser.parse(options);
+            if (explicit_parser.get("--memory-plan")) {
+                TS_LOG_ERROR << "Can not compile with both --dataflow and --memory-plan" << eject;
+            }
+            program->m_memory_plan = false;
+        }
 
+        // link register code's data sagment
+        if (parser.get("--register") && block.dataflow != nullptr) {
+            program->m_register_code = RegisterCode::Allocate(*block.dataflow, block.nargs);
+            for (auto &step : program->m_register_code->steps) {
+                for (auto &input : step.inputs) {
+                    if (input.kind == RegisterCode::Operand::DATA) input.index += data_sagment_base;
+                }
+            }
+            for (auto &output : program->m_register_code->outputs) {
+                if (output.kind == RegisterCode::Operand::DATA) output.index += data_sagment_base;
+            }
+        }
+
+        // link dataflow's data sagment
+        if (parser.get("--dataflow") && block.dataflow != nullptr) {
+            program->m_dataflow = block.dataflow;
+            for (auto &node : program->m_dataflow->nodes) {
+                for (auto &input : node.inputs) {
+                    if (input.kind == Dataflow::Value::DATA) input.index += data_sagment_base;
+                }
+            }
+            for (auto &output : program->m_dataflow->outputs) {
+                if (output.kind == Dataflow::Value::DATA) output.index += data_sagment_base;
+            }
+        }
+
+        auto data_memory_device = ComputingMemory::Query(program->m_device);
         for (auto &data : block.data_segment) {
             Tensor *value = nullptr;
-            if (data.device.empty()) {
+            MemoryDevice value_device = data.device.empty() ? data_memory_device : MemoryDevice(data.device);
+            if (!do_filter && data.tensor.fields_count() == 1 && data.tensor.device() == value_device) {
+                // already on running device, like weights mapped from module file, so share it
+                value = program->m_data_segment->push(data.tensor);
+            } else if (data.device.empty()) {
                 value = program->m_data_segment->clone_push(data.tensor);
             } else {
                 value = program->m_data_segment->clone_push(data.tensor, data.device);
@@ -148,7 +281,10 @@ namespace ts {
         // dolly->m_outputs.resize(this->m_outputs.size());
         dolly->m_map_input_slots = this->m_map_input_slots;
         dolly->m_map_output_slots = this->m_map_output_slots;
+        dolly->m_input_names = this->m_input_names;
+        dolly->m_output_names = this->m_output_names;
         dolly->m_data_segment = this->m_data_segment;
+        dolly->m_packed_weights = this->m_packed_weights;
         dolly->m_input_filters.resize(this->m_input_filters.size(), nullptr);
 
         for (size_t i = 0; i < this->m_input_filters.size(); ++i) {
@@ -170,6 +306,16 @@ namespace ts {
         dolly->m_input_dtypes = m_input_dtypes;
         dolly->m_output_dtypes = m_output_dtypes;
 
+        dolly->m_memory_plan = m_memory_plan;
+        dolly->m_dataflow = m_dataflow;
+        dolly->m_register_code = m_register_code;
+
+        return std::move(dolly);
+    }
+
+    Program::shared Program::unfiltered() const {
+        Program::shared dolly(new Program(*this));
+        dolly->m_input_filters.assign(this->m_input_filters.size(), nullptr);
         return std::move(dolly);
     }
 
@@ -182,6 +328,7 @@ namespace ts {
         auto memory_device = ComputingMemory::Query(m_device);
 
         this->m_data_segment = std::make_shared<Stack>(memory_device, DynamicSyncMemoryController::Make(memory_device, true));
+        this->m_packed_weights = std::make_shared<PackedWeights>(this->m_data_segment);
     }
 
     Tensor Program::data_segment(int index) const {
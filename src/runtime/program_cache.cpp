@@ -0,0 +1,186 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "runtime/program_cache.h"
+
+#include "module/io/stream.h"
+#include "utils/box.h"
+#include "utils/platform.h"
+#include "compiler/option/translator_option.h"
+#include "compiler/option/zipper_option.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <random>
+#include <typeinfo>
+#include <algorithm>
+
+#if TS_PLATFORM_OS_WINDOWS
+
+#include <direct.h>
+#include <io.h>
+
+#define ACCESS ::_access
+#define MKDIR(a) ::_mkdir((a))
+
+#elif TS_PLATFORM_OS_LINUX || TS_PLATFORM_OS_MAC || TS_PLATFORM_OS_IOS
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define ACCESS ::access
+#define MKDIR(a) ::mkdir((a),0755)
+
+#endif
+
+namespace ts {
+    /**
+     * update when compiled graph changed, like new zipper or packing.
+     * registered translator and zipper options are also hashed into key, see RegisteredOptions.
+     * 2: int8 zipper, conv2d fusion and NCHWc translating
+     */
+    static const char *const CACHE_VERSION = "2";
+
+    static const std::string FileSeparator() {
+#if TS_PLATFORM_OS_WINDOWS
+        return "\\";
+#else
+        return "/";
+#endif
+    }
+
+    static bool mkdir_core(const std::string &dir) {
+        int miss = ACCESS(dir.c_str(), 0);
+        if (miss) {
+            int failed = MKDIR(dir.c_str());
+            if (failed) {
+                return ACCESS(dir.c_str(), 0) == 0;   // may created by other process
+            }
+        }
+        return true;
+    }
+
+    static bool mkdir(const std::string &dir) {
+        auto path = Split(dir, "\\/");
+        for (size_t i = 1; i <= path.size(); ++i) {
+            if (path[i - 1].empty()) continue;
+            auto local_path = Join(std::vector<std::string>(path.begin(), path.begin() + i), FileSeparator());
+            if (!dir.empty() && (dir[0] == '/' || dir[0] == '\\')) local_path = FileSeparator() + local_path;
+            if (!mkdir_core(local_path)) return false;
+        }
+        return true;
+    }
+
+    /**
+     * FNV-1a 64, hashing serialized bytes without buffering them
+     */
+    class HashStreamWriter : public StreamWriter {
+    public:
+        size_t write(const void *buffer, size_t size) final {
+            auto bytes = reinterpret_cast<const uint8_t *>(buffer);
+            for (size_t i = 0; i < size; ++i) {
+                m_hash ^= bytes[i];
+                m_hash *= 0x100000001b3ULL;
+            }
+            return size;
+        }
+
+        size_t write(const std::string &str) {
+            auto size = uint32_t(str.size());
+            write(&size, sizeof(size));
+            return write(str.data(), str.size());
+        }
+
+        std::string hex() const {
+            std::ostringstream oss;
+            oss << std::hex << std::setw(16) << std::setfill('0') << m_hash;
+            return oss.str();
+        }
+
+    private:
+        uint64_t m_hash = 0xcbf29ce484222325ULL;
+    };
+
+    /**
+     * @return sorted names of registered translator and zipper options, so cache compiled with other passes is not hit
+     */
+    static std::vector<std::string> RegisteredOptions() {
+        std::vector<std::string> names;
+        for (auto option : GetFullTranslateOptions()) names.emplace_back(typeid(*option).name());
+        for (auto option : GetFullTranslateV2Options()) names.emplace_back(typeid(*option).name());
+        for (auto option : GetFullOptions()) names.emplace_back(typeid(*option).name());
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    ProgramCache::ProgramCache(const std::string &root)
+            : m_root(root) {
+        if (!mkdir(root)) {
+            TS_LOG_ERROR << "Can not access program cache: " << root << eject;
+        }
+    }
+
+    std::string ProgramCache::Hash(const Module::shared &module) {
+        HashStreamWriter hash;
+        Module::Save(hash, module);
+        return hash.hex();
+    }
+
+    std::string ProgramCache::Key(const std::string &model, const ComputingDevice &device, const std::string &options) {
+        HashStreamWriter hash;
+        hash.write(model);
+        hash.write(device.type().std());
+        auto id = int32_t(device.id());
+        hash.write(&id, sizeof(id));
+        hash.write(options);
+        hash.write(CACHE_VERSION);
+        static const auto registered = RegisteredOptions();
+        for (auto &name : registered) hash.write(name);
+        return hash.hex();
+    }
+
+    Program::shared ProgramCache::compile(const Module::shared &module, const ComputingDevice &device,
+                                          const std::string &options) {
+        return compile(Hash(module), module, device, options);
+    }
+
+    Program::shared ProgramCache::compile(const std::string &model, const Module::shared &module,
+                                          const ComputingDevice &device, const std::string &options) {
+        auto filename = m_root + FileSeparator() + Key(model, device, options) + ".tsm";
+
+        if (ACCESS(filename.c_str(), 0) == 0) {
+            try {
+                auto optimized = Module::Load(filename, Module::BINARY_V2);
+                return Program::Link(optimized, device, options);
+            } catch (const Exception &) {
+                TS_LOG_INFO << "Program cache broken, recompiling: " << filename;
+            }
+        }
+
+        Module::shared optimized;
+        auto program = Program::Compile(module, device, options, optimized);
+        if (optimized == nullptr) return program;
+
+        // write to temporary file then rename, so no reader sees part of it
+        std::ostringstream temp;
+        temp << filename << "." << std::hex << std::random_device()() << ".tmp";
+        auto temp_filename = temp.str();
+        try {
+            Module::Save(temp_filename, optimized, Module::BINARY_V2);
+        } catch (const Exception &) {
+            std::remove(temp_filename.c_str());
+            TS_LOG_INFO << "Can not write program cache: " << filename;
+            return program;
+        }
+#if TS_PLATFORM_OS_WINDOWS
+        std::remove(filename.c_str());
+#endif
+        if (std::rename(temp_filename.c_str(), filename.c_str()) != 0) {
+            std::remove(temp_filename.c_str());
+        }
+
+        return program;
+    }
+}
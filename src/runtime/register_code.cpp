@@ -0,0 +1,167 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "runtime/register_code.h"
+
+#include "runtime/workbench.h"
+#include "runtime/program.h"
+#include "runtime/instruction.h"
+#include "utils/assert.h"
+
+#include <sstream>
+#include <algorithm>
+
+namespace ts {
+    RegisterCode::shared RegisterCode::Allocate(const Dataflow &dataflow, int nargs) {
+        auto code = std::make_shared<RegisterCode>();
+        auto &nodes = dataflow.nodes;
+        auto steps = int(nodes.size());
+
+        // values are arguments in [0, nargs), and node outputs after them
+        auto value_of = [&](const Dataflow::Value &value) -> int {
+            return value.kind == Dataflow::Value::NODE ? nargs + value.index : value.index;
+        };
+        std::vector<int> last_read(size_t(nargs + steps), -1);
+        for (int i = 0; i < nargs; ++i) last_read[i] = 0;
+        for (int i = 0; i < steps; ++i) {
+            last_read[nargs + i] = i;
+            for (auto &input : nodes[i].inputs) {
+                if (input.kind == Dataflow::Value::DATA) continue;
+                last_read[value_of(input)] = i;
+            }
+        }
+        for (auto &output : dataflow.outputs) {
+            if (output.kind == Dataflow::Value::DATA) continue;
+            last_read[value_of(output)] = steps;  // never released
+        }
+
+        std::vector<int> slot_of(last_read.size(), -1);
+        std::vector<int> free_slots;
+        int slots = nargs;
+        for (int i = 0; i < nargs; ++i) slot_of[i] = i;
+
+        code->steps.resize(size_t(steps));
+        for (int i = 0; i < steps; ++i) {
+            auto &node = nodes[i];
+            auto &step = code->steps[i];
+            step.instruction = node.instruction;
+            for (auto &input : node.inputs) {
+                if (input.kind == Dataflow::Value::DATA) {
+                    step.inputs.emplace_back(Operand::DATA, input.index);
+                } else {
+                    step.inputs.emplace_back(Operand::SLOT, slot_of[value_of(input)]);
+                }
+            }
+            // release values last read here, so output can reuse their slots
+            auto release = [&](int value) {
+                if (last_read[value] != i || slot_of[value] < 0) return;
+                if (std::find(step.release.begin(), step.release.end(), slot_of[value]) != step.release.end()) return;
+                step.release.push_back(slot_of[value]);
+                free_slots.push_back(slot_of[value]);
+            };
+            for (auto &input : node.inputs) {
+                if (input.kind == Dataflow::Value::DATA) continue;
+                release(value_of(input));
+            }
+            if (i == 0) {
+                // arguments never read
+                for (int j = 0; j < nargs; ++j) release(j);
+            }
+            int output;
+            if (free_slots.empty()) {
+                output = slots++;
+            } else {
+                output = free_slots.back();
+                free_slots.pop_back();
+            }
+            slot_of[nargs + i] = output;
+            step.output = output;
+            // output never read, its slot is free for next step
+            if (last_read[nargs + i] == i) {
+                step.discard = true;
+                free_slots.push_back(output);
+            }
+        }
+
+        for (auto &output : dataflow.outputs) {
+            if (output.kind == Dataflow::Value::DATA) {
+                code->outputs.emplace_back(Operand::DATA, output.index);
+            } else {
+                code->outputs.emplace_back(Operand::SLOT, slot_of[value_of(output)]);
+            }
+        }
+        code->slots = slots;
+
+        return code;
+    }
+
+    static std::ostream &operator<<(std::ostream &out, const RegisterCode::Operand &operand) {
+        return out << (operand.kind == RegisterCode::Operand::DATA ? "@" : "%") << operand.index;
+    }
+
+    std::string RegisterCode::str() const {
+        std::ostringstream oss;
+        for (auto &step : steps) {
+            oss << "%" << step.output << " = $" << step.instruction << "(";
+            for (size_t i = 0; i < step.inputs.size(); ++i) {
+                if (i) oss << ", ";
+                oss << step.inputs[i];
+            }
+            oss << ")";
+            if (!step.release.empty()) {
+                oss << " release";
+                for (auto slot : step.release) oss << " %" << slot;
+            }
+            if (step.discard) oss << " discard";
+            oss << std::endl;
+        }
+        oss << "return";
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            oss << (i ? ", " : " ") << outputs[i];
+        }
+        return oss.str();
+    }
+
+    bool RegisterRunner::Ready(Workbench &bench, const Program &program) {
+        (void)(bench);
+        return program.register_code() != nullptr;
+    }
+
+    int RegisterRunner::Run(Workbench &bench, const Program &program, int nargs) {
+        auto &code = *program.register_code();
+        auto &stack = bench.stack();
+
+        TS_AUTO_CHECK(stack.size() == size_t(nargs));
+
+        std::vector<Tensor> slots(size_t(code.slots));
+        for (int i = 0; i < nargs; ++i) {
+            slots[i] = stack[i];
+        }
+        stack.clear();
+
+        auto value = [&](const RegisterCode::Operand &operand) -> Tensor {
+            return operand.kind == RegisterCode::Operand::DATA
+                   ? program.data_segment(operand.index)
+                   : slots[operand.index];
+        };
+
+        for (auto &step : code.steps) {
+            for (auto &input : step.inputs) {
+                stack.push(value(input));
+            }
+            for (auto slot : step.release) {
+                slots[slot] = Tensor();
+            }
+            // OperatorInstruction leaves only its output on stack
+            program.instruction(size_t(step.instruction))->run(bench);
+            if (!step.discard) slots[step.output] = stack[0];
+            stack.clear();
+        }
+
+        for (auto &output : code.outputs) {
+            stack.push(value(output));
+        }
+        return int(code.outputs.size());
+    }
+}
@@ -9,6 +9,8 @@
 #include "utils/ctxmgr_lite_support.h"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include <memory/flow.h>
 
 #ifdef TS_USE_CBLAS
@@ -39,6 +41,11 @@ namespace ts {
         this->m_dynamic = DynamicSyncMemoryController::Make(device, false);
     }
 
+    RuntimeContext::RuntimeContext(ThreadPool::shared thread_pool, int computing_thread_number)
+            : m_computing_thread_number(computing_thread_number)
+            , m_thread_pool(std::move(thread_pool)) {
+    }
+
     void RuntimeContext::set_computing_thread_number(int computing_thread_number) {
         int fixed_thread_number;
         if (computing_thread_number < 0) {
@@ -56,7 +63,12 @@ namespace ts {
         }
         this->m_computing_thread_number = fixed_thread_number;
 
-        this->m_thread_pool = std::make_shared<ThreadPool>(fixed_thread_number);
+        this->m_shared_thread_pool = UsingSharedThreadPool();
+        if (this->m_shared_thread_pool) {
+            this->m_thread_pool = SharedThreadPool();
+        } else {
+            this->m_thread_pool = std::make_shared<ThreadPool>(fixed_thread_number);
+        }
 #ifdef TS_USE_CBLAS
 #ifdef TS_USING_OPENBLAS
         goto_set_num_threads(fixed_thread_number);
@@ -72,8 +84,13 @@ namespace ts {
     RuntimeContext::self RuntimeContext::clone() const {
         self doly;
         doly.m_computing_thread_number = this->m_computing_thread_number;
+        doly.m_shared_thread_pool = this->m_shared_thread_pool;
         if (m_thread_pool) {
-            doly.m_thread_pool = std::make_shared<ThreadPool>(this->m_thread_pool->size());
+            if (using_shared_thread_pool()) {
+                doly.m_thread_pool = m_thread_pool;
+            } else {
+                doly.m_thread_pool = std::make_shared<ThreadPool>(this->m_thread_pool->size());
+            }
         }
         if (this->m_dynamic) {
             doly.m_dynamic = this->m_dynamic->clone();
@@ -84,6 +101,12 @@ namespace ts {
         return std::move(doly);
     }
 
+    RuntimeContext::self RuntimeContext::share() const {
+        self doly(m_thread_pool, m_computing_thread_number);
+        doly.m_shared_thread_pool = m_shared_thread_pool;
+        return std::move(doly);
+    }
+
     RuntimeContext::RuntimeContext(RuntimeContext::self &&other) {
         this->operator=(std::move(other));
     }
@@ -91,6 +114,7 @@ namespace ts {
     RuntimeContext::self &RuntimeContext::operator=(RuntimeContext::self &&other) {
         std::swap(this->m_computing_thread_number, other.m_computing_thread_number);
         std::swap(this->m_thread_pool, other.m_thread_pool);
+        std::swap(this->m_shared_thread_pool, other.m_shared_thread_pool);
         std::swap(this->m_dynamic, other.m_dynamic);
         std::swap(this->m_flow, other.m_flow);
         return *this;
@@ -100,6 +124,29 @@ namespace ts {
         return *this->m_thread_pool;
     }
 
+    static std::atomic<bool> &use_shared_thread_pool() {
+        static std::atomic<bool> use(false);
+        return use;
+    }
+
+    bool RuntimeContext::using_shared_thread_pool() const {
+        return m_shared_thread_pool;
+    }
+
+    void RuntimeContext::UseSharedThreadPool(bool use) {
+        use_shared_thread_pool().store(use);
+    }
+
+    bool RuntimeContext::UsingSharedThreadPool() {
+        return use_shared_thread_pool().load();
+    }
+
+    ThreadPool::shared RuntimeContext::SharedThreadPool() {
+        static ThreadPool::shared pool = std::make_shared<ThreadPool>(
+                std::max<size_t>(std::thread::hardware_concurrency(), 1));
+        return pool;
+    }
+
     void RuntimeContext::bind_flow(SyncMemoryController::shared flow) {
         m_flow = std::move(flow);
     }
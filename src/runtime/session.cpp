@@ -0,0 +1,104 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "runtime/session.h"
+
+#include <mutex>
+#include <vector>
+
+namespace ts {
+    class Session::Implement {
+    public:
+        explicit Implement(Workbench::shared bench)
+                : prototype(std::move(bench)) {}
+
+        Workbench::shared take() {
+            {
+                std::unique_lock<std::mutex> _lock(mutex);
+                if (!idle.empty()) {
+                    auto bench = std::move(idle.back());
+                    idle.pop_back();
+                    return bench;
+                }
+            }
+            return prototype->share();
+        }
+
+        void give(Workbench::shared bench) {
+            // drop request data, so idle workbench only holds its own memory
+            for (int i = 0; i < bench->input_count(); ++i) {
+                bench->input(i, Tensor());
+            }
+            std::unique_lock<std::mutex> _lock(mutex);
+            idle.emplace_back(std::move(bench));
+        }
+
+        Workbench::shared prototype;
+        std::vector<Workbench::shared> idle;
+        mutable std::mutex mutex;
+    };
+
+    Session::Session(Workbench::shared bench) {
+        if (bench == nullptr) {
+            TS_LOG_ERROR << "Can not create session with null workbench" << eject;
+        }
+        m_impl = std::make_shared<Implement>(std::move(bench));
+    }
+
+    Session::~Session() = default;
+
+    Session::shared Session::Load(const Module::shared &module, const ComputingDevice &device) {
+        return std::make_shared<Session>(Workbench::Load(module, device));
+    }
+
+    Session::shared Session::Load(const Module::shared &module, const ComputingDevice &device,
+                                  const std::string &options) {
+        return std::make_shared<Session>(Workbench::Load(module, device, options));
+    }
+
+    Workbench::shared Session::acquire() {
+        auto bench = m_impl->take();
+        auto raw = bench.get();
+        std::weak_ptr<Implement> session = m_impl;
+        // give workbench back once the returned one released, or destroy it if session is gone
+        return Workbench::shared(raw, [bench, session](Workbench *) mutable {
+            auto impl = session.lock();
+            if (impl) impl->give(std::move(bench));
+            bench.reset();
+        });
+    }
+
+    void Session::reserve(size_t count) {
+        std::vector<Workbench::shared> prepared;
+        {
+            std::unique_lock<std::mutex> _lock(m_impl->mutex);
+            if (m_impl->idle.size() >= count) return;
+            count -= m_impl->idle.size();
+        }
+        for (size_t i = 0; i < count; ++i) {
+            prepared.emplace_back(m_impl->prototype->share());
+        }
+        std::unique_lock<std::mutex> _lock(m_impl->mutex);
+        for (auto &bench : prepared) {
+            m_impl->idle.emplace_back(std::move(bench));
+        }
+    }
+
+    void Session::clear() {
+        std::vector<Workbench::shared> dropped;
+        {
+            std::unique_lock<std::mutex> _lock(m_impl->mutex);
+            dropped.swap(m_impl->idle);
+        }
+    }
+
+    size_t Session::idle() const {
+        std::unique_lock<std::mutex> _lock(m_impl->mutex);
+        return m_impl->idle.size();
+    }
+
+    Workbench::shared Session::prototype() const {
+        return m_impl->prototype;
+    }
+}
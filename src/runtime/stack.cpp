@@ -26,6 +26,32 @@ namespace ts {
         return Tensor(m_controller, dtype, shape, device);
     }
 
+    Tensor *Stack::push(DTYPE dtype, const Shape &shape) {
+        Tensor preset;
+        if (take_preset(dtype, shape, m_device, preset)) return this->push(preset);
+        return this->push(this->make(dtype, shape));
+    }
+
+    Tensor *Stack::push(DTYPE dtype, const Shape &shape, const MemoryDevice &device) {
+        Tensor preset;
+        if (take_preset(dtype, shape, device, preset)) return this->push(preset);
+        return this->push(this->make(dtype, shape, device));
+    }
+
+    void Stack::preset(const Tensor &tensor) {
+        m_preset = tensor;
+        m_preset_slot = m_stack.size();
+    }
+
+    bool Stack::take_preset(DTYPE dtype, const Shape &shape, const Device &device, Tensor &tensor) {
+        if (m_preset.empty() || m_stack.size() != m_preset_slot) return false;
+        if (m_preset.dtype() != dtype || m_preset.count() != Tensor::Prototype::count(shape) ||
+            m_preset.device() != device) return false;
+        tensor = m_preset.reshape(shape);
+        m_preset = Tensor();
+        return true;
+    }
+
     Tensor Stack::make(const TensorPrototype &proto) {
         Tensor packed;
         auto count = proto.fields_count();
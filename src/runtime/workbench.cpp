@@ -10,10 +10,12 @@
 #include "runtime/workbench.h"
 #include "global/memory_device.h"
 #include "compiler/compiler.h"
+#include "runtime/program_cache.h"
 #include "utils/box.h"
 
 #include "memory/flow.h"
 #include "global/hard_converter.h"
+#include "kernels/cpu/memory_cpu.h"
 
 #include <climits>
 #include <board/hook.h>
@@ -24,6 +26,9 @@
 #include "backend/name.h"
 #include "backend/base/base_cast_v2.h"
 #include "runtime/operator.h"
+#include "runtime/dataflow.h"
+#include "runtime/register_code.h"
+#include "runtime/executor.h"
 
 #include "utils/ctxmgr_lite_support.h"
 #include "utils/cpu_info.h"
@@ -103,15 +108,21 @@ namespace ts {
         return true;
     }
 
-    Workbench::Workbench(const ComputingDevice &device) {
+    Workbench::Workbench(const ComputingDevice &device)
+            : self(device, RuntimeContext()) {
+    }
+
+    Workbench::Workbench(const ComputingDevice &device, RuntimeContext &&runtime)
+            : m_runtime_context(std::move(runtime)) {
         //check_cpu_features();
 
         this->m_device_context.initialize(device);
         auto &memory_device = this->m_device_context.memory_device;
 
         this->m_static_memory = DynamicSyncMemoryController::Make(memory_device, true);
-        // TODO: Make real flow memory controller
-        this->m_flow_memory = HypeSyncMemoryController<FlowMemoryController>::Make(memory_device, false);
+        auto flow_memory = HypeSyncMemoryController<PlannedMemoryController>::Make(memory_device, false);
+        this->m_flow_planner = flow_memory->controller(memory_device);
+        this->m_flow_memory = flow_memory;
         this->m_dynamic_memory = DynamicSyncMemoryController::Make(memory_device, false);
         this->m_stack = std::make_shared<Stack>(memory_device, this->m_flow_memory);
         // bind flow and dynamic memory, so you can use it to alloc memory in any where
@@ -135,6 +146,7 @@ namespace ts {
     }
 
     Workbench::~Workbench() {
+        this->m_executor.reset();
         this->m_desktop.reset();
         this->m_stack->clear();
         this->m_inputs.clear();
@@ -150,6 +162,39 @@ namespace ts {
         return std::unique_ptr<ctx::bind<Profiler>>(new ctx::bind<Profiler>(profiler));
     }
 
+    /**
+     * @return output in buffer memory, copy output into buffer if operator not written it directly
+     */
+    static Tensor fill_output_buffer(const Tensor &buffer, const Tensor &output) {
+        if (output.fields_count() != 1 || output.dtype() != buffer.dtype() || output.count() != buffer.count()) {
+            TS_LOG_ERROR << "Can not write output " << output.proto()
+                         << " into bound buffer " << buffer.proto() << eject;
+        }
+        auto filled = buffer;
+        if (output.data() != buffer.data()) {
+            auto bytes = size_t(output.count()) * output.proto().type_bytes();
+            memcpy(filled.data(), filled.device(), bytes, output.data(), output.device(), bytes);
+        }
+        return filled.reshape(output.sizes());
+    }
+
+    /**
+     * @return key of inputs' dtype and shape, runs with same key share one memory plan
+     */
+    static std::string plan_signature(const std::vector<Tensor> &inputs) {
+        std::ostringstream oss;
+        for (auto &input : inputs) {
+            for (int i = 0; i < input.fields_count(); ++i) {
+                auto field = input.field(i);
+                oss << int(field.dtype());
+                for (auto size : field.sizes()) oss << ',' << size;
+                oss << ';';
+            }
+            oss << '|';
+        }
+        return oss.str();
+    }
+
     void Workbench::run() {
         if (m_desktop == nullptr) {
             TS_LOG_ERROR << "Can not run workbench with no program setup" << eject;
@@ -157,11 +202,58 @@ namespace ts {
 
         this->m_hooked_tensor.clear();
 
-        auto outputs = launch_offline(m_desktop, m_inputs);
+        /**
+         * release last outputs, so the planned memory of last run can be reused
+         */
+        for (auto &output : m_outputs) {
+            output = Tensor();
+        }
+
+        std::vector<Tensor> outputs;
+        if (m_desktop->memory_plan()) {
+            m_flow_planner->begin(plan_signature(m_inputs));
+            ts::need end_plan(&PlannedMemoryController::end, m_flow_planner.get());
+            outputs = launch_offline(m_desktop, m_inputs);
+        } else {
+            outputs = launch_offline(m_desktop, m_inputs);
+        }
+
+        for (size_t i = 0; i < m_output_buffers.size() && i < outputs.size(); ++i) {
+            auto &buffer = m_output_buffers[i];
+            if (buffer.empty()) continue;
+            outputs[i] = fill_output_buffer(buffer, outputs[i]);
+        }
 
         m_outputs = outputs;
     }
 
+    void Workbench::set_plan_capacity(int capacity) {
+        m_flow_planner->set_capacity(size_t(std::max(1, capacity)));
+    }
+
+    int Workbench::plan_capacity() const {
+        return int(m_flow_planner->capacity());
+    }
+
+    AsyncRun::shared Workbench::run_async(const std::vector<Tensor> &inputs, const AsyncRun::Callback &callback) {
+        if (m_desktop == nullptr) {
+            TS_LOG_ERROR << "Can not run workbench with no program setup" << eject;
+        }
+        if (m_executor == nullptr) {
+            m_executor = std::make_shared<Executor>(*this, m_async_capacity);
+        }
+        return m_executor->submit(inputs, callback);
+    }
+
+    AsyncRun::shared Workbench::run_async() {
+        return run_async(m_inputs);
+    }
+
+    void Workbench::set_async_capacity(int capacity) {
+        m_executor.reset();
+        m_async_capacity = std::max(1, capacity);
+    }
+
     Workbench::shared Workbench::clone() const {
         Workbench::shared dolly(new Workbench(
                 this->m_device_context.computing_device));
@@ -170,10 +262,28 @@ namespace ts {
 
         dolly->m_inputs.resize(this->m_inputs.size());
         dolly->m_outputs.resize(this->m_outputs.size());
+        dolly->m_output_buffers.resize(this->m_outputs.size());
         dolly->m_runtime_context = this->m_runtime_context.clone();
         if (this->m_desktop) {
             dolly->m_desktop = this->m_desktop->clone();
         }
+        dolly->set_plan_capacity(this->plan_capacity());
+
+        return std::move(dolly);
+    }
+
+    Workbench::shared Workbench::share() const {
+        if (m_desktop == nullptr) {
+            TS_LOG_ERROR << "Can not share workbench with no program setup" << eject;
+        }
+        Workbench::shared dolly(new Workbench(
+                this->m_device_context.computing_device, this->m_runtime_context.share()));
+
+        // operators keep running state in members, so each workbench runs its own instances,
+        // the cloned program still shares data segment and packed weights
+        BindWorkbenchRuntime _bind_runtime(*dolly);
+        dolly->setup(this->m_desktop->clone());
+        dolly->set_plan_capacity(this->plan_capacity());
 
         return std::move(dolly);
     }
@@ -206,6 +316,44 @@ namespace ts {
         return m_outputs[slot];
     }
 
+    void Workbench::bind_output(int slot, const Tensor &buffer) {
+        if (slot < 0 || size_t(slot) >= m_output_buffers.size()) {
+            TS_LOG_ERROR << "Output index out of range. with index=" << slot << eject;
+        }
+        if (buffer.fields_count() != 1) {
+            TS_LOG_ERROR << "Can not bind packed tensor as output buffer" << eject;
+        }
+        m_output_buffers[slot] = buffer;
+
+        // find operators producing bound outputs, by output names
+        m_output_buffer_slots.clear();
+        if (m_desktop == nullptr) return;
+        auto &names = m_desktop->output_names();
+        for (auto &inst : m_desktop->instruction()) {
+            auto op_inst = dynamic_cast<OperatorInstruction *>(inst.get());
+            if (op_inst == nullptr) continue;
+            auto op = op_inst->op();
+            for (size_t i = 0; i < names.size() && i < m_output_buffers.size(); ++i) {
+                if (m_output_buffers[i].empty() || names[i] != op->name()) continue;
+                m_output_buffer_slots[op.get()] = int(i);
+            }
+        }
+    }
+
+    void Workbench::bind_output(const std::string &name, const Tensor &buffer) {
+        if (m_desktop == nullptr) {
+            TS_LOG_ERROR << "Can not run workbench with no program setup" << eject;
+        }
+        this->bind_output(m_desktop->output_slot(name), buffer);
+    }
+
+    const Tensor *Workbench::output_buffer(const Operator *op) const {
+        if (m_output_buffer_slots.empty()) return nullptr;
+        auto it = m_output_buffer_slots.find(op);
+        if (it == m_output_buffer_slots.end()) return nullptr;
+        return &m_output_buffers[it->second];
+    }
+
     int Workbench::input_count() const {
         return int(m_inputs.size());
     }
@@ -235,6 +383,8 @@ namespace ts {
         if (slot < 0 || slot >= m_desktop->input_count()) {
             TS_LOG_ERROR << "Input index out of range. with index=" << slot << eject;
         }
+        // executor stages are built on filters
+        m_executor.reset();
         BindWorkbenchRuntime _bind_runtime(*this);
         filter->compile();
         m_desktop->bind_filter(slot, filter->program());
@@ -268,7 +418,7 @@ namespace ts {
     }
 
     void Workbench::push_data_segment(int data_index) {
-        // TODO: deal with data_sagment, in case of thread sharing, waitting testing
+        // data segment is read only, tensors can be pushed by workbenches sharing program in different threads
         this->m_stack->push(this->m_env.top().program->data_segment(data_index));
     }
 
@@ -395,19 +545,6 @@ namespace ts {
         return online_run(online_create(bubble, strict), input);
     }
 
-    static Tensor adjust_nhwc(const Tensor &tensor) {
-        if (tensor.dims() < 2 || tensor.dims() > 4) {
-            TS_LOG_ERROR << "Can not filter input with shape: " << to_string(tensor.sizes()) << eject;
-        }
-        if (tensor.dims() == 2) {
-            return tensor.reshape({1, tensor.size(0), tensor.size(1), 1});
-        }
-        if (tensor.dims() == 3) {
-            return tensor.reshape({1, tensor.size(0), tensor.size(1), tensor.size(2)});
-        }
-        return tensor;
-    }
-
     int Workbench::launch_online(Program::shared program, int nargs) {
         if (program == nullptr) {
             TS_LOG_ERROR << "Can not launch null program." << eject;
@@ -459,7 +596,7 @@ namespace ts {
             auto filter = this->m_env.top().program->input_filter(i);
             if (filter != nullptr) {
                 // ajust to nhwc image format
-                this->m_stack->push(adjust_nhwc(arg));
+                this->m_stack->push(ImageFilter::AdjustNHWC(arg));
                 this->m_stack->erase(-2);   // delete arg before
                 launch_online(filter, 1);
             }
@@ -472,6 +609,20 @@ namespace ts {
          */
         this->m_stack->erase(0, nargs);
 
+        /**
+         * Run independent branches concurrently
+         */
+        if (DataflowRunner::Ready(*this, *program)) {
+            DataflowRunner::Run(*this, *program, nargs);
+            this->m_env.top().pointer = this->m_env.top().length;
+        } else if (RegisterRunner::Ready(*this, *program)) {
+            /**
+             * Run operators on fixed slots, without stack instructions
+             */
+            RegisterRunner::Run(*this, *program, nargs);
+            this->m_env.top().pointer = this->m_env.top().length;
+        }
+
         /**
          * Start run program
          */
@@ -497,13 +648,18 @@ namespace ts {
     }
 
     void Workbench::setup(Program::shared program) {
+        this->m_executor.reset();
         this->m_desktop = program;
+        this->m_flow_planner->reset();
+        this->m_output_buffers.clear();
+        this->m_output_buffer_slots.clear();
         if (program == nullptr) {
             this->m_inputs.clear();
             this->m_outputs.clear();
         } else {
             this->m_inputs.resize(program->input_count());
             this->m_outputs.resize(program->output_count());
+            this->m_output_buffers.resize(program->output_count());
         }
         this->m_hooked_tensor.clear();
     }
@@ -575,6 +731,11 @@ namespace ts {
         return Program::Compile(module, this->device().computing_device, options);
     }
 
+    Program::shared Workbench::compile(const Module::shared &module, const std::string &options, ProgramCache &cache) {
+        BindWorkbenchRuntime _bind_runtime(*this);
+        return cache.compile(module, this->device().computing_device, options);
+    }
+
     Workbench::shared
     Workbench::Load(const Module::shared &module, const ComputingDevice &device, const std::string &options) {
         auto bench = std::make_shared<Workbench>(device);
@@ -629,7 +790,9 @@ namespace ts {
 
     const std::string &Workbench::summary() {
         uint64_t shared_memory = 0;
+        uint64_t packed_memory = 0;
         if (m_desktop) {
+            packed_memory = m_desktop->packed_weights()->memory();
             auto &stack = m_desktop->data_segment();
             auto size = stack.size();
             for (size_t i = 0; i < size; ++i) {
@@ -642,8 +805,14 @@ namespace ts {
         oss << "{\"device\": \"" << m_device_context.computing_device << "\""
             << ", \"thread\": " << m_runtime_context.get_computing_thread_number()
             << ", \"shared\": \"" << memory_size_string(shared_memory) << "\""
+            << ", \"packed\": \"" << memory_size_string(packed_memory) << "\""
             << ", \"memory\": " << m_flow_memory->summary()
-            << "}";
+            << ", \"plan\": \"" << memory_size_string(m_flow_planner->arena()) << "\""
+            << ", \"plans\": " << m_flow_planner->plans();
+        if (m_device_context.memory_device.type() == CPU) {
+            oss << ", \"allocator\": " << CpuAllocator::Summary();
+        }
+        oss << "}";
         m_summary = oss.str();
         return m_summary;
     }
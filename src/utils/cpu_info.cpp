@@ -80,7 +80,12 @@ namespace ts {
                   have_sse3_(0),
                   have_sse4_1_(0),
                   have_sse4_2_(0),
-                  have_ssse3_(0) {}
+                  have_ssse3_(0),
+                  have_avx512f_(0),
+                  have_avx512dq_(0),
+                  have_avx512bw_(0),
+                  have_avx512vl_(0),
+                  have_aes_(0) {}
 
         static void Initialize() {
             // Initialize cpuid struct
@@ -107,14 +112,17 @@ namespace ts {
             cpuid->have_sse4_2_ = (ecx >> 20) & 0x1;
             cpuid->have_sse_ = (edx >> 25) & 0x1;
             cpuid->have_ssse3_ = (ecx >> 9) & 0x1;
+            cpuid->have_aes_ = (ecx >> 25) & 0x1;
 
             const uint64_t xcr0_xmm_mask = 0x2;
             const uint64_t xcr0_ymm_mask = 0x4;
-            // const uint64_t xcr0_maskreg_mask = 0x20;
-            // const uint64_t xcr0_zmm0_15_mask = 0x40;
-            // const uint64_t xcr0_zmm16_31_mask = 0x80;
+            const uint64_t xcr0_maskreg_mask = 0x20;
+            const uint64_t xcr0_zmm0_15_mask = 0x40;
+            const uint64_t xcr0_zmm16_31_mask = 0x80;
 
             const uint64_t xcr0_avx_mask = xcr0_xmm_mask | xcr0_ymm_mask;
+            const uint64_t xcr0_avx512_mask = xcr0_avx_mask | xcr0_maskreg_mask |
+                                              xcr0_zmm0_15_mask | xcr0_zmm16_31_mask;
             const bool have_avx =
                     // Does the OS support XGETBV instruction use by applications?
                     ((ecx >> 27) & 0x1) &&
@@ -135,6 +143,14 @@ namespace ts {
 
             cpuid->have_avx2_ = have_avx && ((ebx >> 5) & 0x1);
 
+            // The OS must also save/restore opmask and ZMM state for AVX-512.
+            const bool have_avx512 = have_avx &&
+                                     ((GetXCR0EAX() & xcr0_avx512_mask) == xcr0_avx512_mask);
+            cpuid->have_avx512f_ = have_avx512 && ((ebx >> 16) & 0x1);
+            cpuid->have_avx512dq_ = have_avx512 && ((ebx >> 17) & 0x1);
+            cpuid->have_avx512bw_ = have_avx512 && ((ebx >> 30) & 0x1);
+            cpuid->have_avx512vl_ = have_avx512 && ((ebx >> 31) & 0x1);
+
         }
 
         static bool check_feature(CPUFeature feature) {
@@ -159,6 +175,16 @@ namespace ts {
                     return cpuid->have_sse_;
                 case SSSE3:
                     return cpuid->have_ssse3_;
+                case AVX512F:
+                    return cpuid->have_avx512f_;
+                case AVX512DQ:
+                    return cpuid->have_avx512dq_;
+                case AVX512BW:
+                    return cpuid->have_avx512bw_;
+                case AVX512VL:
+                    return cpuid->have_avx512vl_;
+                case AES:
+                    return cpuid->have_aes_;
                 default:
                     break;
             }
@@ -176,6 +202,11 @@ namespace ts {
         int have_sse4_1_ : 1;
         int have_sse4_2_ : 1;
         int have_ssse3_ : 1;
+        int have_avx512f_ : 1;
+        int have_avx512dq_ : 1;
+        int have_avx512bw_ : 1;
+        int have_avx512vl_ : 1;
+        int have_aes_ : 1;
         std::string vendor_str_;
     };
 
@@ -0,0 +1,177 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/workbench.h>
+#include <runtime/executor.h>
+#include <utils/except.h>
+#include <global/setup.h>
+#include <api/tennis.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * c = a + b
+ */
+static ts::Module::shared add_module() {
+    return ts::test::build_module([]() {
+        auto a = ts::bubble::param("a");
+        auto b = ts::bubble::param("b");
+        ts::bubble::op("c", ts::name::layer::add(), {a, b});
+    }, {"c"}, {"a", "b"});
+}
+
+static std::vector<ts::Tensor> make_inputs(float a) {
+    return {ts::tensor::build(ts::FLOAT32, {a, a + 1, a + 2}), ts::tensor::build(ts::FLOAT32, {1.0f, 2.0f, 3.0f})};
+}
+
+static bool check_outputs(const ts::AsyncRun::Outputs &outputs, float a) {
+    if (outputs.size() != 1 || outputs[0].count() != 3) return false;
+    auto c = outputs[0].data<float>();
+    return c[0] == a + 1 && c[1] == a + 3 && c[2] == a + 5;
+}
+
+/**
+ * all runs of workbench give right outputs, and callback called once each
+ */
+static bool check_run_async(ts::Workbench &bench) {
+    const int runs_count = 50;
+    std::atomic<int> calls(0);
+    std::vector<ts::AsyncRun::shared> runs;
+    for (int k = 0; k < runs_count; ++k) {
+        runs.push_back(bench.run_async(make_inputs(float(k)), [&](ts::AsyncRun &run) {
+            if (run.status() == ts::AsyncRun::DONE) ++calls;
+        }));
+    }
+    bool ok = true;
+    for (int k = 0; k < runs_count; ++k) {
+        ok = check_outputs(runs[k]->get(), float(k)) && ok;
+    }
+    // callback is called after outputs ready
+    for (int t = 0; t < 1000 && calls != runs_count; ++t) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ok = ok && calls == runs_count;
+    std::cout << "run_async " << (ok ? "OK" : "FAILED") << ", callbacks " << calls << std::endl;
+    return ok;
+}
+
+/**
+ * block the executor in callback of first run, so later runs stay queued
+ */
+static bool check_cancel_and_capacity(ts::Workbench &bench) {
+    ts::Executor executor(bench, 2);
+
+    std::promise<void> entered, gate;
+    auto gate_future = gate.get_future().share();
+    auto first = executor.submit(make_inputs(0), [&](ts::AsyncRun &) {
+        entered.set_value();
+        gate_future.wait();
+    });
+    entered.get_future().wait();
+
+    std::atomic<int> cancelled_calls(0);
+    auto queued = executor.submit(make_inputs(1));
+    auto cancelled = executor.submit(make_inputs(2), [&](ts::AsyncRun &run) {
+        if (run.status() == ts::AsyncRun::CANCELLED) ++cancelled_calls;
+    });
+    bool ok = executor.in_flight() == 2;
+
+    // capacity is full, next submit blocks until one leaves executor
+    std::atomic<bool> submitted(false);
+    ts::AsyncRun::shared last;
+    std::thread submitter([&]() {
+        last = executor.submit(make_inputs(3));
+        submitted = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    bool blocked = !submitted;
+
+    bool cancel = cancelled->cancel();
+    submitter.join();
+    gate.set_value();
+
+    bool threw = false;
+    try {
+        cancelled->get();
+    } catch (const ts::Exception &) {
+        threw = true;
+    }
+
+    ok = ok && blocked && cancel && threw && cancelled->status() == ts::AsyncRun::CANCELLED && cancelled_calls == 1;
+    ok = ok && !first->cancel() && check_outputs(first->get(), 0);
+    ok = ok && check_outputs(queued->get(), 1) && check_outputs(last->get(), 3);
+    std::cout << "capacity " << (blocked ? "blocked" : "NOT blocked") << ", queued run "
+              << (cancel && threw ? "cancelled" : "NOT cancelled") << ", " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+static std::atomic<int> c_calls(0);
+
+static void c_callback(ts_AsyncRun *run, void *userdata) {
+    *static_cast<ts_AsyncRun_Status *>(userdata) = ts_AsyncRun_status(run);
+    ++c_calls;
+}
+
+/**
+ * C api run async with callback and userdata
+ */
+static bool check_c_api(const ts::Module::shared &module) {
+    const char *filename = "async_run.tsm";
+    ts::Module::Save(filename, module);
+
+    auto c_module = ts_Module_Load(filename, TS_BINARY);
+    std::remove(filename);
+    ts_Device device = {"cpu", 0};
+    auto c_bench = ts_Workbench_Load(c_module, &device);
+
+    float a[] = {3, 4, 5};
+    float b[] = {1, 2, 3};
+    int32_t shape[] = {3};
+    auto c_a = ts_new_Tensor(shape, 1, TS_FLOAT32, a);
+    auto c_b = ts_new_Tensor(shape, 1, TS_FLOAT32, b);
+    const ts_Tensor *inputs[] = {c_a, c_b};
+
+    ts_AsyncRun_Status status = TS_ASYNC_QUEUED;
+    auto run = ts_Workbench_run_async(c_bench, inputs, 2, c_callback, &status);
+    bool ok = run != nullptr && ts_AsyncRun_wait(run) && ts_AsyncRun_output_count(run) == 1;
+
+    auto c_c = ts_new_Tensor(nullptr, 0, TS_FLOAT32, nullptr);
+    ok = ok && ts_AsyncRun_output(run, 0, c_c);
+    if (ok) {
+        auto c = static_cast<float *>(ts_Tensor_data(c_c));
+        ok = c[0] == 4 && c[1] == 6 && c[2] == 8;
+    }
+    for (int t = 0; t < 1000 && c_calls == 0; ++t) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ok = ok && c_calls == 1 && status == TS_ASYNC_DONE;
+
+    ts_free_Tensor(c_c);
+    if (run) ts_free_AsyncRun(run);
+    ts_free_Tensor(c_a);
+    ts_free_Tensor(c_b);
+    ts_free_Workbench(c_bench);
+    ts_free_Module(c_module);
+
+    std::cout << "C api callback " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+int main() {
+    ts::setup();
+
+    auto module = add_module();
+    auto bench = ts::Workbench::Load(module, ts::ComputingDevice(ts::CPU, 0));
+
+    bool ok = check_run_async(*bench);
+    ok = check_cancel_and_capacity(*bench) && ok;
+    ok = check_c_api(module) && ok;
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/batcher.h>
+#include <global/setup.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+/**
+ * y = conv2d(x, w) + b, x in [N, 3, 8, 8], b in [N, 4, 8, 8]
+ * with_shape adds output shape(y), which has no batch axis
+ */
+static ts::Module::shared conv_add_module(bool with_shape) {
+    std::vector<std::string> outputs = {"y"};
+    if (with_shape) outputs.emplace_back("y_shape");
+    return ts::test::build_module([&]() {
+        auto x = ts::bubble::param("x");
+        auto b = ts::bubble::param("b");
+        auto conv = ts::test::conv2d_fixture("conv", x, 4, 3);
+        auto y = ts::bubble::op("y", ts::name::layer::add(), {conv, b});
+        if (with_shape) ts::bubble::op("y_shape", ts::name::layer::shape(), {y});
+    }, outputs, {"x", "b"});
+}
+
+static std::vector<ts::Tensor> make_inputs(int batch, int seed) {
+    ts::Tensor x(ts::FLOAT32, {batch, 3, 8, 8});
+    ts::Tensor b(ts::FLOAT32, {batch, 4, 8, 8});
+    for (int i = 0; i < x.count(); ++i) x.data<float>()[i] = std::cos(i * 0.11f + seed);
+    for (int i = 0; i < b.count(); ++i) b.data<float>()[i] = std::sin(i * 0.07f + seed);
+    return {x, b};
+}
+
+static bool same(const ts::Tensor &lhs, const ts::Tensor &rhs) {
+    if (lhs.sizes() != rhs.sizes()) return false;
+    for (int i = 0; i < lhs.count(); ++i) {
+        if (std::fabs(lhs.data<float>()[i] - rhs.data<float>()[i]) > 1e-4f) return false;
+    }
+    return true;
+}
+
+static bool failed(std::future<ts::Batcher::Outputs> &future) {
+    try {
+        future.get();
+    } catch (const ts::Exception &) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    ts::setup();
+    ts::ComputingDevice device(ts::CPU, 0);
+
+    int errors = 0;
+
+    // batched outputs are same as running each request alone
+    {
+        auto module = conv_add_module(false);
+        auto bench = ts::Workbench::Load(module, device);
+
+        const int requests = 12;
+        std::vector<std::vector<ts::Tensor>> inputs;
+        std::vector<ts::Tensor> expected;
+        for (int i = 0; i < requests; ++i) {
+            inputs.push_back(make_inputs(1 + i % 3, i));
+            bench->input(0, inputs.back()[0]);
+            bench->input(1, inputs.back()[1]);
+            bench->run();
+            expected.push_back(bench->output(0).clone());
+        }
+
+        ts::Batcher batcher(bench, 8, 100000);
+        std::vector<std::future<ts::Batcher::Outputs>> futures;
+        for (auto &input : inputs) futures.emplace_back(batcher.submit(input));
+        for (int i = 0; i < requests; ++i) {
+            auto outputs = futures[i].get();
+            if (outputs.size() != 1 || !same(outputs[0], expected[i])) {
+                std::cout << "request " << i << " got wrong output" << std::endl;
+                ++errors;
+            }
+        }
+
+        // inputs must have same samples, the other requests in queue are not affected
+        auto mismatch = make_inputs(2, 0);
+        mismatch[1] = make_inputs(3, 0)[1];
+        auto bad = batcher.submit(mismatch);
+        auto good = batcher.submit(inputs[0]);
+        if (!failed(bad)) {
+            std::cout << "mismatch batch of inputs not rejected" << std::endl;
+            ++errors;
+        }
+        if (!same(good.get()[0], expected[0])) {
+            std::cout << "request after rejected one got wrong output" << std::endl;
+            ++errors;
+        }
+    }
+
+    // outputs without batch axis must be flagged, not guessed
+    {
+        auto module = conv_add_module(true);
+        auto bench = ts::Workbench::Load(module, device);
+
+        {
+            ts::Batcher batcher(bench, 8, 0);
+            auto future = batcher.submit(make_inputs(2, 0));
+            if (!failed(future)) {
+                std::cout << "output without batch axis not rejected" << std::endl;
+                ++errors;
+            }
+        }
+        {
+            ts::Batcher batcher(bench, 8, 100000, {true, false});
+            auto lhs = batcher.submit(make_inputs(1, 1));
+            auto rhs = batcher.submit(make_inputs(3, 2));
+            auto lhs_outputs = lhs.get();
+            auto rhs_outputs = rhs.get();
+            if (lhs_outputs[0].size(0) != 1 || rhs_outputs[0].size(0) != 3 ||
+                lhs_outputs[1].dims() != 1 || rhs_outputs[1].dims() != 1) {
+                std::cout << "flagged output is sliced" << std::endl;
+                ++errors;
+            }
+        }
+    }
+
+    std::cout << "errors=" << errors << std::endl;
+    return errors == 0 ? 0 : 1;
+}
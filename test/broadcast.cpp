@@ -0,0 +1,102 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <kernels/cpu/element_wise_broadcast.h>
+#include <runtime/workbench.h>
+#include <global/setup.h>
+
+#include <iostream>
+#include <vector>
+
+struct SubFunctor {
+    static const bool vectorized = true;
+
+    float operator()(float lhs, float rhs) const { return lhs - rhs; }
+
+    ts::float32x4 operator()(const ts::float32x4 &lhs, const ts::float32x4 &rhs) const { return lhs - rhs; }
+};
+
+/**
+ * index input by coordinate of out, front appended ones and size 1 axis are broadcast
+ */
+static int input_index(const ts::Shape &shape, const ts::Shape &out, int index) {
+    std::vector<int> coordinate(out.size());
+    for (int i = int(out.size()) - 1; i >= 0; --i) {
+        coordinate[i] = index % out[i];
+        index /= out[i];
+    }
+    auto offset = out.size() - shape.size();
+    int result = 0;
+    for (size_t i = 0; i < shape.size(); ++i) {
+        result = result * shape[i] + (shape[i] == 1 ? 0 : coordinate[i + offset]);
+    }
+    return result;
+}
+
+static bool check(const ts::Shape &lhs_shape, const ts::Shape &rhs_shape, const ts::Shape &out_shape,
+                  const std::vector<int> &expected_plan) {
+    auto lhs = ts::test::sin_tensor(lhs_shape, 0.13f);
+    auto rhs = ts::test::sin_tensor(rhs_shape, 0.29f);
+    ts::Tensor out(ts::FLOAT32, out_shape);
+
+    ts::cpu::BroadcastPlan plan(lhs_shape, rhs_shape, out_shape);
+    bool ok = plan.shape() == expected_plan && plan.count() == out.count();
+
+    ts::cpu::broadcast<float>(lhs, rhs, out, SubFunctor());
+    for (int i = 0; ok && i < out.count(); ++i) {
+        auto expected = lhs.data<float>()[input_index(lhs_shape, out_shape, i)] -
+                        rhs.data<float>()[input_index(rhs_shape, out_shape, i)];
+        ok = out.data<float>()[i] == expected;
+    }
+
+    std::cout << ts::to_string(lhs_shape) << " - " << ts::to_string(rhs_shape)
+              << " -> plan " << ts::to_string(plan.shape()) << ": " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+/**
+ * add operator with empty broadcast output
+ */
+static bool check_empty_add() {
+    auto module = ts::test::build_module([]() {
+        ts::bubble::op("z", ts::name::layer::add(), {ts::bubble::param("x"), ts::bubble::param("y")});
+    }, {"z"}, {"x", "y"});
+
+    auto bench = ts::Workbench::Load(module, ts::ComputingDevice(ts::CPU, 0));
+    bench->input(0, ts::test::sin_tensor({2, 1}, 0.1f));
+    bench->input(1, ts::test::sin_tensor({1, 0}, 0.1f));
+    bench->run();
+    bool ok = bench->output(0).sizes() == ts::Shape({2, 0});
+    std::cout << "add [2, 1] + [1, 0]: " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+int main() {
+    ts::setup();
+
+    bool ok = true;
+    // empty
+    ok = check({2, 1}, {1, 0}, {2, 0}, {2, 0}) && ok;
+    ok = check({0, 3}, {3}, {0, 3}, {0, 3}) && ok;
+    // scalar
+    ok = check(ts::Shape(), ts::Shape(), ts::Shape(), {1}) && ok;
+    ok = check({3, 5}, {1}, {3, 5}, {15}) && ok;
+    ok = check({1}, {4, 1, 7}, {4, 1, 7}, {28}) && ok;
+    // same shape
+    ok = check({2, 3, 4}, {2, 3, 4}, {2, 3, 4}, {24}) && ok;
+    // bias
+    ok = check({2, 6, 5, 5}, {1, 6, 1, 1}, {2, 6, 5, 5}, {2, 6, 25}) && ok;
+    ok = check({4, 9}, {9}, {4, 9}, {4, 9}) && ok;
+    // general
+    ok = check({3, 1, 5}, {1, 4, 1}, {3, 4, 5}, {3, 4, 5}) && ok;
+    ok = check({2, 1, 3, 4}, {5, 1, 1}, {2, 5, 3, 4}, {2, 5, 12}) && ok;
+    ok = check({7, 1}, {1, 9000}, {7, 9000}, {7, 9000}) && ok;
+
+    ok = check_empty_add() && ok;
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
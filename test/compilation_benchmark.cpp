@@ -0,0 +1,103 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include <module/module.h>
+#include <module/menu.h>
+#include <compiler/compiler.h>
+#include <backend/name.h>
+#include <global/setup.h>
+#include <utils/ctxmgr_lite.h>
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+
+/**
+ * chain of relu and add, each add also reads the output 2 layers before
+ */
+static std::vector<ts::Node> deep_graph(int layers) {
+    auto x = ts::bubble::param("x");
+    ts::Node prev = x, last = x;
+    for (int i = 0; i < layers; ++i) {
+        auto name = std::to_string(i);
+        auto relu = ts::bubble::op("relu" + name, ts::name::layer::relu(), {last});
+        auto add = ts::bubble::op("add" + name, ts::name::layer::add(), {relu, prev});
+        prev = last;
+        last = add;
+    }
+    return {last};
+}
+
+/**
+ * branches of relu chains on one input, each branch is also an output, and summed up as the last output
+ */
+static std::vector<ts::Node> wide_graph(int branches, int depth) {
+    auto x = ts::bubble::param("x");
+    std::vector<ts::Node> outputs;
+    for (int b = 0; b < branches; ++b) {
+        ts::Node node = x;
+        for (int d = 0; d < depth; ++d) {
+            node = ts::bubble::op("relu" + std::to_string(b) + "_" + std::to_string(d),
+                                  ts::name::layer::relu(), {node});
+        }
+        outputs.push_back(node);
+    }
+    auto sum = outputs;
+    while (sum.size() > 1) {
+        std::vector<ts::Node> next;
+        for (size_t i = 0; i + 1 < sum.size(); i += 2) {
+            next.push_back(ts::bubble::op("sum" + std::to_string(sum.size()) + "_" + std::to_string(i),
+                                          ts::name::layer::add(), {sum[i], sum[i + 1]}));
+        }
+        if (sum.size() % 2) next.push_back(sum.back());
+        sum = next;
+    }
+    outputs.push_back(sum[0]);
+    return outputs;
+}
+
+static double time_ms(const std::function<void()> &func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static void benchmark(const std::string &title, const std::function<std::vector<ts::Node>()> &build) {
+    ts::Graph g;
+    ts::ctx::bind<ts::Graph> _bind_graph(g);
+    auto outputs = build();
+    auto inputs = std::vector<ts::Node>{g.nodes().front()};
+
+    size_t nodes = 0;
+    auto list_ms = time_ms([&]() { nodes = ts::Module::list_reference_nodes(outputs).size(); });
+
+    ts::Compiler compiler(ts::ComputingDevice(ts::CPU, 0));
+    size_t instructions = 0;
+    auto generate_ms = time_ms([&]() { instructions = compiler.generate(inputs, outputs).instructions.size(); });
+
+    std::cout << std::left << std::setw(20) << title
+              << " nodes=" << std::setw(8) << nodes
+              << " instructions=" << std::setw(8) << instructions
+              << " list=" << std::setw(10) << list_ms << "ms"
+              << " generate=" << generate_ms << "ms" << std::endl;
+}
+
+int main(int argc, const char *argv[]) {
+    ts::setup();
+
+    int scale = argc > 1 ? std::atoi(argv[1]) : 1;
+
+    for (int layers : {500, 1000, 2000}) {
+        layers *= scale;
+        benchmark("deep(" + std::to_string(layers) + ")", [=]() { return deep_graph(layers); });
+    }
+    for (int branches : {50, 100, 200}) {
+        branches *= scale;
+        benchmark("wide(" + std::to_string(branches) + "x10)", [=]() { return wide_graph(branches, 10); });
+    }
+
+    return 0;
+}
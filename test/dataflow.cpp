@@ -0,0 +1,86 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/workbench.h>
+#include <utils/except.h>
+#include <global/setup.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * branches k in [0, 6): c_k = sigmoid(x + y) * x, summed to s, with one branch c_2 as output too
+ */
+static ts::Module::shared branched_module() {
+    return ts::test::build_module([]() {
+        auto x = ts::bubble::param("x");
+        auto y = ts::bubble::param("y");
+        std::vector<ts::Node> branches;
+        for (int k = 0; k < 6; ++k) {
+            auto suffix = std::to_string(k);
+            auto a = ts::bubble::op("a" + suffix, ts::name::layer::add(), {x, y});
+            auto b = ts::bubble::op("b" + suffix, ts::name::layer::sigmoid(), {a});
+            branches.push_back(ts::bubble::op("c" + suffix, ts::name::layer::mul(), {b, x}));
+        }
+        auto sum = branches[0];
+        for (int k = 1; k < 6; ++k) {
+            sum = ts::bubble::op("s" + std::to_string(k), ts::name::layer::add(), {sum, branches[k]});
+        }
+    }, {"s5", "c2"}, {"x", "y"});
+}
+
+int main() {
+    ts::setup();
+
+    auto module = branched_module();
+    ts::ComputingDevice device(ts::CPU, 0);
+
+    auto serial = ts::Workbench::Load(module, device);
+    auto dataflow = ts::Workbench::Load(module, device, "--dataflow");
+    dataflow->runtime().set_computing_thread_number(4);
+
+    bool ok = dataflow->desktop()->dataflow() != nullptr && !dataflow->desktop()->memory_plan();
+    if (!ok) std::cout << "no dataflow compiled, or memory plan not turned off" << std::endl;
+
+    for (int size : {1, 37, 100000}) {
+        ts::Tensor x(ts::FLOAT32, {size});
+        ts::Tensor y(ts::FLOAT32, {size});
+        for (int i = 0; i < size; ++i) {
+            x.data<float>()[i] = std::sin(i * 0.1f);
+            y.data<float>()[i] = std::cos(i * 0.3f);
+        }
+        for (auto bench : {serial, dataflow}) {
+            bench->input(0, x);
+            bench->input(1, y);
+            bench->run();
+        }
+        for (int i = 0; i < serial->output_count(); ++i) {
+            auto &lhs = serial->output(i);
+            auto &rhs = dataflow->output(i);
+            bool same = lhs.sizes() == rhs.sizes();
+            for (int j = 0; same && j < lhs.count(); ++j) {
+                same = lhs.data<float>()[j] == rhs.data<float>()[j];
+            }
+            if (!same) {
+                std::cout << "size=" << size << " output " << i << " mismatch" << std::endl;
+                ok = false;
+            }
+        }
+    }
+
+    // dataflow lanes can not allocate planned memory, asking for both explicitly is rejected
+    try {
+        ts::Workbench::Load(module, device, "--dataflow --memory-plan");
+        std::cout << "--dataflow with --memory-plan not rejected" << std::endl;
+        ok = false;
+    } catch (const ts::Exception &) {
+    }
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include <encryption/encrypted_fstream.h>
+#include <runtime/inside/thread_pool.h>
+#include <utils/except.h>
+#include <utils/ctxmgr_lite.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+static std::vector<char> random_data(size_t size) {
+    std::vector<char> data(size);
+    uint32_t seed = uint32_t(size);
+    for (auto &byte : data) {
+        seed = seed * 1103515245 + 12345;
+        byte = char(seed >> 16);
+    }
+    return data;
+}
+
+/**
+ * write data encrypted, then read it back in pieces of given size
+ */
+static bool round_trip(const std::string &path, const std::vector<char> &data, size_t piece) {
+    {
+        ts::EncryptedFileStreamWriter writer(path, "tennis");
+        writer.write(data.data(), data.size());
+    }
+    std::vector<char> read(data.size() + 1);
+    ts::EncryptedFileStreamReader reader(path, "tennis");
+    size_t offset = 0;
+    while (offset < data.size()) {
+        auto size = reader.read(read.data() + offset, std::min(piece, read.size() - offset));
+        if (size == 0) break;
+        offset += size;
+    }
+    // all read, next read must fail on eof
+    bool eof = false;
+    try {
+        reader.read(read.data(), 1);
+    } catch (const ts::Exception &) {
+        eof = true;
+    }
+    return eof && offset == data.size() && std::memcmp(read.data(), data.data(), data.size()) == 0;
+}
+
+/**
+ * usage: encryption [--benchmark]
+ * @note with --benchmark, time reading 64MB file
+ */
+int main(int argc, const char *argv[]) {
+    std::string path = "test_encryption.bin";
+    bool benchmark = argc > 1 && std::string(argv[1]) == "--benchmark";
+
+    // large reads are decrypted over context thread pool
+    ts::ThreadPool pool(4);
+    ts::ctx::bind<ts::ThreadPool> _bind_thread_pool(pool);
+
+    bool ok = true;
+    for (size_t size : {size_t(0), size_t(1), size_t(15), size_t(16), size_t(17), size_t(4096), size_t(100000),
+                        (size_t(9) << 20) + 5}) {
+        auto data = random_data(size);
+        for (size_t piece : {1, 7, 16, 1000, 1 << 24}) {
+            if (piece == 1 && size > 100000) continue;
+            if (!round_trip(path, data, piece)) {
+                std::cout << "Failed size=" << size << " piece=" << piece << std::endl;
+                ok = false;
+            }
+        }
+    }
+
+    if (benchmark) {
+        auto data = random_data(size_t(64) << 20);
+        {
+            ts::EncryptedFileStreamWriter writer(path, "tennis");
+            writer.write(data.data(), data.size());
+        }
+        for (size_t piece : {size_t(4) << 10, size_t(64) << 20}) {
+            std::vector<char> read(data.size());
+            auto start = std::chrono::steady_clock::now();
+            ts::EncryptedFileStreamReader reader(path, "tennis");
+            size_t offset = 0;
+            while (offset < data.size()) {
+                offset += reader.read(read.data() + offset, std::min(piece, data.size() - offset));
+            }
+            auto end = std::chrono::steady_clock::now();
+            auto seconds = std::chrono::duration<double>(end - start).count();
+            ok = ok && std::memcmp(read.data(), data.data(), data.size()) == 0;
+            std::cout << "read 64MB in pieces of " << piece << "B: " << 64 / seconds << "MB/s" << std::endl;
+        }
+    }
+
+    std::remove(path.c_str());
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/workbench.h>
+#include <global/setup.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using ts::test::random_tensor;
+
+/**
+ * conv2d -> add_bias -> batch_norm -> relu, or
+ * conv2d -> add_bias -> fused_batch_norm -> batch_scale -> prelu
+ */
+static ts::Module::shared conv_bn_module(bool fused_batch_norm) {
+    return ts::test::build_module([&]() {
+        const int out_channels = 20;
+        const int in_channels = 8;
+
+        auto x = ts::bubble::param("x");
+        auto w = ts::bubble::data("w", random_tensor({out_channels, in_channels, 3, 3}, 1, -1, 1));
+        auto conv = ts::test::conv2d("conv", x, w);
+
+        auto bias = ts::bubble::op("bias", ts::name::layer::add_bias(),
+                                   {conv, ts::bubble::data("b", random_tensor({out_channels}, 2, -1, 1))});
+        bias->set(ts::name::dim, ts::tensor::from<int>(1));
+
+        auto mean = ts::bubble::data("mean", random_tensor({out_channels}, 3, -1, 1));
+        auto variance = ts::bubble::data("variance", random_tensor({out_channels}, 4, 0.5f, 2));
+        if (fused_batch_norm) {
+            auto scale = ts::bubble::data("scale", random_tensor({out_channels}, 5, -1, 1));
+            auto shift = ts::bubble::data("shift", random_tensor({out_channels}, 6, -1, 1));
+            auto bn = ts::bubble::op("bn", ts::name::layer::fused_batch_norm(), {bias, mean, variance, scale, shift});
+            bn->set(ts::name::dim, ts::tensor::from<int>(1));
+            bn->set(ts::name::epsilon, ts::tensor::from<float>(0.001f));
+            auto bs = ts::bubble::op("bs", ts::name::layer::batch_scale(),
+                                     {bn, ts::bubble::data("bs_scale", random_tensor({out_channels}, 7, -1, 1)),
+                                      ts::bubble::data("bs_bias", random_tensor({out_channels}, 8, -1, 1))});
+            bs->set(ts::name::dim, ts::tensor::from<int>(1));
+            auto act = ts::bubble::op("act", ts::name::layer::prelu(),
+                                      {bs, ts::bubble::data("slope", random_tensor({out_channels}, 9, 0, 0.5f))});
+            act->set(ts::name::dim, ts::tensor::from<int>(1));
+        } else {
+            auto bn = ts::bubble::op("bn", ts::name::layer::batch_norm(), {bias, mean, variance});
+            bn->set(ts::name::dim, ts::tensor::from<int>(1));
+            ts::bubble::op("act", ts::name::layer::relu(), {bn});
+        }
+    }, {"act"});
+}
+
+int main() {
+    ts::setup();
+    ts::ComputingDevice device(ts::CPU, 0);
+
+    auto x = random_tensor({2, 8, 13, 11}, 10, -1, 1);
+
+    bool ok = true;
+    for (bool fused_batch_norm : {false, true}) {
+        auto module = conv_bn_module(fused_batch_norm);
+        auto fused = ts::Workbench::Load(module, device);
+        auto unfused = ts::Workbench::Load(module, device, "--no-fusion");
+
+        int fused_operators = ts::test::count_operators(*fused->desktop());
+        int unfused_operators = ts::test::count_operators(*unfused->desktop());
+
+        fused->input(0, x);
+        fused->run();
+        unfused->input(0, x);
+        unfused->run();
+        auto lhs = ts::tensor::cast(ts::FLOAT32, fused->output(0));
+        auto rhs = ts::tensor::cast(ts::FLOAT32, unfused->output(0));
+
+        float max_diff = lhs.sizes() == rhs.sizes() ? 0 : INFINITY;
+        for (int i = 0; lhs.sizes() == rhs.sizes() && i < lhs.count(); ++i) {
+            max_diff = std::max(max_diff, std::fabs(lhs.data<float>()[i] - rhs.data<float>()[i]));
+        }
+
+        std::cout << (fused_batch_norm ? "fused_batch_norm" : "batch_norm")
+                  << ": operators " << fused_operators << " vs. " << unfused_operators
+                  << ", max diff " << max_diff << std::endl;
+        if (fused_operators >= unfused_operators || max_diff > 1e-4f) ok = false;
+    }
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
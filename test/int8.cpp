@@ -0,0 +1,119 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/workbench.h>
+#include <kernels/cpu/quantized/int8_gemm.h>
+#include <backend/common_structure.h>
+#include <global/setup.h>
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static ts::Node conv2d_quantized(const std::string &name, const ts::Node &x, int out_channels, int in_channels,
+                                 unsigned seed) {
+    ts::Tensor w(ts::INT8, {out_channels, in_channels, 3, 3});
+    std::mt19937 engine(seed);
+    for (int i = 0; i < w.count(); ++i) w.data<int8_t>()[i] = int8_t(int(engine() % 255) - 127);
+    auto conv = ts::test::conv2d(name, x, ts::bubble::data(name + "_w", w), ts::name::layer::conv2d_quantized());
+    std::vector<float> scales;
+    for (int i = 0; i < out_channels; ++i) scales.push_back(0.0001f * (1 + i % 5));
+    conv->set(ts::name::dequantize_scales, ts::tensor::build(ts::FLOAT32, scales));
+    return conv;
+}
+
+/**
+ * quantize -> conv2d_quantized -> relu -> max pooling -> quantize -> conv2d_quantized,
+ * the second quantize is zipped into the first conv2d_quantized.
+ * zipped = false adds another reader of pooling, so the chain can not be zipped.
+ */
+static ts::Module::shared quantized_module(bool zipped) {
+    std::vector<std::string> outputs = {"c2"};
+    if (!zipped) outputs.emplace_back("p1_shape");
+    return ts::test::build_module([&]() {
+        auto x = ts::bubble::param("x");
+        auto q0 = ts::bubble::op("q0", ts::name::layer::quantize(), {x});
+        q0->set(ts::name::quantize_scale, ts::tensor::build(ts::FLOAT32, {40.0f}));
+        auto c1 = conv2d_quantized("c1", q0, 16, 8, 1);
+        auto r1 = ts::bubble::op("r1", ts::name::layer::relu(), {c1});
+        auto p1 = ts::bubble::op("p1", ts::name::layer::pooling2d(), {r1});
+        p1->set(ts::name::format, ts::tensor::from(ts::name::NCHW));
+        p1->set(ts::name::type, ts::tensor::from(int(ts::Pooling2DType::MAX)));
+        p1->set(ts::name::padding, ts::tensor::build(ts::INT32, ts::Shape{4, 2}, {0, 0, 0, 0, 0, 0, 0, 0}));
+        p1->set(ts::name::ksize, ts::tensor::build(ts::INT32, {1, 1, 2, 2}));
+        p1->set(ts::name::stride, ts::tensor::build(ts::INT32, {1, 1, 2, 2}));
+        auto q1 = ts::bubble::op("q1", ts::name::layer::quantize(), {p1});
+        q1->set(ts::name::quantize_scale, ts::tensor::build(ts::FLOAT32, {3.0f}));
+        conv2d_quantized("c2", q1, 12, 16, 2);
+        if (!zipped) ts::bubble::op("p1_shape", ts::name::layer::shape(), {p1});
+    }, outputs);
+}
+
+/**
+ * packed int8 gemm against naive int32 accumulation, on sizes not multiple of panels
+ */
+static bool check_gemm() {
+    const int M = 13, N = 37, K = 29;
+    std::vector<int8_t> A(M * K), B(K * N);
+    std::mt19937 engine(3);
+    for (auto &a : A) a = int8_t(int(engine() % 256) - 128);
+    for (auto &b : B) b = int8_t(int(engine() % 256) - 128);
+
+    std::vector<int16_t> packed_A(ts::cpu::Int8Gemm::pack_A_size(M, K));
+    std::vector<int16_t> packed_B(ts::cpu::Int8Gemm::pack_B_size(K, N));
+    ts::cpu::Int8Gemm::pack_A(M, K, A.data(), K, packed_A.data());
+    ts::cpu::Int8Gemm::pack_B(K, N, B.data(), N, packed_B.data());
+    std::vector<float> scales(M, 1.0f), C(M * N);
+    ts::cpu::Int8Gemm::dequantize(M, N, K, packed_A.data(), packed_B.data(), scales.data(), C.data(), N);
+
+    bool ok = true;
+    for (int i = 0; ok && i < M; ++i) {
+        for (int j = 0; ok && j < N; ++j) {
+            int sum = 0;
+            for (int k = 0; k < K; ++k) sum += A[i * K + k] * B[k * N + j];
+            ok = float(sum) == C[i * N + j];
+        }
+    }
+    std::cout << "int8 gemm " << (ok ? "matched" : "FAILED") << std::endl;
+    return ok;
+}
+
+int main() {
+    ts::setup();
+
+    bool ok = check_gemm();
+
+    ts::ComputingDevice device(ts::CPU, 0);
+    auto zipped = ts::Workbench::Load(quantized_module(true), device);
+    auto unzipped = ts::Workbench::Load(quantized_module(false), device);
+
+    int zipped_quantize = ts::test::count_operators(*zipped->desktop(), ts::name::layer::quantize());
+    int unzipped_quantize = ts::test::count_operators(*unzipped->desktop(), ts::name::layer::quantize());
+    std::cout << "quantize operators " << zipped_quantize << " vs. " << unzipped_quantize << std::endl;
+    if (zipped_quantize >= unzipped_quantize) ok = false;
+
+    for (auto &shape : {ts::Shape({1, 8, 16, 16}), ts::Shape({1, 8, 13, 11})}) {
+        ts::Tensor x(ts::FLOAT32, shape);
+        for (int i = 0; i < x.count(); ++i) x.data<float>()[i] = std::sin(i * 0.1f);
+        zipped->input(0, x);
+        zipped->run();
+        unzipped->input(0, x);
+        unzipped->run();
+        auto &lhs = zipped->output(0);
+        auto &rhs = unzipped->output(0);
+
+        bool same = lhs.sizes() == rhs.sizes();
+        for (int i = 0; same && i < lhs.count(); ++i) {
+            same = lhs.data<float>()[i] == rhs.data<float>()[i];
+        }
+        std::cout << ts::to_string(shape) << ": zipped output " << (same ? "matched" : "FAILED") << std::endl;
+        ok = ok && same;
+    }
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include <frontend/intime.h>
+#include <core/tensor_builder.h>
+#include <global/setup.h>
+#include <utils/ctxmgr_lite.h>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+/**
+ * post processing like calls, resize, transpose, affine sample then concat
+ */
+static ts::Tensor post_process(const ts::Tensor &x) {
+    auto resized = ts::intime::resize2d(x, {-1, 32, 32, -1});
+    auto nchw = ts::intime::transpose(resized, {0, 3, 1, 2});
+    auto sampled = ts::intime::affine_sample2d("", nchw, std::array<int32_t, 2>({16, 16}),
+                                               std::array<float, 9>({2, 0, 0, 0, 2, 0, 0, 0, 1}), 2);
+    auto scaled = ts::intime::mul(sampled, ts::tensor::from<float>(0.5f));
+    return ts::intime::concat({sampled, scaled}, 1);
+}
+
+static double time_ms(const std::function<void()> &func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static float max_diff(const ts::Tensor &lhs, const ts::Tensor &rhs) {
+    if (lhs.sizes() != rhs.sizes()) return INFINITY;
+    auto a = lhs.data<float>();
+    auto b = rhs.data<float>();
+    float diff = 0;
+    for (int i = 0; i < lhs.count(); ++i) diff = std::max(diff, std::fabs(a[i] - b[i]));
+    return diff;
+}
+
+static ts::Tensor random_image(int seed) {
+    ts::Tensor x(ts::FLOAT32, {1, 48, 64, 3});
+    auto data = x.data<float>();
+    for (int i = 0; i < x.count(); ++i) data[i] = float((i * 37 + seed * 11) % 255);
+    return x;
+}
+
+int main() {
+    ts::setup();
+
+    ts::Workbench bench(ts::ComputingDevice(ts::CPU, 0));
+    bench.runtime().set_computing_thread_number(1);
+    ts::ctx::bind<ts::Workbench> _bind_bench(bench);
+
+    const int times = 1000;
+    auto x = random_image(0);
+    auto expected = post_process(x).clone();
+
+    auto eager_ms = time_ms([&]() {
+        for (int i = 0; i < times; ++i) post_process(x);
+    });
+
+    ts::intime::OperatorCache cache;
+    float cached_diff = 0;
+    auto cached_ms = time_ms([&]() {
+        ts::ctx::bind<ts::intime::OperatorCache> _bind_cache(cache);
+        for (int i = 0; i < times; ++i) cached_diff = max_diff(post_process(x), expected);
+    });
+
+    ts::intime::Capture capture;
+    ts::Program::shared program;
+    {
+        ts::ctx::bind<ts::intime::Capture> _bind_capture(capture);
+        auto input = capture.input(random_image(1));
+        auto output = post_process(input);
+        program = capture.compile({output}, bench.device().computing_device);
+    }
+    float captured_diff = 0;
+    auto captured_ms = time_ms([&]() {
+        for (int i = 0; i < times; ++i) {
+            captured_diff = max_diff(bench.launch_offline(program, {x})[0], expected);
+        }
+    });
+
+    std::cout << "eager: " << eager_ms / times << "ms" << std::endl;
+    std::cout << "cached: " << cached_ms / times << "ms, hits=" << cache.hits()
+              << " misses=" << cache.misses() << " diff=" << cached_diff << std::endl;
+    std::cout << "captured: " << captured_ms / times << "ms, calls=" << capture.size()
+              << " diff=" << captured_diff << std::endl;
+
+    return cached_diff < 1e-5f && captured_diff < 1e-5f ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include <kernels/cpu/isa.h>
+#include <kernels/cpu/math_cpu.h>
+#include <global/setup.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using math = ts::cpu::math<float, float>;
+
+static std::vector<float> random_vector(size_t size, unsigned seed) {
+    std::vector<float> vector(size);
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    for (auto &value : vector) value = distribution(engine);
+    return vector;
+}
+
+/**
+ * naive C = epilogue(A * B), C has ldc columns
+ */
+static std::vector<float> naive_gemm(int M, int N, int K, const std::vector<float> &A, const std::vector<float> &B,
+                                     int ldc, const ts::cpu::GemmEpilogue<float> &epilogue) {
+    std::vector<float> C(M * ldc, 0);
+    for (int i = 0; i < M; ++i) {
+        for (int j = 0; j < N; ++j) {
+            float sum = 0;
+            for (int k = 0; k < K; ++k) sum += A[i * K + k] * B[k * N + j];
+            C[i * ldc + j] = sum;
+        }
+        epilogue(i, &C[i * ldc], N);
+    }
+    return C;
+}
+
+static float max_diff(const std::vector<float> &lhs, const std::vector<float> &rhs) {
+    float diff = 0;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        auto d = std::fabs(lhs[i] - rhs[i]);
+        diff = std::isnan(d) ? INFINITY : std::max(diff, d);
+    }
+    return diff;
+}
+
+static std::vector<ts::cpu::GemmEpilogue<float>> epilogues(const std::vector<float> &bias, const std::vector<float> &slope) {
+    std::vector<ts::cpu::GemmEpilogue<float>> result(4);
+    result[0].bias = bias.data();
+    result[1].bias = bias.data();
+    result[1].activation = ts::FusedActivation::RELU;
+    result[2].bias = bias.data();
+    result[2].activation = ts::FusedActivation::RELU_MAX;
+    result[2].max = 0.5f;
+    result[3].activation = ts::FusedActivation::LEAKY_RELU;
+    result[3].slope = slope.data();
+    result[3].slope_step = 1;
+    return result;
+}
+
+/**
+ * tile kernel of each built tier, followed by epilogue on the tile as gemm does
+ */
+static bool check_tiles() {
+    const int K = 37;
+    auto bias = random_vector(8, 1);
+    auto slope = random_vector(8, 2);
+    bool ok = true;
+    for (auto isa : {ts::cpu::ISA::AVX2, ts::cpu::ISA::AVX512}) {
+        auto &kernels = ts::cpu::isa_kernels(isa);
+        if (kernels.gemm_tile8 == nullptr) {
+            std::cout << ts::cpu::isa_str(isa) << " tile not built in" << std::endl;
+            continue;
+        }
+        float diff = 0;
+        for (int panels : {1, 2, 3, 5}) {
+            int N = panels * 8, ldc = N + 3;
+            auto A = random_vector(8 * K, 3);
+            auto B = random_vector(K * N, 4);
+            std::vector<float> packed_A(A.size()), packed_B(B.size());
+            math::pack8_A(8, K, A.data(), K, packed_A.data());
+            math::pack8_B(K, N, B.data(), N, packed_B.data());
+            for (auto &epilogue : epilogues(bias, slope)) {
+                std::vector<float> C(8 * ldc, 0);
+                kernels.gemm_tile8(K, packed_A.data(), packed_B.data(), panels, C.data(), ldc);
+                for (int i = 0; i < 8; ++i) epilogue(i, &C[i * ldc], N);
+                diff = std::max(diff, max_diff(C, naive_gemm(8, N, K, A, B, ldc, epilogue)));
+            }
+        }
+        std::cout << ts::cpu::isa_str(isa) << " tile max diff " << diff << std::endl;
+        if (!(diff < 1e-4f)) ok = false;
+    }
+    return ok;
+}
+
+/**
+ * gemm with epilogue on dispatched tier, with rows and columns out of tiles,
+ * set environment TS_CPU_ISA to check lower tiers
+ */
+static bool check_gemm() {
+    const int K = 37;
+    float diff = 0;
+    for (int M : {3, 8, 13}) {
+        for (int N : {5, 8, 40, 45, 67}) {
+            auto A = random_vector(M * K, 5);
+            auto B = random_vector(K * N, 6);
+            auto bias = random_vector(M, 7);
+            auto slope = random_vector(M, 8);
+            std::vector<float> packed_A(A.size()), packed_B(B.size());
+            for (auto &epilogue : epilogues(bias, slope)) {
+                std::vector<float> C(M * N, 0);
+                math::gemm(M, N, K, 1, A.data(), packed_A.data(), B.data(), packed_B.data(), 0, C.data(),
+                           true, true, &epilogue);
+                diff = std::max(diff, max_diff(C, naive_gemm(M, N, K, A, B, N, epilogue)));
+            }
+        }
+    }
+    std::cout << ts::cpu::isa_str(ts::cpu::cpu_isa()) << " gemm epilogue max diff " << diff << std::endl;
+    return diff < 1e-4f;
+}
+
+int main() {
+    ts::setup();
+
+    bool ok = check_tiles();
+    ok = check_gemm() && ok;
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -7,6 +7,7 @@
 #include <iostream>
 #include <global/memory_device.h>
 #include <global/setup.h>
+#include <kernels/cpu/memory_cpu.h>
 
 #include <map>
 #include <unordered_map>
@@ -48,6 +49,16 @@ int main()
         std::cout << e.what() << std::endl;
     }
 
+    ts::Memory big = c.alloc(ts::CpuAllocator::GetHugePageThreshold());
+    for (auto &memory : {a, b, big}) {
+        if (ts::CpuAllocator::Selected() == "aligned" &&
+            reinterpret_cast<uintptr_t>(memory.data()) % ts::CpuAllocator::Alignment() != 0) {
+            std::cout << "Unaligned memory " << memory.data() << std::endl;
+            return 1;
+        }
+    }
+    std::cout << ts::CpuAllocator::Summary() << std::endl;
+
 #ifdef TS_USE_CUDA
     ts::Memory host_data1 = c.alloc(4);
     ts::Memory host_data2 = c.alloc(4);
@@ -0,0 +1,195 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <memory/flow.h>
+#include <runtime/workbench.h>
+#include <global/setup.h>
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static const size_t BLOCK = 4096;
+
+/**
+ * a and b alive together, c allocated after a freed
+ * @param planned set to if the run is served by a ready plan
+ */
+static std::vector<void *> run_sequence(ts::PlannedMemoryController &planner, size_t size,
+                                        const std::string &signature = "", bool *planned = nullptr) {
+    planner.begin(signature);
+    if (planned) *planned = planner.planned();
+    auto a = planner.alloc(size);
+    auto b = planner.alloc(size);
+    std::vector<void *> pointers = {a.data(), b.data()};
+    a = ts::Memory();
+    auto c = planner.alloc(size);
+    pointers.push_back(c.data());
+    planner.end();
+    return pointers;
+}
+
+/**
+ * the traced run is packed into arena, later runs reuse freed block
+ */
+static bool check_reuse() {
+    ts::PlannedMemoryController planner(ts::MemoryDevice(ts::CPU, 0));
+
+    run_sequence(planner, BLOCK);
+    bool ok = planner.planned() && planner.arena() == 2 * BLOCK;
+
+    auto planned = run_sequence(planner, BLOCK);
+    ok = ok && planned[2] == planned[0] && planned[1] != planned[0];
+
+    // same plan replayed
+    auto replayed = run_sequence(planner, BLOCK);
+    ok = ok && replayed == planned;
+
+    std::cout << "arena " << planner.arena() << " for 3 blocks of " << BLOCK << ": "
+              << (ok ? "reused" : "FAILED") << std::endl;
+    return ok;
+}
+
+/**
+ * changed sizes fall back to dynamic memory and get re-planned,
+ * memory kept out of run is never handed out again while alive
+ */
+static bool check_fallback() {
+    ts::PlannedMemoryController planner(ts::MemoryDevice(ts::CPU, 0));
+    run_sequence(planner, BLOCK);
+
+    // sizes changed, traced again out of plan
+    auto changed = run_sequence(planner, 4 * BLOCK);
+    bool ok = planner.planned() && planner.arena() == 8 * BLOCK && changed[2] == changed[0];
+
+    // block kept alive out of run must not be handed out by next run
+    planner.begin();
+    auto a = planner.alloc(4 * BLOCK);
+    auto kept = planner.alloc(4 * BLOCK);
+    std::memset(kept.data(), 2, kept.size());
+    a = ts::Memory();
+    auto c = planner.alloc(4 * BLOCK);
+    planner.end();
+
+    auto pointers = run_sequence(planner, 4 * BLOCK);
+    for (auto pointer : pointers) ok = ok && pointer != kept.data();
+    for (size_t i = 0; ok && i < kept.size(); ++i) {
+        ok = kept.data<char>()[i] == 2;
+    }
+
+    std::cout << "shape change " << (ok ? "re-planned" : "FAILED") << ", arena " << planner.arena() << std::endl;
+    return ok;
+}
+
+/**
+ * @return if the run of signature is served by a ready plan
+ */
+static bool replayed(ts::PlannedMemoryController &planner, size_t size, const std::string &signature) {
+    bool planned = false;
+    run_sequence(planner, size, signature, &planned);
+    return planned;
+}
+
+/**
+ * plans kept per signature, least recently used one dropped out of capacity
+ */
+static bool check_lru() {
+    ts::PlannedMemoryController planner(ts::MemoryDevice(ts::CPU, 0));
+    planner.set_capacity(2);
+
+    run_sequence(planner, BLOCK, "a");
+    run_sequence(planner, 4 * BLOCK, "b");
+    bool ok = planner.plans() == 2;
+
+    // switching back replays own plan
+    auto a = run_sequence(planner, BLOCK, "a");
+    ok = ok && planner.arena() == 2 * BLOCK && a[2] == a[0];
+    auto b = run_sequence(planner, 4 * BLOCK, "b");
+    ok = ok && planner.arena() == 8 * BLOCK && b[2] == b[0];
+
+    // a is used after b, so b is dropped by c
+    run_sequence(planner, BLOCK, "a");
+    run_sequence(planner, 2 * BLOCK, "c");
+    ok = ok && planner.plans() == 2 && replayed(planner, 2 * BLOCK, "c") && replayed(planner, BLOCK, "a");
+    ok = ok && !replayed(planner, 4 * BLOCK, "b");
+
+    // shrinking capacity keeps the most recently used
+    planner.set_capacity(1);
+    ok = ok && planner.plans() == 1 && replayed(planner, 4 * BLOCK, "b") && !replayed(planner, BLOCK, "a");
+
+    std::cout << "plan lru " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+/**
+ * a = x + x, b = a * x, c = sigmoid(b), d = c + a, e = d - b, f = e * c, outputs f and d
+ */
+static ts::Module::shared chain_module() {
+    return ts::test::build_module([]() {
+        auto x = ts::bubble::param("x");
+        auto a = ts::bubble::op("a", ts::name::layer::add(), {x, x});
+        auto b = ts::bubble::op("b", ts::name::layer::mul(), {a, x});
+        auto c = ts::bubble::op("c", ts::name::layer::sigmoid(), {b});
+        auto d = ts::bubble::op("d", ts::name::layer::add(), {c, a});
+        auto e = ts::bubble::op("e", ts::name::layer::sub(), {d, b});
+        ts::bubble::op("f", ts::name::layer::mul(), {e, c});
+    }, {"f", "d"});
+}
+
+static bool same(const ts::Tensor &lhs, const ts::Tensor &rhs) {
+    bool ok = lhs.sizes() == rhs.sizes();
+    for (int i = 0; ok && i < lhs.count(); ++i) {
+        ok = lhs.data<float>()[i] == rhs.data<float>()[i];
+    }
+    return ok;
+}
+
+/**
+ * planned workbench against unplanned one, with changed shapes and outputs held over runs
+ */
+static bool check_workbench() {
+    auto module = chain_module();
+    ts::ComputingDevice device(ts::CPU, 0);
+    auto planned = ts::Workbench::Load(module, device, "--memory-plan");
+    auto unplanned = ts::Workbench::Load(module, device, "--no-memory-plan");
+    planned->set_plan_capacity(2);
+
+    bool ok = planned->desktop()->memory_plan() && !unplanned->desktop()->memory_plan();
+    for (int size : {1000, 1000, 37, 5000, 1000, 37, 1000, 64, 37}) {
+        ts::Tensor x(ts::FLOAT32, {size});
+        for (int i = 0; i < size; ++i) x.data<float>()[i] = std::sin(i * 0.1f);
+        planned->input(0, x);
+        unplanned->input(0, x);
+
+        ts::Tensor kept;
+        for (int t = 0; t < 3; ++t) {
+            planned->run();
+            unplanned->run();
+            if (t == 0) kept = planned->output(0);
+            for (int i = 0; i < planned->output_count(); ++i) {
+                ok = same(planned->output(i), unplanned->output(i)) && ok;
+            }
+        }
+        ok = same(kept, unplanned->output(0)) && ok;
+        std::cout << "size=" << size << ": " << (ok ? "matched" : "FAILED") << std::endl;
+    }
+    ok = ok && planned->share()->plan_capacity() == 2 && planned->clone()->plan_capacity() == 2;
+    return ok;
+}
+
+int main() {
+    ts::setup();
+
+    bool ok = check_reuse();
+    ok = check_fallback() && ok;
+    ok = check_lru() && ok;
+    ok = check_workbench() && ok;
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/workbench.h>
+#include <global/setup.h>
+
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * y = relu(x * w + b), w of 4 KB is saved as blob, b is small and kept in graph
+ */
+static ts::Module::shared weighted_module() {
+    return ts::test::build_module([]() {
+        auto x = ts::bubble::param("x");
+        auto a = ts::bubble::op("a", ts::name::layer::mul(), {x, ts::bubble::data("w", ts::test::sin_tensor({1024}, 0.37f))});
+        auto b = ts::bubble::op("b", ts::name::layer::add(), {a, ts::bubble::data("b", ts::test::sin_tensor({1}, 0.71f))});
+        ts::bubble::op("y", ts::name::layer::relu(), {b});
+    }, {"y"});
+}
+
+/**
+ * @return value of const node named name, walking from outputs
+ */
+static ts::Tensor const_value(const ts::Module::shared &module, const std::string &name) {
+    std::vector<ts::Node> walker = module->outputs();
+    while (!walker.empty()) {
+        auto node = walker.back();
+        walker.pop_back();
+        if (node->op() == ts::Bubble::Const && node->name() == name) return node->get(ts::name::value);
+        for (auto &input : node.inputs()) walker.push_back(input);
+    }
+    return ts::Tensor();
+}
+
+/**
+ * @return if one tensor in data segment of bench is on the memory of value
+ */
+static bool in_data_segment(const ts::Workbench &bench, const ts::Tensor &value) {
+    auto &data_segment = bench.desktop()->data_segment();
+    for (size_t i = 0; i < data_segment.size(); ++i) {
+        if (data_segment[i].data() == value.data()) return true;
+    }
+    return false;
+}
+
+static bool same(const ts::Tensor &lhs, const ts::Tensor &rhs) {
+    bool ok = lhs.sizes() == rhs.sizes();
+    for (int i = 0; ok && i < lhs.count(); ++i) {
+        ok = lhs.data<float>()[i] == rhs.data<float>()[i];
+    }
+    return ok;
+}
+
+int main() {
+    ts::setup();
+    ts::ComputingDevice device(ts::CPU, 0);
+
+    const char *filename = "module_v2.tsm";
+    auto module = weighted_module();
+    ts::Module::Save(filename, module, ts::Module::BINARY_V2);
+    auto mapped = ts::Module::Load(filename, ts::Module::BINARY_V2);
+
+    auto reference = ts::Workbench::Load(module, device);
+    auto bench = ts::Workbench::Load(mapped, device);
+    auto shared = bench->share();
+
+    // weights of mapped module are in data segment of both benches, not copied
+    auto w = const_value(mapped, "w");
+    bool ok = same(w, const_value(module, "w")) && same(const_value(mapped, "b"), const_value(module, "b"));
+    bool zero_copy = in_data_segment(*bench, w) && in_data_segment(*shared, w);
+    std::cout << "mapped weights " << (zero_copy ? "shared" : "COPIED") << std::endl;
+    ok = ok && zero_copy;
+
+    std::vector<ts::Tensor> inputs = {ts::test::sin_tensor({1024}, 0.1f), ts::test::sin_tensor({3, 1024}, 0.13f)};
+    std::vector<ts::Tensor> expected;
+    for (auto &x : inputs) {
+        reference->input(0, x);
+        reference->run();
+        expected.push_back(reference->output(0).clone());
+    }
+
+    // both benches run concurrently on the mapped weights
+    bool matched[2] = {true, true};
+    std::vector<ts::Workbench::shared> benches = {bench, shared};
+    std::vector<std::thread> threads;
+    for (size_t k = 0; k < benches.size(); ++k) {
+        threads.emplace_back([&, k]() {
+            for (int t = 0; t < 50; ++t) {
+                auto i = (t + k) % inputs.size();
+                benches[k]->input(0, inputs[i]);
+                benches[k]->run();
+                if (!same(benches[k]->output(0), expected[i])) matched[k] = false;
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+    std::cout << "bench " << (matched[0] ? "matched" : "FAILED")
+              << ", shared bench " << (matched[1] ? "matched" : "FAILED") << std::endl;
+    ok = ok && matched[0] && matched[1];
+
+    bench.reset();
+    shared.reset();
+    mapped.reset();
+    std::remove(filename);
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
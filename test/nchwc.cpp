@@ -0,0 +1,84 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/workbench.h>
+#include <global/setup.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using ts::test::random_tensor;
+
+/**
+ * conv2d with small weights and bias in [bias_min, bias_max], so outputs stay near bias for inputs in [-1, 1]
+ */
+static ts::Node conv2d(const std::string &name, const ts::Node &x, int out_channels, int in_channels, unsigned seed,
+                       float bias_min, float bias_max) {
+    auto w = ts::bubble::data(name + "_w", random_tensor({out_channels, in_channels, 3, 3}, seed, -0.05f, 0.05f));
+    auto conv = ts::test::conv2d(name, x, w);
+    auto bias = ts::bubble::op(name + "_bias", ts::name::layer::add_bias(),
+                               {conv, ts::bubble::data(name + "_b", random_tensor({out_channels}, seed + 1, bias_min, bias_max))});
+    bias->set(ts::name::dim, ts::tensor::from<int>(1));
+    return bias;
+}
+
+/**
+ * blocked conv2d outputs of 5 channels, mixed by element-wise ops which turn zeros to non zeros,
+ * div of zeros and square of it would fill padded channels of blocked layout with inf,
+ * then blocked conv2d reading them would output NaN.
+ */
+static ts::Module::shared element_wise_module() {
+    return ts::test::build_module([]() {
+        auto x = ts::bubble::param("x");
+
+        auto a = conv2d("a", x, 5, 3, 1, -1, 1);
+        auto b = conv2d("b", x, 5, 3, 3, 2, 3);
+        auto a_relu = ts::bubble::op("a_relu", ts::name::layer::relu(), {a});
+        auto b_square = ts::bubble::op("b_square", ts::name::layer::square(), {b});
+        auto quotient = ts::bubble::op("quotient", ts::name::layer::div(), {a_relu, b_square});
+        auto quotient_square = ts::bubble::op("quotient_square", ts::name::layer::square(), {quotient});
+        auto exp = ts::bubble::op("exp", ts::name::layer::exp(), {a_relu});
+        auto sum = ts::bubble::op("sum", ts::name::layer::add(), {quotient_square, exp});
+        auto product = ts::bubble::op("product", ts::name::layer::mul(), {sum, b});
+        auto c = conv2d("c", product, 3, 5, 5, -1, 1);
+        ts::bubble::op("y", ts::name::layer::relu(), {c});
+    }, {"y"});
+}
+
+int main() {
+    ts::setup();
+    ts::ComputingDevice device(ts::CPU, 0);
+
+    auto module = element_wise_module();
+    auto nchwc = ts::Workbench::Load(module, device, "--nchwc");
+    auto nchw = ts::Workbench::Load(module, device, "--no-nchwc");
+
+    int blocked = ts::test::count_operators(*nchwc->desktop(), ts::name::layer::conv2d_nchwc());
+
+    bool ok = blocked > 0;
+    for (auto &shape : {ts::Shape({1, 3, 9, 7}), ts::Shape({2, 3, 16, 16})}) {
+        auto x = random_tensor(shape, 10, -1, 1);
+        nchwc->input(0, x);
+        nchwc->run();
+        nchw->input(0, x);
+        nchw->run();
+        auto &lhs = nchwc->output(0);
+        auto &rhs = nchw->output(0);
+
+        float max_diff = lhs.sizes() == rhs.sizes() ? 0 : INFINITY;
+        for (int i = 0; lhs.sizes() == rhs.sizes() && i < lhs.count(); ++i) {
+            auto diff = std::fabs(lhs.data<float>()[i] - rhs.data<float>()[i]);
+            max_diff = std::isnan(diff) ? INFINITY : std::max(max_diff, diff);
+        }
+        std::cout << ts::to_string(shape) << ": blocked conv2d " << blocked
+                  << ", max diff " << max_diff << std::endl;
+        if (!(max_diff < 1e-4f)) ok = false;
+    }
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/workbench.h>
+#include <runtime/stack.h>
+#include <board/hook.h>
+#include <global/setup.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * y = conv2d(x, w), w in [9, 1, 3, 3] with padding 1,
+ * so the im2col buffer has the same count as output, and must not take the output buffer
+ */
+static ts::Module::shared conv_module() {
+    return ts::test::build_module([]() {
+        ts::test::conv2d_fixture("y", ts::bubble::param("x"), 9, 1);
+    }, {"y"});
+}
+
+/**
+ * preset only goes to the tensor pushed on the slot it bound to
+ */
+static bool check_stack() {
+    ts::Stack stack(ts::MemoryDevice(ts::CPU));
+    stack.push(ts::FLOAT32, {4});   // argument
+
+    ts::Tensor buffer(ts::FLOAT32, {2, 3});
+    stack.preset(buffer);
+
+    auto temporary = stack.make(ts::FLOAT32, {3, 2});
+    bool ok = temporary.data() != buffer.data() && !stack.preset_taken();
+
+    auto output = stack.push(ts::FLOAT32, {6});
+    ok = ok && output->data() == buffer.data() && stack.preset_taken();
+
+    auto next = stack.push(ts::FLOAT32, {6});
+    ok = ok && next->data() != buffer.data();
+
+    std::cout << "stack preset " << (ok ? "bound to slot" : "FAILED") << std::endl;
+    return ok;
+}
+
+/**
+ * bind buffer to output and run, the operator producing output must write into buffer directly,
+ * checked by hook after it run, before output is copied into buffer by workbench
+ */
+static bool check_bench(const std::string &title, ts::Workbench &bench, const ts::Tensor &x,
+                        const ts::Tensor &expected) {
+    ts::Tensor buffer(ts::FLOAT32, {1, 9, 8, 8});
+    bench.bind_output(0, buffer);
+
+    bool written = false;
+    ts::Hook hook;
+    hook.after_run([&](const ts::Hook::StructAfterRun &info) {
+        if (info.op->name() == "y") written = info.stack->top()->data() == buffer.data();
+    });
+    {
+        ts::ctx::bind<ts::Hook> _bind_hook(hook);
+        bench.input(0, x);
+        bench.run();
+    }
+    auto &y = bench.output(0);
+
+    bool same = y.data() == buffer.data() && y.sizes() == expected.sizes();
+    for (int i = 0; same && i < y.count(); ++i) {
+        same = std::fabs(buffer.data<float>()[i] - expected.data<float>()[i]) < 1e-5f;
+    }
+    std::cout << title << " conv2d output " << (written ? "written in buffer" : "NOT written in buffer")
+              << ", " << (same ? "matched" : "FAILED") << std::endl;
+    return written && same;
+}
+
+int main() {
+    ts::setup();
+
+    bool ok = check_stack();
+
+    ts::ComputingDevice device(ts::CPU, 0);
+    auto module = conv_module();
+
+    ts::Tensor x(ts::FLOAT32, {1, 1, 8, 8});
+    for (int i = 0; i < x.count(); ++i) x.data<float>()[i] = std::cos(i * 0.11f);
+
+    auto reference = ts::Workbench::Load(module, device);
+    reference->input(0, x);
+    reference->run();
+    auto expected = reference->output(0).clone();
+
+    auto bench = ts::Workbench::Load(module, device);
+    ok = check_bench("loaded", *bench, x, expected) && ok;
+    ok = check_bench("shared", *bench->share(), x, expected) && ok;
+    ok = check_bench("cloned", *bench->clone(), x, expected) && ok;
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
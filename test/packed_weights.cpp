@@ -0,0 +1,124 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/packed_weights.h>
+#include <runtime/workbench.h>
+#include <global/setup.h>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using ts::test::random_tensor;
+
+/**
+ * weight in data segment packed once per layout, others packed on every call
+ */
+static bool check_cache() {
+    auto data_segment = std::make_shared<ts::Stack>(ts::MemoryDevice(ts::CPU));
+    auto constant = *data_segment->push(random_tensor({4, 8}, 1, -1, 1));
+    auto temporary = random_tensor({4, 8}, 2, -1, 1);
+    ts::PackedWeights packed(data_segment);
+
+    int packs = 0;
+    auto packer = [&](const ts::Tensor &weight) {
+        ++packs;
+        return weight.clone();
+    };
+
+    auto first = packed.get(constant, "layout", packer);
+    auto second = packed.get(constant, "layout", packer);
+    bool ok = packs == 1 && first.data() == second.data() && packed.constant(constant);
+
+    packed.get(constant, "other_layout", packer);
+    ok = ok && packs == 2 && packed.count() == 2 && packed.memory() == 2 * constant.count() * sizeof(float);
+
+    packed.get(temporary, "layout", packer);
+    packed.get(temporary, "layout", packer);
+    ok = ok && packs == 4 && packed.count() == 2 && !packed.constant(temporary);
+
+    std::cout << "packed weights cache " << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+/**
+ * conv2d and transposed inner_prod, both pack their weights for gemm
+ */
+static ts::Module::shared gemm_module() {
+    return ts::test::build_module([]() {
+        auto x = ts::bubble::param("x");
+        auto conv = ts::test::conv2d("conv", x, ts::bubble::data("w", random_tensor({20, 8, 3, 3}, 3, -1, 1)));
+        auto flatten = ts::bubble::op("flatten", ts::name::layer::flatten(), {conv});
+        auto fc = ts::bubble::op("fc", ts::name::layer::inner_prod(),
+                                 {flatten, ts::bubble::data("fc_w", random_tensor({30, 20 * 13 * 11}, 4, -0.1f, 0.1f))});
+        fc->set(ts::name::transpose, ts::tensor::from<bool>(true));
+    }, {"fc"});
+}
+
+static bool same(const ts::Tensor &lhs, const ts::Tensor &rhs) {
+    bool ok = lhs.sizes() == rhs.sizes();
+    for (int i = 0; ok && i < lhs.count(); ++i) {
+        ok = lhs.data<float>()[i] == rhs.data<float>()[i];
+    }
+    return ok;
+}
+
+/**
+ * shared and cloned benches reuse weights packed by any of them,
+ * compiled with --no-pack, so weights are packed by operators instead of pack translator
+ */
+static bool check_shared_benches() {
+    auto bench = ts::Workbench::Load(gemm_module(), ts::ComputingDevice(ts::CPU, 0), "--no-pack");
+    std::vector<ts::Workbench::shared> benches = {bench, bench->share(), bench->share(), bench->clone()};
+
+    auto &packed = bench->desktop()->packed_weights();
+    bool ok = packed != nullptr && packed->count() == 0;
+    for (auto &other : benches) ok = ok && other->desktop()->packed_weights() == packed;
+
+    std::vector<ts::Tensor> inputs = {random_tensor({1, 8, 13, 11}, 5, -1, 1), random_tensor({3, 8, 13, 11}, 6, -1, 1)};
+
+    // first runs are concurrent, each weight is still packed once
+    std::vector<std::vector<ts::Tensor>> outputs(benches.size());
+    std::vector<std::thread> threads;
+    for (size_t k = 0; k < benches.size(); ++k) {
+        threads.emplace_back([&, k]() {
+            for (auto &x : inputs) {
+                benches[k]->input(0, x);
+                benches[k]->run();
+                outputs[k].push_back(benches[k]->output(0).clone());
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    auto count = packed->count();
+    ok = ok && count == 2;
+    for (size_t k = 1; k < benches.size(); ++k) {
+        for (size_t i = 0; i < inputs.size(); ++i) ok = ok && same(outputs[k][i], outputs[0][i]);
+    }
+
+    // later runs pack nothing new
+    for (auto &other : benches) {
+        other->input(0, inputs[0]);
+        other->run();
+        ok = ok && same(other->output(0), outputs[0][0]);
+    }
+    ok = ok && packed->count() == count;
+
+    std::cout << "packed weights " << count << " shared by " << benches.size() << " benches: "
+              << (ok ? "OK" : "FAILED") << std::endl;
+    return ok;
+}
+
+int main() {
+    ts::setup();
+
+    bool ok = check_cache();
+    ok = check_shared_benches() && ok;
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
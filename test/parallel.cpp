@@ -2,10 +2,19 @@
 // Created by kier on 2018/11/28.
 //
 
+#include "test_helpers.h"
+
 #include "runtime/inside/parallel.h"
+#include "runtime/workbench.h"
+#include "board/hook.h"
+#include "global/setup.h"
 
 #include "utils/log.h"
 
+#include <atomic>
+#include <cmath>
+#include <vector>
+
 void test_parallel_for() {
     for (int i = 0; i < 10; ++i) {
         TS_PARALLEL_FOR_BEGIN(j, 0, 10, i)
@@ -22,7 +31,133 @@ void test_parallel_range() {
     }
 }
 
+void test_parallel_nest() {
+    std::vector<std::atomic<int>> counter(100 * 100);
+    for (auto &count : counter) count = 0;
+    ts::parallel_run([&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            ts::parallel_run([&](int, int inner_begin, int inner_end) {
+                for (int j = inner_begin; j < inner_end; ++j) {
+                    ++counter[i * 100 + j];
+                }
+            }, 0, 100);
+        }
+    }, 0, 100);
+    for (auto &count : counter) {
+        if (count != 1) TS_LOG_ERROR << "Nest parallel failed, got count " << count << ts::eject;
+    }
+    TS_LOG_INFO << "Nest parallel ok.";
+}
+
+void test_parallel_budget() {
+    if (ts::parallel_budget() != 1) TS_LOG_ERROR << "Budget without thread pool must be 1" << ts::eject;
+
+    ts::ThreadPool pool(4);
+    ts::ctx::bind<ts::ThreadPool> _bind_pool(pool);
+    ts::RuntimeContext runtime;
+
+    for (int threads : {1, 2, 4, 8}) {
+        runtime.set_computing_thread_number(threads);
+        ts::ctx::bind<ts::RuntimeContext> _bind_runtime(runtime);
+        auto budget = std::min(threads, 4);
+        if (ts::parallel_budget() != budget) {
+            TS_LOG_ERROR << "Budget of " << threads << " threads on pool of 4 is " << ts::parallel_budget() << ts::eject;
+        }
+
+        // no more participants than budget, and each index once
+        std::vector<std::atomic<int>> counter(1000);
+        for (auto &count : counter) count = 0;
+        std::atomic<int> max_signet(0);
+        ts::parallel_run([&](int signet, int begin, int end) {
+            int seen = max_signet;
+            while (signet > seen && !max_signet.compare_exchange_weak(seen, signet));
+            for (int i = begin; i < end; ++i) ++counter[i];
+        }, 0, int(counter.size()));
+        for (auto &count : counter) {
+            if (count != 1) TS_LOG_ERROR << "Budget parallel failed, got count " << count << ts::eject;
+        }
+        if (max_signet >= budget) {
+            TS_LOG_ERROR << "Parallel used signet " << max_signet << " over budget " << budget << ts::eject;
+        }
+    }
+    TS_LOG_INFO << "Parallel budget ok.";
+}
+
+void test_shared_thread_pool() {
+    ts::RuntimeContext::UseSharedThreadPool(true);
+    ts::RuntimeContext lhs, rhs;
+    lhs.set_computing_thread_number(2);
+    rhs.set_computing_thread_number(3);
+    auto cloned = lhs.clone();
+    auto shared = ts::RuntimeContext::SharedThreadPool().get();
+    ts::RuntimeContext::UseSharedThreadPool(false);
+
+    for (auto runtime : {&lhs, &rhs, &cloned}) {
+        if (!runtime->using_shared_thread_pool() || &runtime->thread_pool() != shared) {
+            TS_LOG_ERROR << "Runtime not in shared thread pool" << ts::eject;
+        }
+    }
+    {
+        ts::ctx::bind<ts::ThreadPool> _bind_pool(lhs.thread_pool());
+        ts::ctx::bind<ts::RuntimeContext> _bind_runtime(lhs);
+        if (ts::parallel_budget() != std::min<int>(2, int(shared->size()))) {
+            TS_LOG_ERROR << "Budget in shared thread pool is " << ts::parallel_budget() << ts::eject;
+        }
+    }
+
+    ts::RuntimeContext own;
+    own.set_computing_thread_number(2);
+    if (own.using_shared_thread_pool() || &own.thread_pool() == shared || own.thread_pool().size() != 2) {
+        TS_LOG_ERROR << "Runtime still in shared thread pool after turned off" << ts::eject;
+    }
+    TS_LOG_INFO << "Shared thread pool ok.";
+}
+
+/**
+ * kernels run in thread pool of workbench, with computing thread number as budget
+ */
+void test_workbench_parallel() {
+    auto module = ts::test::build_module([]() {
+        auto conv = ts::test::conv2d_fixture("conv", ts::bubble::param("x"), 16, 8);
+        ts::bubble::op("y", ts::name::layer::relu(), {conv});
+    }, {"y"});
+
+    ts::Tensor x(ts::FLOAT32, {2, 8, 32, 32});
+    for (int i = 0; i < x.count(); ++i) x.data<float>()[i] = std::sin(i * 0.1f);
+
+    ts::Tensor expected;
+    for (int threads : {1, 4}) {
+        auto bench = std::make_shared<ts::Workbench>(ts::ComputingDevice(ts::CPU, 0), threads);
+        bench->setup(bench->compile(module, ""));
+        int budget = 0;
+        ts::Hook hook;
+        hook.before_run([&](const ts::Hook::StructBeforeRun &) { budget = ts::parallel_budget(); });
+        ts::ctx::bind<ts::Hook> _bind_hook(hook);
+        bench->input(0, x);
+        bench->run();
+        if (budget != threads) {
+            TS_LOG_ERROR << "Kernels of workbench with " << threads << " threads got budget " << budget << ts::eject;
+        }
+        auto &y = bench->output(0);
+        if (expected.empty()) {
+            expected = y.clone();
+            continue;
+        }
+        for (int i = 0; i < y.count(); ++i) {
+            if (std::fabs(y.data<float>()[i] - expected.data<float>()[i]) > 1e-4f) {
+                TS_LOG_ERROR << "Parallel output mismatch at " << i << ts::eject;
+            }
+        }
+    }
+    TS_LOG_INFO << "Workbench parallel ok.";
+}
+
 int main() {
+    ts::setup();
+
+    test_parallel_budget();
+    test_shared_thread_pool();
+    test_workbench_parallel();
 
     ts::ThreadPool pool(4);
 
@@ -30,6 +165,7 @@ int main() {
 
     test_parallel_for();
     test_parallel_range();
+    test_parallel_nest();
 
     return 0;
 }
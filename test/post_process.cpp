@@ -0,0 +1,245 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <kernels/cpu/nms.h>
+#include <kernels/cpu/caffe/bbox_util.hpp>
+#include <runtime/workbench.h>
+#include <global/setup.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * scores rounded to few levels, so there are lots of ties
+ */
+static std::vector<float> tied_scores(int n, int levels, std::mt19937 &engine) {
+    std::vector<float> scores(n);
+    for (auto &score : scores) score = float(engine() % levels) / levels;
+    return scores;
+}
+
+/**
+ * indices of scores above threshold, stable sorted by score descending, at most top_k if top_k >= 0
+ */
+static std::vector<int> stable_index(const std::vector<float> &scores, float threshold, int top_k) {
+    std::vector<int> index;
+    for (int i = 0; i < int(scores.size()); ++i) {
+        if (scores[i] > threshold) index.push_back(i);
+    }
+    std::stable_sort(index.begin(), index.end(), [&](int a, int b) { return scores[a] > scores[b]; });
+    if (top_k >= 0 && size_t(top_k) < index.size()) index.resize(top_k);
+    return index;
+}
+
+static float iou(const float *lhs, const float *rhs) {
+    float lhs_area = (lhs[2] - lhs[0]) * (lhs[3] - lhs[1]);
+    float rhs_area = (rhs[2] - rhs[0]) * (rhs[3] - rhs[1]);
+    float inter_w = std::max(std::min(lhs[2], rhs[2]) - std::max(lhs[0], rhs[0]), 0.0f);
+    float inter_h = std::max(std::min(lhs[3], rhs[3]) - std::max(lhs[1], rhs[1]), 0.0f);
+    float inter = inter_w * inter_h;
+    return inter / (lhs_area + rhs_area - inter);
+}
+
+/**
+ * boxes in [x1, y1, x2, y2], every 13th box is empty
+ */
+static std::vector<float> random_boxes(int n, float size, std::mt19937 &engine) {
+    std::uniform_real_distribution<float> distribution(0, 1);
+    std::vector<float> boxes(n * 4);
+    for (int i = 0; i < n; ++i) {
+        auto box = &boxes[i * 4];
+        box[0] = distribution(engine);
+        box[1] = distribution(engine);
+        box[2] = box[0] + distribution(engine) * size;
+        box[3] = box[1] + distribution(engine) * size;
+        if (i % 13 == 0) box[2] = box[0];
+    }
+    return boxes;
+}
+
+static bool check_sorted_scores_index() {
+    std::mt19937 engine(1);
+    bool ok = true;
+    for (int n : {0, 1, 7, 100, 5000}) {
+        auto scores = tied_scores(n, 10, engine);
+        for (int top_k : {-1, 0, 3, 64, 10000}) {
+            std::vector<int> index;
+            ts::cpu::sorted_scores_index(scores.data(), n, 0.25f, top_k, index);
+            ok = index == stable_index(scores, 0.25f, top_k) && ok;
+        }
+    }
+    std::cout << "sorted scores index " << (ok ? "stable on ties" : "FAILED") << std::endl;
+    return ok;
+}
+
+/**
+ * vectorized overlapped against scalar IoU, with kept boxes not multiple of lanes
+ */
+static bool check_nms_kept() {
+    std::mt19937 engine(2);
+    bool ok = true;
+    for (int kept_count : {0, 1, 3, 4, 5, 9}) {
+        auto kept_boxes = random_boxes(kept_count, 0.5f, engine);
+        auto boxes = random_boxes(200, 0.5f, engine);
+        ts::cpu::NMSKept kept;
+        for (int i = 0; i < kept_count; ++i) {
+            auto box = &kept_boxes[i * 4];
+            kept.keep(box[0], box[1], box[2], box[3], (box[2] - box[0]) * (box[3] - box[1]));
+        }
+        for (int i = 0; i < 200; ++i) {
+            auto box = &boxes[i * 4];
+            bool expected = false;
+            for (int j = 0; j < kept_count; ++j) expected = expected || iou(box, &kept_boxes[j * 4]) > 0.3f;
+            auto got = kept.overlapped(box[0], box[1], box[2], box[3], (box[2] - box[0]) * (box[3] - box[1]), 0.3f);
+            ok = got == expected && ok;
+        }
+    }
+    std::cout << "nms kept " << (ok ? "matched" : "FAILED") << std::endl;
+    return ok;
+}
+
+static ts::Module::shared nms_module(int max_output_size) {
+    return ts::test::build_module([&]() {
+        auto boxes = ts::bubble::param("boxes");
+        auto scores = ts::bubble::param("scores");
+        auto nms = ts::bubble::op("nms", ts::name::layer::non_max_suppression_v3(), {boxes, scores});
+        nms->set(ts::name::max_output_size, ts::tensor::from<int32_t>(max_output_size));
+        nms->set(ts::name::iou_threshold, ts::tensor::from<float>(0.4f));
+        nms->set(ts::name::score_threshold, ts::tensor::from<float>(0.3f));
+        nms->set(ts::name::mode, ts::tensor::from("xyxy"));
+    }, {"nms"}, {"boxes", "scores"});
+}
+
+/**
+ * greedy nms of operator, tied scores selected in order of index, padded with -1
+ */
+static bool check_nms_v3() {
+    std::mt19937 engine(3);
+    bool ok = true;
+    for (int n : {7, 100, 3000}) {
+        for (int max_output_size : {5, 100}) {
+            auto boxes = random_boxes(n, 0.2f, engine);
+            auto scores = tied_scores(n, 20, engine);
+
+            std::vector<int> expected;
+            for (auto i : stable_index(scores, 0.3f, -1)) {
+                if (int(expected.size()) >= max_output_size) break;
+                bool overlapped = false;
+                for (auto j : expected) overlapped = overlapped || iou(&boxes[i * 4], &boxes[j * 4]) > 0.4f;
+                if (!overlapped) expected.push_back(i);
+            }
+            expected.resize(max_output_size, -1);
+
+            auto bench = ts::Workbench::Load(nms_module(max_output_size), ts::ComputingDevice(ts::CPU, 0));
+            bench->input(0, ts::tensor::build(ts::FLOAT32, ts::Shape{n, 4}, boxes));
+            bench->input(1, ts::tensor::build(ts::FLOAT32, ts::Shape{n}, scores));
+            bench->run();
+            auto &selected = bench->output(0);
+            bool same = selected.count() == max_output_size &&
+                        std::equal(expected.begin(), expected.end(), selected.data<int32_t>());
+            if (!same) std::cout << "nms n=" << n << " max_output_size=" << max_output_size << " mismatch" << std::endl;
+            ok = same && ok;
+        }
+    }
+    std::cout << "non_max_suppression_v3 " << (ok ? "matched" : "FAILED") << std::endl;
+    return ok;
+}
+
+/**
+ * caffe nms on both box structures and raw data
+ */
+static bool check_caffe_nms() {
+    std::mt19937 engine(4);
+    bool ok = true;
+    for (int n : {10, 500}) {
+        for (int top_k : {-1, 100}) {
+            auto raw = random_boxes(n, 0.2f, engine);
+            auto scores = tied_scores(n, 20, engine);
+            std::vector<ts::caffe::NormalizedBBox> boxes(n);
+            for (int i = 0; i < n; ++i) {
+                boxes[i].set_xmin(raw[i * 4]);
+                boxes[i].set_ymin(raw[i * 4 + 1]);
+                boxes[i].set_xmax(raw[i * 4 + 2]);
+                boxes[i].set_ymax(raw[i * 4 + 3]);
+            }
+
+            std::vector<int> expected;
+            for (auto i : stable_index(scores, 0.05f, top_k)) {
+                bool overlapped = false;
+                for (auto j : expected) overlapped = overlapped || ts::caffe::JaccardOverlap(boxes[i], boxes[j]) > 0.45f;
+                if (!overlapped) expected.push_back(i);
+            }
+
+            std::vector<int> got, raw_got;
+            ts::caffe::ApplyNMSFast(boxes, scores, 0.05f, 0.45f, 1.0f, top_k, &got);
+            ts::caffe::ApplyNMSFast(raw.data(), scores.data(), n, 0.05f, 0.45f, 1.0f, top_k, &raw_got);
+            ok = got == expected && raw_got == expected && ok;
+        }
+    }
+    std::cout << "caffe nms " << (ok ? "matched" : "FAILED") << std::endl;
+    return ok;
+}
+
+static ts::Module::shared topk_module(int k) {
+    return ts::test::build_module([&]() {
+        auto x = ts::bubble::param("x");
+        auto topk = ts::bubble::op("topk", ts::name::layer::topkv2(), {x});
+        topk->set(ts::name::number, ts::tensor::from<int32_t>(k));
+        topk->set(ts::name::sorted, ts::tensor::from<int32_t>(1));
+        auto values = ts::bubble::op("values", ts::name::layer::field(), {topk});
+        values->set(ts::name::offset, ts::tensor::from<int32_t>(0));
+        auto indices = ts::bubble::op("indices", ts::name::layer::field(), {topk});
+        indices->set(ts::name::offset, ts::tensor::from<int32_t>(1));
+    }, {"values", "indices"});
+}
+
+/**
+ * top k of each row, tied values ordered by index
+ */
+static bool check_topk() {
+    std::mt19937 engine(5);
+    bool ok = true;
+    for (auto &shape : {ts::Shape({5, 17}), ts::Shape({3, 4, 1000})}) {
+        for (int k : {1, 5, 17}) {
+            ts::Tensor x(ts::FLOAT32, shape);
+            for (int i = 0; i < x.count(); ++i) x.data<float>()[i] = float(engine() % 8);
+
+            auto bench = ts::Workbench::Load(topk_module(k), ts::ComputingDevice(ts::CPU, 0));
+            bench->input(0, x);
+            bench->run();
+            auto &values = bench->output(0);
+            auto &indices = bench->output(1);
+
+            int width = shape.back();
+            for (int row = 0; row < x.count() / width; ++row) {
+                std::vector<float> scores(x.data<float>() + row * width, x.data<float>() + (row + 1) * width);
+                auto expected = stable_index(scores, -1, k);
+                for (int j = 0; j < k; ++j) {
+                    ok = ok && indices.data<int32_t>()[row * k + j] == expected[j] &&
+                         values.data<float>()[row * k + j] == scores[expected[j]];
+                }
+            }
+        }
+    }
+    std::cout << "topkv2 " << (ok ? "stable on ties" : "FAILED") << std::endl;
+    return ok;
+}
+
+int main() {
+    ts::setup();
+
+    bool ok = check_sorted_scores_index();
+    ok = check_nms_kept() && ok;
+    ok = check_nms_v3() && ok;
+    ok = check_caffe_nms() && ok;
+    ok = check_topk() && ok;
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
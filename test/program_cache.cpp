@@ -0,0 +1,90 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/workbench.h>
+#include <runtime/program_cache.h>
+#include <global/setup.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+static const char *const ROOT = "program_cache";
+
+/**
+ * y = x * scale + 1
+ */
+static ts::Module::shared scale_module(float scale) {
+    return ts::test::build_module([&]() {
+        auto x = ts::bubble::param("x");
+        auto a = ts::bubble::op("a", ts::name::layer::mul(), {x, ts::bubble::data("scale", ts::tensor::from(scale))});
+        ts::bubble::op("y", ts::name::layer::add(), {a, ts::bubble::data("one", ts::tensor::from(1.0f))});
+    }, {"y"});
+}
+
+static std::string cached_file(const ts::Module::shared &module, const std::string &options) {
+    auto key = ts::ProgramCache::Key(ts::ProgramCache::Hash(module), ts::ComputingDevice(ts::CPU, 0), options);
+    return std::string(ROOT) + "/" + key + ".tsm";
+}
+
+static bool exists(const std::string &filename) {
+    return std::ifstream(filename).good();
+}
+
+/**
+ * @return the output of program compiled through cache, for x = {1, 2, 3}
+ */
+static std::vector<float> run(ts::ProgramCache &cache, const ts::Module::shared &module, const std::string &options) {
+    auto bench = std::make_shared<ts::Workbench>(ts::ComputingDevice(ts::CPU, 0));
+    bench->setup(bench->compile(module, options, cache));
+    bench->input(0, ts::tensor::build(ts::FLOAT32, {1.0f, 2.0f, 3.0f}));
+    bench->run();
+    auto &y = bench->output(0);
+    return std::vector<float>(y.data<float>(), y.data<float>() + y.count());
+}
+
+int main() {
+    ts::setup();
+
+    auto module = scale_module(2);
+    const std::string options = "--winograd";
+    const std::string other_options = "--no-winograd";
+    auto filename = cached_file(module, options);
+    auto other_filename = cached_file(module, other_options);
+    std::remove(filename.c_str());
+    std::remove(other_filename.c_str());
+
+    ts::ProgramCache cache(ROOT);
+    const std::vector<float> expected = {3, 5, 7};
+
+    // miss, compiled and cached
+    bool miss = run(cache, module, options) == expected && exists(filename) && !exists(other_filename);
+    std::cout << "miss " << (miss ? "cached" : "FAILED") << std::endl;
+
+    // hit, program comes from cached file, replaced by module of other scale to tell it
+    ts::Module::Save(filename, scale_module(3), ts::Module::BINARY_V2);
+    bool hit = run(cache, module, options) == std::vector<float>({4, 7, 10});
+    std::cout << "hit " << (hit ? "loaded" : "FAILED") << std::endl;
+
+    // same module with other options is another entry
+    bool other = cached_file(module, options) != other_filename &&
+                 run(cache, module, other_options) == expected && exists(other_filename);
+    other = other && run(cache, module, other_options) == expected;
+    std::cout << "other options " << (other ? "cached apart" : "FAILED") << std::endl;
+
+    // broken file is compiled again
+    std::ofstream(other_filename, std::ios::binary) << "broken";
+    bool broken = run(cache, module, other_options) == expected && run(cache, module, other_options) == expected;
+    std::cout << "broken cache " << (broken ? "recompiled" : "FAILED") << std::endl;
+
+    std::remove(filename.c_str());
+    std::remove(other_filename.c_str());
+
+    bool ok = miss && hit && other && broken;
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/workbench.h>
+#include <runtime/register_code.h>
+#include <global/setup.h>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+/**
+ * a = x + y, b = a * a, c = b - d, e = maximum(a, c), outputs e, x and b,
+ * so a and b are read more than once, argument x is also output, and d is data operand
+ */
+static ts::Module::shared reused_module() {
+    return ts::test::build_module([]() {
+        auto x = ts::bubble::param("x");
+        auto y = ts::bubble::param("y");
+        auto a = ts::bubble::op("a", ts::name::layer::add(), {x, y});
+        auto b = ts::bubble::op("b", ts::name::layer::mul(), {a, a});
+        auto d = ts::bubble::data("d", ts::tensor::build(ts::FLOAT32, {0.5f, -0.25f, 1.0f}));
+        auto c = ts::bubble::op("c", ts::name::layer::sub(), {b, d});
+        ts::bubble::op("e", ts::name::layer::maximum(), {a, c});
+    }, {"e", "x", "b"}, {"x", "y"});
+}
+
+/**
+ * output never read by later steps must be released right after it is produced
+ */
+static bool check_discard() {
+    using Value = ts::Dataflow::Value;
+    ts::Dataflow dataflow;
+    dataflow.nodes.resize(3);
+    dataflow.nodes[0].instruction = 0;
+    dataflow.nodes[0].inputs = {Value(Value::ARGUMENT, 0)};
+    dataflow.nodes[1].instruction = 1;
+    dataflow.nodes[1].inputs = {Value(Value::ARGUMENT, 0), Value(Value::DATA, 0)};
+    dataflow.nodes[2].instruction = 2;
+    dataflow.nodes[2].inputs = {Value(Value::NODE, 1), Value(Value::NODE, 1)};
+    dataflow.outputs = {Value(Value::NODE, 2), Value(Value::ARGUMENT, 0)};
+
+    auto code = ts::RegisterCode::Allocate(dataflow, 1);
+    auto &steps = code->steps;
+    bool ok = steps.size() == 3 && steps[0].discard && !steps[1].discard && !steps[2].discard &&
+              steps[1].output == steps[0].output && code->slots == 2 &&
+              code->outputs[1].kind == ts::RegisterCode::Operand::SLOT && code->outputs[1].index == 0;
+
+    std::cout << code->str() << std::endl;
+    std::cout << "unread output " << (ok ? "discarded" : "FAILED") << std::endl;
+    return ok;
+}
+
+int main() {
+    ts::setup();
+
+    bool ok = check_discard();
+
+    auto module = reused_module();
+    ts::ComputingDevice device(ts::CPU, 0);
+    auto serial = ts::Workbench::Load(module, device, "--no-register");
+    auto registered = ts::Workbench::Load(module, device, "--register");
+
+    if (serial->desktop()->register_code() != nullptr || registered->desktop()->register_code() == nullptr) {
+        std::cout << "register code not set by compile option" << std::endl;
+        ok = false;
+    }
+
+    for (int size : {1, 3}) {
+        ts::Tensor x(ts::FLOAT32, {2, size});
+        ts::Tensor y(ts::FLOAT32, {2, 3});
+        for (int i = 0; i < x.count(); ++i) x.data<float>()[i] = std::sin(i * 0.7f);
+        for (int i = 0; i < y.count(); ++i) y.data<float>()[i] = std::cos(i * 0.3f);
+
+        for (auto bench : {serial, registered}) {
+            bench->input(0, x);
+            bench->input(1, y);
+            bench->run();
+        }
+        for (int i = 0; i < serial->output_count(); ++i) {
+            auto &lhs = serial->output(i);
+            auto &rhs = registered->output(i);
+            bool same = lhs.sizes() == rhs.sizes();
+            for (int j = 0; same && j < lhs.count(); ++j) {
+                same = lhs.data<float>()[j] == rhs.data<float>()[j];
+            }
+            if (!same) {
+                std::cout << "size=" << size << " output " << i << " mismatch" << std::endl;
+                ok = false;
+            }
+        }
+    }
+
+    std::cout << (ok ? "OK" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
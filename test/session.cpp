@@ -0,0 +1,154 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include "test_helpers.h"
+
+#include <runtime/session.h>
+#include <runtime/instruction.h>
+#include <global/setup.h>
+
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * y = slice_v3(conv2d(x, w), starts, ends, axes), starts and ends are inputs of each request,
+ * slice_v3 loads them into its members when running, so requests running the same operator would race.
+ */
+static ts::Module::shared slice_conv_module() {
+    return ts::test::build_module([]() {
+        auto x = ts::bubble::param("x");
+        auto starts = ts::bubble::param("starts");
+        auto ends = ts::bubble::param("ends");
+        auto conv = ts::test::conv2d_fixture("conv", x, 4, 3);
+        auto axes = ts::bubble::data("axes", ts::tensor::build(ts::INT32, {2, 3}));
+        ts::bubble::op("y", "slice_v3", {conv, starts, ends, axes});
+    }, {"y"}, {"x", "starts", "ends"});
+}
+
+class Request {
+public:
+    ts::Tensor x;
+    ts::Tensor starts;
+    ts::Tensor ends;
+    ts::Tensor y;   ///< expected output
+};
+
+static Request make_request(int seed) {
+    Request request;
+    int size = 8 + seed % 5;
+    request.x = ts::Tensor(ts::FLOAT32, {1, 3, size, size});
+    for (int i = 0; i < request.x.count(); ++i) request.x.data<float>()[i] = std::cos(i * 0.11f + seed);
+    int begin = seed % 3;
+    int end = size - seed % 4;
+    request.starts = ts::tensor::build(ts::INT32, {begin, begin + 1});
+    request.ends = ts::tensor::build(ts::INT32, {end, end - 1});
+    return request;
+}
+
+/**
+ * naive conv2d with padding 1 and slice, for checking the reference outputs
+ */
+static ts::Tensor naive_slice_conv(const Request &request) {
+    auto weights = ts::test::sin_tensor({4, 3, 3, 3});
+    auto weight = weights.data<float>();
+    int size = request.x.size(2);
+    auto x = request.x.data<float>();
+    auto starts = request.starts.data<int32_t>();
+    auto ends = request.ends.data<int32_t>();
+    int height = ends[0] - starts[0];
+    int width = ends[1] - starts[1];
+    ts::Tensor y(ts::FLOAT32, {1, 4, height, width});
+    auto out = y.data<float>();
+    for (int o = 0; o < 4; ++o) {
+        for (int h = starts[0]; h < ends[0]; ++h) {
+            for (int w = starts[1]; w < ends[1]; ++w) {
+                float sum = 0;
+                for (int c = 0; c < 3; ++c) {
+                    for (int kh = 0; kh < 3; ++kh) {
+                        for (int kw = 0; kw < 3; ++kw) {
+                            int ih = h + kh - 1;
+                            int iw = w + kw - 1;
+                            if (ih < 0 || ih >= size || iw < 0 || iw >= size) continue;
+                            sum += x[(c * size + ih) * size + iw] * weight[((o * 3 + c) * 3 + kh) * 3 + kw];
+                        }
+                    }
+                }
+                *out++ = sum;
+            }
+        }
+    }
+    return y;
+}
+
+static ts::Tensor run(ts::Workbench &bench, const Request &request) {
+    bench.input(0, request.x);
+    bench.input(1, request.starts);
+    bench.input(2, request.ends);
+    bench.run();
+    return bench.output(0).clone();
+}
+
+static bool same(const ts::Tensor &lhs, const ts::Tensor &rhs) {
+    if (lhs.sizes() != rhs.sizes()) return false;
+    for (int i = 0; i < lhs.count(); ++i) {
+        if (std::fabs(lhs.data<float>()[i] - rhs.data<float>()[i]) > 1e-4f) return false;
+    }
+    return true;
+}
+
+int main() {
+    ts::setup();
+
+    auto module = slice_conv_module();
+    ts::ComputingDevice device(ts::CPU, 0);
+
+    const int threads = 4;
+    const int requests = 100;
+
+    // expected outputs, run in serial and checked with naive computing
+    std::vector<Request> all;
+    auto reference = ts::Workbench::Load(module, device);
+    int wrong_reference = 0;
+    for (int i = 0; i < threads * requests; ++i) {
+        all.push_back(make_request(i));
+        all.back().y = run(*reference, all.back());
+        if (all.back().y.count() == 0 || !same(all.back().y, naive_slice_conv(all.back()))) ++wrong_reference;
+    }
+
+    auto session = ts::Session::Load(module, device);
+
+    // workbenches in using at the same time must not share operators
+    int shared_operators = 0;
+    {
+        auto lhs = session->acquire();
+        auto rhs = session->acquire();
+        auto &lhs_program = lhs->desktop()->instruction();
+        auto &rhs_program = rhs->desktop()->instruction();
+        for (size_t i = 0; i < lhs_program.size(); ++i) {
+            auto lhs_op = dynamic_cast<ts::OperatorInstruction *>(lhs_program[i].get());
+            auto rhs_op = dynamic_cast<ts::OperatorInstruction *>(rhs_program[i].get());
+            if (lhs_op && rhs_op && lhs_op->op() == rhs_op->op()) ++shared_operators;
+        }
+    }
+
+    std::atomic<int> failed(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int k = 0; k < requests; ++k) {
+                auto &request = all[k * threads + t];
+                auto bench = session->acquire();
+                if (!same(run(*bench, request), request.y)) ++failed;
+            }
+        });
+    }
+    for (auto &worker : workers) worker.join();
+
+    std::cout << "idle=" << session->idle() << " shared_operators=" << shared_operators
+              << " wrong_reference=" << wrong_reference << " failed=" << failed << std::endl;
+    return failed == 0 && shared_operators == 0 && wrong_reference == 0 ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+#include "kernels/common/simd.h"
+
+using Vector = ts::float32x4 (*)(const ts::float32x4 &);
+using Scalar = double (*)(double);
+
+static double sigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+
+static double rsqrt(double x) { return 1.0 / std::sqrt(x); }
+
+/**
+ * compare vector function with double precision reference on [begin, end]
+ * @param relative check relative error, or absolute error
+ * @return true if max error under bound
+ */
+static bool check(const std::string &name, Vector vector, Scalar scalar,
+                  float begin, float end, double bound, bool relative = true) {
+    static const int N = 1 << 20;
+    double max_error = 0;
+    float worst = begin;
+    for (int i = 0; i < N; i += 4) {
+        float x[4], y[4];
+        for (int j = 0; j < 4; ++j) x[j] = begin + (end - begin) * float(i + j) / (N - 1);
+        vector(ts::float32x4(x)).store(y);
+        for (int j = 0; j < 4; ++j) {
+            auto expected = scalar(x[j]);
+            auto error = std::fabs(y[j] - expected);
+            if (relative && expected != 0) error /= std::fabs(expected);
+            if (!(error <= max_error)) {
+                max_error = error;
+                worst = x[j];
+            }
+        }
+    }
+    bool passed = max_error <= bound;
+    std::printf("[%s] %s on [%g, %g]: max %s error %g at %g, bound %g\n",
+                passed ? "OK" : "FAILED", name.c_str(), begin, end,
+                relative ? "relative" : "absolute", max_error, worst, bound);
+    return passed;
+}
+
+/**
+ * check special values
+ */
+static bool check(const std::string &name, Vector vector, float x, float expected) {
+    float y[4];
+    vector(ts::float32x4(x)).store(y);
+    bool passed = std::isnan(expected) ? std::isnan(y[0]) : y[0] == expected;
+    std::printf("[%s] %s(%g) = %g, expected %g\n", passed ? "OK" : "FAILED", name.c_str(), x, y[0], expected);
+    return passed;
+}
+
+int main() {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    bool passed = true;
+    passed &= check("exp", ts::exp_float32x4, std::exp, -87, 88, 4e-7);
+    passed &= check("exp", ts::exp_float32x4, std::exp, -1, 1, 4e-7);
+    passed &= check("exp", ts::exp_float32x4, std::exp, 88, 88.72f, 4e-7);
+    passed &= check("log", ts::log_float32x4, std::log, 1e-30f, 1e30f, 4e-7);
+    passed &= check("log", ts::log_float32x4, std::log, 1e-3f, 10, 4e-7);
+    passed &= check("log", ts::log_float32x4, std::log, 0.5f, 2, 2e-7, false);
+    passed &= check("sigmoid", ts::sigmoid_float32x4, sigmoid, -30, 30, 2e-7, false);
+    passed &= check("tanh", ts::tanh_float32x4, std::tanh, -10, 10, 4e-7);
+    passed &= check("tanh", ts::tanh_float32x4, std::tanh, -1, 1, 4e-7);
+    passed &= check("sqrt", ts::sqrt_float32x4, std::sqrt, 0, 1e6f, 2e-7);
+    passed &= check("rsqrt", ts::rsqrt_float32x4, rsqrt, 1e-6f, 1e6f, 4e-7);
+
+    passed &= check("exp", ts::exp_float32x4, 0, 1);
+    passed &= check("exp", ts::exp_float32x4, nan, nan);
+    passed &= check("exp", ts::exp_float32x4, inf, inf);
+    passed &= check("exp", ts::exp_float32x4, -inf, 0);
+    passed &= check("exp", ts::exp_float32x4, 89, inf);
+    passed &= check("exp", ts::exp_float32x4, -104, 0);
+    passed &= check("log", ts::log_float32x4, 1, 0);
+    passed &= check("log", ts::log_float32x4, 0, -inf);
+    passed &= check("log", ts::log_float32x4, inf, inf);
+    passed &= check("log", ts::log_float32x4, -1, nan);
+    passed &= check("log", ts::log_float32x4, nan, nan);
+    passed &= check("sigmoid", ts::sigmoid_float32x4, inf, 1);
+    passed &= check("sigmoid", ts::sigmoid_float32x4, -inf, 0);
+    passed &= check("tanh", ts::tanh_float32x4, 0, 0);
+    passed &= check("tanh", ts::tanh_float32x4, -inf, -1);
+    passed &= check("tanh", ts::tanh_float32x4, inf, 1);
+    passed &= check("sqrt", ts::sqrt_float32x4, 0, 0);
+    passed &= check("rsqrt", ts::rsqrt_float32x4, 0, inf);
+    passed &= check("rsqrt", ts::rsqrt_float32x4, inf, 0);
+
+    return passed ? 0 : 1;
+}
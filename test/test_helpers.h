@@ -0,0 +1,99 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#ifndef TENSORSTACK_TEST_TEST_HELPERS_H
+#define TENSORSTACK_TEST_TEST_HELPERS_H
+
+#include <module/graph.h>
+#include <module/module.h>
+#include <module/menu.h>
+#include <runtime/instruction.h>
+#include <runtime/program.h>
+#include <backend/name.h>
+#include <core/tensor_builder.h>
+#include <utils/ctxmgr_lite.h>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ts {
+    namespace test {
+        /**
+         * @return tensor filled with sin(i * scale), i is the index in memory
+         */
+        inline Tensor sin_tensor(const Shape &shape, float scale = 0.37f) {
+            Tensor tensor(FLOAT32, shape);
+            for (int i = 0; i < tensor.count(); ++i) tensor.data<float>()[i] = std::sin(i * scale);
+            return tensor;
+        }
+
+        /**
+         * @return tensor filled with uniform random values in [min, max)
+         */
+        inline Tensor random_tensor(const Shape &shape, unsigned seed, float min, float max) {
+            Tensor tensor(FLOAT32, shape);
+            std::mt19937 engine(seed);
+            std::uniform_real_distribution<float> distribution(min, max);
+            for (int i = 0; i < tensor.count(); ++i) tensor.data<float>()[i] = distribution(engine);
+            return tensor;
+        }
+
+        /**
+         * NCHW conv2d of 3x3 kernel w, with padding 1, stride 1 and dilation 1, so output keeps the size of x
+         * @param op conv2d operator, conv2d_quantized for example
+         * @note must be called with Graph bound
+         */
+        inline Node conv2d(const std::string &name, const Node &x, const Node &w,
+                           const std::string &op = ts::name::layer::conv2d()) {
+            auto conv = bubble::op(name, op, {x, w});
+            conv->set(ts::name::format, tensor::from(ts::name::NCHW));
+            conv->set(ts::name::padding, tensor::build(INT32, Shape{4, 2}, {0, 0, 0, 0, 1, 1, 1, 1}));
+            conv->set(ts::name::stride, tensor::build(INT32, {1, 1, 1, 1}));
+            conv->set(ts::name::dilation, tensor::build(INT32, {1, 1, 1, 1}));
+            return conv;
+        }
+
+        /**
+         * conv2d with weights name + "_w" in [out_channels, in_channels, 3, 3], filled by sin_tensor
+         * @note must be called with Graph bound
+         */
+        inline Node conv2d_fixture(const std::string &name, const Node &x, int out_channels, int in_channels) {
+            return conv2d(name, x, bubble::data(name + "_w", sin_tensor({out_channels, in_channels, 3, 3})));
+        }
+
+        /**
+         * build graph in bound Graph, then load module of outputs
+         * @param build function called with Graph bound
+         * @param outputs names of output nodes
+         * @param inputs names of input nodes in order, keep order of graph if empty
+         */
+        template <typename FUNC>
+        inline Module::shared build_module(FUNC build, const std::vector<std::string> &outputs,
+                                           const std::vector<std::string> &inputs = {}) {
+            Graph g;
+            ctx::bind<Graph> _bind_graph(g);
+            build();
+            auto module = std::make_shared<Module>();
+            module->load(g, outputs);
+            if (!inputs.empty()) module->sort_inputs(inputs);
+            return module;
+        }
+
+        /**
+         * @return number of operators in program, only of type op if op is not empty
+         */
+        inline int count_operators(const Program &program, const std::string &op = "") {
+            int count = 0;
+            for (auto &inst : program.instruction()) {
+                auto operator_instruction = dynamic_cast<OperatorInstruction *>(inst.get());
+                if (operator_instruction && (op.empty() || operator_instruction->op()->op() == op)) ++count;
+            }
+            return count;
+        }
+    }
+}
+
+#endif //TENSORSTACK_TEST_TEST_HELPERS_H
@@ -11,6 +11,7 @@
 #include "runtime/workbench.h"
 #include <string>
 #include <chrono>
+#include <fstream>
 #include <algorithm>
 
 namespace ts{
@@ -247,6 +248,9 @@ namespace ts{
             bench->run();
             db->index_inch();
 
+            bench->profiler().clean();
+            bench->do_profile(need_statistical);
+
             float count_time = 0.f;
             float max_time = 0.f,min_time = FLT_MAX;
             for (size_t i = 0; i < option.loop_counts; i++)
@@ -268,9 +272,15 @@ namespace ts{
                 db->index_inch();
             }
 
+            bench->do_profile(false);
+
             if(need_statistical){
                 db->analyze();
                 db->log(std::cout);
+
+                bench->profiler().summary(std::cout);
+                std::ofstream trace(name + ".trace.json");
+                bench->profiler().trace(trace);
             }
 
             std::cout << "Net: " << name
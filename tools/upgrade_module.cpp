@@ -0,0 +1,32 @@
+//
+// Created by agent on 2026-10-18.
+//
+
+#include <module/module.h>
+#include <global/setup.h>
+#include <utils/log.h>
+
+#include <iostream>
+
+using namespace ts;
+
+/**
+ * Save module in v2 format, which weights can be loaded by mapping file
+ */
+int main(int argc, const char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " input.tsm output.tsm" << std::endl;
+        return 1;
+    }
+    setup();
+
+    std::string input = argv[1];
+    std::string output = argv[2];
+
+    auto module = Module::Load(input);
+    Module::Save(output, module, Module::BINARY_V2);
+
+    TS_LOG_INFO << "Saved " << output;
+
+    return 0;
+}